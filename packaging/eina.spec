@@ -61,6 +61,7 @@ rm -rf %{buildroot}
 
 %files
 %defattr(-,root,root,-)
+%{_bindir}/eina_log_decode
 %{_libdir}/libeina.so.*
 
 
@@ -0,0 +1,90 @@
+/* EINA - EFL data type library
+ * Copyright (C) 2012 Enlightenment Project
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Print the messages of binary log files, written by
+ * eina_log_print_cb_binary(), like eina_log_print_cb_stderr() does without
+ * colors, prefixed by the time they were logged at.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <Eina.h>
+
+static Eina_Bool
+_print_cb(void *data, const Eina_Log_Binary_Record *record)
+{
+   FILE *f = data;
+   char date[64];
+   char name[4];
+   time_t t;
+   struct tm *tm;
+
+   t = (time_t)record->timestamp;
+   tm = localtime(&t);
+   if (!tm || !strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", tm))
+     date[0] = '\0';
+
+   eina_log_level_name_get(record->level, name);
+
+   fprintf(f, "%s.%06u %s<%u>:%s", date,
+           (unsigned int)((record->timestamp - (double)t) * 1000000.0),
+           name, record->pid, record->domain);
+   if (record->thread)
+     fprintf(f, "[T:%lu]", record->thread);
+   fprintf(f, " %s:%d %s() %s\n",
+           record->file, record->line, record->fnc, record->message);
+
+   return EINA_TRUE;
+}
+
+int
+main(int argc, char **argv)
+{
+   int ret = 0;
+   int i;
+
+   if (argc < 2 ||
+       !strcmp(argv[1], "-h") || !strcmp(argv[1], "--help"))
+     {
+        fprintf(stderr, "Usage: %s <binary log file> [...]\n", argv[0]);
+        return argc < 2 ? 1 : 0;
+     }
+
+   eina_init();
+
+   for (i = 1; i < argc; i++)
+     {
+        if (!eina_log_binary_decode(argv[i], _print_cb, stdout))
+          {
+             fprintf(stderr, "%s: could not decode all of '%s'\n",
+                     argv[0], argv[i]);
+             ret = 1;
+          }
+     }
+
+   eina_shutdown();
+
+   return ret;
+}
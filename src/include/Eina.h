@@ -240,6 +240,8 @@ extern "C" {
 #include "eina_mmap.h"
 #include "eina_xattr.h"
 #include "eina_value.h"
+#include "eina_hash_index.h"
+#include "eina_value_binary.h"
 
 #ifdef __cplusplus
 }
@@ -114,6 +114,33 @@ typedef struct _Eina_File_Line Eina_File_Line;
  */
 typedef void (*Eina_File_Dir_List_Cb)(const char *name, const char *path, void *data);
 
+/**
+ * @typedef Eina_File_Walk_Filter_Cb
+ * Type for the filter and prune callbacks of eina_file_dir_walk().
+ * @param data The data passed to eina_file_dir_walk()
+ * @param info The entry being considered, only valid during the call
+ * @return #EINA_TRUE to select the entry, #EINA_FALSE otherwise.
+ * @since 1.7
+ */
+typedef Eina_Bool (*Eina_File_Walk_Filter_Cb)(void *data, const Eina_File_Direct_Info *info);
+
+/**
+ * @typedef Eina_File_Walk_Batch_Cb
+ * Type for the callback receiving the entries found by eina_file_dir_walk().
+ * @param data The data passed to eina_file_dir_walk()
+ * @param infos Array of @p count entries, only valid during the call
+ * @param count The number of entries in @p infos
+ * @since 1.7
+ */
+typedef void (*Eina_File_Walk_Batch_Cb)(void *data, const Eina_File_Direct_Info **infos, unsigned int count);
+
+/**
+ * @typedef Eina_File_Async
+ * A queue of asynchronous reads, see eina_file_async_new().
+ * @since 1.7
+ */
+typedef struct _Eina_File_Async Eina_File_Async;
+
 /**
  * @typedef Eina_File_Type
  * file type in Eina_File_Direct_Info.
@@ -131,6 +158,19 @@ typedef enum {
 } Eina_File_Type;
 
 typedef struct _Eina_File Eina_File;
+
+/**
+ * @typedef Eina_File_Async_Cb
+ * Type for the callback called when an asynchronous read is done.
+ * @param data The data passed to eina_file_async_read()
+ * @param file The file that was read
+ * @param buffer The buffer passed to eina_file_async_read()
+ * @param offset The offset the read started at
+ * @param result The number of bytes read, or a negative errno on error
+ * @since 1.7
+ */
+typedef void (*Eina_File_Async_Cb)(void *data, Eina_File *file, void *buffer, unsigned long int offset, long int result);
+
 /**
  * @typedef Eina_File_Populate
  * File access type used in Eina_File_Direct_info.
@@ -242,6 +282,47 @@ EAPI Eina_Bool eina_file_dir_list(const char           *dir,
                                   Eina_File_Dir_List_Cb cb,
                                   void                 *data) EINA_ARG_NONNULL(1, 3);
 
+/**
+ * @brief Recursively walk a directory tree using several threads.
+ *
+ * @param dir The directory name.
+ * @param max_threads The maximum number of threads to use, @c 0 to use
+ *        eina_cpu_count().
+ * @param filter Callback selecting the entries to report, or @c NULL to
+ *        report all of them.
+ * @param prune Callback returning #EINA_TRUE for the directories that must
+ *        not be descended into, or @c NULL to walk the whole tree.
+ * @param cb The callback receiving the reported entries.
+ * @param data The data to pass to the callbacks.
+ * @return #EINA_TRUE on success, #EINA_FALSE otherwise.
+ *
+ * This function lists @p dir and all its subdirectories like
+ * eina_file_dir_list() does in recursive mode, but lists different
+ * subdirectories in parallel on up to @p max_threads threads, the calling
+ * thread being one of them. It returns once the whole tree has been walked.
+ *
+ * Entries are reported by batch to @p cb, in no specific order. Calls to
+ * @p cb are serialized, but they can happen from any of the walking
+ * threads. The entries passed to @p cb only keep the first
+ * Eina_File_Direct_Info::path_length + 1 bytes of their path and they
+ * must be copied if needed after @p cb returns. @p filter and @p prune
+ * are called concurrently from all the walking threads. Symbolic links
+ * to directories are not followed.
+ *
+ * If @p cb or @p dir are @c NULL, or if @p dir is a string of size 0,
+ * or if @p dir can not be opened, this function returns #EINA_FALSE
+ * immediately.
+ *
+ * @see eina_file_dir_list()
+ * @since 1.7
+ */
+EAPI Eina_Bool eina_file_dir_walk(const char              *dir,
+                                  unsigned int             max_threads,
+                                  Eina_File_Walk_Filter_Cb filter,
+                                  Eina_File_Walk_Filter_Cb prune,
+                                  Eina_File_Walk_Batch_Cb  cb,
+                                  void                    *data) EINA_ARG_NONNULL(1, 5);
+
 /**
  * @brief Split a path according to the delimiter of the filesystem.
  *
@@ -316,6 +397,7 @@ EAPI Eina_Iterator *eina_file_stat_ls(const char *dir) EINA_WARN_UNUSED_RESULT E
  *
  * This function calls fstatat or stat depending on what your system supports. This makes it efficient and simple
  * to use on your side without complex detection already done inside Eina on what the system can do.
+ * Symbolic links are not followed, @p buf describes the link itself.
  *
  * @see eina_file_direct_ls()
  * @see eina_file_stat_ls()
@@ -395,6 +477,39 @@ EAPI Eina_File *eina_file_open(const char *name, Eina_Bool shared) EINA_WARN_UNU
  */
 EAPI void eina_file_close(Eina_File *file);
 
+/**
+ * @brief Enable or disable change notification for the open file cache.
+ *
+ * @param watch #EINA_TRUE to watch cached files, #EINA_FALSE to go back
+ *        to checking them on each open.
+ * @return #EINA_TRUE on success, #EINA_FALSE if the mode could not be set.
+ *
+ * Files opened with eina_file_open() are cached and a new open of the
+ * same file reuses the cached handler, after calling stat() to check that
+ * the file did not change. When watching is enabled, cached files are
+ * monitored by the system (inotify on Linux) from a dedicated thread
+ * instead. Opening a file that did not change since it was last checked
+ * then only costs a hash lookup, without any system call. Shared
+ * memory files are always checked with stat().
+ *
+ * Changes are detected asynchronously, so a file modified right before
+ * being opened may still be served from the cache for a very short time.
+ * This function must be called from the main loop.
+ *
+ * @see eina_file_cache_watch_get()
+ * @since 1.7
+ */
+EAPI Eina_Bool eina_file_cache_watch_set(Eina_Bool watch);
+
+/**
+ * @brief Tell if the open file cache is watched for changes.
+ *
+ * @return #EINA_TRUE if eina_file_cache_watch_set() enabled watching.
+ *
+ * @since 1.7
+ */
+EAPI Eina_Bool eina_file_cache_watch_get(void);
+
 /**
  * @brief Get file size at open time.
  *
@@ -513,6 +628,128 @@ EAPI Eina_Iterator *eina_file_map_lines(Eina_File *file);
  */
 EAPI Eina_Bool eina_file_map_faulted(Eina_File *file, void *map);
 
+/**
+ * @brief Write a part of a file to a file descriptor.
+ *
+ * @param file The file handler to read from.
+ * @param offset The offset inside the file.
+ * @param length The number of bytes to write.
+ * @param fd The file descriptor to write to.
+ * @return #EINA_TRUE if the @p length bytes were written, #EINA_FALSE otherwise.
+ *
+ * This function writes @p length bytes of @p file, starting at @p offset,
+ * at the current position of @p fd, like a write() of the mapped memory
+ * would. When the system allows it (copy_file_range() or sendfile() on
+ * Linux) the data is moved by the kernel without being copied to user
+ * space, whether @p fd is a file, a pipe or a socket. Otherwise the file
+ * is mapped and written in chunks.
+ *
+ * @p fd should be in blocking mode, as the transfer stops at the first
+ * error, in which case an unknown amount of data may already have been
+ * written.
+ *
+ * @since 1.7
+ */
+EAPI Eina_Bool eina_file_transfer(Eina_File *file,
+                                  unsigned long int offset, unsigned long int length,
+                                  int fd);
+
+/**
+ * @brief Create a queue of asynchronous reads.
+ *
+ * @param depth The number of reads the queue should keep in flight, 0 for a default.
+ * @return A new queue, or @c NULL on error.
+ *
+ * Reads submitted with eina_file_async_read() are done in the
+ * background, by io_uring when the system provides it or by a small
+ * pool of threads otherwise. Completions are dispatched in the thread
+ * calling eina_file_async_process() or eina_file_async_wait(), and
+ * eina_file_async_fd_get() gives a descriptor to poll to know when to
+ * do so. A queue is not meant to be shared between threads.
+ *
+ * @since 1.7
+ */
+EAPI Eina_File_Async *eina_file_async_new(unsigned int depth);
+
+/**
+ * @brief Free a queue of asynchronous reads.
+ *
+ * @param async The queue to free.
+ *
+ * This waits for all pending reads and calls their callbacks before
+ * freeing @p async.
+ *
+ * @since 1.7
+ */
+EAPI void eina_file_async_free(Eina_File_Async *async);
+
+/**
+ * @brief Queue an asynchronous read.
+ *
+ * @param async The queue.
+ * @param file The file to read from.
+ * @param offset The offset inside the file.
+ * @param length The number of bytes to read.
+ * @param buffer Where to store the data, at least @p length bytes.
+ * @param cb The callback called once the read is done.
+ * @param data The data passed to @p cb.
+ * @return #EINA_TRUE if the read was queued, #EINA_FALSE otherwise.
+ *
+ * @p buffer must stay valid until @p cb is called. @p file is
+ * referenced until then, so it can be closed right after this call.
+ * Like pread(), a read may return less than @p length bytes.
+ *
+ * @since 1.7
+ */
+EAPI Eina_Bool eina_file_async_read(Eina_File_Async *async, Eina_File *file,
+                                    unsigned long int offset, unsigned long int length,
+                                    void *buffer, Eina_File_Async_Cb cb, const void *data) EINA_ARG_NONNULL(1, 2, 5, 6);
+
+/**
+ * @brief Get a file descriptor that becomes readable when reads are done.
+ *
+ * @param async The queue.
+ * @return The file descriptor, -1 on error.
+ *
+ * The descriptor must not be read nor closed, call
+ * eina_file_async_process() once it is readable.
+ *
+ * @since 1.7
+ */
+EAPI int eina_file_async_fd_get(const Eina_File_Async *async);
+
+/**
+ * @brief Get the number of reads whose callback was not called yet.
+ *
+ * @param async The queue.
+ * @return The number of pending reads.
+ *
+ * @since 1.7
+ */
+EAPI unsigned int eina_file_async_pending_get(const Eina_File_Async *async);
+
+/**
+ * @brief Call the callbacks of the reads that are done, without blocking.
+ *
+ * @param async The queue.
+ * @return The number of callbacks called.
+ *
+ * @since 1.7
+ */
+EAPI unsigned int eina_file_async_process(Eina_File_Async *async);
+
+/**
+ * @brief Wait for all pending reads and call their callbacks.
+ *
+ * @param async The queue.
+ * @return The number of callbacks called.
+ *
+ * Reads queued from the callbacks are waited for too.
+ *
+ * @since 1.7
+ */
+EAPI unsigned int eina_file_async_wait(Eina_File_Async *async);
+
 /**
  * @}
  */
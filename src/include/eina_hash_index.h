@@ -0,0 +1,185 @@
+/* EINA - EFL data type library
+ * Copyright (C) 2012 Enlightenment Project
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EINA_HASH_INDEX_H_
+#define EINA_HASH_INDEX_H_
+
+#include "eina_types.h"
+#include "eina_iterator.h"
+#include "eina_hash.h"
+#include "eina_file.h"
+
+/**
+ * @page eina_hash_index_main Hash Index
+ *
+ * An hash index is a read only hash table stored in a file. It is built
+ * once, with eina_hash_index_write() or eina_hash_index_hash_write(), and
+ * then opened with eina_hash_index_open() on an #Eina_File. Opening does
+ * not parse nor copy anything, the lookups are done directly in the
+ * mapped file, so large tables are available almost immediately and
+ * their memory is shared between all the processes using them.
+ *
+ * Keys and values are arbitrary bytes. Values are aligned on 8 bytes in
+ * the file, so they can directly hold plain structures. The format uses
+ * the byte order of the machine that wrote it, an index written on a
+ * machine with a different byte order is refused by
+ * eina_hash_index_open().
+ */
+
+/**
+ * @addtogroup Eina_Data_Types_Group Data Types
+ *
+ * @{
+ */
+
+/**
+ * @addtogroup Eina_Containers_Group Containers
+ *
+ * @{
+ */
+
+/**
+ * @defgroup Eina_Hash_Index_Group Hash Index
+ *
+ * Read only hash table mapped from a file, see @ref eina_hash_index_main.
+ *
+ * @{
+ */
+
+/**
+ * @typedef Eina_Hash_Index
+ * Type for a hash index opened from a file.
+ * @since 1.7
+ */
+typedef struct _Eina_Hash_Index Eina_Hash_Index;
+
+/**
+ * @typedef Eina_Hash_Index_Value_Cb
+ * Type for the callback giving the bytes to store for a value.
+ * @param data The data passed to eina_hash_index_write()
+ * @param tuple The key and data being written
+ * @param length Where to store the number of bytes of the value
+ * @return The bytes of the value, they are copied before the next call.
+ * @since 1.7
+ */
+typedef const void *(*Eina_Hash_Index_Value_Cb)(void *data, const Eina_Hash_Tuple *tuple, unsigned int *length);
+
+/**
+ * @brief Write a hash index file from an iterator.
+ *
+ * @param filename The file to create.
+ * @param tuples An iterator returning #Eina_Hash_Tuple.
+ * @param cb The callback giving the bytes of each value, or @c NULL.
+ * @param data The data passed to @p cb.
+ * @return #EINA_TRUE on success, #EINA_FALSE otherwise.
+ *
+ * The key of each tuple is stored as @c key_length bytes. When @p cb is
+ * @c NULL, the data of each tuple is expected to be a nul terminated
+ * string and is stored with its terminating nul. When a key is given
+ * more than once, the last value wins.
+ *
+ * The index is written to a temporary file that then replaces
+ * @p filename, so processes that still map the previous version of the
+ * file are not affected. @p tuples is not freed.
+ *
+ * @since 1.7
+ */
+EAPI Eina_Bool eina_hash_index_write(const char *filename, Eina_Iterator *tuples,
+                                     Eina_Hash_Index_Value_Cb cb, const void *data) EINA_ARG_NONNULL(1, 2);
+
+/**
+ * @brief Write a hash index file with the content of a hash table.
+ *
+ * @param filename The file to create.
+ * @param hash The hash table to write.
+ * @param cb The callback giving the bytes of each value, or @c NULL.
+ * @param data The data passed to @p cb.
+ * @return #EINA_TRUE on success, #EINA_FALSE otherwise.
+ *
+ * This is eina_hash_index_write() on eina_hash_iterator_tuple_new().
+ *
+ * @since 1.7
+ */
+EAPI Eina_Bool eina_hash_index_hash_write(const char *filename, const Eina_Hash *hash,
+                                          Eina_Hash_Index_Value_Cb cb, const void *data) EINA_ARG_NONNULL(1, 2);
+
+/**
+ * @brief Open a hash index.
+ *
+ * @param file The file holding the index.
+ * @return The index, or @c NULL if @p file is not a valid index.
+ *
+ * Only the header of the file is checked, the content is accessed on
+ * demand. @p file must stay open as long as the index is.
+ *
+ * @since 1.7
+ */
+EAPI Eina_Hash_Index *eina_hash_index_open(Eina_File *file) EINA_ARG_NONNULL(1) EINA_WARN_UNUSED_RESULT;
+
+/**
+ * @brief Close a hash index.
+ *
+ * @param idx The index to close.
+ *
+ * The pointers returned by eina_hash_index_find() become invalid.
+ *
+ * @since 1.7
+ */
+EAPI void eina_hash_index_close(Eina_Hash_Index *idx);
+
+/**
+ * @brief Find the value of a key in a hash index.
+ *
+ * @param idx The index.
+ * @param key The key to look for.
+ * @param key_length The length of @p key, in bytes.
+ * @param length Where to store the length of the value, may be @c NULL.
+ * @return A pointer to the value inside the mapped file, @c NULL if not found.
+ *
+ * For a string key written from a string #Eina_Hash, @p key_length is
+ * strlen(key) + 1, like eina_hash does.
+ *
+ * @since 1.7
+ */
+EAPI const void *eina_hash_index_find(const Eina_Hash_Index *idx,
+                                      const void *key, unsigned int key_length,
+                                      unsigned int *length) EINA_ARG_NONNULL(1, 2);
+
+/**
+ * @brief Get the number of keys in a hash index.
+ *
+ * @param idx The index.
+ * @return The number of keys.
+ *
+ * @since 1.7
+ */
+EAPI unsigned int eina_hash_index_count(const Eina_Hash_Index *idx);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif
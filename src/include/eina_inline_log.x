@@ -195,6 +195,51 @@ eina_log_level_color_if_enabled_get(int level)
    return eina_log_level_color_get(level);
 }
 
+#ifdef EINA_LOG_SITES
+/**
+ * @internal
+ * Whether the message of a call site is to be printed, from its cache if
+ * it is still valid. The cache is a sequence lock: eina_log_site_sync()
+ * makes sequence odd while writing it and changes it on each write, so a
+ * cache read while written is ignored.
+ */
+static inline int
+eina_log_site_enabled(Eina_Log_Site *site, int domain, int level)
+{
+   unsigned int sequence;
+   int enabled;
+
+#ifdef __ATOMIC_ACQUIRE
+   sequence = __atomic_load_n(&site->sequence, __ATOMIC_ACQUIRE);
+   enabled = __atomic_load_n(&site->enabled, __ATOMIC_RELAXED);
+   if (EINA_UNLIKELY((sequence & 1) ||
+                     (__atomic_load_n(&site->generation, __ATOMIC_RELAXED) !=
+                      __atomic_load_n(&_eina_log_site_generation,
+                                      __ATOMIC_RELAXED)) ||
+                     (__atomic_load_n(&site->domain, __ATOMIC_RELAXED) !=
+                      domain) ||
+                     (__atomic_load_n(&site->level, __ATOMIC_RELAXED) !=
+                      level)))
+     return eina_log_site_sync(site, domain, level);
+
+   __atomic_thread_fence(__ATOMIC_ACQUIRE);
+   if (EINA_UNLIKELY(__atomic_load_n(&site->sequence, __ATOMIC_RELAXED) !=
+                     sequence))
+     return eina_log_site_sync(site, domain, level);
+#else
+   sequence = site->sequence;
+   enabled = site->enabled;
+   if (EINA_UNLIKELY((sequence & 1) ||
+                     (site->generation != _eina_log_site_generation) ||
+                     (site->domain != domain) || (site->level != level) ||
+                     (site->sequence != sequence)))
+     return eina_log_site_sync(site, domain, level);
+#endif
+
+   return enabled;
+}
+#endif
+
 /**
  * @}
  */
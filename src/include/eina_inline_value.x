@@ -26,6 +26,31 @@
 
 /* NOTE: most of value is implemented here for performance reasons */
 
+/**
+ * @brief Position of the basic types after _EINA_VALUE_TYPE_BASICS_START.
+ * @since 1.7
+ * @private
+ */
+typedef enum _Eina_Value_Type_Basic
+{
+  EINA_VALUE_TYPE_BASIC_UCHAR = 0,
+  EINA_VALUE_TYPE_BASIC_USHORT,
+  EINA_VALUE_TYPE_BASIC_UINT,
+  EINA_VALUE_TYPE_BASIC_ULONG,
+  EINA_VALUE_TYPE_BASIC_UINT64,
+  EINA_VALUE_TYPE_BASIC_CHAR,
+  EINA_VALUE_TYPE_BASIC_SHORT,
+  EINA_VALUE_TYPE_BASIC_INT,
+  EINA_VALUE_TYPE_BASIC_LONG,
+  EINA_VALUE_TYPE_BASIC_INT64,
+  EINA_VALUE_TYPE_BASIC_FLOAT,
+  EINA_VALUE_TYPE_BASIC_DOUBLE,
+  EINA_VALUE_TYPE_BASIC_STRINGSHARE,
+  EINA_VALUE_TYPE_BASIC_STRING,
+  EINA_VALUE_TYPE_BASIC_TIMESTAMP,
+  EINA_VALUE_TYPE_BASIC_COUNT
+} Eina_Value_Type_Basic;
+
 //#define EINA_VALUE_NO_OPTIMIZE 1
 #ifdef EINA_VALUE_NO_OPTIMIZE
 #define EINA_VALUE_TYPE_DEFAULT(type) (0)
@@ -51,13 +76,17 @@ EAPI extern const Eina_Value_Type *_EINA_VALUE_TYPE_BASICS_END;
    (type <= _EINA_VALUE_TYPE_BASICS_END))
 #endif
 
+/* basic types are always valid, do not call eina_value_type_check() */
+#define EINA_VALUE_TYPE_CHECK(type)                                     \
+  (EINA_VALUE_TYPE_DEFAULT(type) || eina_value_type_check(type))
+
 #define EINA_VALUE_TYPE_CHECK_RETURN(value)     \
   EINA_SAFETY_ON_NULL_RETURN(value);            \
-  EINA_SAFETY_ON_FALSE_RETURN(eina_value_type_check(value->type))
+  EINA_SAFETY_ON_FALSE_RETURN(EINA_VALUE_TYPE_CHECK(value->type))
 
 #define EINA_VALUE_TYPE_CHECK_RETURN_VAL(value, retval)                 \
   EINA_SAFETY_ON_NULL_RETURN_VAL(value, retval);                        \
-  EINA_SAFETY_ON_FALSE_RETURN_VAL(eina_value_type_check(value->type), retval)
+  EINA_SAFETY_ON_FALSE_RETURN_VAL(EINA_VALUE_TYPE_CHECK(value->type), retval)
 
 #define EINA_VALUE_TYPE_DISPATCH(type, method, no_method_err, ...)      \
   do                                                                    \
@@ -92,6 +121,24 @@ eina_value_memory_get(const Eina_Value *value)
    return value->value.ptr;
 }
 
+/**
+ * @brief Copy the memory of a basic type with a fixed size copy.
+ * @since 1.7
+ * @private
+ */
+static inline void
+eina_value_basic_copy(void *dst, const void *src, size_t size)
+{
+   switch (size)
+     {
+      case 1: memcpy(dst, src, 1); break;
+      case 2: memcpy(dst, src, 2); break;
+      case 4: memcpy(dst, src, 4); break;
+      case 8: memcpy(dst, src, 8); break;
+      default: memcpy(dst, src, size); break;
+     }
+}
+
 /**
  * @brief Allocate memory for internal value types.
  * @since 1.2
@@ -110,20 +157,23 @@ eina_value_setup(Eina_Value *value, const Eina_Value_Type *type)
 {
    void *mem;
 
-   EINA_SAFETY_ON_FALSE_RETURN_VAL(eina_value_type_check(type), EINA_FALSE);
+   EINA_SAFETY_ON_FALSE_RETURN_VAL(EINA_VALUE_TYPE_CHECK(type), EINA_FALSE);
    EINA_SAFETY_ON_FALSE_RETURN_VAL(type->value_size > 0, EINA_FALSE);
 
    value->type = type;
 
-   if (type->value_size <= 8) mem = &value->value;
+   if (type->value_size <= 8)
+     {
+        mem = &value->value;
+        memset(mem, 0, 8);
+     }
    else
      {
         mem = value->value.ptr = eina_value_inner_alloc(type->value_size);
         EINA_SAFETY_ON_NULL_RETURN_VAL(mem, EINA_FALSE);
+        memset(mem, 0, type->value_size);
      }
 
-   memset(mem, 0, type->value_size);
-
    if (EINA_VALUE_TYPE_DEFAULT(type))
      {
         eina_error_set(0);
@@ -344,105 +394,112 @@ eina_value_vset(Eina_Value *value, va_list args)
    mem = eina_value_memory_get(value);
    eina_error_set(0);
 #ifndef EINA_VALUE_NO_OPTIMIZE
-   if (type == EINA_VALUE_TYPE_UCHAR)
-     {
-        unsigned char *tmem = (unsigned char *) mem;
-        *tmem = va_arg(args, unsigned int); /* promoted by va_arg */
-        return EINA_TRUE;
-     }
-   else if (type == EINA_VALUE_TYPE_USHORT)
-     {
-        unsigned short *tmem = (unsigned short *) mem;
-        *tmem = va_arg(args, unsigned int); /* promoted by va_arg */
-        return EINA_TRUE;
-     }
-   else if (type == EINA_VALUE_TYPE_UINT)
-     {
-        unsigned int *tmem = (unsigned int *) mem;
-        *tmem = va_arg(args, unsigned int);
-        return EINA_TRUE;
-     }
-   else if ((type == EINA_VALUE_TYPE_ULONG) || (type == EINA_VALUE_TYPE_TIMESTAMP))
-     {
-        unsigned long *tmem = (unsigned long *) mem;
-        *tmem = va_arg(args, unsigned long);
-        return EINA_TRUE;
-     }
-   else if (type == EINA_VALUE_TYPE_UINT64)
-     {
-        uint64_t *tmem = (uint64_t *) mem;
-        *tmem = va_arg(args, uint64_t);
-        return EINA_TRUE;
-     }
-   else if (type == EINA_VALUE_TYPE_CHAR)
-     {
-        signed char *tmem = (signed char *) mem;
-        *tmem = va_arg(args, int); /* promoted by va_arg */
-        return EINA_TRUE;
-     }
-   else if (type == EINA_VALUE_TYPE_SHORT)
-     {
-        short *tmem = (short *) mem;
-        *tmem = va_arg(args, int); /* promoted by va_arg */
-        return EINA_TRUE;
-     }
-   else if (type == EINA_VALUE_TYPE_INT)
-     {
-        int *tmem = (int *) mem;
-        *tmem = va_arg(args, int);
-        return EINA_TRUE;
-     }
-   else if (type == EINA_VALUE_TYPE_LONG)
-     {
-        long *tmem = (long *) mem;
-        *tmem = va_arg(args, long);
-        return EINA_TRUE;
-     }
-   else if (type == EINA_VALUE_TYPE_INT64)
-     {
-        int64_t *tmem = (int64_t *) mem;
-        *tmem = va_arg(args, int64_t);
-        return EINA_TRUE;
-     }
-   else if (type == EINA_VALUE_TYPE_FLOAT)
-     {
-        float *tmem = (float *) mem;
-        *tmem = va_arg(args, double); /* promoted by va_arg */
-        return EINA_TRUE;
-     }
-   else if (type == EINA_VALUE_TYPE_DOUBLE)
-     {
-        double *tmem = (double *) mem;
-        *tmem = va_arg(args, double);
-        return EINA_TRUE;
-     }
-   else if (type == EINA_VALUE_TYPE_STRINGSHARE)
-     {
-        const char *str = (const char *) va_arg(args, const char *);
-        return eina_stringshare_replace((const char **)&value->value.ptr, str);
-     }
-   else if (type == EINA_VALUE_TYPE_STRING)
-     {
-        const char *str = (const char *) va_arg(args, const char *);
-        if (value->value.ptr == str) return EINA_TRUE;
-        if (!str)
+   if (EINA_VALUE_TYPE_DEFAULT(type))
+     switch ((Eina_Value_Type_Basic)(type - _EINA_VALUE_TYPE_BASICS_START))
+       {
+        case EINA_VALUE_TYPE_BASIC_UCHAR:
           {
-             free(value->value.ptr);
-             value->value.ptr = NULL;
+             unsigned char *tmem = (unsigned char *) mem;
+             *tmem = va_arg(args, unsigned int); /* promoted by va_arg */
+             return EINA_TRUE;
           }
-        else
+        case EINA_VALUE_TYPE_BASIC_USHORT:
+          {
+             unsigned short *tmem = (unsigned short *) mem;
+             *tmem = va_arg(args, unsigned int); /* promoted by va_arg */
+             return EINA_TRUE;
+          }
+        case EINA_VALUE_TYPE_BASIC_UINT:
+          {
+             unsigned int *tmem = (unsigned int *) mem;
+             *tmem = va_arg(args, unsigned int);
+             return EINA_TRUE;
+          }
+        case EINA_VALUE_TYPE_BASIC_ULONG:
+        case EINA_VALUE_TYPE_BASIC_TIMESTAMP:
           {
-             char *tmp = strdup(str);
-             if (!tmp)
+             unsigned long *tmem = (unsigned long *) mem;
+             *tmem = va_arg(args, unsigned long);
+             return EINA_TRUE;
+          }
+        case EINA_VALUE_TYPE_BASIC_UINT64:
+          {
+             uint64_t *tmem = (uint64_t *) mem;
+             *tmem = va_arg(args, uint64_t);
+             return EINA_TRUE;
+          }
+        case EINA_VALUE_TYPE_BASIC_CHAR:
+          {
+             signed char *tmem = (signed char *) mem;
+             *tmem = va_arg(args, int); /* promoted by va_arg */
+             return EINA_TRUE;
+          }
+        case EINA_VALUE_TYPE_BASIC_SHORT:
+          {
+             short *tmem = (short *) mem;
+             *tmem = va_arg(args, int); /* promoted by va_arg */
+             return EINA_TRUE;
+          }
+        case EINA_VALUE_TYPE_BASIC_INT:
+          {
+             int *tmem = (int *) mem;
+             *tmem = va_arg(args, int);
+             return EINA_TRUE;
+          }
+        case EINA_VALUE_TYPE_BASIC_LONG:
+          {
+             long *tmem = (long *) mem;
+             *tmem = va_arg(args, long);
+             return EINA_TRUE;
+          }
+        case EINA_VALUE_TYPE_BASIC_INT64:
+          {
+             int64_t *tmem = (int64_t *) mem;
+             *tmem = va_arg(args, int64_t);
+             return EINA_TRUE;
+          }
+        case EINA_VALUE_TYPE_BASIC_FLOAT:
+          {
+             float *tmem = (float *) mem;
+             *tmem = va_arg(args, double); /* promoted by va_arg */
+             return EINA_TRUE;
+          }
+        case EINA_VALUE_TYPE_BASIC_DOUBLE:
+          {
+             double *tmem = (double *) mem;
+             *tmem = va_arg(args, double);
+             return EINA_TRUE;
+          }
+        case EINA_VALUE_TYPE_BASIC_STRINGSHARE:
+          {
+             const char *str = (const char *) va_arg(args, const char *);
+             return eina_stringshare_replace((const char **)&value->value.ptr, str);
+          }
+        case EINA_VALUE_TYPE_BASIC_STRING:
+          {
+             const char *str = (const char *) va_arg(args, const char *);
+             if (value->value.ptr == str) return EINA_TRUE;
+             if (!str)
+               {
+                  free(value->value.ptr);
+                  value->value.ptr = NULL;
+               }
+             else
                {
-                  eina_error_set(EINA_ERROR_OUT_OF_MEMORY);
-                  return EINA_FALSE;
+                  char *tmp = strdup(str);
+                  if (!tmp)
+                    {
+                       eina_error_set(EINA_ERROR_OUT_OF_MEMORY);
+                       return EINA_FALSE;
+                    }
+                  free(value->value.ptr);
+                  value->value.ptr = tmp;
                }
-             free(value->value.ptr);
-             value->value.ptr = tmp;
+             return EINA_TRUE;
           }
-        return EINA_TRUE;
-     }
+        default:
+           break;
+       }
 #endif
 
    EINA_VALUE_TYPE_DISPATCH_RETURN(value, vset, EINA_ERROR_VALUE_FAILED,
@@ -464,7 +521,7 @@ eina_value_vget(const Eina_Value *value, va_list args)
    eina_error_set(0);
    if (EINA_VALUE_TYPE_DEFAULT(type))
      {
-        memcpy(ptr, mem, type->value_size);
+        eina_value_basic_copy(ptr, mem, type->value_size);
         return EINA_TRUE;
      }
 
@@ -517,7 +574,7 @@ eina_value_pset(Eina_Value *value, const void *ptr)
              return EINA_TRUE;
           }
         else
-          memcpy(mem, ptr, type->value_size);
+          eina_value_basic_copy(mem, ptr, type->value_size);
         return EINA_TRUE;
      }
 
@@ -539,7 +596,7 @@ eina_value_pget(const Eina_Value *value, void *ptr)
    eina_error_set(0);
    if (EINA_VALUE_TYPE_DEFAULT(type))
      {
-        memcpy(ptr, mem, type->value_size);
+        eina_value_basic_copy(ptr, mem, type->value_size);
         return EINA_TRUE;
      }
 
@@ -1669,6 +1726,130 @@ eina_value_struct_member_value_set(Eina_Value *dst, const Eina_Value_Struct_Memb
    return eina_value_type_pset(member->type, mem, ptr);
 }
 
+static inline const Eina_Value_Struct_Member *
+eina_value_struct_member_at(const Eina_Value_Struct *st, unsigned int index)
+{
+   const Eina_Value_Struct_Member *itr;
+
+   if ((!st) || (!st->desc))
+     return NULL;
+   if (st->desc->member_count)
+     {
+        if (index >= st->desc->member_count)
+          return NULL;
+        return st->desc->members + index;
+     }
+
+   for (itr = st->desc->members; itr->name != NULL; itr++, index--)
+     {
+        if (index == 0)
+          return itr;
+     }
+   return NULL;
+}
+
+static inline Eina_Bool
+eina_value_struct_index_vset(Eina_Value *value, unsigned int index, va_list args)
+{
+   const Eina_Value_Struct_Member *member;
+   Eina_Value_Struct *st;
+   void *mem;
+
+   EINA_VALUE_TYPE_STRUCT_CHECK_RETURN_VAL(value, EINA_FALSE);
+   st = (Eina_Value_Struct *)eina_value_memory_get(value);
+   member = eina_value_struct_member_at(st, index);
+   if (!member)
+     return EINA_FALSE;
+   mem = eina_value_struct_member_memory_get(st, member);
+   if (!mem)
+     return EINA_FALSE;
+
+   return eina_value_type_vset(member->type, mem, args);
+}
+
+static inline Eina_Bool
+eina_value_struct_index_vget(const Eina_Value *value, unsigned int index, va_list args)
+{
+   const Eina_Value_Struct_Member *member;
+   const Eina_Value_Struct *st;
+   const void *mem;
+   void *ptr;
+
+   EINA_VALUE_TYPE_STRUCT_CHECK_RETURN_VAL(value, EINA_FALSE);
+   st = (const Eina_Value_Struct *)eina_value_memory_get(value);
+   member = eina_value_struct_member_at(st, index);
+   if (!member)
+     return EINA_FALSE;
+   mem = eina_value_struct_member_memory_get(st, member);
+   if (!mem)
+     return EINA_FALSE;
+
+   ptr = va_arg(args, void *);
+   return eina_value_type_pget(member->type, mem, ptr);
+}
+
+static inline Eina_Bool
+eina_value_struct_index_set(Eina_Value *value, unsigned int index, ...)
+{
+   va_list args;
+   Eina_Bool ret;
+   va_start(args, index);
+   ret = eina_value_struct_index_vset(value, index, args);
+   va_end(args);
+   return ret;
+}
+
+static inline Eina_Bool
+eina_value_struct_index_get(const Eina_Value *value, unsigned int index, ...)
+{
+   va_list args;
+   Eina_Bool ret;
+   va_start(args, index);
+   ret = eina_value_struct_index_vget(value, index, args);
+   va_end(args);
+   return ret;
+}
+
+static inline Eina_Bool
+eina_value_struct_index_pset(Eina_Value *value, unsigned int index, const void *ptr)
+{
+   const Eina_Value_Struct_Member *member;
+   Eina_Value_Struct *st;
+   void *mem;
+
+   EINA_VALUE_TYPE_STRUCT_CHECK_RETURN_VAL(value, EINA_FALSE);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(ptr, EINA_FALSE);
+   st = (Eina_Value_Struct *)eina_value_memory_get(value);
+   member = eina_value_struct_member_at(st, index);
+   if (!member)
+     return EINA_FALSE;
+   mem = eina_value_struct_member_memory_get(st, member);
+   if (!mem)
+     return EINA_FALSE;
+
+   return eina_value_type_pset(member->type, mem, ptr);
+}
+
+static inline Eina_Bool
+eina_value_struct_index_pget(const Eina_Value *value, unsigned int index, void *ptr)
+{
+   const Eina_Value_Struct_Member *member;
+   const Eina_Value_Struct *st;
+   const void *mem;
+
+   EINA_VALUE_TYPE_STRUCT_CHECK_RETURN_VAL(value, EINA_FALSE);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(ptr, EINA_FALSE);
+   st = (const Eina_Value_Struct *)eina_value_memory_get(value);
+   member = eina_value_struct_member_at(st, index);
+   if (!member)
+     return EINA_FALSE;
+   mem = eina_value_struct_member_memory_get(st, member);
+   if (!mem)
+     return EINA_FALSE;
+
+   return eina_value_type_pget(member->type, mem, ptr);
+}
+
 #undef EINA_VALUE_TYPE_STRUCT_CHECK_RETURN_VAL
 
 
@@ -1781,6 +1962,7 @@ eina_value_type_pget(const Eina_Value_Type *type, const void *mem, void *ptr)
 }
 
 #undef EINA_VALUE_TYPE_DEFAULT
+#undef EINA_VALUE_TYPE_CHECK
 #undef EINA_VALUE_TYPE_CHECK_RETURN
 #undef EINA_VALUE_TYPE_CHECK_RETURN_VAL
 #undef EINA_VALUE_TYPE_DISPATCH
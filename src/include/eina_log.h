@@ -132,6 +132,19 @@
  * This will disable eina_log output from all internal eina code thus allowing
  * you to see your own domain messages easier.
  *
+ * A domain that logs too much, say a warning in a hot loop, can be
+ * throttled instead of silenced. After its level, EINA_LOG_LEVELS
+ * accepts @c sample=N to only print one message out of N, and
+ * @c rate=B/T to print at most B messages every T seconds. Both are
+ * counted for each call site (file and line) of the domain:
+ *
+ * @verbatim EINA_LOG_LEVELS=module1:3:rate=10/1,module2:4:sample=100 ./myapp@endverbatim
+ *
+ * When a call site gets to print again after its rate limit, the number
+ * of messages it dropped is printed too. Critical messages are never
+ * dropped. See eina_log_domain_rate_limit_set() and
+ * eina_log_domain_sampling_set().
+ *
  * @section tutorial_log_advanced_display Advanced usage of print callbacks
  *
  * The log module allows the user to change the way
@@ -192,6 +205,19 @@
  * EINA_LOG_LEVELS. It will default to #EINA_LOG_ERR. This can be
  * changed with eina_log_level_set().
  *
+ * Messages can also be printed by a background thread, so that logging
+ * threads never wait for each other nor for the output. This is enabled
+ * by the environment variable @c EINA_LOG_ASYNC or with
+ * eina_log_async_set().
+ *
+ * When built with GCC for an ELF platform, each use of EINA_LOG() keeps
+ * a static #Eina_Log_Site in the @c __eina_log_sites section. The site
+ * caches whether its messages are to be printed, so that a disabled
+ * message only costs a test of that cache. Sites can be listed with
+ * eina_log_sites_foreach() and enabled or disabled one by one with
+ * eina_log_sites_state_set() or the @c EINA_LOG_SITES environment
+ * variable, whatever the level of their domain.
+ *
  * To use the log system Eina must be initialized with eina_init() and
  * later shut down with eina_shutdown(). Here is a straightforward
  * example:
@@ -284,10 +310,93 @@ EAPI extern int EINA_LOG_DOMAIN_GLOBAL;
 
 #endif /* EINA_LOG_DOMAIN_DEFAULT */
 
+/**
+ * @typedef Eina_Log_Site
+ * Type for a call site of EINA_LOG().
+ * @since 1.7
+ */
+typedef struct _Eina_Log_Site Eina_Log_Site;
+
+/**
+ * @typedef Eina_Log_Site_State
+ * Whether the messages of a call site are printed.
+ * @since 1.7
+ */
+typedef enum _Eina_Log_Site_State
+{
+   EINA_LOG_SITE_DEFAULT = 0, /**< Printed depending on the domain level */
+   EINA_LOG_SITE_ENABLED, /**< Always printed */
+   EINA_LOG_SITE_DISABLED /**< Never printed */
+} Eina_Log_Site_State;
+
+/**
+ * @struct _Eina_Log_Site
+ * A call site of EINA_LOG(), a static variable of the function logging.
+ * @since 1.7
+ */
+struct _Eina_Log_Site
+{
+   const char  *file; /**< File of the call site */
+   const char  *fnc; /**< Function of the call site */
+   int          line; /**< Line of the call site */
+   int          level; /**< Level of the last message, #EINA_LOG_LEVEL_UNKNOWN before the first if not a constant */
+
+   /* Private */
+   int          domain; /**< Domain of the last message, -1 before the first */
+   Eina_Log_Site_State state; /**< State set with eina_log_sites_state_set() */
+   volatile int enabled; /**< Cached result of the level check */
+   volatile unsigned int generation; /**< When enabled was computed */
+   volatile unsigned int sequence; /**< Odd while the cache is written, changed by each write */
+};
+
+#if defined(__GNUC__) && defined(__ELF__) && !defined(__cplusplus)
+/**
+ * @def EINA_LOG_SITES
+ * Defined when EINA_LOG() keeps an #Eina_Log_Site for each call site.
+ * @since 1.7
+ */
+# define EINA_LOG_SITES 1
+# define EINA_LOG_SITE_SECTION \
+  __attribute__((section("__eina_log_sites"), used, aligned(sizeof(void *))))
+
+/* bounds of the __eina_log_sites section, provided by the linker */
+extern Eina_Log_Site __start___eina_log_sites[] __attribute__((weak, visibility("hidden")));
+extern Eina_Log_Site __stop___eina_log_sites[] __attribute__((weak, visibility("hidden")));
+
+/**
+ * @def EINA_LOG_SITES_REGISTER()
+ * Make the call sites of the calling binary or module known to
+ * eina_log_sites_foreach() and eina_log_sites_state_set(). Call it after
+ * eina_init(). The sites of Eina itself are always registered.
+ * @since 1.7
+ */
+# define EINA_LOG_SITES_REGISTER() \
+  eina_log_sites_register(__start___eina_log_sites, __stop___eina_log_sites)
+
+/**
+ * @def EINA_LOG_SITES_UNREGISTER()
+ * Forget the call sites registered by EINA_LOG_SITES_REGISTER(), to be
+ * called before a module is unloaded.
+ * @since 1.7
+ */
+# define EINA_LOG_SITES_UNREGISTER() \
+  eina_log_sites_unregister(__start___eina_log_sites)
+#else
+# define EINA_LOG_SITES_REGISTER() do {} while (0)
+# define EINA_LOG_SITES_UNREGISTER() do {} while (0)
+#endif
+
 /**
  * @def EINA_LOG(DOM, LEVEL, fmt, ...)
  * Logs a message on the specified domain, level and format.
  *
+ * @note if #EINA_LOG_SITES is defined, the call site keeps whether its
+ *       messages are printed, and only checks it again when a level
+ *       or the state of a site changes. A message that is not printed
+ *       does not even call a function. @p LEVEL does not need to be a
+ *       constant, a site logging with varying levels checks again each
+ *       time its level changes.
+ *
  * @note if @c EINA_LOG_LEVEL_MAXIMUM is defined, then messages larger
  *       than this value will be ignored regardless of current domain
  *       level, the eina_log_print() is not even called! Most
@@ -299,7 +408,29 @@ EAPI extern int EINA_LOG_DOMAIN_GLOBAL;
  *       header files.
  */
 #ifdef EINA_ENABLE_LOG
-# ifdef EINA_LOG_LEVEL_MAXIMUM
+# ifdef EINA_LOG_SITES
+#  ifdef EINA_LOG_LEVEL_MAXIMUM
+#   define EINA_LOG_SITE_MAXIMUM(LEVEL) (LEVEL <= EINA_LOG_LEVEL_MAXIMUM)
+#  else
+#   define EINA_LOG_SITE_MAXIMUM(LEVEL) (1)
+#  endif
+# define EINA_LOG(DOM, LEVEL, fmt, ...)					\
+  do {									\
+     if (EINA_LOG_SITE_MAXIMUM(LEVEL)) {				\
+        static Eina_Log_Site _eina_log_site EINA_LOG_SITE_SECTION =	\
+          { __FILE__, __FUNCTION__, __LINE__,				\
+            __builtin_constant_p(LEVEL) ? (LEVEL) : EINA_LOG_LEVEL_UNKNOWN, \
+            -1, EINA_LOG_SITE_DEFAULT, 0, 0, 0 };			\
+        int _eina_log_site_dom = (DOM);					\
+        int _eina_log_site_level = (LEVEL);				\
+        if (EINA_UNLIKELY(eina_log_site_enabled(&_eina_log_site,	\
+                                                _eina_log_site_dom,	\
+                                                _eina_log_site_level))) \
+          eina_log_site_print(&_eina_log_site, _eina_log_site_dom,	\
+                              _eina_log_site_level,			\
+                              fmt, ## __VA_ARGS__); }			\
+  } while (0)
+# elif defined(EINA_LOG_LEVEL_MAXIMUM)
 # define EINA_LOG(DOM, LEVEL, fmt, ...)					\
   do {									\
      if (LEVEL <= EINA_LOG_LEVEL_MAXIMUM) {				\
@@ -418,6 +549,9 @@ struct _Eina_Log_Domain
 
    /* Private */
    Eina_Bool   deleted : 1; /**< Flags deletion of domain, a free slot */
+   unsigned int sampling; /**< Print one message out of sampling per call site */
+   unsigned int rate_burst; /**< Messages printed per call site and rate_interval */
+   double       rate_interval; /**< Rate limit period in seconds, 0.0 for none */
 };
 
 /**
@@ -463,6 +597,55 @@ typedef void (*Eina_Log_Print_Cb)(const Eina_Log_Domain *d,
                                   const char *file, const char *fnc, int line,
                                   const char *fmt, void *data, va_list args);
 
+/**
+ * @typedef Eina_Log_Buffer
+ * A buffered log file, see eina_log_buffer_new().
+ * @since 1.7
+ */
+typedef struct _Eina_Log_Buffer Eina_Log_Buffer;
+
+/**
+ * @typedef Eina_Log_Binary
+ * A binary log file, see eina_log_binary_new().
+ * @since 1.7
+ */
+typedef struct _Eina_Log_Binary Eina_Log_Binary;
+
+/**
+ * @typedef Eina_Log_Binary_Record
+ * A message read back from a binary log file.
+ * @since 1.7
+ */
+typedef struct _Eina_Log_Binary_Record Eina_Log_Binary_Record;
+
+/**
+ * @struct _Eina_Log_Binary_Record
+ * A message read back from a binary log file.
+ * @since 1.7
+ */
+struct _Eina_Log_Binary_Record
+{
+   const char    *domain; /**< Domain name */
+   Eina_Log_Level level; /**< Level of the message */
+   const char    *file; /**< File which logged */
+   const char    *fnc; /**< Function which logged */
+   int            line; /**< Line which logged */
+   unsigned int   pid; /**< Process which logged */
+   unsigned long  thread; /**< Thread which logged */
+   double         timestamp; /**< Seconds since the epoch */
+   const char    *message; /**< The formatted message */
+};
+
+/**
+ * @typedef Eina_Log_Binary_Cb
+ * Type for the callback of eina_log_binary_decode().
+ * @param data The data passed to eina_log_binary_decode()
+ * @param record The message, only valid during the call
+ * @return #EINA_TRUE to continue, #EINA_FALSE to stop decoding.
+ * @since 1.7
+ */
+typedef Eina_Bool (*Eina_Log_Binary_Cb)(void *data, const Eina_Log_Binary_Record *record);
+
 /*
  * Customization
  */
@@ -639,6 +822,60 @@ EAPI void               eina_log_abort_on_critical_level_set(int critical_level)
  */
 EAPI int                eina_log_abort_on_critical_level_get(void) EINA_WARN_UNUSED_RESULT;
 
+/**
+ * @brief Set if messages are printed asynchronously.
+ *
+ * @param async If #EINA_TRUE, messages are printed by a background thread.
+ * @return #EINA_TRUE if the mode was changed, #EINA_FALSE if not supported.
+ *
+ * In asynchronous mode, eina_log_print() formats the message and queues
+ * it in a buffer of the calling thread, without waiting for the log lock
+ * or for messages being printed, and a background thread gives it to the
+ * print callback (see eina_log_print_cb_set()). The print callback is
+ * thus called from that thread, with the prefix still showing the thread
+ * that logged. It is not called with the log lock held, but calls to it
+ * are still serialized. The first message of a thread, and waking up the
+ * background thread when it sleeps, take a short internal lock. If the
+ * buffer of a thread is full, its messages are dropped and their number
+ * is reported later.
+ *
+ * Messages at #EINA_LOG_LEVEL_CRITICAL, or at a level that makes the
+ * program abort (see eina_log_abort_on_critical_set()), first flush the
+ * queued messages and are then printed synchronously, so nothing is lost
+ * before abort() is called.
+ *
+ * This enables thread support with eina_log_threads_enable(). It should
+ * be called from the main thread while no other thread logs.
+ *
+ * @note this is initially set to envvar EINA_LOG_ASYNC by eina_init().
+ *
+ * @see eina_log_async_flush()
+ * @since 1.7
+ */
+EAPI Eina_Bool          eina_log_async_set(Eina_Bool async);
+
+/**
+ * @brief Get if messages are printed asynchronously.
+ *
+ * @return #EINA_TRUE if messages are printed by a background thread.
+ *
+ * @see eina_log_async_set()
+ * @since 1.7
+ */
+EAPI Eina_Bool          eina_log_async_get(void) EINA_WARN_UNUSED_RESULT;
+
+/**
+ * @brief Wait until the queued messages are printed.
+ *
+ * Messages logged by the calling thread before this call, and by other
+ * threads if they are visible to it, are printed when this returns. It
+ * does nothing if messages are printed synchronously.
+ *
+ * @see eina_log_async_set()
+ * @since 1.7
+ */
+EAPI void               eina_log_async_flush(void);
+
 
 /**
  * Set the domain level given its name.
@@ -687,6 +924,187 @@ EAPI int                eina_log_domain_level_get(const char *domain_name) EINA_
  */
 EAPI int                eina_log_domain_registered_level_get(int domain) EINA_WARN_UNUSED_RESULT;
 
+/**
+ * Only print one message out of @p n for each call site of a domain.
+ *
+ * This call has the same effect as setting
+ * EINA_LOG_LEVELS=&lt;@p domain_name&gt;:&lt;level&gt;:sample=&lt;@p n&gt;
+ *
+ * @param domain_name domain name, it may be of a still not registered
+ *        domain.
+ * @param n print the first message and then one out of @p n, 0 or 1
+ *        to print them all.
+ *
+ * The messages that are dropped are not formatted and do not take the
+ * log lock. Critical messages are always printed.
+ *
+ * @see eina_log_domain_suppressed_get()
+ * @since 1.7
+ */
+EAPI void               eina_log_domain_sampling_set(const char *domain_name, unsigned int n) EINA_ARG_NONNULL(1);
+
+/**
+ * Get the sampling of a domain given its name.
+ *
+ * @param domain_name domain name, it may be of a still not registered
+ *        domain.
+ * @return the value given to eina_log_domain_sampling_set(), 0 if none.
+ *
+ * @since 1.7
+ */
+EAPI unsigned int       eina_log_domain_sampling_get(const char *domain_name) EINA_WARN_UNUSED_RESULT EINA_ARG_NONNULL(1);
+
+/**
+ * Limit the rate of the messages of each call site of a domain.
+ *
+ * This call has the same effect as setting
+ * EINA_LOG_LEVELS=&lt;@p domain_name&gt;:&lt;level&gt;:rate=&lt;@p burst&gt;/&lt;@p interval&gt;
+ *
+ * @param domain_name domain name, it may be of a still not registered
+ *        domain.
+ * @param burst number of messages each call site may print in
+ *        @p interval.
+ * @param interval the period in seconds, 0.0 to remove the limit.
+ *
+ * The messages over the limit are not formatted and do not take the log
+ * lock. The first message a call site prints in a new period is followed
+ * by the number of messages it dropped in the previous ones. Critical
+ * messages are always printed.
+ *
+ * @see eina_log_domain_suppressed_get()
+ * @since 1.7
+ */
+EAPI void               eina_log_domain_rate_limit_set(const char *domain_name, unsigned int burst, double interval) EINA_ARG_NONNULL(1);
+
+/**
+ * Get the rate limit of a domain given its name.
+ *
+ * @param domain_name domain name, it may be of a still not registered
+ *        domain.
+ * @param burst where to store the number of messages per period, may
+ *        be @c NULL.
+ * @param interval where to store the period, 0.0 if there is no limit,
+ *        may be @c NULL.
+ *
+ * @since 1.7
+ */
+EAPI void               eina_log_domain_rate_limit_get(const char *domain_name, unsigned int *burst, double *interval) EINA_ARG_NONNULL(1);
+
+/**
+ * Get the number of messages a domain did not print.
+ *
+ * @param domain identifier, so it must be previously registered with
+ *        eina_log_domain_register().
+ * @return the number of messages dropped by sampling or rate limit
+ *         since the domain was registered.
+ *
+ * @since 1.7
+ */
+EAPI unsigned int       eina_log_domain_suppressed_get(int domain) EINA_WARN_UNUSED_RESULT;
+
+/**
+ * @cond LOCAL
+ * Changed each time the cached state of the call sites becomes invalid.
+ */
+EAPI extern volatile unsigned int _eina_log_site_generation;
+/**
+ * @endcond
+ */
+
+/**
+ * Update the cached state of a call site.
+ *
+ * @param site the call site.
+ * @param domain the domain the call site logs to.
+ * @param level the level of the message.
+ * @return whether the message is to be printed.
+ *
+ * Used by EINA_LOG(), there is no reason to call it directly.
+ *
+ * @since 1.7
+ */
+EAPI int                eina_log_site_sync(Eina_Log_Site *site, int domain, int level) EINA_ARG_NONNULL(1);
+
+/**
+ * Print a message of a call site.
+ *
+ * @param site the call site.
+ * @param domain the domain the call site logs to.
+ * @param level the level of the message.
+ * @param fmt the message format.
+ *
+ * Like eina_log_print() with the file, function and line of @p site,
+ * the domain level is only checked again if the site is not
+ * enabled with eina_log_sites_state_set(). Used by EINA_LOG(), there is
+ * no reason to call it directly.
+ *
+ * @since 1.7
+ */
+EAPI void               eina_log_site_print(const Eina_Log_Site *site, int domain, int level, const char *fmt, ...) EINA_ARG_NONNULL(1, 4) EINA_PRINTF(4, 5);
+
+/**
+ * Register the call sites of a binary or module.
+ *
+ * @param start the first call site.
+ * @param stop past the last call site.
+ *
+ * Use EINA_LOG_SITES_REGISTER() instead, that gives the bounds of the
+ * @c __eina_log_sites section of the caller. The patterns of the @c
+ * EINA_LOG_SITES environment variable are applied to the new sites.
+ *
+ * @since 1.7
+ */
+EAPI void               eina_log_sites_register(Eina_Log_Site *start, Eina_Log_Site *stop);
+
+/**
+ * Unregister call sites registered with eina_log_sites_register().
+ *
+ * @param start the first call site given to eina_log_sites_register().
+ *
+ * @since 1.7
+ */
+EAPI void               eina_log_sites_unregister(Eina_Log_Site *start);
+
+/**
+ * @typedef Eina_Log_Site_Cb
+ * Type for the callback given to eina_log_sites_foreach().
+ * @return #EINA_FALSE to stop iterating.
+ * @since 1.7
+ */
+typedef Eina_Bool (*Eina_Log_Site_Cb)(const Eina_Log_Site *site, void *data);
+
+/**
+ * Call a function for each registered call site.
+ *
+ * @param cb the function to call.
+ * @param data the data given to @p cb.
+ *
+ * The domain of a site is -1 until it logged once. @p cb is called with
+ * the log lock held, it must not log nor register call sites.
+ *
+ * @since 1.7
+ */
+EAPI void               eina_log_sites_foreach(Eina_Log_Site_Cb cb, const void *data) EINA_ARG_NONNULL(1);
+
+/**
+ * Set the state of the registered call sites matching a pattern.
+ *
+ * @param pattern a fnmatch() pattern of the file of the sites, with or
+ *        without its directory, optionally followed by ':' and a line.
+ * @param state the new state of the matching sites.
+ * @return the number of matching sites.
+ *
+ * This call has the same effect as setting
+ * EINA_LOG_SITES=&lt;@p pattern&gt; for #EINA_LOG_SITE_ENABLED or
+ * EINA_LOG_SITES=-&lt;@p pattern&gt; for #EINA_LOG_SITE_DISABLED,
+ * several patterns being separated by commas. For instance
+ * "eina_hash.c" enables all the messages of that file and
+ * "*.c:42" the ones at line 42 of any file.
+ *
+ * @since 1.7
+ */
+EAPI unsigned int       eina_log_sites_state_set(const char *pattern, Eina_Log_Site_State state) EINA_ARG_NONNULL(1);
+
 static inline Eina_Bool eina_log_domain_level_check(int domain, int level);
 
 /*
@@ -850,6 +1268,9 @@ EAPI void eina_log_print_cb_stdout(const Eina_Log_Domain *d,
  * EINA_LOG_FUNCTION_DISABLE will be considered and file information
  * will be printed anyways.
  *
+ * Each message is formatted in memory and written with a single write(),
+ * so it is not mixed with the output of other processes.
+ *
  * @note MT: if threads are enabled, this function is called within locks.
  * @note MT: Threads different from main thread will have thread id
  *       appended to domain name.
@@ -890,6 +1311,145 @@ EAPI void eina_log_print_cb_file(const Eina_Log_Domain *d,
                                  void                  *data,
                                  va_list                args);
 
+/**
+ * @brief Create a buffered log file.
+ *
+ * @param filename The file to append to.
+ * @param size The size of the buffer, in bytes.
+ * @param interval The longest time a message is kept in the buffer, in
+ *        seconds, or 0.0 to only write when the buffer is full.
+ * @return The buffered log file, or @c NULL on error.
+ *
+ * Messages printed with eina_log_print_cb_buffer() are written to the
+ * file only when the buffer is full, when a critical message is
+ * printed, or when the oldest one is older than @p interval. The time
+ * is only checked when a message is printed, call
+ * eina_log_buffer_flush() to write pending messages when idle.
+ *
+ * @since 1.7
+ */
+EAPI Eina_Log_Buffer *eina_log_buffer_new(const char *filename, size_t size, double interval) EINA_ARG_NONNULL(1);
+
+/**
+ * @brief Write the messages pending in a buffered log file.
+ *
+ * @param buffer The buffered log file.
+ *
+ * @since 1.7
+ */
+EAPI void eina_log_buffer_flush(Eina_Log_Buffer *buffer) EINA_ARG_NONNULL(1);
+
+/**
+ * @brief Close a buffered log file.
+ *
+ * @param buffer The buffered log file.
+ *
+ * Pending messages are written. It must not be used by
+ * eina_log_print_cb_buffer() anymore.
+ *
+ * @since 1.7
+ */
+EAPI void eina_log_buffer_free(Eina_Log_Buffer *buffer);
+
+/**
+ * Alternative logging method, this will output to a buffered file.
+ *
+ * @param d The domain.
+ * @param level The level.
+ * @param file The file which is logged.
+ * @param fnc The function which is logged.
+ * @param line The line which is logged.
+ * @param fmt The ouptut format to use.
+ * @param data The buffered file (as a Eina_Log_Buffer *).
+ * @param args The arguments needed by the format.
+ *
+ * The lines are the same as the ones of eina_log_print_cb_file(), see
+ * eina_log_buffer_new() for when they are written.
+ *
+ * @note MT: if threads are enabled, this function is called within locks.
+ * @since 1.7
+ */
+EAPI void eina_log_print_cb_buffer(const Eina_Log_Domain *d,
+                                   Eina_Log_Level         level,
+                                   const char            *file,
+                                   const char            *fnc,
+                                   int                    line,
+                                   const char            *fmt,
+                                   void                  *data,
+                                   va_list                args);
+
+/**
+ * @brief Create a binary log file.
+ *
+ * @param filename The file to write to, it is truncated.
+ * @return The binary log, or @c NULL on error.
+ *
+ * A binary log stores messages without formatting them: only the
+ * arguments are copied, next to a reference to the format string, the
+ * domain, the level, the call site, the time and the thread. This is
+ * much cheaper than formatting, so it suits messages that are kept
+ * enabled but rarely read. Use it with eina_log_print_cb_binary() and
+ * read it back with eina_log_binary_decode() or the eina_log_decode
+ * tool.
+ *
+ * The file is mapped in memory, so what was logged before a crash can
+ * still be decoded.
+ *
+ * @since 1.7
+ */
+EAPI Eina_Log_Binary *eina_log_binary_new(const char *filename) EINA_ARG_NONNULL(1);
+
+/**
+ * @brief Close a binary log file.
+ *
+ * @param bin The binary log to close.
+ *
+ * It must not be used by eina_log_print_cb_binary() anymore.
+ *
+ * @since 1.7
+ */
+EAPI void eina_log_binary_free(Eina_Log_Binary *bin);
+
+/**
+ * @brief Decode a binary log file.
+ *
+ * @param filename The file to read.
+ * @param cb The callback called for each message, in order.
+ * @param data The data passed to @p cb.
+ * @return #EINA_TRUE if the whole file was read, #EINA_FALSE otherwise.
+ *
+ * @since 1.7
+ */
+EAPI Eina_Bool eina_log_binary_decode(const char *filename, Eina_Log_Binary_Cb cb, void *data) EINA_ARG_NONNULL(1, 2);
+
+/**
+ * Alternative logging method, this will store the message in a binary log.
+ *
+ * @param d The domain.
+ * @param level The level.
+ * @param file The file which is logged.
+ * @param fnc The function which is logged.
+ * @param line The line which is logged.
+ * @param fmt The ouptut format to use.
+ * @param data The binary log (as a Eina_Log_Binary *).
+ * @param args The arguments needed by the format.
+ *
+ * The message is not formatted, see eina_log_binary_new(). Formats
+ * using conversions unknown to the C standard, or wide strings, are
+ * formatted at once.
+ *
+ * @note MT: if threads are enabled, this function is called within locks.
+ * @since 1.7
+ */
+EAPI void eina_log_print_cb_binary(const Eina_Log_Domain *d,
+                                   Eina_Log_Level         level,
+                                   const char            *file,
+                                   const char            *fnc,
+                                   int                    line,
+                                   const char            *fmt,
+                                   void                  *data,
+                                   va_list                args);
+
 #include "eina_inline_log.x"
 
 /**
@@ -668,6 +668,46 @@ EAPI int eina_model_event_callback_freeze(Eina_Model *model,
 EAPI int eina_model_event_callback_thaw(Eina_Model *model,
                                         const char *name) EINA_ARG_NONNULL(1, 2);
 
+/**
+ * @brief Makes @a model record its events instead of calling their callbacks.
+ * @param model The model instance.
+ * @return Count of batches started on this model, -1 on error.
+ *
+ * Until eina_model_event_batch_end() is called as many times as this
+ * function, events with callbacks are recorded and their callbacks are
+ * called once at the end:
+ *
+ * @li "property,set" and "property,deleted" are called once per
+ *     property, in the order the properties were first changed, with the
+ *     last of both events that happened to it.
+ * @li "child,inserted", "child,set" and "child,deleted" are replaced by a
+ *     single "children,changed", as the positions they give would not be
+ *     meaningful anymore.
+ * @li other events without event information are called once.
+ *
+ * Events with event information, "deleted" and "freed" are never
+ * delayed. This is meant to load or change many properties and children
+ * at once without calling the callbacks for each of them.
+ *
+ * @see eina_model_event_batch_end()
+ * @see eina_model_event_callback_freeze()
+ * @since 1.7
+ */
+EAPI int eina_model_event_batch_begin(Eina_Model *model) EINA_ARG_NONNULL(1);
+
+/**
+ * @brief Ends a batch started with eina_model_event_batch_begin().
+ * @param model The model instance.
+ * @return Count of batches still started on this model, -1 on error.
+ *
+ * When the last batch ends, the callbacks of the recorded events are
+ * called.
+ *
+ * @see eina_model_event_batch_begin()
+ * @since 1.7
+ */
+EAPI int eina_model_event_batch_end(Eina_Model *model) EINA_ARG_NONNULL(1);
+
 /**
  * @}
  */
@@ -3088,6 +3128,47 @@ EAPI Eina_Bool eina_model_struct_get(const Eina_Model *model,
                                      const Eina_Value_Struct_Desc **p_desc,
                                      void **p_memory) EINA_ARG_NONNULL(1, 2);
 
+/**
+ * @brief Get a property of model implementing #EINA_MODEL_INTERFACE_PROPERTIES_STRUCT given its index.
+ * @param model the model instance.
+ * @param index position of the property in the structure description,
+ *        see eina_value_struct_member_index_get().
+ * @param value where to return the property value, it is considered
+ *        uninitialized and setup to the type of the property.
+ * @return #EINA_TRUE on success, #EINA_FALSE on failure.
+ *
+ * This is eina_model_property_get() without looking up the property
+ * name. The index is valid as long as the structure description given
+ * to eina_model_struct_set() does not change, so it can be resolved
+ * once for all the models of this description.
+ *
+ * @note The property_get() method of the model type is not called.
+ *
+ * @since 1.7
+ */
+EAPI Eina_Bool eina_model_struct_index_get(const Eina_Model *model,
+                                           unsigned int index,
+                                           Eina_Value *value) EINA_ARG_NONNULL(1, 3);
+
+/**
+ * @brief Set a property of model implementing #EINA_MODEL_INTERFACE_PROPERTIES_STRUCT given its index.
+ * @param model the model instance.
+ * @param index position of the property in the structure description,
+ *        see eina_value_struct_member_index_get().
+ * @param value the new property value, of the same type as the property.
+ * @return #EINA_TRUE on success, #EINA_FALSE on failure.
+ *
+ * This is eina_model_property_set() without looking up the property
+ * name, the "property,set" event is emitted the same way.
+ *
+ * @note The property_set() method of the model type is not called.
+ *
+ * @since 1.7
+ */
+EAPI Eina_Bool eina_model_struct_index_set(Eina_Model *model,
+                                           unsigned int index,
+                                           const Eina_Value *value) EINA_ARG_NONNULL(1, 3);
+
 /**
  * @var EINA_MODEL_INTERFACE_NAME_PROPERTIES
  *
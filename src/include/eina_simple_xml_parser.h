@@ -148,6 +148,7 @@ typedef struct _Eina_Simple_XML_Node_Data Eina_Simple_XML_Node_Processing;
 typedef struct _Eina_Simple_XML_Node_Data Eina_Simple_XML_Node_Doctype;
 typedef struct _Eina_Simple_XML_Node_Data Eina_Simple_XML_Node_Comment;
 typedef struct _Eina_Simple_XML_Attribute Eina_Simple_XML_Attribute;
+typedef struct _Eina_Simple_XML_Parser    Eina_Simple_XML_Parser;
 
 struct _Eina_Simple_XML_Attribute
 {
@@ -240,6 +241,100 @@ EAPI Eina_Bool eina_simple_xml_parse(const char *buf, unsigned buflen,
 				     Eina_Bool strip,
 				     Eina_Simple_XML_Cb func, const void *data);
 
+/**
+ * Parse a big XML string text using several threads.
+ *
+ * @param buf the input string. May not contain \0 terminator.
+ * @param buflen the input string size.
+ * @param strip whenever this parser should strip leading and trailing
+ *        whitespace, see eina_simple_xml_parse().
+ * @param max_threads The maximum number of threads to use, @c 0 to use
+ *        eina_cpu_count().
+ * @param func what to call back while parse to do some action, see
+ *        eina_simple_xml_parse().
+ * @param data what to give as context to @a func.
+ *
+ * @return #EINA_TRUE on success or #EINA_FALSE if it was aborted by user or
+ *         parsing error.
+ *
+ * This function gives the same tokens as eina_simple_xml_parse(), in
+ * the same order and from the calling thread. Up to @a max_threads
+ * threads, the calling thread being one of them, first find where the
+ * tags start and end, each in a part of @a buf of at least 1MB, and @a
+ * func is called while the next parts are still looked at. Smaller
+ * documents are parsed by eina_simple_xml_parse().
+ *
+ * @since 1.7
+ */
+EAPI Eina_Bool eina_simple_xml_parse_parallel(const char *buf, unsigned buflen,
+                                              Eina_Bool strip, unsigned int max_threads,
+                                              Eina_Simple_XML_Cb func, const void *data);
+
+/**
+ * Create a parser for a document given in several chunks.
+ *
+ * @param strip whenever this parser should strip leading and trailing
+ *        whitespace, see eina_simple_xml_parse().
+ * @param func what to call back while parse to do some action, see
+ *        eina_simple_xml_parse(). The offset given to it is from the
+ *        start of the document, not of the chunk.
+ * @param data what to give as context to @a func.
+ *
+ * @return Newly allocated parser or @c NULL on error. It should be
+ *         released with eina_simple_xml_parser_free().
+ *
+ * The chunks are given with eina_simple_xml_parser_feed() and
+ * eina_simple_xml_parser_end() tells the document is over. The tokens
+ * are the same as eina_simple_xml_parse() would give for the whole
+ * document, only the bytes of a token that is not finished at the end
+ * of a chunk are kept, so a document can be parsed from a pipe or a
+ * socket without holding it in memory.
+ *
+ * @since 1.7
+ */
+EAPI Eina_Simple_XML_Parser * eina_simple_xml_parser_new(Eina_Bool strip,
+                                                         Eina_Simple_XML_Cb func, const void *data);
+
+/**
+ * Parse the next chunk of a document.
+ *
+ * @param parser the parser returned by eina_simple_xml_parser_new().
+ * @param buf the next bytes of the document. May not contain \0 terminator.
+ * @param buflen the chunk size.
+ *
+ * @return #EINA_TRUE on success or #EINA_FALSE if it was aborted by user or
+ *         parsing error, in which case the following calls will fail too.
+ *
+ * The callback is called for every token that ends in @a buf, the
+ * content it gets may point to @a buf or to a copy kept by @a parser
+ * and is only valid during the call.
+ *
+ * @since 1.7
+ */
+EAPI Eina_Bool eina_simple_xml_parser_feed(Eina_Simple_XML_Parser *parser,
+                                           const char *buf, unsigned buflen);
+
+/**
+ * Parse what is left of a document.
+ *
+ * @param parser the parser returned by eina_simple_xml_parser_new().
+ *
+ * @return #EINA_TRUE on success or #EINA_FALSE if it was aborted by user or
+ *         parsing error, like a tag that is not closed.
+ *
+ * @since 1.7
+ */
+EAPI Eina_Bool eina_simple_xml_parser_end(Eina_Simple_XML_Parser *parser);
+
+/**
+ * Free a parser.
+ *
+ * @param parser the parser returned by eina_simple_xml_parser_new().
+ *
+ * @since 1.7
+ */
+EAPI void eina_simple_xml_parser_free(Eina_Simple_XML_Parser *parser);
+
 
 /**
  * Given the contents of a tag, find where the attributes start.
@@ -442,9 +537,32 @@ EAPI void eina_simple_xml_node_comment_free(Eina_Simple_XML_Node_Data *node);
 EAPI Eina_Simple_XML_Node_Root * eina_simple_xml_node_load(const char *buf, unsigned buflen, Eina_Bool strip);
 
 /**
- * Free node tree build with eina_simple_xml_node_load()
+ * Load a read only XML node tree based on the given string.
+ *
+ * @param buf the input string. May not contain \0 terminator.
+ * @param buflen the input string size.
+ * @param strip whenever this parser should strip leading and trailing
+ *        whitespace.
+ *
+ * @return Document root with children tags, or @c NULL on errors.
+ *
+ * Same as eina_simple_xml_node_load(), but the nodes, attributes and
+ * their strings are cut from a few big memory blocks instead of being
+ * allocated one by one, and the names are not stringshared. It is
+ * faster to load and free and takes less memory, but the nodes may not
+ * be freed one by one nor new nodes added to the tree. The whole tree
+ * is freed with eina_simple_xml_node_root_free().
+ *
+ * @since 1.7
+ */
+EAPI Eina_Simple_XML_Node_Root * eina_simple_xml_node_arena_load(const char *buf, unsigned buflen, Eina_Bool strip);
+
+/**
+ * Free node tree build with eina_simple_xml_node_load() or
+ * eina_simple_xml_node_arena_load()
  *
- * @param root memory returned by eina_simple_xml_node_load()
+ * @param root memory returned by eina_simple_xml_node_load() or
+ *        eina_simple_xml_node_arena_load()
  */
 EAPI void eina_simple_xml_node_root_free(Eina_Simple_XML_Node_Root *root);
 
@@ -153,6 +153,19 @@
  */
 typedef struct _Eina_Tiler Eina_Tiler;
 
+/**
+ * @typedef Eina_Tiler_Algorithm
+ * How a tiler stores its rectangles.
+ *
+ * @since 1.7
+ */
+typedef enum _Eina_Tiler_Algorithm
+{
+   EINA_TILER_ALGORITHM_SPLITTER, /**< split and merge the rectangles, merged ones may cover a bit more than the added ones. The default. */
+   EINA_TILER_ALGORITHM_REGION, /**< keep the exact area as bands of rectangles sorted by y then x, like X11 regions. */
+   EINA_TILER_ALGORITHM_TILES /**< keep a bitmap of the dirty tiles, see eina_tiler_tile_size_set(). */
+} Eina_Tiler_Algorithm;
+
 /**
  * @typedef Eina_Tile_Grid_Info
  * Grid type of a tiler.
@@ -181,6 +194,9 @@ typedef struct _Eina_Tile_Grid_Slicer Eina_Tile_Grid_Slicer;
  * @param h Height of the tiler
  * @return The newly created tiler
  *
+ * A tiler must only be used by one thread at a time, but different tilers
+ * can be used by different threads.
+ *
  * @see eina_tiler_free()
  */
 EAPI Eina_Tiler        *eina_tiler_new(int w, int h);
@@ -202,9 +218,49 @@ EAPI void               eina_tiler_free(Eina_Tiler *t);
  *
  * @warning @p w and @p h @b must be greater than zero, otherwise tile size
  * won't be changed.
- * @warning Tile size is not used!
+ * @warning Tile size is only used by #EINA_TILER_ALGORITHM_TILES, where
+ * changing it removes all rectangles from @p t.
  */
 EAPI void               eina_tiler_tile_size_set(Eina_Tiler *t, int w, int h);
+/**
+ * @brief Sets the algorithm used by a tiler.
+ *
+ * @param t The tiler.
+ * @param algorithm The algorithm to use.
+ * @return #EINA_TRUE on success, #EINA_FALSE if @p algorithm is unknown.
+ *
+ * #EINA_TILER_ALGORITHM_SPLITTER merges the rectangles with some tolerance,
+ * so the iterator may give an area a bit bigger than the one added, and
+ * adding a rectangle costs a walk of all the others, twice.
+ * #EINA_TILER_ALGORITHM_REGION gives exactly the added area, without
+ * overlap. Additions are queued and merged all at once, in O(n log n), when
+ * the rectangles are needed, a removal is linear in the number of
+ * rectangles. It is better when many rectangles are added.
+ * #EINA_TILER_ALGORITHM_TILES marks each tile touched by an added rectangle
+ * as dirty, and only cleans the tiles fully covered by a removed one. Adding
+ * or removing a rectangle costs the same whatever the number of rectangles
+ * already added, and the iterator gives the runs of dirty tiles of each
+ * row, merged with the following rows when they have the same runs. It is
+ * better when there are many small rectangles and redrawing whole tiles is
+ * fine. Its tiles are the size set by eina_tiler_tile_size_set(), that is
+ * the whole tiler by default.
+ *
+ * @note Changing the algorithm removes all rectangles from @p t.
+ *
+ * @see eina_tiler_algorithm_get()
+ * @since 1.7
+ */
+EAPI Eina_Bool          eina_tiler_algorithm_set(Eina_Tiler *t, Eina_Tiler_Algorithm algorithm);
+/**
+ * @brief Gets the algorithm used by a tiler.
+ *
+ * @param t The tiler.
+ * @return The algorithm used by @p t.
+ *
+ * @see eina_tiler_algorithm_set()
+ * @since 1.7
+ */
+EAPI Eina_Tiler_Algorithm eina_tiler_algorithm_get(const Eina_Tiler *t);
 /**
  * @brief Adds a rectangle to a tiler.
  *
@@ -233,6 +289,114 @@ EAPI void               eina_tiler_rect_del(Eina_Tiler *t, const Eina_Rectangle
  * @see eina_tiler_rect_del()
  */
 EAPI void               eina_tiler_clear(Eina_Tiler *t);
+/**
+ * @brief Adds many rectangles to a tiler.
+ *
+ * @param t The tiler in which to add the rectangles.
+ * @param rects The rectangles to add.
+ * @param count The number of rectangles in @p rects.
+ * @return #EINA_TRUE on success, #EINA_FALSE on failure.
+ *
+ * This is the same as calling eina_tiler_rect_add() on each rectangle, but
+ * faster. The rectangles are sorted by y and merged in a single pass before
+ * they are given to the tiler. Empty rectangles and rectangles out of the
+ * tiler are skipped.
+ *
+ * @see eina_tiler_rects_del()
+ * @since 1.7
+ */
+EAPI Eina_Bool          eina_tiler_rects_add(Eina_Tiler *t, const Eina_Rectangle *rects, unsigned int count);
+/**
+ * @brief Removes many rectangles from a tiler.
+ *
+ * @param t The tiler from which to remove the rectangles.
+ * @param rects The rectangles to remove.
+ * @param count The number of rectangles in @p rects.
+ * @return #EINA_TRUE on success, #EINA_FALSE on failure.
+ *
+ * This is the same as calling eina_tiler_rect_del() on each rectangle.
+ * With #EINA_TILER_ALGORITHM_REGION, the rectangles are merged in a single
+ * pass and removed at once.
+ *
+ * @see eina_tiler_rects_add()
+ * @since 1.7
+ */
+EAPI Eina_Bool          eina_tiler_rects_del(Eina_Tiler *t, const Eina_Rectangle *rects, unsigned int count);
+/**
+ * @brief Adds the rectangles of a tiler to another one.
+ *
+ * @param dst The tiler to add to.
+ * @param src The tiler whose rectangles are added.
+ * @return #EINA_TRUE on success, #EINA_FALSE on failure.
+ *
+ * The result is clipped to the size of @p dst. It is much faster than adding
+ * each rectangle of @p src to @p dst, most of all when @p dst uses
+ * #EINA_TILER_ALGORITHM_REGION, or when both use
+ * #EINA_TILER_ALGORITHM_TILES with the same tile and tiler sizes. With the
+ * other algorithms the area of @p dst is computed, changed then given back
+ * to it, so the result is as loose as adding it to @p dst again.
+ * @p dst is not changed on failure.
+ *
+ * @see eina_tiler_subtract()
+ * @see eina_tiler_intersect()
+ * @since 1.7
+ */
+EAPI Eina_Bool          eina_tiler_union(Eina_Tiler *dst, const Eina_Tiler *src);
+/**
+ * @brief Removes the rectangles of a tiler from another one.
+ *
+ * @param dst The tiler to remove from.
+ * @param src The tiler whose rectangles are removed.
+ * @return #EINA_TRUE on success, #EINA_FALSE on failure.
+ *
+ * For example the damage of a frame minus its opaque areas. With
+ * #EINA_TILER_ALGORITHM_TILES, only the tiles fully covered by @p src are
+ * removed. @p dst is not changed on failure.
+ *
+ * @see eina_tiler_union()
+ * @since 1.7
+ */
+EAPI Eina_Bool          eina_tiler_subtract(Eina_Tiler *dst, const Eina_Tiler *src);
+/**
+ * @brief Keeps the part of a tiler inside another one.
+ *
+ * @param dst The tiler to change.
+ * @param src The tiler giving the area to keep.
+ * @return #EINA_TRUE on success, #EINA_FALSE on failure.
+ *
+ * @p dst is not changed on failure.
+ *
+ * @see eina_tiler_union()
+ * @see eina_tiler_clip()
+ * @since 1.7
+ */
+EAPI Eina_Bool          eina_tiler_intersect(Eina_Tiler *dst, const Eina_Tiler *src);
+/**
+ * @brief Moves the rectangles of a tiler.
+ *
+ * @param t The tiler.
+ * @param dx The distance to move on the x axis.
+ * @param dy The distance to move on the y axis.
+ * @return #EINA_TRUE on success, #EINA_FALSE on failure.
+ *
+ * What goes out of the tiler is lost. With #EINA_TILER_ALGORITHM_TILES,
+ * moving by a distance that is not a multiple of the tile size makes every
+ * tile touched by a moved tile dirty.
+ *
+ * @since 1.7
+ */
+EAPI Eina_Bool          eina_tiler_translate(Eina_Tiler *t, int dx, int dy);
+/**
+ * @brief Keeps the part of a tiler inside a rectangle.
+ *
+ * @param t The tiler.
+ * @param clip The rectangle to keep.
+ * @return #EINA_TRUE on success, #EINA_FALSE on failure.
+ *
+ * @see eina_tiler_intersect()
+ * @since 1.7
+ */
+EAPI Eina_Bool          eina_tiler_clip(Eina_Tiler *t, const Eina_Rectangle *clip);
 /**
  * @brief Create a iterator to access the tilers calculated rectangles.
  *
@@ -468,6 +468,8 @@ EAPI extern const Eina_Value_Type *EINA_VALUE_TYPE_STRING;
  *  @li eina_value_array_get() and eina_value_array_set()
  *  @li eina_value_array_vget() and eina_value_array_vset()
  *  @li eina_value_array_pget() and eina_value_array_pset()
+ *  @li eina_value_array_data_get(), eina_value_array_data_append() and
+ *      eina_value_array_data_convert() for many members at once
  *
  * eina_value_set() takes an #Eina_Value_Array where just @c subtype
  * and @c step are used. If there is an @c array, it will be copied
@@ -1713,6 +1715,89 @@ static inline Eina_Bool eina_value_array_value_get(const Eina_Value *src,
                                                    unsigned int position,
                                                    Eina_Value *dst) EINA_ARG_NONNULL(1, 3);
 
+/**
+ * @brief Get the memory holding the members of an array.
+ * @param value source value object
+ * @param count where to return the number of members, may be @c NULL
+ * @return the first member, or @c NULL if the array is empty.
+ *
+ * Members are contiguous, each of them is @c value_size bytes of the
+ * array subtype. For numbers, like #EINA_VALUE_TYPE_INT or
+ * #EINA_VALUE_TYPE_DOUBLE, this is a plain C array that can be read
+ * and written directly, which is much faster than
+ * eina_value_array_get() on each member. Other subtypes may own their
+ * memory, their members should only be read.
+ *
+ * The memory is valid until the array is changed.
+ *
+ * @code
+ *     Eina_Value *value = eina_value_array_new(EINA_VALUE_TYPE_INT, 0);
+ *     int x[] = { 1, 2, 3 };
+ *     const int *members;
+ *     unsigned int i, count;
+ *     long sum = 0;
+ *
+ *     eina_value_array_data_append(value, x, 3);
+ *     members = eina_value_array_data_get(value, &count);
+ *     for (i = 0; i < count; i++) sum += members[i];
+ *     eina_value_free(value);
+ * @endcode
+ *
+ * @see eina_value_array_data_append()
+ * @see eina_value_array_data_convert()
+ *
+ * @since 1.7
+ */
+EAPI void *eina_value_array_data_get(const Eina_Value *value,
+                                     unsigned int *count) EINA_ARG_NONNULL(1);
+
+/**
+ * @brief Append many members to an array at once.
+ * @param value destination value object
+ * @param data C array of @p count members of the array subtype
+ * @param count number of members in @p data
+ * @return #EINA_TRUE on success, #EINA_FALSE otherwise.
+ *
+ * Each member of @p data is given like eina_value_array_pappend()
+ * expects it, for instance @c int for #EINA_VALUE_TYPE_INT or
+ * <tt>const char *</tt> for #EINA_VALUE_TYPE_STRING. The array grows
+ * once, and numbers are copied without going through the subtype.
+ *
+ * On failure, the array is left unchanged.
+ *
+ * @see eina_value_array_pappend()
+ * @see eina_value_array_data_get()
+ *
+ * @since 1.7
+ */
+EAPI Eina_Bool eina_value_array_data_append(Eina_Value *value,
+                                            const void *data,
+                                            unsigned int count) EINA_ARG_NONNULL(1);
+
+/**
+ * @brief Convert a range of array members to a C array of numbers.
+ * @param value source value object
+ * @param position index of the first member to convert
+ * @param count number of members to convert
+ * @param type numeric type to convert to, like #EINA_VALUE_TYPE_DOUBLE
+ * @param data where to store the @p count converted members
+ * @return #EINA_TRUE on success, #EINA_FALSE otherwise.
+ *
+ * This is eina_value_convert() on each member, with the same rules.
+ * Between numeric types it is done with a single loop over the
+ * members, and fails if any member does not fit in @p type, before
+ * @p data is changed.
+ *
+ * @see eina_value_array_data_get()
+ *
+ * @since 1.7
+ */
+EAPI Eina_Bool eina_value_array_data_convert(const Eina_Value *value,
+                                             unsigned int position,
+                                             unsigned int count,
+                                             const Eina_Value_Type *type,
+                                             void *data) EINA_ARG_NONNULL(1, 4);
+
 /**
  * @}
  */
@@ -3344,6 +3429,146 @@ static inline Eina_Bool eina_value_struct_member_value_set(Eina_Value *dst,
                                                            const Eina_Value_Struct_Member *member,
                                                            const Eina_Value *src) EINA_ARG_NONNULL(1, 2, 3);
 
+/**
+ * @brief Find the index of a struct member.
+ * @param desc the struct description
+ * @param name name of the member
+ * @return The position of the member in @c desc->members, -1 if there is
+ *         no member with this name.
+ *
+ * Looking up a member by name has to compare the names of the members.
+ * Descriptions with many members and no @c find_member operation get a
+ * hash index of their names, built on the first lookup, but it is
+ * faster still to look the name up once with this function and then
+ * use the eina_value_struct_index_*() functions.
+ *
+ * The index is valid for all the structs of @p desc.
+ *
+ * @see eina_value_struct_index_set()
+ * @see eina_value_struct_index_get()
+ *
+ * @since 1.7
+ */
+EAPI int eina_value_struct_member_index_get(const Eina_Value_Struct_Desc *desc,
+                                            const char *name) EINA_ARG_NONNULL(1, 2) EINA_WARN_UNUSED_RESULT;
+
+/**
+ * @brief Drop the hash index of the member names of a description.
+ * @param desc the struct description
+ *
+ * The index built by member lookups is kept until eina_shutdown(). Call
+ * this before freeing or reusing a description allocated at runtime, so
+ * its index does not pile up or outlive it.
+ *
+ * @see eina_value_struct_member_index_get()
+ *
+ * @since 1.7
+ */
+EAPI void eina_value_struct_desc_index_del(const Eina_Value_Struct_Desc *desc) EINA_ARG_NONNULL(1);
+
+/**
+ * @brief Set the generic value in a struct member given its index.
+ * @param value source value object
+ * @param index position of the member, see eina_value_struct_member_index_get()
+ * @return #EINA_TRUE on success, #EINA_FALSE otherwise.
+ *
+ * This is eina_value_struct_set() without the lookup of the member.
+ *
+ * @code
+ *     Eina_Value *value = eina_value_struct_new(&myst_desc);
+ *     int i = eina_value_struct_member_index_get(&myst_desc, "i");
+ *     int n;
+ *
+ *     for (n = 0; n < 1000; n++)
+ *       eina_value_struct_index_set(value, i, n);
+ * @endcode
+ *
+ * @see eina_value_struct_index_get()
+ * @see eina_value_struct_index_pset()
+ *
+ * @since 1.7
+ */
+static inline Eina_Bool eina_value_struct_index_set(Eina_Value *value,
+                                                    unsigned int index,
+                                                    ...) EINA_ARG_NONNULL(1);
+
+/**
+ * @brief Get the generic value from a struct member given its index.
+ * @param value source value object
+ * @param index position of the member, see eina_value_struct_member_index_get()
+ * @return #EINA_TRUE on success, #EINA_FALSE otherwise.
+ *
+ * This is eina_value_struct_get() without the lookup of the member.
+ *
+ * @see eina_value_struct_index_set()
+ * @see eina_value_struct_index_pget()
+ *
+ * @since 1.7
+ */
+static inline Eina_Bool eina_value_struct_index_get(const Eina_Value *value,
+                                                    unsigned int index,
+                                                    ...) EINA_ARG_NONNULL(1);
+
+/**
+ * @brief Set the generic value in a struct member given its index.
+ * @param value source value object
+ * @param index position of the member
+ * @param args variable argument
+ * @return #EINA_TRUE on success, #EINA_FALSE otherwise.
+ *
+ * @see eina_value_struct_index_set()
+ *
+ * @since 1.7
+ */
+static inline Eina_Bool eina_value_struct_index_vset(Eina_Value *value,
+                                                     unsigned int index,
+                                                     va_list args) EINA_ARG_NONNULL(1);
+
+/**
+ * @brief Get the generic value from a struct member given its index.
+ * @param value source value object
+ * @param index position of the member
+ * @param args variable argument
+ * @return #EINA_TRUE on success, #EINA_FALSE otherwise.
+ *
+ * @see eina_value_struct_index_get()
+ *
+ * @since 1.7
+ */
+static inline Eina_Bool eina_value_struct_index_vget(const Eina_Value *value,
+                                                     unsigned int index,
+                                                     va_list args) EINA_ARG_NONNULL(1);
+
+/**
+ * @brief Set the generic value in a struct member from pointer given its index.
+ * @param value source value object
+ * @param index position of the member
+ * @param ptr pointer to specify the contents.
+ * @return #EINA_TRUE on success, #EINA_FALSE otherwise.
+ *
+ * @see eina_value_struct_pset()
+ *
+ * @since 1.7
+ */
+static inline Eina_Bool eina_value_struct_index_pset(Eina_Value *value,
+                                                     unsigned int index,
+                                                     const void *ptr) EINA_ARG_NONNULL(1, 3);
+
+/**
+ * @brief Get the generic value to pointer from a struct member given its index.
+ * @param value source value object
+ * @param index position of the member
+ * @param ptr pointer to receive the contents.
+ * @return #EINA_TRUE on success, #EINA_FALSE otherwise.
+ *
+ * @see eina_value_struct_pget()
+ *
+ * @since 1.7
+ */
+static inline Eina_Bool eina_value_struct_index_pget(const Eina_Value *value,
+                                                     unsigned int index,
+                                                     void *ptr) EINA_ARG_NONNULL(1, 3);
+
 
 /**
  * @}
@@ -0,0 +1,128 @@
+/* EINA - EFL data type library
+ * Copyright (C) 2012 Enlightenment Project
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EINA_VALUE_BINARY_H_
+#define EINA_VALUE_BINARY_H_
+
+#include "eina_types.h"
+#include "eina_value.h"
+#include "eina_binbuf.h"
+#include "eina_file.h"
+
+/**
+ * @page eina_value_binary_main Binary Values
+ *
+ * An #Eina_Value can be encoded to a compact binary form with
+ * eina_value_binary_encode(), to be stored or sent to another process,
+ * and decoded back with eina_value_binary_decode() or, without copying
+ * its blobs, from a mapped file with eina_value_binary_file_decode().
+ *
+ * All the builtin types are supported, values of other types are
+ * refused. Values are encoded with their types, so the decoded value is
+ * of the same type as the encoded one. Numbers use the byte order of the machine that
+ * encoded them, data encoded on a machine with a different byte order
+ * is refused. Arrays of numbers are encoded as their members memory.
+ *
+ * Structs are encoded with the names and types of their members, their
+ * description is written once per encoded value. Decoded structs use a
+ * description built from them, with the same members in the same order,
+ * and shared by all the decoded structs that had the same description.
+ */
+
+/**
+ * @addtogroup Eina_Data_Types_Group Data Types
+ *
+ * @{
+ */
+
+/**
+ * @addtogroup Eina_Value_Group Generic Value Storage
+ *
+ * @{
+ */
+
+/**
+ * @defgroup Eina_Value_Binary_Group Binary Encoding
+ *
+ * Store and load values, see @ref eina_value_binary_main.
+ *
+ * @{
+ */
+
+/**
+ * @brief Append the binary encoding of a value to a buffer.
+ *
+ * @param value The value to encode.
+ * @param buf The buffer to append to.
+ * @return #EINA_TRUE on success, #EINA_FALSE otherwise.
+ *
+ * Strings and blobs are appended directly from their memory. Several
+ * values may be appended to the same buffer, each of them is decoded
+ * separately. On failure, @p buf is left as it was.
+ *
+ * @since 1.7
+ */
+EAPI Eina_Bool eina_value_binary_encode(const Eina_Value *value, Eina_Binbuf *buf) EINA_ARG_NONNULL(1, 2);
+
+/**
+ * @brief Decode a value from memory.
+ *
+ * @param data The memory holding the encoded value.
+ * @param size The number of bytes available in @p data.
+ * @param value Where to decode, it is considered uninitialized.
+ * @return The number of bytes used by the encoded value, 0 on failure.
+ *
+ * On success, @p value is setup to the encoded type and must be
+ * flushed by the caller. The decoded value does not refer to @p data.
+ * The returned size can be used to decode the next value of @p data.
+ *
+ * @since 1.7
+ */
+EAPI size_t eina_value_binary_decode(const void *data, size_t size, Eina_Value *value) EINA_ARG_NONNULL(1, 3);
+
+/**
+ * @brief Decode a value from a file, without copying its blobs.
+ *
+ * @param file The file holding the encoded value.
+ * @param offset Where the encoded value starts in @p file.
+ * @param value Where to decode, it is considered uninitialized.
+ * @return The number of bytes used by the encoded value, 0 on failure.
+ *
+ * This is eina_value_binary_decode() on the mapped @p file, except that
+ * the blobs of @p value point directly inside the map instead of being
+ * copied, and stringshares are added from it with no intermediate
+ * buffer. If there is a blob, the map is kept until @p file is closed,
+ * so @p file must stay open as long as @p value is used.
+ *
+ * @since 1.7
+ */
+EAPI size_t eina_value_binary_file_decode(Eina_File *file, size_t offset, Eina_Value *value) EINA_ARG_NONNULL(1, 3);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif
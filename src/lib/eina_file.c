@@ -42,6 +42,7 @@ void *alloca (size_t);
 #include <string.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <errno.h>
 #ifdef HAVE_DIRENT_H
 # include <dirent.h>
 #endif
@@ -52,6 +53,30 @@ void *alloca (size_t);
 # include <sys/mman.h>
 #endif
 #include <fcntl.h>
+#ifdef HAVE_SYS_SENDFILE_H
+# include <sys/sendfile.h>
+#endif
+#ifdef HAVE_SYS_EVENTFD_H
+# include <sys/eventfd.h>
+#endif
+#ifdef HAVE_LINUX_IO_URING_H
+# include <sys/syscall.h>
+# include <sys/uio.h>
+# include <linux/io_uring.h>
+# if defined(__NR_io_uring_setup) && defined(HAVE_SYS_EVENTFD_H)
+#  define EINA_FILE_URING 1
+# endif
+#endif
+
+#ifdef EFL_HAVE_POSIX_THREADS
+# include <pthread.h>
+#endif
+
+#if defined(HAVE_SYS_INOTIFY_H) && defined(HAVE_POLL_H) && defined(EFL_HAVE_POSIX_THREADS)
+# include <sys/inotify.h>
+# include <poll.h>
+# define EINA_FILE_WATCH 1
+#endif
 
 #define PATH_DELIM '/'
 
@@ -64,6 +89,9 @@ void *alloca (size_t);
 #include "eina_stringshare.h"
 #include "eina_hash.h"
 #include "eina_list.h"
+#include "eina_inlist.h"
+#include "eina_cpu.h"
+#include "eina_main.h"
 #include "eina_lock.h"
 #include "eina_mmap.h"
 #include "eina_log.h"
@@ -103,6 +131,9 @@ void *alloca (size_t);
 #define EINA_SMALL_PAGE 4096
 # define EINA_HUGE_PAGE 16 * 1024 * 1024
 
+/* Linux never moves more than this in one read/write/sendfile call. */
+#define EINA_FILE_TRANSFER_CHUNK 0x7ffff000UL
+
 #ifdef HAVE_DIRENT_H
 typedef struct _Eina_File_Iterator Eina_File_Iterator;
 struct _Eina_File_Iterator
@@ -137,6 +168,10 @@ struct _Eina_File
    int global_refcount;
 
    int fd;
+   int watch;
+
+   /* not a bit field as the watch thread set it without file->lock */
+   Eina_Bool stale;
 
    Eina_Bool shared : 1;
    Eina_Bool delete_me : 1;
@@ -160,6 +195,18 @@ struct _Eina_File_Map
 static Eina_Hash *_eina_file_cache = NULL;
 static Eina_Lock _eina_file_lock_cache;
 
+#ifdef EINA_FILE_WATCH
+#define EINA_FILE_WATCH_MASK (IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE | \
+                              IN_MOVE_SELF | IN_DELETE_SELF)
+
+/* Everything here is protected by _eina_file_lock_cache. */
+static Eina_Hash *_eina_file_watches = NULL;
+static int _eina_file_watch_fd = -1;
+static int _eina_file_watch_pipe[2] = { -1, -1 };
+static unsigned int _eina_file_watch_serial = 0;
+static pthread_t _eina_file_watch_thread;
+#endif
+
 static int _eina_file_log_dom = -1;
 
 /*
@@ -376,6 +423,171 @@ _eina_file_stat_ls_iterator_next(Eina_File_Direct_Iterator *it, void **data)
 
    return EINA_TRUE;
 }
+
+/* Parallel walker: every worker (the calling thread included) pops a
+   directory from the shared stack, lists it and pushes back the
+   subdirectories it found. Reported entries are packed into a per-worker
+   batch that only keeps the used part of each Eina_File_Direct_Info. */
+#define EINA_FILE_WALK_THREADS_MAX 32
+#define EINA_FILE_WALK_BATCH_COUNT 64
+#define EINA_FILE_WALK_BATCH_WORDS (64 * 1024 / sizeof (size_t))
+
+typedef struct _Eina_File_Walk Eina_File_Walk;
+typedef struct _Eina_File_Walk_Dir Eina_File_Walk_Dir;
+typedef struct _Eina_File_Walk_Batch Eina_File_Walk_Batch;
+
+struct _Eina_File_Walk
+{
+   Eina_File_Walk_Filter_Cb filter;
+   Eina_File_Walk_Filter_Cb prune;
+   Eina_File_Walk_Batch_Cb cb;
+   void *data;
+
+   Eina_Inlist *pending;
+   int active;
+
+   Eina_Lock lock;
+   Eina_Condition cond;
+   Eina_Lock cb_lock;
+};
+
+struct _Eina_File_Walk_Dir
+{
+   EINA_INLIST;
+   char path[1];
+};
+
+struct _Eina_File_Walk_Batch
+{
+   Eina_File_Walk *walk;
+   const Eina_File_Direct_Info *infos[EINA_FILE_WALK_BATCH_COUNT];
+   unsigned int count;
+   size_t used;
+   size_t buffer[EINA_FILE_WALK_BATCH_WORDS];
+};
+
+static Eina_File_Walk_Dir *
+_eina_file_walk_dir_new(const char *path, size_t length)
+{
+   Eina_File_Walk_Dir *d;
+
+   d = malloc(sizeof (Eina_File_Walk_Dir) + length);
+   if (!d) return NULL;
+
+   memcpy(d->path, path, length + 1);
+   return d;
+}
+
+static void
+_eina_file_walk_flush(Eina_File_Walk_Batch *batch)
+{
+   Eina_File_Walk *walk = batch->walk;
+
+   if (batch->count == 0) return;
+
+   eina_lock_take(&walk->cb_lock);
+   walk->cb(walk->data, batch->infos, batch->count);
+   eina_lock_release(&walk->cb_lock);
+
+   batch->count = 0;
+   batch->used = 0;
+}
+
+static void
+_eina_file_walk_report(Eina_File_Walk_Batch *batch,
+                       const Eina_File_Direct_Info *info)
+{
+   Eina_File_Direct_Info *copy;
+   size_t length;
+   size_t words;
+
+   length = offsetof(Eina_File_Direct_Info, path) + info->path_length + 1;
+   words = (length + sizeof (size_t) - 1) / sizeof (size_t);
+
+   if ((batch->count == EINA_FILE_WALK_BATCH_COUNT) ||
+       (batch->used + words > EINA_FILE_WALK_BATCH_WORDS))
+     _eina_file_walk_flush(batch);
+
+   copy = (Eina_File_Direct_Info *)(batch->buffer + batch->used);
+   memcpy(copy, info, length);
+
+   batch->infos[batch->count++] = copy;
+   batch->used += words;
+}
+
+static Eina_Inlist *
+_eina_file_walk_list(Eina_File_Walk_Batch *batch, const char *dir)
+{
+   Eina_File_Walk *walk = batch->walk;
+   Eina_File_Direct_Info *info;
+   Eina_Iterator *it;
+   Eina_Inlist *subdirs = NULL;
+
+   it = eina_file_stat_ls(dir);
+   if (!it) return NULL;
+
+   EINA_ITERATOR_FOREACH(it, info)
+     {
+        if (!walk->filter || walk->filter(walk->data, info))
+          _eina_file_walk_report(batch, info);
+
+        if ((info->type == EINA_FILE_DIR) &&
+            !(walk->prune && walk->prune(walk->data, info)))
+          {
+             Eina_File_Walk_Dir *d;
+
+             d = _eina_file_walk_dir_new(info->path, info->path_length);
+             if (d) subdirs = eina_inlist_prepend(subdirs, EINA_INLIST_GET(d));
+          }
+     }
+
+   eina_iterator_free(it);
+
+   return subdirs;
+}
+
+static void *
+_eina_file_walk_worker(void *data)
+{
+   Eina_File_Walk_Batch *batch = data;
+   Eina_File_Walk *walk = batch->walk;
+
+   eina_lock_take(&walk->lock);
+   for (;;)
+     {
+        Eina_File_Walk_Dir *d;
+        Eina_Inlist *subdirs;
+
+        while (!walk->pending && walk->active > 0)
+          eina_condition_wait(&walk->cond);
+
+        if (!walk->pending) break;
+
+        d = EINA_INLIST_CONTAINER_GET(walk->pending, Eina_File_Walk_Dir);
+        walk->pending = eina_inlist_remove(walk->pending, walk->pending);
+        walk->active++;
+        eina_lock_release(&walk->lock);
+
+        subdirs = _eina_file_walk_list(batch, d->path);
+        free(d);
+
+        eina_lock_take(&walk->lock);
+        walk->active--;
+        while (subdirs)
+          {
+             Eina_Inlist *l = subdirs;
+
+             subdirs = eina_inlist_remove(subdirs, l);
+             walk->pending = eina_inlist_prepend(walk->pending, l);
+          }
+        eina_condition_broadcast(&walk->cond);
+     }
+   eina_lock_release(&walk->lock);
+
+   _eina_file_walk_flush(batch);
+
+   return NULL;
+}
 #endif
 
 static void
@@ -485,6 +697,110 @@ _eina_file_timestamp_compare(Eina_File *f, struct stat *st)
    return EINA_TRUE;
 }
 
+#ifdef EINA_FILE_WATCH
+static void *
+_eina_file_watch_main(void *data __UNUSED__)
+{
+   union {
+      struct inotify_event event;
+      char buffer[4096];
+   } events;
+   struct pollfd fds[2];
+
+   fds[0].fd = _eina_file_watch_fd;
+   fds[0].events = POLLIN;
+   fds[1].fd = _eina_file_watch_pipe[0];
+   fds[1].events = POLLIN;
+
+   for (;;)
+     {
+        ssize_t length;
+        char *p;
+
+        if (poll(fds, 2, -1) < 0)
+          {
+             if (errno == EINTR) continue;
+             break;
+          }
+        if (fds[1].revents) break;
+
+        length = read(_eina_file_watch_fd, &events, sizeof (events));
+        if (length <= 0) continue;
+
+        eina_lock_take(&_eina_file_lock_cache);
+        for (p = events.buffer; p < events.buffer + length; )
+          {
+             struct inotify_event *ev = (struct inotify_event *) p;
+             Eina_File *f;
+
+             p += sizeof (struct inotify_event) + ev->len;
+
+             if (ev->mask & IN_Q_OVERFLOW)
+               {
+                  Eina_Iterator *it;
+
+                  /* we lost track, everyone has to be checked again */
+                  it = eina_hash_iterator_data_new(_eina_file_watches);
+                  EINA_ITERATOR_FOREACH(it, f)
+                    f->stale = EINA_TRUE;
+                  eina_iterator_free(it);
+                  continue;
+               }
+
+             f = eina_hash_find(_eina_file_watches, &ev->wd);
+             if (!f) continue;
+
+             f->stale = EINA_TRUE;
+             if (ev->mask & IN_IGNORED)
+               {
+                  eina_hash_del(_eina_file_watches, &ev->wd, f);
+                  f->watch = -1;
+               }
+          }
+        _eina_file_watch_serial++;
+        eina_lock_release(&_eina_file_lock_cache);
+     }
+
+   return NULL;
+}
+
+/* Both need _eina_file_lock_cache to be taken. */
+static void
+_eina_file_watch_add(Eina_File *file)
+{
+   int wd;
+
+   if ((_eina_file_watch_fd < 0) || (file->shared) || (file->watch >= 0))
+     return;
+
+   wd = inotify_add_watch(_eina_file_watch_fd, file->filename,
+                          EINA_FILE_WATCH_MASK);
+   if (wd < 0) return;
+
+   /* another path to the same inode already own that watch */
+   if (eina_hash_find(_eina_file_watches, &wd)) return;
+
+   file->watch = wd;
+   /* the file could have changed since it was stat'ed, so it is only
+      trusted after being checked once more with the watch in place */
+   file->stale = EINA_TRUE;
+   eina_hash_add(_eina_file_watches, &file->watch, file);
+}
+
+static void
+_eina_file_watch_del(Eina_File *file)
+{
+   if (file->watch < 0) return;
+
+   if (_eina_file_watch_fd >= 0)
+     {
+        eina_hash_del(_eina_file_watches, &file->watch, file);
+        inotify_rm_watch(_eina_file_watch_fd, file->watch);
+     }
+   file->watch = -1;
+}
+#endif
+
 static void
 slprintf(char *str, size_t size, const char *format, ...)
 {
@@ -568,6 +884,326 @@ _eina_file_escape(const char *path, int *length)
    return result;
 }
 
+#define EINA_FILE_ASYNC_THREADS_MAX 8
+
+typedef struct _Eina_File_Async_Request Eina_File_Async_Request;
+struct _Eina_File_Async_Request
+{
+   EINA_INLIST;
+
+   Eina_File *file;
+   Eina_File_Async_Cb cb;
+   const void *data;
+
+   void *buffer;
+   unsigned long int offset;
+   unsigned long int length;
+   long int result;
+
+#ifdef EINA_FILE_URING
+   struct iovec iov;
+#endif
+};
+
+#ifdef EINA_FILE_URING
+typedef struct _Eina_File_Uring Eina_File_Uring;
+struct _Eina_File_Uring
+{
+   int fd;
+
+   void *sq_ring;
+   size_t sq_ring_size;
+   void *cq_ring;
+   size_t cq_ring_size;
+   struct io_uring_sqe *sqes;
+   size_t sqes_size;
+
+   unsigned int *sq_head;
+   unsigned int *sq_tail;
+   unsigned int *sq_mask;
+   unsigned int *sq_array;
+   unsigned int sq_entries;
+
+   unsigned int *cq_head;
+   unsigned int *cq_tail;
+   unsigned int *cq_mask;
+   struct io_uring_cqe *cqes;
+   unsigned int cq_entries;
+
+   unsigned int unsubmitted;
+   unsigned int inflight;
+};
+#endif
+
+struct _Eina_File_Async
+{
+   /* requests not yet handed to the kernel or to a thread */
+   Eina_Inlist *queued;
+   /* requests done but not yet dispatched */
+   Eina_Inlist *done;
+   unsigned int outstanding;
+
+   /* readable as long as there is something in done */
+   int notify[2];
+
+#ifdef EINA_FILE_URING
+   Eina_File_Uring *uring;
+#endif
+
+   Eina_Lock lock;
+   Eina_Condition cond;
+#ifdef EFL_HAVE_POSIX_THREADS
+   pthread_t threads[EINA_FILE_ASYNC_THREADS_MAX];
+   unsigned int threads_count;
+   Eina_Bool shutdown;
+#endif
+};
+
+static void
+_eina_file_async_notify(Eina_File_Async *async)
+{
+#ifdef HAVE_SYS_EVENTFD_H
+   eventfd_write(async->notify[1], 1);
+#else
+   char c = 0;
+
+   if (write(async->notify[1], &c, 1) < 0)
+     DBG("Could not notify completion.");
+#endif
+}
+
+static void
+_eina_file_async_notify_drain(Eina_File_Async *async)
+{
+#ifdef HAVE_SYS_EVENTFD_H
+   eventfd_t value;
+
+   eventfd_read(async->notify[0], &value);
+#else
+   char buffer[64];
+
+   while (read(async->notify[0], buffer, sizeof (buffer)) == sizeof (buffer))
+     ;
+#endif
+}
+
+static long int
+_eina_file_async_pread(Eina_File_Async_Request *req)
+{
+   ssize_t n;
+
+   do
+     n = pread(req->file->fd, req->buffer, req->length, req->offset);
+   while (n < 0 && errno == EINTR);
+
+   return n < 0 ? -errno : n;
+}
+
+#ifdef EINA_FILE_URING
+static void
+_eina_file_uring_free(Eina_File_Uring *ring)
+{
+   if (ring->sqes) munmap(ring->sqes, ring->sqes_size);
+   if (ring->cq_ring && ring->cq_ring != ring->sq_ring)
+     munmap(ring->cq_ring, ring->cq_ring_size);
+   if (ring->sq_ring) munmap(ring->sq_ring, ring->sq_ring_size);
+   close(ring->fd);
+   free(ring);
+}
+
+static Eina_File_Uring *
+_eina_file_uring_new(unsigned int depth, int eventfd)
+{
+   struct io_uring_params params;
+   Eina_File_Uring *ring;
+   char *sq;
+   char *cq;
+
+   ring = calloc(1, sizeof (Eina_File_Uring));
+   if (!ring) return NULL;
+
+   memset(&params, 0, sizeof (params));
+   ring->fd = syscall(__NR_io_uring_setup, depth, &params);
+   if (ring->fd < 0)
+     {
+        free(ring);
+        return NULL;
+     }
+
+   ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof (unsigned int);
+   ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof (struct io_uring_cqe);
+   ring->sqes_size = params.sq_entries * sizeof (struct io_uring_sqe);
+
+# ifdef IORING_FEAT_SINGLE_MMAP
+   if (params.features & IORING_FEAT_SINGLE_MMAP)
+     {
+        if (ring->cq_ring_size > ring->sq_ring_size)
+          ring->sq_ring_size = ring->cq_ring_size;
+        ring->cq_ring_size = ring->sq_ring_size;
+     }
+# endif
+
+   ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED, ring->fd, IORING_OFF_SQ_RING);
+   if (ring->sq_ring == MAP_FAILED) goto on_error;
+
+# ifdef IORING_FEAT_SINGLE_MMAP
+   if (params.features & IORING_FEAT_SINGLE_MMAP)
+     ring->cq_ring = ring->sq_ring;
+   else
+# endif
+   ring->cq_ring = mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED, ring->fd, IORING_OFF_CQ_RING);
+   if (ring->cq_ring == MAP_FAILED) goto on_error;
+
+   ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED, ring->fd, IORING_OFF_SQES);
+   if (ring->sqes == MAP_FAILED) goto on_error;
+
+   /* completions are signaled through the eventfd of the queue */
+   if (syscall(__NR_io_uring_register, ring->fd,
+               IORING_REGISTER_EVENTFD, &eventfd, 1) < 0)
+     goto on_error;
+
+   sq = ring->sq_ring;
+   ring->sq_head = (unsigned int *)(sq + params.sq_off.head);
+   ring->sq_tail = (unsigned int *)(sq + params.sq_off.tail);
+   ring->sq_mask = (unsigned int *)(sq + params.sq_off.ring_mask);
+   ring->sq_array = (unsigned int *)(sq + params.sq_off.array);
+   ring->sq_entries = params.sq_entries;
+
+   cq = ring->cq_ring;
+   ring->cq_head = (unsigned int *)(cq + params.cq_off.head);
+   ring->cq_tail = (unsigned int *)(cq + params.cq_off.tail);
+   ring->cq_mask = (unsigned int *)(cq + params.cq_off.ring_mask);
+   ring->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+   ring->cq_entries = params.cq_entries;
+
+   return ring;
+
+ on_error:
+   if (ring->sq_ring == MAP_FAILED) ring->sq_ring = NULL;
+   if (ring->cq_ring == MAP_FAILED) ring->cq_ring = NULL;
+   if (ring->sqes == MAP_FAILED) ring->sqes = NULL;
+   _eina_file_uring_free(ring);
+   return NULL;
+}
+
+static void
+_eina_file_uring_enter(Eina_File_Uring *ring, Eina_Bool wait)
+{
+   int n;
+
+   if (!ring->unsubmitted && !wait) return;
+
+   n = syscall(__NR_io_uring_enter, ring->fd, ring->unsubmitted,
+               wait ? 1 : 0, wait ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+   if (n > 0) ring->unsubmitted -= n;
+}
+
+/* Move as many queued requests as possible to the submission ring. */
+static void
+_eina_file_uring_submit(Eina_File_Async *async)
+{
+   Eina_File_Uring *ring = async->uring;
+
+   while (async->queued)
+     {
+        Eina_File_Async_Request *req;
+        struct io_uring_sqe *sqe;
+        unsigned int tail;
+        unsigned int index;
+
+        tail = *ring->sq_tail;
+        if (tail - __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE) >= ring->sq_entries)
+          break;
+        /* never have more in flight than the completion ring can hold */
+        if (ring->inflight >= ring->cq_entries)
+          break;
+
+        req = EINA_INLIST_CONTAINER_GET(async->queued, Eina_File_Async_Request);
+        async->queued = eina_inlist_remove(async->queued, async->queued);
+
+        req->iov.iov_base = req->buffer;
+        req->iov.iov_len = req->length;
+
+        index = tail & *ring->sq_mask;
+        sqe = &ring->sqes[index];
+        memset(sqe, 0, sizeof (struct io_uring_sqe));
+        sqe->opcode = IORING_OP_READV;
+        sqe->fd = req->file->fd;
+        sqe->off = req->offset;
+        sqe->addr = (unsigned long) &req->iov;
+        sqe->len = 1;
+        sqe->user_data = (unsigned long) req;
+        ring->sq_array[index] = index;
+
+        __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+        ring->unsubmitted++;
+        ring->inflight++;
+     }
+
+   _eina_file_uring_enter(ring, EINA_FALSE);
+}
+
+static void
+_eina_file_uring_reap(Eina_File_Async *async)
+{
+   Eina_File_Uring *ring = async->uring;
+   unsigned int head;
+   unsigned int tail;
+
+   head = *ring->cq_head;
+   tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+   for (; head != tail; head++)
+     {
+        struct io_uring_cqe *cqe;
+        Eina_File_Async_Request *req;
+
+        cqe = &ring->cqes[head & *ring->cq_mask];
+        req = (Eina_File_Async_Request *)(unsigned long) cqe->user_data;
+        req->result = cqe->res;
+        async->done = eina_inlist_append(async->done, EINA_INLIST_GET(req));
+        ring->inflight--;
+     }
+   __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+
+   _eina_file_uring_submit(async);
+}
+#endif
+
+#ifdef EFL_HAVE_POSIX_THREADS
+static void *
+_eina_file_async_worker(void *data)
+{
+   Eina_File_Async *async = data;
+
+   eina_lock_take(&async->lock);
+   for (;;)
+     {
+        Eina_File_Async_Request *req;
+
+        while (!async->queued && !async->shutdown)
+          eina_condition_wait(&async->cond);
+        if (!async->queued) break;
+
+        req = EINA_INLIST_CONTAINER_GET(async->queued, Eina_File_Async_Request);
+        async->queued = eina_inlist_remove(async->queued, async->queued);
+        eina_lock_release(&async->lock);
+
+        req->result = _eina_file_async_pread(req);
+
+        eina_lock_take(&async->lock);
+        async->done = eina_inlist_append(async->done, EINA_INLIST_GET(req));
+        _eina_file_async_notify(async);
+        eina_condition_broadcast(&async->cond);
+     }
+   eina_lock_release(&async->lock);
+
+   return NULL;
+}
+#endif
+
 /**
  * @endcond
  */
@@ -604,6 +1240,8 @@ eina_file_init(void)
 Eina_Bool
 eina_file_shutdown(void)
 {
+   eina_file_cache_watch_set(EINA_FALSE);
+
    if (eina_hash_population(_eina_file_cache) > 0)
      {
         Eina_Iterator *it;
@@ -744,6 +1382,118 @@ eina_file_dir_list(const char *dir,
    return EINA_TRUE;
 }
 
+EAPI Eina_Bool
+eina_file_dir_walk(const char *dir,
+                   unsigned int max_threads,
+                   Eina_File_Walk_Filter_Cb filter,
+                   Eina_File_Walk_Filter_Cb prune,
+                   Eina_File_Walk_Batch_Cb cb,
+                   void *data)
+{
+#ifdef HAVE_DIRENT_H
+   Eina_File_Walk walk;
+   Eina_File_Walk_Batch **batches;
+   Eina_File_Walk_Dir *root;
+   DIR *dirp;
+   unsigned int i;
+# ifdef EFL_HAVE_POSIX_THREADS
+   pthread_t *threads;
+   unsigned int spawned = 0;
+# endif
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(cb,  EINA_FALSE);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(dir, EINA_FALSE);
+   EINA_SAFETY_ON_TRUE_RETURN_VAL(dir[0] == '\0', EINA_FALSE);
+
+   /* Report an unreadable root like eina_file_dir_list() does. */
+   dirp = opendir(dir);
+   if (!dirp) return EINA_FALSE;
+   closedir(dirp);
+
+   if (max_threads == 0) max_threads = eina_cpu_count();
+   if (max_threads < 1) max_threads = 1;
+# ifdef EFL_HAVE_POSIX_THREADS
+   if (max_threads > EINA_FILE_WALK_THREADS_MAX)
+     max_threads = EINA_FILE_WALK_THREADS_MAX;
+# else
+   max_threads = 1;
+# endif
+
+   root = _eina_file_walk_dir_new(dir, strlen(dir));
+   if (!root) return EINA_FALSE;
+
+   batches = alloca(sizeof (Eina_File_Walk_Batch *) * max_threads);
+   for (i = 0; i < max_threads; i++)
+     {
+        batches[i] = malloc(sizeof (Eina_File_Walk_Batch));
+        if (!batches[i]) break;
+        batches[i]->walk = &walk;
+        batches[i]->count = 0;
+        batches[i]->used = 0;
+     }
+   if (i == 0)
+     {
+        free(root);
+        return EINA_FALSE;
+     }
+   max_threads = i;
+
+   walk.filter = filter;
+   walk.prune = prune;
+   walk.cb = cb;
+   walk.data = data;
+   walk.pending = eina_inlist_append(NULL, EINA_INLIST_GET(root));
+   walk.active = 0;
+
+# ifdef EFL_HAVE_POSIX_THREADS
+   if (max_threads > 1) eina_threads_init();
+# endif
+
+   eina_lock_new(&walk.lock);
+   eina_condition_new(&walk.cond, &walk.lock);
+   eina_lock_new(&walk.cb_lock);
+
+# ifdef EFL_HAVE_POSIX_THREADS
+   threads = alloca(sizeof (pthread_t) * max_threads);
+   for (i = 1; i < max_threads; i++)
+     {
+        if (pthread_create(&threads[spawned], NULL,
+                           _eina_file_walk_worker, batches[i]) != 0)
+          break;
+        spawned++;
+     }
+# endif
+
+   _eina_file_walk_worker(batches[0]);
+
+# ifdef EFL_HAVE_POSIX_THREADS
+   for (i = 0; i < spawned; i++)
+     pthread_join(threads[i], NULL);
+# endif
+
+   eina_lock_free(&walk.cb_lock);
+   eina_condition_free(&walk.cond);
+   eina_lock_free(&walk.lock);
+
+# ifdef EFL_HAVE_POSIX_THREADS
+   if (max_threads > 1) eina_threads_shutdown();
+# endif
+
+   for (i = 0; i < max_threads; i++)
+     free(batches[i]);
+
+   return EINA_TRUE;
+#else
+   (void) dir;
+   (void) max_threads;
+   (void) filter;
+   (void) prune;
+   (void) cb;
+   (void) data;
+   return EINA_FALSE;
+#endif
+}
+
 EAPI Eina_Array *
 eina_file_split(char *path)
 {
@@ -947,12 +1697,38 @@ eina_file_open(const char *path, Eina_Bool shared)
 #ifdef HAVE_EXECVP
    int flags;
 #endif
+#ifdef EINA_FILE_WATCH
+   unsigned int serial = 0;
+   Eina_Bool watched = EINA_FALSE;
+#endif
 
    EINA_SAFETY_ON_NULL_RETURN_VAL(path, NULL);
 
    filename = eina_file_path_sanitize(path);
    if (!filename) return NULL;
 
+#ifdef EINA_FILE_WATCH
+   if (!shared && _eina_file_watch_fd >= 0)
+     {
+        /* a watched file that did not change is reused without any syscall */
+        eina_lock_take(&_eina_file_lock_cache);
+        serial = _eina_file_watch_serial;
+        watched = EINA_TRUE;
+        file = eina_hash_find(_eina_file_cache, filename);
+        if ((file) && (file->watch >= 0) && (!file->stale))
+          {
+             eina_lock_take(&file->lock);
+             file->refcount++;
+             eina_lock_release(&file->lock);
+
+             eina_lock_release(&_eina_file_lock_cache);
+             free(filename);
+             return file;
+          }
+        eina_lock_release(&_eina_file_lock_cache);
+     }
+#endif
+
    if (shared)
 #ifdef HAVE_SHM_OPEN
      fd = shm_open(filename, O_RDONLY, S_IRWXU | S_IRWXG | S_IRWXO);
@@ -983,6 +1759,9 @@ eina_file_open(const char *path, Eina_Bool shared)
    if ((file) && !_eina_file_timestamp_compare(file, &file_stat))
      {
         file->delete_me = EINA_TRUE;
+#ifdef EINA_FILE_WATCH
+        _eina_file_watch_del(file);
+#endif
         eina_hash_del(_eina_file_cache, file->filename, file);
         _eina_file_real_close(file);
         file = NULL;
@@ -1018,6 +1797,7 @@ eina_file_open(const char *path, Eina_Bool shared)
 #endif
         n->inode = file_stat.st_ino;
         n->fd = fd;
+        n->watch = -1;
         n->shared = shared;
         eina_lock_new(&n->lock);
         eina_hash_direct_add(_eina_file_cache, n->filename, n);
@@ -1027,6 +1807,12 @@ eina_file_open(const char *path, Eina_Bool shared)
         close(fd);
         n = file;
      }
+#ifdef EINA_FILE_WATCH
+   if (n->watch < 0)
+     _eina_file_watch_add(n);
+   else if (watched && serial == _eina_file_watch_serial)
+     n->stale = EINA_FALSE;
+#endif
    eina_lock_take(&n->lock);
    n->refcount++;
    eina_lock_release(&n->lock);
@@ -1043,6 +1829,94 @@ eina_file_open(const char *path, Eina_Bool shared)
    return NULL;
 }
 
+EAPI Eina_Bool
+eina_file_cache_watch_set(Eina_Bool watch)
+{
+#ifdef EINA_FILE_WATCH
+   Eina_Iterator *it;
+   Eina_File *f;
+   Eina_Bool ret = EINA_TRUE;
+   int fd;
+
+   if (!!watch == (_eina_file_watch_fd >= 0)) return EINA_TRUE;
+
+   if (watch)
+     {
+        fd = inotify_init();
+        if (fd < 0)
+          {
+             ERR("Could not create inotify descriptor.");
+             return EINA_FALSE;
+          }
+        if (pipe(_eina_file_watch_pipe))
+          {
+             ERR("Could not create the inotify thread pipe.");
+             close(fd);
+             return EINA_FALSE;
+          }
+# ifdef HAVE_EXECVP
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+        fcntl(_eina_file_watch_pipe[0], F_SETFD, FD_CLOEXEC);
+        fcntl(_eina_file_watch_pipe[1], F_SETFD, FD_CLOEXEC);
+# endif
+
+        eina_threads_init();
+
+        eina_lock_take(&_eina_file_lock_cache);
+        _eina_file_watches = eina_hash_int32_new(NULL);
+        _eina_file_watch_fd = fd;
+        if (pthread_create(&_eina_file_watch_thread, NULL,
+                           _eina_file_watch_main, NULL) == 0)
+          {
+             eina_lock_release(&_eina_file_lock_cache);
+             return EINA_TRUE;
+          }
+
+        ERR("Could not create the inotify thread.");
+        ret = EINA_FALSE;
+        eina_lock_release(&_eina_file_lock_cache);
+     }
+   else
+     {
+        if (write(_eina_file_watch_pipe[1], "", 1) == 1)
+          pthread_join(_eina_file_watch_thread, NULL);
+     }
+
+   eina_lock_take(&_eina_file_lock_cache);
+   it = eina_hash_iterator_data_new(_eina_file_watches);
+   EINA_ITERATOR_FOREACH(it, f)
+     f->watch = -1;
+   eina_iterator_free(it);
+   eina_hash_free(_eina_file_watches);
+   _eina_file_watches = NULL;
+
+   close(_eina_file_watch_fd);
+   _eina_file_watch_fd = -1;
+   eina_lock_release(&_eina_file_lock_cache);
+
+   close(_eina_file_watch_pipe[0]);
+   close(_eina_file_watch_pipe[1]);
+   _eina_file_watch_pipe[0] = -1;
+   _eina_file_watch_pipe[1] = -1;
+
+   eina_threads_shutdown();
+
+   return ret;
+#else
+   return !watch;
+#endif
+}
+
+EAPI Eina_Bool
+eina_file_cache_watch_get(void)
+{
+#ifdef EINA_FILE_WATCH
+   return _eina_file_watch_fd >= 0;
+#else
+   return EINA_FALSE;
+#endif
+}
+
 EAPI void
 eina_file_close(Eina_File *file)
 {
@@ -1055,6 +1929,9 @@ eina_file_close(Eina_File *file)
    if (file->refcount != 0) return;
    eina_lock_take(&_eina_file_lock_cache);
 
+#ifdef EINA_FILE_WATCH
+   _eina_file_watch_del(file);
+#endif
    eina_hash_del(_eina_file_cache, file->filename, file);
    _eina_file_real_close(file);
 
@@ -1380,6 +2257,82 @@ eina_file_map_free(Eina_File *file, void *map)
    eina_lock_release(&file->lock);
 }
 
+EAPI Eina_Bool
+eina_file_transfer(Eina_File *file,
+                   unsigned long int offset, unsigned long int length,
+                   int fd)
+{
+   off_t pos = offset;
+   const char *map;
+   const char *p;
+   Eina_Bool r;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(file, EINA_FALSE);
+   EINA_SAFETY_ON_TRUE_RETURN_VAL(fd < 0, EINA_FALSE);
+
+   if (offset > file->length)
+     return EINA_FALSE;
+   if (length > file->length - offset)
+     return EINA_FALSE;
+
+   /* Try each way to let the kernel do the copy and only fall back to the
+      next one when the current one refuse to do it. As all of them write
+      at the current position of fd, they can take over from each other. */
+#ifdef HAVE_COPY_FILE_RANGE
+   while (length > 0)
+     {
+        ssize_t n;
+
+        n = copy_file_range(file->fd, &pos, fd, NULL,
+                            length > EINA_FILE_TRANSFER_CHUNK ?
+                            EINA_FILE_TRANSFER_CHUNK : length, 0);
+        if (n > 0) length -= n;
+        else if (n < 0 && errno == EINTR) continue;
+        else break;
+     }
+#endif
+
+#if defined(HAVE_SENDFILE) && defined(HAVE_SYS_SENDFILE_H)
+   while (length > 0)
+     {
+        ssize_t n;
+
+        n = sendfile(fd, file->fd, &pos,
+                     length > EINA_FILE_TRANSFER_CHUNK ?
+                     EINA_FILE_TRANSFER_CHUNK : length);
+        if (n > 0) length -= n;
+        else if (n < 0 && errno == EINTR) continue;
+        else break;
+     }
+#endif
+
+   if (length == 0) return EINA_TRUE;
+
+   map = eina_file_map_all(file, EINA_FILE_SEQUENTIAL);
+   if (!map) return EINA_FALSE;
+
+   for (p = map + pos; length > 0; )
+     {
+        ssize_t n;
+
+        n = write(fd, p,
+                  length > EINA_FILE_TRANSFER_CHUNK ?
+                  EINA_FILE_TRANSFER_CHUNK : length);
+        if (n > 0)
+          {
+             p += n;
+             length -= n;
+          }
+        else if (n < 0 && errno == EINTR) continue;
+        else break;
+     }
+
+   r = (length == 0) && !eina_file_map_faulted(file, (void *) map);
+   eina_file_map_free(file, (void *) map);
+
+   return r;
+}
+
 EAPI Eina_Bool
 eina_file_map_faulted(Eina_File *file, void *map)
 {
@@ -1434,10 +2387,10 @@ eina_file_statat(void *container, Eina_File_Direct_Info *info, Eina_Stat *st)
 
 #ifdef HAVE_FSTATAT
    fd = dirfd((DIR*) container);
-   if (fstatat(fd, info->path + info->name_start, &buf, 0))
+   if (fstatat(fd, info->path + info->name_start, &buf, AT_SYMLINK_NOFOLLOW))
 #else
    (void)container;
-   if (stat(info->path, &buf))
+   if (lstat(info->path, &buf))
 #endif
      {
         if (info->type != EINA_FILE_LNK)
@@ -1495,3 +2448,249 @@ eina_file_statat(void *container, Eina_File_Direct_Info *info, Eina_Stat *st)
 #endif
    return 0;
 }
+
+EAPI Eina_File_Async *
+eina_file_async_new(unsigned int depth)
+{
+   Eina_File_Async *async;
+#ifdef EFL_HAVE_POSIX_THREADS
+   unsigned int i;
+#endif
+
+   if (depth == 0) depth = 64;
+
+   async = calloc(1, sizeof (Eina_File_Async));
+   if (!async) return NULL;
+
+#ifdef HAVE_SYS_EVENTFD_H
+   async->notify[0] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+   async->notify[1] = async->notify[0];
+   if (async->notify[0] < 0)
+     {
+        free(async);
+        return NULL;
+     }
+#else
+   if (pipe(async->notify))
+     {
+        free(async);
+        return NULL;
+     }
+   fcntl(async->notify[0], F_SETFL, O_NONBLOCK);
+# ifdef HAVE_EXECVP
+   fcntl(async->notify[0], F_SETFD, FD_CLOEXEC);
+   fcntl(async->notify[1], F_SETFD, FD_CLOEXEC);
+# endif
+#endif
+
+   eina_lock_new(&async->lock);
+   eina_condition_new(&async->cond, &async->lock);
+
+#ifdef EINA_FILE_URING
+   async->uring = _eina_file_uring_new(depth, async->notify[0]);
+   if (async->uring) return async;
+   DBG("io_uring is not available, using threads.");
+#endif
+
+#ifdef EFL_HAVE_POSIX_THREADS
+   eina_threads_init();
+   for (i = 0; i < depth && i < EINA_FILE_ASYNC_THREADS_MAX; i++)
+     {
+        if (pthread_create(&async->threads[i], NULL,
+                           _eina_file_async_worker, async) != 0)
+          break;
+        async->threads_count++;
+     }
+   if (async->threads_count == 0)
+     eina_threads_shutdown();
+#endif
+
+   return async;
+}
+
+EAPI void
+eina_file_async_free(Eina_File_Async *async)
+{
+#ifdef EFL_HAVE_POSIX_THREADS
+   unsigned int i;
+#endif
+
+   if (!async) return;
+
+   eina_file_async_wait(async);
+
+#ifdef EINA_FILE_URING
+   if (async->uring) _eina_file_uring_free(async->uring);
+#endif
+
+#ifdef EFL_HAVE_POSIX_THREADS
+   if (async->threads_count)
+     {
+        eina_lock_take(&async->lock);
+        async->shutdown = EINA_TRUE;
+        eina_condition_broadcast(&async->cond);
+        eina_lock_release(&async->lock);
+
+        for (i = 0; i < async->threads_count; i++)
+          pthread_join(async->threads[i], NULL);
+
+        eina_threads_shutdown();
+     }
+#endif
+
+   eina_condition_free(&async->cond);
+   eina_lock_free(&async->lock);
+
+   close(async->notify[0]);
+   if (async->notify[1] != async->notify[0])
+     close(async->notify[1]);
+
+   free(async);
+}
+
+EAPI Eina_Bool
+eina_file_async_read(Eina_File_Async *async, Eina_File *file,
+                     unsigned long int offset, unsigned long int length,
+                     void *buffer, Eina_File_Async_Cb cb, const void *data)
+{
+   Eina_File_Async_Request *req;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(async, EINA_FALSE);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(file, EINA_FALSE);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(buffer, EINA_FALSE);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(cb, EINA_FALSE);
+
+   req = malloc(sizeof (Eina_File_Async_Request));
+   if (!req) return EINA_FALSE;
+
+   eina_lock_take(&file->lock);
+   file->refcount++;
+   eina_lock_release(&file->lock);
+
+   req->file = file;
+   req->cb = cb;
+   req->data = data;
+   req->buffer = buffer;
+   req->offset = offset;
+   req->length = length;
+   req->result = 0;
+
+   eina_lock_take(&async->lock);
+   async->outstanding++;
+   async->queued = eina_inlist_append(async->queued, EINA_INLIST_GET(req));
+
+#ifdef EINA_FILE_URING
+   if (async->uring)
+     {
+        _eina_file_uring_submit(async);
+        eina_lock_release(&async->lock);
+        return EINA_TRUE;
+     }
+#endif
+#ifdef EFL_HAVE_POSIX_THREADS
+   if (async->threads_count)
+     {
+        eina_condition_broadcast(&async->cond);
+        eina_lock_release(&async->lock);
+        return EINA_TRUE;
+     }
+#endif
+
+   /* no way to do it in the background, do it now */
+   async->queued = eina_inlist_remove(async->queued, EINA_INLIST_GET(req));
+   req->result = _eina_file_async_pread(req);
+   async->done = eina_inlist_append(async->done, EINA_INLIST_GET(req));
+   _eina_file_async_notify(async);
+   eina_lock_release(&async->lock);
+
+   return EINA_TRUE;
+}
+
+EAPI int
+eina_file_async_fd_get(const Eina_File_Async *async)
+{
+   EINA_SAFETY_ON_NULL_RETURN_VAL(async, -1);
+
+   return async->notify[0];
+}
+
+EAPI unsigned int
+eina_file_async_pending_get(const Eina_File_Async *async)
+{
+   EINA_SAFETY_ON_NULL_RETURN_VAL(async, 0);
+
+   return async->outstanding;
+}
+
+EAPI unsigned int
+eina_file_async_process(Eina_File_Async *async)
+{
+   Eina_Inlist *done;
+   unsigned int count = 0;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(async, 0);
+
+   _eina_file_async_notify_drain(async);
+
+   eina_lock_take(&async->lock);
+#ifdef EINA_FILE_URING
+   if (async->uring) _eina_file_uring_reap(async);
+#endif
+   done = async->done;
+   async->done = NULL;
+   eina_lock_release(&async->lock);
+
+   while (done)
+     {
+        Eina_File_Async_Request *req;
+
+        req = EINA_INLIST_CONTAINER_GET(done, Eina_File_Async_Request);
+        done = eina_inlist_remove(done, done);
+
+        req->cb((void *) req->data, req->file, req->buffer,
+                req->offset, req->result);
+        eina_file_close(req->file);
+        free(req);
+        count++;
+     }
+
+   eina_lock_take(&async->lock);
+   async->outstanding -= count;
+   eina_lock_release(&async->lock);
+
+   return count;
+}
+
+EAPI unsigned int
+eina_file_async_wait(Eina_File_Async *async)
+{
+   unsigned int count = 0;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(async, 0);
+
+   eina_lock_take(&async->lock);
+   while (async->outstanding > 0)
+     {
+        if (!async->done)
+          {
+#ifdef EINA_FILE_URING
+             if (async->uring)
+               {
+                  _eina_file_uring_enter(async->uring, EINA_TRUE);
+                  _eina_file_uring_reap(async);
+               }
+             else
+#endif
+               eina_condition_wait(&async->cond);
+             continue;
+          }
+        eina_lock_release(&async->lock);
+
+        count += eina_file_async_process(async);
+
+        eina_lock_take(&async->lock);
+     }
+   eina_lock_release(&async->lock);
+
+   return count;
+}
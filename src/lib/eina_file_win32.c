@@ -37,8 +37,10 @@ extern "C"
 void *alloca (size_t);
 #endif
 
+#include <errno.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
@@ -825,6 +827,42 @@ eina_file_dir_list(const char *dir,
    return EINA_TRUE;
 }
 
+EAPI Eina_Bool
+eina_file_dir_walk(const char *dir,
+                   unsigned int max_threads __UNUSED__,
+                   Eina_File_Walk_Filter_Cb filter,
+                   Eina_File_Walk_Filter_Cb prune,
+                   Eina_File_Walk_Batch_Cb cb,
+                   void *data)
+{
+   Eina_File_Direct_Info *info;
+   Eina_Iterator *it;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(cb,  EINA_FALSE);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(dir, EINA_FALSE);
+   EINA_SAFETY_ON_TRUE_RETURN_VAL(dir[0] == '\0', EINA_FALSE);
+
+   /* FIXME: walk serially, one entry per batch, until we have threads here */
+   it = eina_file_stat_ls(dir);
+   if (!it)
+      return EINA_FALSE;
+
+   EINA_ITERATOR_FOREACH(it, info)
+     {
+        const Eina_File_Direct_Info *infos[1] = { info };
+
+        if (!filter || filter(data, info))
+          cb(data, infos, 1);
+
+        if (info->type == EINA_FILE_DIR && !(prune && prune(data, info)))
+          eina_file_dir_walk(info->path, 1, filter, prune, cb, data);
+     }
+
+   eina_iterator_free(it);
+
+   return EINA_TRUE;
+}
+
 EAPI Eina_Array *
 eina_file_split(char *path)
 {
@@ -1083,6 +1121,19 @@ eina_file_open(const char *path, Eina_Bool shared)
    return NULL;
 }
 
+EAPI Eina_Bool
+eina_file_cache_watch_set(Eina_Bool watch)
+{
+   /* FIXME: could be done with ReadDirectoryChangesW() */
+   return !watch;
+}
+
+EAPI Eina_Bool
+eina_file_cache_watch_get(void)
+{
+   return EINA_FALSE;
+}
+
 EAPI void
 eina_file_close(Eina_File *file)
 {
@@ -1341,6 +1392,176 @@ eina_file_map_faulted(Eina_File *file, void *map)
    return EINA_FALSE;
 }
 
+EAPI Eina_Bool
+eina_file_transfer(Eina_File *file,
+                   unsigned long int offset, unsigned long int length,
+                   int fd)
+{
+   const char *map;
+   const char *p;
+   Eina_Bool r;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(file, EINA_FALSE);
+   EINA_SAFETY_ON_TRUE_RETURN_VAL(fd < 0, EINA_FALSE);
+
+   if (offset > file->length)
+     return EINA_FALSE;
+   if (length > file->length - offset)
+     return EINA_FALSE;
+   if (length == 0)
+     return EINA_TRUE;
+
+   /* FIXME: TransmitFile() could be used for sockets */
+   map = eina_file_map_all(file, EINA_FILE_SEQUENTIAL);
+   if (!map) return EINA_FALSE;
+
+   for (p = map + offset; length > 0; )
+     {
+        int n;
+
+        n = write(fd, p, length > 0x7ffff000 ? 0x7ffff000 : length);
+        if (n <= 0) break;
+        p += n;
+        length -= n;
+     }
+
+   r = (length == 0);
+   eina_file_map_free(file, (void *) map);
+
+   return r;
+}
+
+/* FIXME: overlapped ReadFile() and an IO completion port would make this
+ * really asynchronous, for now the reads are done in eina_file_async_read()
+ * and only the callbacks are deferred. */
+typedef struct _Eina_File_Async_Request Eina_File_Async_Request;
+struct _Eina_File_Async_Request
+{
+   Eina_File *file;
+   Eina_File_Async_Cb cb;
+   const void *data;
+   void *buffer;
+   unsigned long int offset;
+   long int result;
+};
+
+struct _Eina_File_Async
+{
+   Eina_List *done;
+};
+
+EAPI Eina_File_Async *
+eina_file_async_new(unsigned int depth __UNUSED__)
+{
+   return calloc(1, sizeof (Eina_File_Async));
+}
+
+EAPI void
+eina_file_async_free(Eina_File_Async *async)
+{
+   if (!async) return;
+
+   eina_file_async_wait(async);
+   free(async);
+}
+
+EAPI Eina_Bool
+eina_file_async_read(Eina_File_Async *async, Eina_File *file,
+                     unsigned long int offset, unsigned long int length,
+                     void *buffer, Eina_File_Async_Cb cb, const void *data)
+{
+   Eina_File_Async_Request *req;
+   const char *map;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(async, EINA_FALSE);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(file, EINA_FALSE);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(buffer, EINA_FALSE);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(cb, EINA_FALSE);
+
+   req = malloc(sizeof (Eina_File_Async_Request));
+   if (!req) return EINA_FALSE;
+
+   eina_lock_take(&file->lock);
+   file->refcount++;
+   eina_lock_release(&file->lock);
+
+   req->file = file;
+   req->cb = cb;
+   req->data = data;
+   req->buffer = buffer;
+   req->offset = offset;
+   req->result = 0;
+
+   if (offset < file->length)
+     {
+        if (length > file->length - offset)
+          length = file->length - offset;
+
+        map = eina_file_map_all(file, EINA_FILE_SEQUENTIAL);
+        if (map)
+          {
+             memcpy(buffer, map + offset, length);
+             req->result = length;
+             eina_file_map_free(file, (void *) map);
+          }
+        else
+          req->result = -EIO;
+     }
+
+   async->done = eina_list_append(async->done, req);
+   return EINA_TRUE;
+}
+
+EAPI int
+eina_file_async_fd_get(const Eina_File_Async *async __UNUSED__)
+{
+   return -1;
+}
+
+EAPI unsigned int
+eina_file_async_pending_get(const Eina_File_Async *async)
+{
+   EINA_SAFETY_ON_NULL_RETURN_VAL(async, 0);
+
+   return eina_list_count(async->done);
+}
+
+EAPI unsigned int
+eina_file_async_process(Eina_File_Async *async)
+{
+   Eina_File_Async_Request *req;
+   Eina_List *done;
+   unsigned int count = 0;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(async, 0);
+
+   done = async->done;
+   async->done = NULL;
+   EINA_LIST_FREE(done, req)
+     {
+        req->cb((void *) req->data, req->file, req->buffer,
+                req->offset, req->result);
+        eina_file_close(req->file);
+        free(req);
+        count++;
+     }
+
+   return count;
+}
+
+EAPI unsigned int
+eina_file_async_wait(Eina_File_Async *async)
+{
+   unsigned int count = 0;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(async, 0);
+
+   while (async->done)
+     count += eina_file_async_process(async);
+
+   return count;
+}
+
 EAPI int
 eina_file_statat(void *container __UNUSED__, Eina_File_Direct_Info *info, Eina_Stat *st)
 {
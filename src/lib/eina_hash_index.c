@@ -0,0 +1,451 @@
+/* EINA - EFL data type library
+ * Copyright (C) 2012 Enlightenment Project
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef HAVE_STDINT_H
+# include <stdint.h>
+#endif
+
+#ifdef HAVE_EVIL
+# include <Evil.h>
+#endif
+
+#include "eina_config.h"
+#include "eina_private.h"
+
+/* undefs EINA_ARG_NONULL() so NULL checks are not compiled out! */
+#include "eina_safety_checks.h"
+#include "eina_binbuf.h"
+#include "eina_inarray.h"
+#include "eina_hash_index.h"
+
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+
+/**
+ * @cond LOCAL
+ */
+
+/*
+ * File layout, all integers in the byte order of the writer:
+ *
+ *   header     Eina_Hash_Index_Header
+ *   slots      slots_count Eina_Hash_Index_Slot, open addressing with
+ *              linear probing, slots_count is a power of 2
+ *   entries    for each key: key_length, value_length (uint32), the key,
+ *              padding to 8, the value, padding to 8
+ *
+ * A slot points to its entry in 8 bytes units from the start of the file,
+ * 0 marks an empty slot as the header lives there.
+ */
+
+#define EINA_HASH_INDEX_MAGIC "EiHx"
+#define EINA_HASH_INDEX_BYTE_ORDER 0x01020304
+#define EINA_HASH_INDEX_VERSION 1
+#define EINA_HASH_INDEX_ALIGN(Size) (((Size) + 7) & ~((size_t) 7))
+
+typedef struct _Eina_Hash_Index_Header Eina_Hash_Index_Header;
+typedef struct _Eina_Hash_Index_Slot Eina_Hash_Index_Slot;
+typedef struct _Eina_Hash_Index_Entry Eina_Hash_Index_Entry;
+
+struct _Eina_Hash_Index_Header
+{
+   char magic[4];
+   uint32_t byte_order;
+   uint32_t version;
+   uint32_t count;
+   uint32_t slots_count;
+   uint32_t reserved[3];
+};
+
+struct _Eina_Hash_Index_Slot
+{
+   uint32_t hash;
+   uint32_t entry;
+};
+
+struct _Eina_Hash_Index_Entry
+{
+   uint32_t key_length;
+   uint32_t value_length;
+};
+
+struct _Eina_Hash_Index
+{
+   Eina_File *file;
+   const unsigned char *map;
+   size_t size;
+
+   const Eina_Hash_Index_Header *header;
+   const Eina_Hash_Index_Slot *slots;
+   uint32_t mask;
+};
+
+static uint32_t
+_eina_hash_index_hash(const void *key, unsigned int key_length)
+{
+   if (key_length == 0) return 0;
+   return (uint32_t) eina_hash_superfast(key, key_length);
+}
+
+/* Return the entry at unit, or NULL if it does not fit in the file. */
+static const Eina_Hash_Index_Entry *
+_eina_hash_index_entry_get(const unsigned char *map, size_t size, uint32_t unit)
+{
+   const Eina_Hash_Index_Entry *entry;
+   size_t offset = (size_t) unit * 8;
+
+   if (offset + sizeof (Eina_Hash_Index_Entry) > size) return NULL;
+   entry = (const Eina_Hash_Index_Entry *)(map + offset);
+
+   offset += sizeof (Eina_Hash_Index_Entry);
+   if (entry->key_length > size - offset) return NULL;
+   offset += EINA_HASH_INDEX_ALIGN(entry->key_length);
+   if (offset > size || entry->value_length > size - offset) return NULL;
+
+   return entry;
+}
+
+static const unsigned char *
+_eina_hash_index_entry_key(const Eina_Hash_Index_Entry *entry)
+{
+   return (const unsigned char *)(entry + 1);
+}
+
+static const unsigned char *
+_eina_hash_index_entry_value(const Eina_Hash_Index_Entry *entry)
+{
+   return _eina_hash_index_entry_key(entry) + EINA_HASH_INDEX_ALIGN(entry->key_length);
+}
+
+static Eina_Bool
+_eina_hash_index_write_all(int fd, const void *data, size_t length)
+{
+   const char *p = data;
+
+   while (length > 0)
+     {
+        ssize_t n;
+
+        n = write(fd, p, length);
+        if (n <= 0) return EINA_FALSE;
+        p += n;
+        length -= n;
+     }
+
+   return EINA_TRUE;
+}
+
+/**
+ * @endcond
+ */
+
+/*============================================================================*
+ *                                   API                                      *
+ *============================================================================*/
+
+EAPI Eina_Bool
+eina_hash_index_write(const char *filename, Eina_Iterator *tuples,
+                      Eina_Hash_Index_Value_Cb cb, const void *data)
+{
+   static const unsigned char padding[8] = { 0 };
+   Eina_Hash_Index_Header header;
+   Eina_Hash_Index_Slot *slots = NULL;
+   Eina_Hash_Index_Slot *item;
+   Eina_Hash_Tuple *tuple;
+   Eina_Inarray *items;
+   Eina_Binbuf *entries;
+   const unsigned char *base;
+   size_t data_offset;
+   uint32_t slots_count;
+   uint32_t count = 0;
+   Eina_Bool r = EINA_FALSE;
+   char *tmp;
+   int fd = -1;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(filename, EINA_FALSE);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(tuples, EINA_FALSE);
+
+   items = eina_inarray_new(sizeof (Eina_Hash_Index_Slot), 0);
+   entries = eina_binbuf_new();
+   tmp = malloc(strlen(filename) + 8);
+   if (!items || !entries || !tmp) goto on_error;
+
+   /* serialize every entry, slot.entry being relative to the entries for now */
+   EINA_ITERATOR_FOREACH(tuples, tuple)
+     {
+        Eina_Hash_Index_Entry entry;
+        Eina_Hash_Index_Slot slot;
+        const void *value;
+        unsigned int length;
+        size_t offset;
+
+        if (cb)
+          value = cb((void *) data, tuple, &length);
+        else
+          {
+             value = tuple->data;
+             length = value ? strlen(value) + 1 : 0;
+          }
+        if (!value) length = 0;
+
+        offset = eina_binbuf_length_get(entries);
+        if ((offset / 8) >= 0xffffffff) goto on_error;
+
+        slot.hash = _eina_hash_index_hash(tuple->key, tuple->key_length);
+        slot.entry = offset / 8;
+        if (eina_inarray_push(items, &slot) < 0) goto on_error;
+
+        entry.key_length = tuple->key_length;
+        entry.value_length = length;
+        if (!eina_binbuf_append_length(entries, (const unsigned char *) &entry, sizeof (entry)))
+          goto on_error;
+        if (tuple->key_length &&
+            !eina_binbuf_append_length(entries, tuple->key, tuple->key_length))
+          goto on_error;
+        if (!eina_binbuf_append_length(entries, padding,
+                                       EINA_HASH_INDEX_ALIGN(tuple->key_length) - tuple->key_length))
+          goto on_error;
+        if (length && !eina_binbuf_append_length(entries, value, length))
+          goto on_error;
+        if (!eina_binbuf_append_length(entries, padding,
+                                       EINA_HASH_INDEX_ALIGN(length) - length))
+          goto on_error;
+     }
+
+   /* keep the load factor under 1/2 */
+   for (slots_count = 2; slots_count < eina_inarray_count(items) * 2; slots_count <<= 1)
+     if (slots_count >= 0x40000000) goto on_error;
+
+   slots = calloc(slots_count, sizeof (Eina_Hash_Index_Slot));
+   if (!slots) goto on_error;
+
+   data_offset = sizeof (Eina_Hash_Index_Header) + slots_count * sizeof (Eina_Hash_Index_Slot);
+   if ((data_offset + eina_binbuf_length_get(entries)) / 8 >= 0xffffffff)
+     goto on_error;
+
+   base = eina_binbuf_string_get(entries);
+   EINA_INARRAY_FOREACH(items, item)
+     {
+        const Eina_Hash_Index_Entry *entry;
+        uint32_t i;
+
+        entry = (const Eina_Hash_Index_Entry *)(base + (size_t) item->entry * 8);
+        for (i = item->hash & (slots_count - 1); slots[i].entry;
+             i = (i + 1) & (slots_count - 1))
+          {
+             const Eina_Hash_Index_Entry *other;
+
+             if (slots[i].hash != item->hash) continue;
+
+             other = (const Eina_Hash_Index_Entry *)
+               (base + (size_t) slots[i].entry * 8 - data_offset);
+             if (other->key_length == entry->key_length &&
+                 !memcmp(_eina_hash_index_entry_key(other),
+                         _eina_hash_index_entry_key(entry),
+                         entry->key_length))
+               break;
+          }
+
+        if (!slots[i].entry) count++;
+        slots[i].hash = item->hash;
+        slots[i].entry = item->entry + data_offset / 8;
+     }
+
+   memset(&header, 0, sizeof (header));
+   memcpy(header.magic, EINA_HASH_INDEX_MAGIC, sizeof (header.magic));
+   header.byte_order = EINA_HASH_INDEX_BYTE_ORDER;
+   header.version = EINA_HASH_INDEX_VERSION;
+   header.count = count;
+   header.slots_count = slots_count;
+
+   /* write aside and rename, never truncate a file someone may have mapped */
+   sprintf(tmp, "%s.XXXXXX", filename);
+   fd = mkstemp(tmp);
+   if (fd < 0) goto on_error;
+
+#ifndef _WIN32
+   /* mkstemp() creates the file 0600, the index is meant to be shared */
+   {
+      mode_t mask;
+
+      mask = umask(0);
+      umask(mask);
+      if (fchmod(fd, 0644 & ~mask))
+        {
+           close(fd);
+           unlink(tmp);
+           goto on_error;
+        }
+   }
+#endif
+
+   if (!_eina_hash_index_write_all(fd, &header, sizeof (header)) ||
+       !_eina_hash_index_write_all(fd, slots, slots_count * sizeof (Eina_Hash_Index_Slot)) ||
+       !_eina_hash_index_write_all(fd, base, eina_binbuf_length_get(entries)))
+     {
+        close(fd);
+        unlink(tmp);
+        goto on_error;
+     }
+   close(fd);
+
+#ifdef _WIN32
+   unlink(filename);
+#endif
+   if (rename(tmp, filename))
+     {
+        unlink(tmp);
+        goto on_error;
+     }
+
+   r = EINA_TRUE;
+
+ on_error:
+   free(slots);
+   free(tmp);
+   if (entries) eina_binbuf_free(entries);
+   if (items) eina_inarray_free(items);
+   return r;
+}
+
+EAPI Eina_Bool
+eina_hash_index_hash_write(const char *filename, const Eina_Hash *hash,
+                           Eina_Hash_Index_Value_Cb cb, const void *data)
+{
+   Eina_Iterator *it;
+   Eina_Bool r;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(filename, EINA_FALSE);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(hash, EINA_FALSE);
+
+   it = eina_hash_iterator_tuple_new(hash);
+   if (!it) return EINA_FALSE;
+
+   r = eina_hash_index_write(filename, it, cb, data);
+   eina_iterator_free(it);
+
+   return r;
+}
+
+EAPI Eina_Hash_Index *
+eina_hash_index_open(Eina_File *file)
+{
+   const Eina_Hash_Index_Header *header;
+   Eina_Hash_Index *idx;
+   const unsigned char *map;
+   size_t size;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(file, NULL);
+
+   size = eina_file_size_get(file);
+   if (size < sizeof (Eina_Hash_Index_Header)) return NULL;
+
+   map = eina_file_map_all(file, EINA_FILE_RANDOM);
+   if (!map) return NULL;
+
+   header = (const Eina_Hash_Index_Header *) map;
+   if (memcmp(header->magic, EINA_HASH_INDEX_MAGIC, sizeof (header->magic)) ||
+       header->byte_order != EINA_HASH_INDEX_BYTE_ORDER ||
+       header->version != EINA_HASH_INDEX_VERSION ||
+       header->slots_count == 0 ||
+       (header->slots_count & (header->slots_count - 1)) ||
+       header->slots_count > (size - sizeof (Eina_Hash_Index_Header)) / sizeof (Eina_Hash_Index_Slot))
+     goto on_error;
+
+   idx = malloc(sizeof (Eina_Hash_Index));
+   if (!idx) goto on_error;
+
+   idx->file = file;
+   idx->map = map;
+   idx->size = size;
+   idx->header = header;
+   idx->slots = (const Eina_Hash_Index_Slot *)(header + 1);
+   idx->mask = header->slots_count - 1;
+
+   return idx;
+
+ on_error:
+   eina_file_map_free(file, (void *) map);
+   return NULL;
+}
+
+EAPI void
+eina_hash_index_close(Eina_Hash_Index *idx)
+{
+   if (!idx) return;
+
+   eina_file_map_free(idx->file, (void *) idx->map);
+   free(idx);
+}
+
+EAPI const void *
+eina_hash_index_find(const Eina_Hash_Index *idx,
+                     const void *key, unsigned int key_length,
+                     unsigned int *length)
+{
+   uint32_t hash;
+   uint32_t i;
+   uint32_t n;
+
+   if (length) *length = 0;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(idx, NULL);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(key, NULL);
+
+   hash = _eina_hash_index_hash(key, key_length);
+   for (i = hash & idx->mask, n = 0;
+        n <= idx->mask && idx->slots[i].entry;
+        i = (i + 1) & idx->mask, n++)
+     {
+        const Eina_Hash_Index_Entry *entry;
+
+        if (idx->slots[i].hash != hash) continue;
+
+        entry = _eina_hash_index_entry_get(idx->map, idx->size, idx->slots[i].entry);
+        if (!entry) return NULL;
+
+        if (entry->key_length != key_length ||
+            memcmp(_eina_hash_index_entry_key(entry), key, key_length))
+          continue;
+
+        if (length) *length = entry->value_length;
+        return _eina_hash_index_entry_value(entry);
+     }
+
+   return NULL;
+}
+
+EAPI unsigned int
+eina_hash_index_count(const Eina_Hash_Index *idx)
+{
+   EINA_SAFETY_ON_NULL_RETURN_VAL(idx, 0);
+
+   return idx->header->count;
+}
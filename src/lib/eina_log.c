@@ -27,6 +27,7 @@
 #include <fnmatch.h>
 #include <assert.h>
 #include <errno.h>
+#include <limits.h>
 
 #if defined HAVE_EXECINFO_H && defined HAVE_BACKTRACE && defined HAVE_BACKTRACE_SYMBOLS
 # include <execinfo.h>
@@ -37,6 +38,19 @@
 # include <unistd.h>
 #endif
 
+#include <fcntl.h>
+#include <stddef.h>
+#include <time.h>
+#include <sys/time.h>
+
+#ifdef HAVE_STDINT_H
+# include <stdint.h>
+#endif
+
+#ifdef HAVE_SYS_MMAN_H
+# include <sys/mman.h>
+#endif
+
 #ifdef EFL_HAVE_POSIX_THREADS
 # include <pthread.h>
 #endif
@@ -48,6 +62,10 @@
 #include "eina_config.h"
 #include "eina_private.h"
 #include "eina_inlist.h"
+#include "eina_inarray.h"
+#include "eina_hash.h"
+#include "eina_strbuf.h"
+#include "eina_file.h"
 
 /* undefs EINA_ARG_NONULL() so NULL checks are not compiled out! */
 #include "eina_safety_checks.h"
@@ -76,6 +94,8 @@
 #define EINA_LOG_ENV_FILE_DISABLE "EINA_LOG_FILE_DISABLE"
 #define EINA_LOG_ENV_FUNCTION_DISABLE "EINA_LOG_FUNCTION_DISABLE"
 #define EINA_LOG_ENV_BACKTRACE "EINA_LOG_BACKTRACE"
+#define EINA_LOG_ENV_ASYNC "EINA_LOG_ASYNC"
+#define EINA_LOG_ENV_SITES "EINA_LOG_SITES"
 
 #ifdef EINA_ENABLE_LOG
 
@@ -86,6 +106,9 @@ struct _Eina_Log_Domain_Level_Pending
 {
    EINA_INLIST;
    unsigned int level;
+   unsigned int sampling;
+   unsigned int rate_burst;
+   double rate_interval;
    size_t namelen;
    char name[];
 };
@@ -221,6 +244,114 @@ static HANDLE _log_mutex = NULL;
 
 #endif /* ! EFL_HAVE_THREADS */
 
+#if defined(EFL_HAVE_POSIX_THREADS) && defined(__ATOMIC_ACQUIRE)
+# define EINA_LOG_ASYNC 1
+#endif
+
+#ifdef EINA_LOG_ASYNC
+/* Size of the ring buffer of each thread, must be a power of 2. */
+# define EINA_LOG_ASYNC_RING_SIZE (64 * 1024)
+/* Longest message the async thread will print, longer ones are truncated. */
+# define EINA_LOG_ASYNC_MESSAGE_MAX (EINA_LOG_ASYNC_RING_SIZE / 4)
+
+typedef struct _Eina_Log_Async_Ring Eina_Log_Async_Ring;
+typedef struct _Eina_Log_Async_Record Eina_Log_Async_Record;
+
+/*
+ * One producer (the thread owning it) and one consumer (the async thread).
+ * head and tail are free running counters, only the producer writes tail
+ * and only the consumer writes head.
+ */
+struct _Eina_Log_Async_Ring
+{
+   EINA_INLIST;
+
+   unsigned int head;
+   unsigned int tail;
+   unsigned int dropped;
+   Eina_Bool dead;
+
+   /* records hold pointers, keep them aligned */
+   union {
+      char buffer[EINA_LOG_ASYNC_RING_SIZE];
+      void *align_ptr;
+      long long align_ll;
+      double align_d;
+   } u;
+};
+
+/* size == 0 means the record does not fit before the end, go back to 0. */
+struct _Eina_Log_Async_Record
+{
+   unsigned int size;
+   int domain;
+   int level;
+   int line;
+   const char *file;
+   const char *fnc;
+   pthread_t thread;
+};
+
+# define EINA_LOG_ASYNC_ALIGN(Size) (((Size) + 7) & ~((unsigned int) 7))
+
+static Eina_Bool _log_async = EINA_FALSE;
+static pthread_t _log_async_thread;
+static pthread_key_t _log_async_key;
+static Eina_Bool _log_async_key_created = EINA_FALSE;
+static pthread_mutex_t _log_async_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t _log_async_cond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t _log_async_flushed = PTHREAD_COND_INITIALIZER;
+/* Protected by _log_async_mutex. */
+static Eina_Inlist *_log_async_rings = NULL;
+static unsigned int _log_async_flush_request = 0;
+static unsigned int _log_async_flush_done = 0;
+static Eina_Bool _log_async_quit = EINA_FALSE;
+/* Set by the async thread before sleeping, producers only wake it then. */
+static int _log_async_sleeping = 0;
+
+/* Thread the record being printed by the async thread comes from. */
+static pthread_t _log_async_origin;
+static Eina_Bool _log_async_printing = EINA_FALSE;
+# define LOG_SELF() (_log_async_printing ? _log_async_origin : SELF())
+
+/*
+ * Serializes the calls to the print callback and guards the layout of
+ * _log_domains, so the async thread prints without the log lock. Always
+ * taken after the log lock.
+ */
+static pthread_mutex_t _log_print_mutex = PTHREAD_MUTEX_INITIALIZER;
+# define LOG_PRINT_LOCK() \
+   if (_threads_enabled) {pthread_mutex_lock(&_log_print_mutex); }
+# define LOG_PRINT_UNLOCK() \
+   if (_threads_enabled) {pthread_mutex_unlock(&_log_print_mutex); }
+#else
+# define LOG_PRINT_LOCK() do {} while (0)
+# define LOG_PRINT_UNLOCK() do {} while (0)
+# ifdef EFL_HAVE_THREADS
+#  define LOG_SELF() SELF()
+# endif
+#endif
+
+/* Per thread buffer lines are formatted into, see Eina_Log_Out. */
+typedef struct _Eina_Log_Line Eina_Log_Line;
+struct _Eina_Log_Line
+{
+   char *buf;
+   size_t size;
+};
+
+/* Lines longer than this do not keep their buffer around. */
+#define EINA_LOG_LINE_KEEP_MAX (16 * 1024)
+
+#ifdef EFL_HAVE_POSIX_THREADS
+static pthread_key_t _log_line_key;
+static pthread_once_t _log_line_once = PTHREAD_ONCE_INIT;
+static Eina_Bool _log_line_key_created = EINA_FALSE;
+#else
+/* callbacks are called with the log lock held */
+static Eina_Log_Line _log_line = { NULL, 0 };
+#endif
+
 
 // List of domains registered
 static Eina_Log_Domain *_log_domains = NULL;
@@ -239,6 +370,155 @@ static Eina_Log_Level _log_level = EINA_LOG_LEVEL_CRITICAL;
 static Eina_Log_Level _log_level = EINA_LOG_LEVEL_ERR;
 #endif
 
+/*
+ * Call sites registered with eina_log_sites_register(), and the patterns
+ * of EINA_LOG_SITES applied to each new range.
+ */
+typedef struct _Eina_Log_Site_Range Eina_Log_Site_Range;
+struct _Eina_Log_Site_Range
+{
+   EINA_INLIST;
+   Eina_Log_Site *start;
+   Eina_Log_Site *stop;
+};
+
+static Eina_Inlist *_log_site_ranges = NULL;
+static char *_log_site_patterns = NULL;
+
+/* invalidate the state cached by the call sites */
+#ifdef __ATOMIC_ACQUIRE
+# define LOG_SITES_CHANGED() \
+   __atomic_add_fetch(&_eina_log_site_generation, 1, __ATOMIC_RELEASE)
+#else
+# define LOG_SITES_CHANGED() (_eina_log_site_generation++)
+#endif
+
+/*
+ * What logging reads of a domain without the log lock, as
+ * eina_log_domain_register() may realloc _log_domains meanwhile. Written
+ * with the log lock held, in chunks that are never moved and only freed
+ * by eina_log_shutdown(). Free slots have an EINA_LOG_LEVEL_UNKNOWN level.
+ */
+#define EINA_LOG_SLOTS_CHUNK 64
+#define EINA_LOG_SLOTS_CHUNKS 1024
+
+typedef struct _Eina_Log_Domain_Slot Eina_Log_Domain_Slot;
+struct _Eina_Log_Domain_Slot
+{
+   int level;
+   unsigned int sampling;
+   unsigned int rate_burst;
+   unsigned int rate_interval; /* milliseconds, 0 for none */
+   unsigned int suppressed; /* messages dropped by sampling or rate limit */
+};
+
+static Eina_Log_Domain_Slot *_log_domain_slots[EINA_LOG_SLOTS_CHUNKS];
+
+#ifdef __ATOMIC_ACQUIRE
+# define LOG_ATOMIC_LOAD(Ptr) __atomic_load_n(Ptr, __ATOMIC_ACQUIRE)
+# define LOG_ATOMIC_STORE(Ptr, Value) \
+   __atomic_store_n(Ptr, Value, __ATOMIC_RELEASE)
+#else
+# define LOG_ATOMIC_LOAD(Ptr) (*(Ptr))
+# define LOG_ATOMIC_STORE(Ptr, Value) (*(Ptr) = (Value))
+#endif
+
+/* Returns NULL if the slot of domain was never written. */
+static inline Eina_Log_Domain_Slot *
+eina_log_domain_slot_get(int domain)
+{
+   Eina_Log_Domain_Slot *chunk;
+
+   if (EINA_UNLIKELY((unsigned int)domain >=
+                     EINA_LOG_SLOTS_CHUNK * EINA_LOG_SLOTS_CHUNKS))
+      return NULL;
+
+   chunk = LOG_ATOMIC_LOAD(&_log_domain_slots[domain / EINA_LOG_SLOTS_CHUNK]);
+   if (EINA_UNLIKELY(!chunk))
+      return NULL;
+
+   return chunk + domain % EINA_LOG_SLOTS_CHUNK;
+}
+
+/*
+ * Copies _log_domains[domain] to its slot, with the log lock held.
+ * Returns EINA_FALSE if there is no room for the slot.
+ */
+static Eina_Bool
+eina_log_domain_slot_update(int domain)
+{
+   Eina_Log_Domain_Slot **chunk;
+   Eina_Log_Domain_Slot *slot;
+   const Eina_Log_Domain *d;
+   double interval;
+   unsigned int ms;
+   int i;
+
+   if ((unsigned int)domain >= EINA_LOG_SLOTS_CHUNK * EINA_LOG_SLOTS_CHUNKS)
+      return EINA_FALSE;
+
+   chunk = &_log_domain_slots[domain / EINA_LOG_SLOTS_CHUNK];
+   if (!*chunk)
+     {
+        slot = calloc(EINA_LOG_SLOTS_CHUNK, sizeof(Eina_Log_Domain_Slot));
+        if (!slot)
+           return EINA_FALSE;
+
+        for (i = 0; i < EINA_LOG_SLOTS_CHUNK; i++)
+           slot[i].level = EINA_LOG_LEVEL_UNKNOWN;
+        LOG_ATOMIC_STORE(chunk, slot);
+     }
+
+   slot = *chunk + domain % EINA_LOG_SLOTS_CHUNK;
+   if (((unsigned int)domain >= _log_domains_count) ||
+       (_log_domains[domain].deleted))
+     {
+        LOG_ATOMIC_STORE(&slot->level, EINA_LOG_LEVEL_UNKNOWN);
+        return EINA_TRUE;
+     }
+
+   d = _log_domains + domain;
+   interval = d->rate_interval * 1000.0;
+   if (interval <= 0.0)
+      ms = 0;
+   else if (interval >= (double)UINT_MAX)
+      ms = UINT_MAX;
+   else
+     {
+        // round up, a small interval is still a limit
+        ms = (unsigned int)interval;
+        if (ms < interval)
+           ms++;
+     }
+
+   LOG_ATOMIC_STORE(&slot->sampling, d->sampling);
+   LOG_ATOMIC_STORE(&slot->rate_burst, d->rate_burst);
+   LOG_ATOMIC_STORE(&slot->rate_interval, ms);
+   LOG_ATOMIC_STORE(&slot->level, d->level);
+   return EINA_TRUE;
+}
+
+/*
+ * Counters of the call sites of the domains with a sampling or a rate
+ * limit, keyed on file, line and domain. Entries are claimed once and
+ * never released, without locks: when the table is full, sites are not
+ * limited anymore.
+ */
+#define EINA_LOG_LIMIT_SITES 1024
+#define EINA_LOG_LIMIT_PROBES 8
+
+typedef struct _Eina_Log_Limit_Site Eina_Log_Limit_Site;
+struct _Eina_Log_Limit_Site
+{
+   uintptr_t key; /* 0 when free */
+   unsigned int sampled; /* messages seen, for sampling */
+   unsigned int window; /* rate limit period count is about */
+   unsigned int count; /* messages printed in window */
+   unsigned int suppressed; /* messages dropped since the last print */
+};
+
+static Eina_Log_Limit_Site _log_limit_sites[EINA_LOG_LIMIT_SITES];
+
 /* NOTE: if you change this, also change:
  *   eina_log_print_level_name_get()
  *   eina_log_print_level_name_color_get()
@@ -414,9 +694,233 @@ eina_log_print_level_name_color_get(int level,
    eina_log_print_level_name_color_get(level, &name, &color)
 #endif
 
+/*
+ * A line being printed. The prefix and the message are formatted in a
+ * per thread buffer and written at once, instead of a stdio call for
+ * each piece taking the FILE lock and maybe writing. The win32 console
+ * needs its attributes changed between the pieces, for colors, so then
+ * buf is NULL and everything goes directly to fp.
+ */
+typedef struct _Eina_Log_Out Eina_Log_Out;
+struct _Eina_Log_Out
+{
+   FILE *fp;
+   Eina_Log_Line *line;
+   char *buf;
+   size_t size;
+   size_t len;
+};
+
+#ifdef EFL_HAVE_POSIX_THREADS
+static void
+eina_log_line_del(void *data)
+{
+   Eina_Log_Line *line = data;
+
+   free(line->buf);
+   free(line);
+}
+
+static void
+eina_log_line_key_create(void)
+{
+   if (!pthread_key_create(&_log_line_key, eina_log_line_del))
+      _log_line_key_created = EINA_TRUE;
+}
+#endif
+
+static Eina_Log_Line *
+eina_log_line_get(void)
+{
+#ifdef EFL_HAVE_POSIX_THREADS
+   Eina_Log_Line *line;
+
+   pthread_once(&_log_line_once, eina_log_line_key_create);
+   if (!_log_line_key_created)
+      return NULL;
+
+   line = pthread_getspecific(_log_line_key);
+   if (line)
+      return line;
+
+   line = calloc(1, sizeof(Eina_Log_Line));
+   if (!line)
+      return NULL;
+   if (pthread_setspecific(_log_line_key, line))
+     {
+        free(line);
+        return NULL;
+     }
+   return line;
+#else
+   return &_log_line;
+#endif
+}
+
+static void
+eina_log_out_begin(Eina_Log_Out *out, FILE *fp, Eina_Bool console)
+{
+   out->fp = fp;
+   out->line = NULL;
+   out->buf = NULL;
+   out->size = 0;
+   out->len = 0;
+
+#if defined(_WIN32) && !defined(_WIN32_WCE)
+   if (console && !_disable_color)
+      return;
+#else
+   (void) console;
+#endif
+
+   out->line = eina_log_line_get();
+   if (!out->line)
+      return;
+
+   if (!out->line->buf)
+     {
+        out->line->buf = malloc(512);
+        if (!out->line->buf)
+          {
+             out->line = NULL;
+             return;
+          }
+        out->line->size = 512;
+     }
+   out->buf = out->line->buf;
+   out->size = out->line->size;
+}
+
+/* Room for at least length more bytes, plus the newline and the nul. */
+static Eina_Bool
+eina_log_out_grow(Eina_Log_Out *out, size_t length)
+{
+   size_t size;
+   char *tmp;
+
+   size = out->size;
+   while (size < out->len + length + 2)
+      size *= 2;
+   if (size == out->size)
+      return EINA_TRUE;
+
+   tmp = realloc(out->buf, size);
+   if (!tmp)
+      return EINA_FALSE;
+
+   out->buf = out->line->buf = tmp;
+   out->size = out->line->size = size;
+   return EINA_TRUE;
+}
+
+static void
+eina_log_out_vprintf(Eina_Log_Out *out, const char *fmt, va_list args)
+{
+   va_list copy;
+   int n;
+
+   if (!out->buf)
+     {
+        vfprintf(out->fp, fmt, args);
+        return;
+     }
+
+   // keep a byte for the newline
+   va_copy(copy, args);
+   n = vsnprintf(out->buf + out->len, out->size - out->len - 1, fmt, copy);
+   va_end(copy);
+   if (n < 0)
+      return;
+
+   if ((size_t)n >= out->size - out->len - 1)
+     {
+        if (!eina_log_out_grow(out, n))
+          {
+             out->len = out->size - 2;
+             return;
+          }
+        vsnprintf(out->buf + out->len, out->size - out->len - 1, fmt, args);
+     }
+   out->len += n;
+}
+
+static void
+eina_log_out_printf(Eina_Log_Out *out, const char *fmt, ...) EINA_PRINTF(2, 3);
+
+static void
+eina_log_out_printf(Eina_Log_Out *out, const char *fmt, ...)
+{
+   va_list args;
+
+   va_start(args, fmt);
+   eina_log_out_vprintf(out, fmt, args);
+   va_end(args);
+}
+
+static Eina_Bool
+eina_log_write_all(int fd, const char *buf, size_t len)
+{
+   while (len > 0)
+     {
+        ssize_t n;
+
+        n = write(fd, buf, len);
+        if (n < 0)
+          {
+             if (errno == EINTR)
+                continue;
+             return EINA_FALSE;
+          }
+        buf += n;
+        len -= n;
+     }
+   return EINA_TRUE;
+}
+
+/* Do not keep a large buffer for each thread after a long line. */
+static void
+eina_log_out_release(Eina_Log_Out *out)
+{
+   if (out->size <= EINA_LOG_LINE_KEEP_MAX)
+      return;
+
+   free(out->line->buf);
+   out->line->buf = NULL;
+   out->line->size = 0;
+}
+
+/* Terminate the line and write it. */
+static void
+eina_log_out_end(Eina_Log_Out *out)
+{
+   int fd;
+
+   if (!out->buf)
+     {
+        putc('\n', out->fp);
+        return;
+     }
+
+   out->buf[out->len++] = '\n';
+
+   fd = fileno(out->fp);
+   if (fd < 0)
+      fwrite(out->buf, 1, out->len, out->fp);
+   else
+     {
+        // keep the order with what was printed with stdio, stderr is
+        // not buffered so there is nothing to flush
+        if (out->fp != stderr)
+           fflush(out->fp);
+        eina_log_write_all(fd, out->buf, out->len);
+     }
+
+   eina_log_out_release(out);
+}
+
 /** No threads, No color */
 static void
-eina_log_print_prefix_NOthreads_NOcolor_file_func(FILE *fp,
+eina_log_print_prefix_NOthreads_NOcolor_file_func(Eina_Log_Out *out,
                                                   const Eina_Log_Domain *d,
                                                   Eina_Log_Level level,
                                                   const char *file,
@@ -424,12 +928,12 @@ eina_log_print_prefix_NOthreads_NOcolor_file_func(FILE *fp,
                                                   int line)
 {
    DECLARE_LEVEL_NAME(level);
-   fprintf(fp, "%s<%u>:%s %s:%d %s() ", name, eina_log_pid_get(), 
+   eina_log_out_printf(out, "%s<%u>:%s %s:%d %s() ", name, eina_log_pid_get(), 
            d->domain_str, file, line, fnc);
 }
 
 static void
-eina_log_print_prefix_NOthreads_NOcolor_NOfile_func(FILE *fp,
+eina_log_print_prefix_NOthreads_NOcolor_NOfile_func(Eina_Log_Out *out,
                                                     const Eina_Log_Domain *d,
                                                     Eina_Log_Level level,
                                                     const char *file __UNUSED__,
@@ -437,12 +941,12 @@ eina_log_print_prefix_NOthreads_NOcolor_NOfile_func(FILE *fp,
                                                     int line __UNUSED__)
 {
    DECLARE_LEVEL_NAME(level);
-   fprintf(fp, "%s<%u>:%s %s() ", name, eina_log_pid_get(), d->domain_str, 
+   eina_log_out_printf(out, "%s<%u>:%s %s() ", name, eina_log_pid_get(), d->domain_str, 
            fnc);
 }
 
 static void
-eina_log_print_prefix_NOthreads_NOcolor_file_NOfunc(FILE *fp,
+eina_log_print_prefix_NOthreads_NOcolor_file_NOfunc(Eina_Log_Out *out,
                                                     const Eina_Log_Domain *d,
                                                     Eina_Log_Level level,
                                                     const char *file,
@@ -450,13 +954,13 @@ eina_log_print_prefix_NOthreads_NOcolor_file_NOfunc(FILE *fp,
                                                     int line)
 {
    DECLARE_LEVEL_NAME(level);
-   fprintf(fp, "%s<%u>:%s %s:%d ", name, eina_log_pid_get(), d->domain_str, 
+   eina_log_out_printf(out, "%s<%u>:%s %s:%d ", name, eina_log_pid_get(), d->domain_str, 
            file, line);
 }
 
 /* No threads, color */
 static void
-eina_log_print_prefix_NOthreads_color_file_func(FILE *fp,
+eina_log_print_prefix_NOthreads_color_file_func(Eina_Log_Out *out,
                                                 const Eina_Log_Domain *d,
                                                 Eina_Log_Level level,
                                                 const char *file,
@@ -465,39 +969,39 @@ eina_log_print_prefix_NOthreads_color_file_func(FILE *fp,
 {
    DECLARE_LEVEL_NAME_COLOR(level);
 #ifdef _WIN32_WCE
-   fprintf(fp, "%s<%u>:%s %s:%d %s() ", name, eina_log_pid_get(), 
+   eina_log_out_printf(out, "%s<%u>:%s %s:%d %s() ", name, eina_log_pid_get(), 
            d->domain_str, file, line, fnc);
 #elif _WIN32
    SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE),
                            color);
-   fprintf(fp, "%s", name);
+   eina_log_out_printf(out, "%s", name);
    SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE),
                            FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE);
-   fprintf(fp, ":");
+   eina_log_out_printf(out, ":");
    SetConsoleTextAttribute(GetStdHandle(
                               STD_OUTPUT_HANDLE),
                            eina_log_win32_color_get(d->domain_str));
-   fprintf(fp, "%s", d->name);
+   eina_log_out_printf(out, "%s", d->name);
    SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE),
                            FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE);
-   fprintf(fp, " %s:%d ", file, line);
+   eina_log_out_printf(out, " %s:%d ", file, line);
    SetConsoleTextAttribute(GetStdHandle(
                               STD_OUTPUT_HANDLE),
                            FOREGROUND_INTENSITY | FOREGROUND_RED |
                            FOREGROUND_GREEN | FOREGROUND_BLUE);
-   fprintf(fp, "%s()", fnc);
+   eina_log_out_printf(out, "%s()", fnc);
    SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE),
                            FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE);
-   fprintf(fp, " ");
+   eina_log_out_printf(out, " ");
 #else
-   fprintf(fp, "%s%s<%u>" EINA_COLOR_RESET ":%s %s:%d "
+   eina_log_out_printf(out, "%s%s<%u>" EINA_COLOR_RESET ":%s %s:%d "
            EINA_COLOR_HIGH "%s()" EINA_COLOR_RESET " ",
            color, name, eina_log_pid_get(), d->domain_str, file, line, fnc);
 #endif
 }
 
 static void
-eina_log_print_prefix_NOthreads_color_NOfile_func(FILE *fp,
+eina_log_print_prefix_NOthreads_color_NOfile_func(Eina_Log_Out *out,
                                                   const Eina_Log_Domain *d,
                                                   Eina_Log_Level level,
                                                   const char *file __UNUSED__,
@@ -506,36 +1010,36 @@ eina_log_print_prefix_NOthreads_color_NOfile_func(FILE *fp,
 {
    DECLARE_LEVEL_NAME_COLOR(level);
 #ifdef _WIN32_WCE
-   fprintf(fp, "%s<%u>:%s %s() ", name, eina_log_pid_get(), d->domain_str, 
+   eina_log_out_printf(out, "%s<%u>:%s %s() ", name, eina_log_pid_get(), d->domain_str, 
            fnc);
 #elif _WIN32
    SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE),
                            color);
-   fprintf(fp, "%s", name);
+   eina_log_out_printf(out, "%s", name);
    SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE),
                            FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE);
-   fprintf(fp, ":");
+   eina_log_out_printf(out, ":");
    SetConsoleTextAttribute(GetStdHandle(
                               STD_OUTPUT_HANDLE),
                            eina_log_win32_color_get(d->domain_str));
-   fprintf(fp, "%s", d->name);
+   eina_log_out_printf(out, "%s", d->name);
    SetConsoleTextAttribute(GetStdHandle(
                               STD_OUTPUT_HANDLE),
                            FOREGROUND_INTENSITY | FOREGROUND_RED |
                            FOREGROUND_GREEN | FOREGROUND_BLUE);
-   fprintf(fp, "%s()", fnc);
+   eina_log_out_printf(out, "%s()", fnc);
    SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE),
                            FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE);
-   fprintf(fp, " ");
+   eina_log_out_printf(out, " ");
 #else
-   fprintf(fp, "%s%s<%u>" EINA_COLOR_RESET ":%s "
+   eina_log_out_printf(out, "%s%s<%u>" EINA_COLOR_RESET ":%s "
            EINA_COLOR_HIGH "%s()" EINA_COLOR_RESET " ",
            color, name, eina_log_pid_get(), d->domain_str, fnc);
 #endif
 }
 
 static void
-eina_log_print_prefix_NOthreads_color_file_NOfunc(FILE *fp,
+eina_log_print_prefix_NOthreads_color_file_NOfunc(Eina_Log_Out *out,
                                                   const Eina_Log_Domain *d,
                                                   Eina_Log_Level level,
                                                   const char *file,
@@ -544,24 +1048,24 @@ eina_log_print_prefix_NOthreads_color_file_NOfunc(FILE *fp,
 {
    DECLARE_LEVEL_NAME_COLOR(level);
 #ifdef _WIN32_WCE
-   fprintf(fp, "%s<%u>:%s %s:%d ", name, eina_log_pid_get(), d->domain_str, 
+   eina_log_out_printf(out, "%s<%u>:%s %s:%d ", name, eina_log_pid_get(), d->domain_str, 
            file, line);
 #elif _WIN32
    SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE),
                            color);
-   fprintf(fp, "%s", name);
+   eina_log_out_printf(out, "%s", name);
    SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE),
                            FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE);
-   fprintf(fp, ":");
+   eina_log_out_printf(out, ":");
    SetConsoleTextAttribute(GetStdHandle(
                               STD_OUTPUT_HANDLE),
                            eina_log_win32_color_get(d->domain_str));
-   fprintf(fp, "%s", d->name);
+   eina_log_out_printf(out, "%s", d->name);
    SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE),
                            FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE);
-   fprintf(fp, " %s:%d ", file, line);
+   eina_log_out_printf(out, " %s:%d ", file, line);
 #else
-   fprintf(fp, "%s%s<%u>" EINA_COLOR_RESET ":%s %s:%d ",
+   eina_log_out_printf(out, "%s%s<%u>" EINA_COLOR_RESET ":%s %s:%d ",
            color, name, eina_log_pid_get(), d->domain_str, file, line);
 #endif
 }
@@ -569,7 +1073,7 @@ eina_log_print_prefix_NOthreads_color_file_NOfunc(FILE *fp,
 /** threads, No color */
 #ifdef EFL_HAVE_THREADS
 static void
-eina_log_print_prefix_threads_NOcolor_file_func(FILE *fp,
+eina_log_print_prefix_threads_NOcolor_file_func(Eina_Log_Out *out,
                                                 const Eina_Log_Domain *d,
                                                 Eina_Log_Level level,
                                                 const char *file,
@@ -579,20 +1083,20 @@ eina_log_print_prefix_threads_NOcolor_file_func(FILE *fp,
    Thread cur;
 
    DECLARE_LEVEL_NAME(level);
-   cur = SELF();
+   cur = LOG_SELF();
    if (IS_OTHER(cur))
      {
-        fprintf(fp, "%s<%u>:%s[T:%lu] %s:%d %s() ",
+        eina_log_out_printf(out, "%s<%u>:%s[T:%lu] %s:%d %s() ",
                 name, eina_log_pid_get(), d->domain_str, 
                 (unsigned long)cur, file, line, fnc);
         return;
      }
-   fprintf(fp, "%s<%u>:%s %s:%d %s() ", 
+   eina_log_out_printf(out, "%s<%u>:%s %s:%d %s() ", 
            name, eina_log_pid_get(), d->domain_str, file, line, fnc);
 }
 
 static void
-eina_log_print_prefix_threads_NOcolor_NOfile_func(FILE *fp,
+eina_log_print_prefix_threads_NOcolor_NOfile_func(Eina_Log_Out *out,
                                                   const Eina_Log_Domain *d,
                                                   Eina_Log_Level level,
                                                   const char *file __UNUSED__,
@@ -602,20 +1106,20 @@ eina_log_print_prefix_threads_NOcolor_NOfile_func(FILE *fp,
    Thread cur;
 
    DECLARE_LEVEL_NAME(level);
-   cur = SELF();
+   cur = LOG_SELF();
    if (IS_OTHER(cur))
      {
-        fprintf(fp, "%s<%u>:%s[T:%lu] %s() ",
+        eina_log_out_printf(out, "%s<%u>:%s[T:%lu] %s() ",
                 name, eina_log_pid_get(), d->domain_str, 
                 (unsigned long)cur, fnc);
         return;
      }
-   fprintf(fp, "%s<%u>:%s %s() ", 
+   eina_log_out_printf(out, "%s<%u>:%s %s() ", 
            name, eina_log_pid_get(), d->domain_str, fnc);
 }
 
 static void
-eina_log_print_prefix_threads_NOcolor_file_NOfunc(FILE *fp,
+eina_log_print_prefix_threads_NOcolor_file_NOfunc(Eina_Log_Out *out,
                                                   const Eina_Log_Domain *d,
                                                   Eina_Log_Level level,
                                                   const char *file,
@@ -625,22 +1129,22 @@ eina_log_print_prefix_threads_NOcolor_file_NOfunc(FILE *fp,
    Thread cur;
 
    DECLARE_LEVEL_NAME(level);
-   cur = SELF();
+   cur = LOG_SELF();
    if (IS_OTHER(cur))
      {
-        fprintf(fp, "%s<%u>:%s[T:%lu] %s:%d ",
+        eina_log_out_printf(out, "%s<%u>:%s[T:%lu] %s:%d ",
                 name, eina_log_pid_get(), d->domain_str, (unsigned long)cur, 
                 file, line);
         return;
      }
    
-   fprintf(fp, "%s<%u>:%s %s:%d ", 
+   eina_log_out_printf(out, "%s<%u>:%s %s:%d ", 
            name, eina_log_pid_get(), d->domain_str, file, line);
 }
 
 /* threads, color */
 static void
-eina_log_print_prefix_threads_color_file_func(FILE *fp,
+eina_log_print_prefix_threads_color_file_func(Eina_Log_Out *out,
                                               const Eina_Log_Domain *d,
                                               Eina_Log_Level level,
                                               const char *file,
@@ -650,47 +1154,47 @@ eina_log_print_prefix_threads_color_file_func(FILE *fp,
    Thread cur;
 
    DECLARE_LEVEL_NAME_COLOR(level);
-   cur = SELF();
+   cur = LOG_SELF();
    if (IS_OTHER(cur))
      {
 # ifdef _WIN32
         SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE),
                                 color);
-        fprintf(fp, "%s", name);
+        eina_log_out_printf(out, "%s", name);
         SetConsoleTextAttribute(GetStdHandle(
                                    STD_OUTPUT_HANDLE),
                                 FOREGROUND_RED | FOREGROUND_GREEN |
                                 FOREGROUND_BLUE);
-        fprintf(fp, ":");
+        eina_log_out_printf(out, ":");
         SetConsoleTextAttribute(GetStdHandle(
                                    STD_OUTPUT_HANDLE),
                                 eina_log_win32_color_get(d->domain_str));
-        fprintf(fp, "%s[T:", d->name);
+        eina_log_out_printf(out, "%s[T:", d->name);
         SetConsoleTextAttribute(GetStdHandle(
                                    STD_OUTPUT_HANDLE),
                                 FOREGROUND_RED | FOREGROUND_GREEN |
                                 FOREGROUND_BLUE);
-        fprintf(fp, "[T:");
+        eina_log_out_printf(out, "[T:");
         SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE),
                                 FOREGROUND_GREEN | FOREGROUND_BLUE);
-        fprintf(fp, "%lu", (unsigned long)cur);
+        eina_log_out_printf(out, "%lu", (unsigned long)cur);
         SetConsoleTextAttribute(GetStdHandle(
                                    STD_OUTPUT_HANDLE),
                                 FOREGROUND_RED | FOREGROUND_GREEN |
                                 FOREGROUND_BLUE);
-        fprintf(fp, "] %s:%d ", file, line);
+        eina_log_out_printf(out, "] %s:%d ", file, line);
         SetConsoleTextAttribute(GetStdHandle(
                                    STD_OUTPUT_HANDLE),
                                 FOREGROUND_INTENSITY | FOREGROUND_RED |
                                 FOREGROUND_GREEN | FOREGROUND_BLUE);
-        fprintf(fp, "%s()", fnc);
+        eina_log_out_printf(out, "%s()", fnc);
         SetConsoleTextAttribute(GetStdHandle(
                                    STD_OUTPUT_HANDLE),
                                 FOREGROUND_RED | FOREGROUND_GREEN |
                                 FOREGROUND_BLUE);
-        fprintf(fp, " ");
+        eina_log_out_printf(out, " ");
 # else
-        fprintf(fp, "%s%s<%u>" EINA_COLOR_RESET ":%s[T:"
+        eina_log_out_printf(out, "%s%s<%u>" EINA_COLOR_RESET ":%s[T:"
                 EINA_COLOR_ORANGE "%lu" EINA_COLOR_RESET "] %s:%d "
                 EINA_COLOR_HIGH "%s()" EINA_COLOR_RESET " ",
                 color, name, eina_log_pid_get() ,d->domain_str, 
@@ -700,21 +1204,21 @@ eina_log_print_prefix_threads_color_file_func(FILE *fp,
      }
 
 # ifdef _WIN32
-   eina_log_print_prefix_NOthreads_color_file_func(fp,
+   eina_log_print_prefix_NOthreads_color_file_func(out,
                                                    d,
                                                    level,
                                                    file,
                                                    fnc,
                                                    line);
 # else
-   fprintf(fp, "%s%s<%u>" EINA_COLOR_RESET ":%s %s:%d "
+   eina_log_out_printf(out, "%s%s<%u>" EINA_COLOR_RESET ":%s %s:%d "
            EINA_COLOR_HIGH "%s()" EINA_COLOR_RESET " ",
            color, name, eina_log_pid_get(), d->domain_str, file, line, fnc);
 # endif
 }
 
 static void
-eina_log_print_prefix_threads_color_NOfile_func(FILE *fp,
+eina_log_print_prefix_threads_color_NOfile_func(Eina_Log_Out *out,
                                                 const Eina_Log_Domain *d,
                                                 Eina_Log_Level level,
                                                 const char *file __UNUSED__,
@@ -724,42 +1228,42 @@ eina_log_print_prefix_threads_color_NOfile_func(FILE *fp,
    Thread cur;
 
    DECLARE_LEVEL_NAME_COLOR(level);
-   cur = SELF();
+   cur = LOG_SELF();
    if (IS_OTHER(cur))
      {
 # ifdef _WIN32
         SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE),
                                 color);
-        fprintf(fp, "%s", name);
+        eina_log_out_printf(out, "%s", name);
         SetConsoleTextAttribute(GetStdHandle(
                                    STD_OUTPUT_HANDLE),
                                 FOREGROUND_RED | FOREGROUND_GREEN |
                                 FOREGROUND_BLUE);
-        fprintf(fp, ":");
+        eina_log_out_printf(out, ":");
         SetConsoleTextAttribute(GetStdHandle(
                                    STD_OUTPUT_HANDLE),
                                 eina_log_win32_color_get(d->domain_str));
-        fprintf(fp, "%s[T:", d->name);
+        eina_log_out_printf(out, "%s[T:", d->name);
         SetConsoleTextAttribute(GetStdHandle(
                                    STD_OUTPUT_HANDLE),
                                 FOREGROUND_RED | FOREGROUND_GREEN |
                                 FOREGROUND_BLUE);
-        fprintf(fp, "[T:");
+        eina_log_out_printf(out, "[T:");
         SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE),
                                 FOREGROUND_GREEN | FOREGROUND_BLUE);
-        fprintf(fp, "%lu", (unsigned long)cur);
+        eina_log_out_printf(out, "%lu", (unsigned long)cur);
         SetConsoleTextAttribute(GetStdHandle(
                                    STD_OUTPUT_HANDLE),
                                 FOREGROUND_INTENSITY | FOREGROUND_RED |
                                 FOREGROUND_GREEN | FOREGROUND_BLUE);
-        fprintf(fp, "%s()", fnc);
+        eina_log_out_printf(out, "%s()", fnc);
         SetConsoleTextAttribute(GetStdHandle(
                                    STD_OUTPUT_HANDLE),
                                 FOREGROUND_RED | FOREGROUND_GREEN |
                                 FOREGROUND_BLUE);
-        fprintf(fp, " ");
+        eina_log_out_printf(out, " ");
 # else
-        fprintf(fp, "%s%s<%u>" EINA_COLOR_RESET ":%s[T:"
+        eina_log_out_printf(out, "%s%s<%u>" EINA_COLOR_RESET ":%s[T:"
                 EINA_COLOR_ORANGE "%lu" EINA_COLOR_RESET "] "
                 EINA_COLOR_HIGH "%s()" EINA_COLOR_RESET " ",
                 color, name, eina_log_pid_get(), d->domain_str, 
@@ -769,21 +1273,21 @@ eina_log_print_prefix_threads_color_NOfile_func(FILE *fp,
      }
 
 # ifdef _WIN32
-   eina_log_print_prefix_NOthreads_color_NOfile_func(fp,
+   eina_log_print_prefix_NOthreads_color_NOfile_func(out,
                                                      d,
                                                      level,
                                                      file,
                                                      fnc,
                                                      line);
 # else
-   fprintf(fp, "%s%s<%u>" EINA_COLOR_RESET ":%s "
+   eina_log_out_printf(out, "%s%s<%u>" EINA_COLOR_RESET ":%s "
            EINA_COLOR_HIGH "%s()" EINA_COLOR_RESET " ",
            color, name, eina_log_pid_get(), d->domain_str, fnc);
 # endif
 }
 
 static void
-eina_log_print_prefix_threads_color_file_NOfunc(FILE *fp,
+eina_log_print_prefix_threads_color_file_NOfunc(Eina_Log_Out *out,
                                                 const Eina_Log_Domain *d,
                                                 Eina_Log_Level level,
                                                 const char *file,
@@ -793,37 +1297,37 @@ eina_log_print_prefix_threads_color_file_NOfunc(FILE *fp,
    Thread cur;
 
    DECLARE_LEVEL_NAME_COLOR(level);
-   cur = SELF();
+   cur = LOG_SELF();
    if (IS_OTHER(cur))
      {
 # ifdef _WIN32
         SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE),
                                 color);
-        fprintf(fp, "%s", name);
+        eina_log_out_printf(out, "%s", name);
         SetConsoleTextAttribute(GetStdHandle(
                                    STD_OUTPUT_HANDLE),
                                 FOREGROUND_RED | FOREGROUND_GREEN |
                                 FOREGROUND_BLUE);
-        fprintf(fp, ":");
+        eina_log_out_printf(out, ":");
         SetConsoleTextAttribute(GetStdHandle(
                                    STD_OUTPUT_HANDLE),
                                 eina_log_win32_color_get(d->domain_str));
-        fprintf(fp, "%s[T:", d->name);
+        eina_log_out_printf(out, "%s[T:", d->name);
         SetConsoleTextAttribute(GetStdHandle(
                                    STD_OUTPUT_HANDLE),
                                 FOREGROUND_RED | FOREGROUND_GREEN |
                                 FOREGROUND_BLUE);
-        fprintf(fp, "[T:");
+        eina_log_out_printf(out, "[T:");
         SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE),
                                 FOREGROUND_GREEN | FOREGROUND_BLUE);
-        fprintf(fp, "%lu", (unsigned long)cur);
+        eina_log_out_printf(out, "%lu", (unsigned long)cur);
         SetConsoleTextAttribute(GetStdHandle(
                                    STD_OUTPUT_HANDLE),
                                 FOREGROUND_RED | FOREGROUND_GREEN |
                                 FOREGROUND_BLUE);
-        fprintf(fp, "] %s:%d ", file, line);
+        eina_log_out_printf(out, "] %s:%d ", file, line);
 # else
-        fprintf(fp, "%s%s<%u>" EINA_COLOR_RESET ":%s[T:"
+        eina_log_out_printf(out, "%s%s<%u>" EINA_COLOR_RESET ":%s[T:"
                 EINA_COLOR_ORANGE "%lu" EINA_COLOR_RESET "] %s:%d ",
                 color, name, eina_log_pid_get(), d->domain_str, 
                 (unsigned long)cur, file, line);
@@ -832,25 +1336,52 @@ eina_log_print_prefix_threads_color_file_NOfunc(FILE *fp,
      }
 
 # ifdef _WIN32
-   eina_log_print_prefix_NOthreads_color_file_NOfunc(fp,
+   eina_log_print_prefix_NOthreads_color_file_NOfunc(out,
                                                      d,
                                                      level,
                                                      file,
                                                      fnc,
                                                      line);
 # else
-        fprintf(fp, "%s%s" EINA_COLOR_RESET ":%s %s:%d ",
+        eina_log_out_printf(out, "%s%s" EINA_COLOR_RESET ":%s %s:%d ",
            color, name, d->domain_str, file, line);
 # endif
 }
 #endif /* EFL_HAVE_THREADS */
 
-static void (*_eina_log_print_prefix)(FILE *fp, const Eina_Log_Domain *d,
+static void (*_eina_log_print_prefix)(Eina_Log_Out *out, const Eina_Log_Domain *d,
                                       Eina_Log_Level level, const char *file,
                                       const char *fnc,
                                       int line) =
    eina_log_print_prefix_NOthreads_color_file_func;
 
+/* Prefix of eina_log_print_cb_file() and eina_log_print_cb_buffer(). */
+static void
+eina_log_print_file_prefix(Eina_Log_Out *out,
+                           const Eina_Log_Domain *d,
+                           const char *file,
+                           const char *fnc,
+                           int line)
+{
+#ifdef EFL_HAVE_THREADS
+   if (_threads_enabled)
+     {
+        Thread cur;
+
+        cur = LOG_SELF();
+        if (IS_OTHER(cur))
+          {
+             eina_log_out_printf(out, "%s[T:%lu] %s:%d %s() ", d->name,
+                                 (unsigned long)cur, file, line, fnc);
+             return;
+          }
+     }
+
+#endif
+   eina_log_out_printf(out, "%s<%u> %s:%d %s() ", d->name, eina_log_pid_get(),
+                       file, line, fnc);
+}
+
 static inline void
 eina_log_print_prefix_update(void)
 {
@@ -962,6 +1493,9 @@ eina_log_domain_new(Eina_Log_Domain *d, const char *name, const char *color)
 
    d->level = EINA_LOG_LEVEL_UNKNOWN;
    d->deleted = EINA_FALSE;
+   d->sampling = 0;
+   d->rate_burst = 0;
+   d->rate_interval = 0.0;
 
    if ((color) && (!_disable_color))
       d->domain_str = eina_log_domain_str_get(name, color);
@@ -990,6 +1524,87 @@ eina_log_domain_free(Eina_Log_Domain *d)
       free((char *)d->name);
 }
 
+/*
+ * Returns the pending settings of a domain that is not registered yet,
+ * creating them if needed.
+ */
+static Eina_Log_Domain_Level_Pending *
+eina_log_domain_pending_get(const char *name, size_t namelen)
+{
+   Eina_Log_Domain_Level_Pending *pending;
+
+   EINA_INLIST_FOREACH(_pending_list, pending)
+   {
+      if ((namelen == pending->namelen) &&
+          (strcmp(pending->name, name) == 0))
+         return pending;
+   }
+
+   pending = malloc(sizeof(Eina_Log_Domain_Level_Pending) + namelen + 1);
+   if (!pending)
+      return NULL;
+
+   pending->level = EINA_LOG_LEVEL_UNKNOWN;
+   pending->sampling = 0;
+   pending->rate_burst = 0;
+   pending->rate_interval = 0.0;
+   pending->namelen = namelen;
+   memcpy(pending->name, name, namelen + 1);
+
+   _pending_list = eina_inlist_append(_pending_list, EINA_INLIST_GET(pending));
+   return pending;
+}
+
+/*
+ * Returns the registered domain called name, or NULL.
+ */
+static Eina_Log_Domain *
+eina_log_domain_find(const char *name, size_t namelen)
+{
+   unsigned int i;
+
+   for (i = 0; i < _log_domains_count; i++)
+     {
+        if (_log_domains[i].deleted)
+           continue;
+
+        if ((namelen != _log_domains[i].namelen) ||
+            (strcmp(_log_domains[i].name, name) != 0))
+           continue;
+
+        return _log_domains + i;
+     }
+
+   return NULL;
+}
+
+/*
+ * Parses a number of seconds like "2" or "0.5", strtod() would depend
+ * on the locale.
+ */
+static double
+eina_log_seconds_parse(const char *str, char **end)
+{
+   double value = 0.0;
+   double unit = 1.0;
+   const char *p;
+
+   for (p = str; (*p >= '0') && (*p <= '9'); p++)
+      value = value * 10.0 + (*p - '0');
+
+   if (*p == '.')
+     {
+        for (p++; (*p >= '0') && (*p <= '9'); p++)
+          {
+             unit /= 10.0;
+             value += (*p - '0') * unit;
+          }
+     }
+
+   *end = (char *)p;
+   return value;
+}
+
 /*
  * Parses domain levels passed through the env var.
  */
@@ -1027,9 +1642,28 @@ eina_log_domain_parse_pendings(void)
         memcpy((char *)p->name, start, end - start);
         ((char *)p->name)[end - start] = '\0';
         p->level = level;
+        p->sampling = 0;
+        p->rate_burst = 0;
+        p->rate_interval = 0.0;
+
+        // Parse options, name:level:sample=N:rate=B/T
+        while (*tmp == ':')
+          {
+             if (!strncmp(tmp + 1, "sample=", 7))
+                p->sampling = strtoul(tmp + 8, &tmp, 10);
+             else if (!strncmp(tmp + 1, "rate=", 5))
+               {
+                  p->rate_burst = strtoul(tmp + 6, &tmp, 10);
+                  if (*tmp != '/')
+                     break;
+                  p->rate_interval = eina_log_seconds_parse(tmp + 1, &tmp);
+               }
+             else
+                break;
+          }
+
+        _pending_list = eina_inlist_append(_pending_list, EINA_INLIST_GET(p));
 
-        _pending_list = eina_inlist_append(_pending_list, EINA_INLIST_GET(p));
-
 parse_end:
         start = strchr(tmp, ',');
         if (start)
@@ -1097,7 +1731,9 @@ eina_log_domain_register_unlocked(const char *name, const char *color)
         if (_log_domains[i].deleted)
           {
              // Found a flagged slot, free domain_str and replace slot
+             LOG_PRINT_LOCK();
              eina_log_domain_new(&_log_domains[i], name, color);
+             LOG_PRINT_UNLOCK();
              goto finish_register;
           }
      }
@@ -1114,6 +1750,7 @@ eina_log_domain_register_unlocked(const char *name, const char *color)
            // grow 8 buckets to minimize reallocs
            size = _log_domains_allocated + 8;
 
+        LOG_PRINT_LOCK();
         tmp = realloc(_log_domains, sizeof(Eina_Log_Domain) * size);
 
         if (tmp)
@@ -1123,12 +1760,18 @@ eina_log_domain_register_unlocked(const char *name, const char *color)
              _log_domains_allocated = size;
           }
         else
-           return -1;
+          {
+             LOG_PRINT_UNLOCK();
+             return -1;
+          }
+        LOG_PRINT_UNLOCK();
      }
 
    // Use an allocated slot
+   LOG_PRINT_LOCK();
              eina_log_domain_new(&_log_domains[i], name, color);
    _log_domains_count++;
+   LOG_PRINT_UNLOCK();
 
 finish_register:
    namelen = _log_domains[i].namelen;
@@ -1138,6 +1781,9 @@ finish_register:
       if ((namelen == pending->namelen) && (strcmp(pending->name, name) == 0))
         {
            _log_domains[i].level = pending->level;
+           _log_domains[i].sampling = pending->sampling;
+           _log_domains[i].rate_burst = pending->rate_burst;
+           _log_domains[i].rate_interval = pending->rate_interval;
            break;
         }
    }
@@ -1158,6 +1804,17 @@ finish_register:
    if (_log_domains[i].level == EINA_LOG_LEVEL_UNKNOWN)
       _log_domains[i].level = _log_level;
 
+   if (!eina_log_domain_slot_update(i))
+     {
+        LOG_PRINT_LOCK();
+        eina_log_domain_free(&_log_domains[i]);
+        _log_domains[i].deleted = 1;
+        LOG_PRINT_UNLOCK();
+        return -1;
+     }
+   LOG_ATOMIC_STORE(&eina_log_domain_slot_get(i)->suppressed, 0);
+
+   LOG_SITES_CHANGED();
    return i;
 }
 
@@ -1214,8 +1871,12 @@ eina_log_domain_unregister_unlocked(int domain)
       return;
 
    d = &_log_domains[domain];
+   LOG_PRINT_LOCK();
    eina_log_domain_free(d);
    d->deleted = 1;
+   LOG_PRINT_UNLOCK();
+   eina_log_domain_slot_update(domain);
+   LOG_SITES_CHANGED();
 }
 
 static inline void
@@ -1268,8 +1929,7 @@ eina_log_print_unlocked(int domain,
 
 #endif
 
-   if (level > d->level)
-      return;
+   // the level was checked by eina_log_print_filter()
 
 #ifdef _WIN32
    {
@@ -1290,11 +1950,15 @@ eina_log_print_unlocked(int domain,
            if (*tmp == 'z')
               *tmp = 'I';
         }
+      LOG_PRINT_LOCK();
       _print_cb(d, level, file, fnc, line, wfmt, _print_cb_data, args);
+      LOG_PRINT_UNLOCK();
       free(wfmt);
    }
 #else
+   LOG_PRINT_LOCK();
    _print_cb(d, level, file, fnc, line, fmt, _print_cb_data, args);
+   LOG_PRINT_UNLOCK();
 #endif
 
    if (EINA_UNLIKELY(_abort_on_critical) &&
@@ -1302,223 +1966,1665 @@ eina_log_print_unlocked(int domain,
       abort();
 }
 
-#endif
+static double
+eina_log_now(void)
+{
+#ifdef CLOCK_MONOTONIC
+   struct timespec t;
 
-/**
- * @endcond
- */
+   if (!clock_gettime(CLOCK_MONOTONIC, &t))
+      return (double)t.tv_sec + (double)t.tv_nsec / 1000000000.0;
+#endif
+   {
+      struct timeval tv;
 
+      gettimeofday(&tv, NULL);
+      return (double)tv.tv_sec + (double)tv.tv_usec / 1000000.0;
+   }
+}
 
-/*============================================================================*
-*                                 Global                                     *
-*============================================================================*/
+#ifdef __ATOMIC_ACQUIRE
+# define LOG_ATOMIC_ADD(Ptr, Value) \
+   __atomic_add_fetch(Ptr, Value, __ATOMIC_RELAXED)
+# define LOG_ATOMIC_EXCHANGE(Ptr, Value) \
+   __atomic_exchange_n(Ptr, Value, __ATOMIC_RELAXED)
+# define LOG_ATOMIC_CAS(Ptr, Expected, Value) \
+   __atomic_compare_exchange_n(Ptr, Expected, Value, 0, \
+                               __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#else
+/* counting may be a bit off, good enough for throttling */
+# define LOG_ATOMIC_ADD(Ptr, Value) (*(Ptr) += (Value))
+# define LOG_ATOMIC_EXCHANGE(Ptr, Value) \
+   eina_log_atomic_exchange(Ptr, Value)
+# define LOG_ATOMIC_CAS(Ptr, Expected, Value) \
+   ((*(Ptr) == *(Expected)) ? (*(Ptr) = (Value), 1) : (*(Expected) = *(Ptr), 0))
 
-/**
- * @internal
- * @brief Initialize the log module.
- *
- * @return #EINA_TRUE on success, #EINA_FALSE on failure.
- *
- * This function sets up the log module of Eina. It is called by
- * eina_init().
- *
- * @see eina_init()
- *
- * @warning Not-MT: just call this function from main thread! The
- *          place where this function was called the first time is
- *          considered the main thread.
- */
-Eina_Bool
-eina_log_init(void)
+static inline unsigned int
+eina_log_atomic_exchange(unsigned int *ptr, unsigned int value)
 {
-#ifdef EINA_ENABLE_LOG
-   const char *level, *tmp;
-   int color_disable;
-
-   assert((sizeof(_names) / sizeof(_names[0])) == EINA_LOG_LEVELS);
+   unsigned int old = *ptr;
 
-#ifdef EINA_LOG_BACKTRACE
-   if ((tmp = getenv(EINA_LOG_ENV_BACKTRACE)))
-     _backtrace_level = atoi(tmp);
+   *ptr = value;
+   return old;
+}
 #endif
 
-   if ((tmp = getenv(EINA_LOG_ENV_COLOR_DISABLE)))
-      color_disable = atoi(tmp);
-   else
-      color_disable = -1;
+static Eina_Log_Limit_Site *
+eina_log_limit_site_get(int domain, const char *file, int line)
+{
+   uintptr_t key, expected;
+   unsigned int i, n;
 
-   /* Check if color is explicitly disabled */
-   if (color_disable == 1)
-      _disable_color = EINA_TRUE;
+   key = (((uintptr_t)file * 31) + line) * 31 + domain;
+   if (!key)
+      key = 1;
 
-#ifndef _WIN32
-   /* color was not explicitly disabled or enabled, guess it */
-   else if (color_disable == -1)
+   i = (unsigned int)(key ^ (key >> 15)) * 2654435761U;
+   for (n = 0; n < EINA_LOG_LIMIT_PROBES; n++, i++)
      {
-        if (!eina_log_term_color_supported(getenv("TERM")))
-           _disable_color = EINA_TRUE;
-        else
-          {
-             /* if not a terminal, but redirected to a file, disable color */
-             int fd;
+        Eina_Log_Limit_Site *site;
+
+        site = _log_limit_sites + (i & (EINA_LOG_LIMIT_SITES - 1));
+        expected = 0;
+        if ((site->key == key) ||
+            LOG_ATOMIC_CAS(&site->key, &expected, key) ||
+            (expected == key))
+           return site;
+     }
 
-             if (_print_cb == eina_log_print_cb_stderr)
-                fd = STDERR_FILENO;
-             else if (_print_cb == eina_log_print_cb_stdout)
-                fd = STDOUT_FILENO;
-             else
-                fd = -1;
+   return NULL;
+}
 
-             if ((fd >= 0) && (!isatty(fd)))
-                _disable_color = EINA_TRUE;
-          }
-     }
-#endif
+/*
+ * Check the sampling and rate limit of d at a call site. Returns
+ * EINA_FALSE if the message must be dropped, otherwise *resumed is the
+ * number of messages dropped by the rate limit since the site last
+ * printed.
+ */
+static Eina_Bool
+eina_log_limit_check(Eina_Log_Domain_Slot *slot, int domain,
+                     unsigned int sampling, unsigned int interval,
+                     const char *file, int line,
+                     unsigned int *resumed)
+{
+   Eina_Log_Limit_Site *site;
 
-   if ((tmp = getenv(EINA_LOG_ENV_FILE_DISABLE)) && (atoi(tmp) == 1))
-      _disable_file = EINA_TRUE;
+   site = eina_log_limit_site_get(domain, file, line);
+   if (!site)
+      return EINA_TRUE;
 
-   if ((tmp = getenv(EINA_LOG_ENV_FUNCTION_DISABLE)) && (atoi(tmp) == 1))
-      _disable_function = EINA_TRUE;
+   if ((sampling > 1) &&
+       ((LOG_ATOMIC_ADD(&site->sampled, 1) - 1) % sampling))
+      goto drop;
 
-   if ((tmp = getenv(EINA_LOG_ENV_ABORT)) && (atoi(tmp) == 1))
-      _abort_on_critical = EINA_TRUE;
+   if (interval > 0)
+     {
+        unsigned int window, old;
 
-   if ((tmp = getenv(EINA_LOG_ENV_ABORT_LEVEL)))
-      _abort_level_on_critical = atoi(tmp);
+        window = (unsigned int)(eina_log_now() * 1000.0 / interval) + 1;
+        old = site->window;
+        if ((old != window) && LOG_ATOMIC_CAS(&site->window, &old, window))
+          {
+             LOG_ATOMIC_EXCHANGE(&site->count, 0);
+             *resumed = LOG_ATOMIC_EXCHANGE(&site->suppressed, 0);
+          }
 
-   eina_log_print_prefix_update();
+        if (LOG_ATOMIC_ADD(&site->count, 1) >
+            LOG_ATOMIC_LOAD(&slot->rate_burst))
+          {
+             LOG_ATOMIC_ADD(&site->suppressed, 1);
+             goto drop;
+          }
+     }
 
-   // Global log level
-   if ((level = getenv(EINA_LOG_ENV_LEVEL)))
-      _log_level = atoi(level);
+   return EINA_TRUE;
 
-   // Register UNKNOWN domain, the default logger
-   EINA_LOG_DOMAIN_GLOBAL = eina_log_domain_register("", NULL);
+drop:
+   LOG_ATOMIC_ADD(&slot->suppressed, 1);
+   return EINA_FALSE;
+}
 
-   if (EINA_LOG_DOMAIN_GLOBAL < 0)
-     {
-        fprintf(stderr, "Failed to create global logging domain.\n");
-        return EINA_FALSE;
-     }
+/*
+ * Called before taking the log lock or formatting anything, so it only
+ * reads the slot of the domain. Returns EINA_FALSE if the message is not
+ * to be printed. Errors are left to eina_log_print_unlocked() to report.
+ */
+static inline Eina_Bool
+eina_log_print_filter(int domain, Eina_Log_Level level,
+                      const char *file, int line,
+                      Eina_Bool forced, unsigned int *resumed)
+{
+   Eina_Log_Domain_Slot *slot;
+   unsigned int sampling, interval;
+   int domain_level;
 
-   // Parse pending domains passed through EINA_LOG_LEVELS_GLOB
-   eina_log_domain_parse_pending_globs();
+   slot = eina_log_domain_slot_get(domain);
+   if (EINA_UNLIKELY(!slot))
+      return EINA_TRUE;
 
-   // Parse pending domains passed through EINA_LOG_LEVELS
-   eina_log_domain_parse_pendings();
+   domain_level = LOG_ATOMIC_LOAD(&slot->level);
+   if (EINA_UNLIKELY(domain_level == EINA_LOG_LEVEL_UNKNOWN))
+      return EINA_TRUE;
 
-#endif
-   return EINA_TRUE;
+   if (((int)level > domain_level) && (!forced))
+      return EINA_FALSE;
+
+   sampling = LOG_ATOMIC_LOAD(&slot->sampling);
+   interval = LOG_ATOMIC_LOAD(&slot->rate_interval);
+   if (EINA_LIKELY((sampling <= 1) && (interval == 0)) ||
+       (level <= EINA_LOG_LEVEL_CRITICAL))
+      return EINA_TRUE;
+
+   return eina_log_limit_check(slot, domain, sampling, interval,
+                               file, line, resumed);
 }
 
-/**
- * @internal
- * @brief Shut down the log module.
- *
- * @return #EINA_TRUE on success, #EINA_FALSE on failure.
- *
- * This function shuts down the log module set up by
- * eina_log_init(). It is called by eina_shutdown().
+/*
+ * Binary log file, all integers in the byte order of the writer:
  *
- * @see eina_shutdown()
+ *   Eina_Log_Binary_Header
+ *   records, each starting with Eina_Log_Binary_Head and aligned on 8
  *
- * @warning Not-MT: just call this function from main thread! The
- *          place where eina_log_init() (eina_init()) was called the
- *          first time is considered the main thread.
+ * A site record describes a call site (format, file, function, line) the
+ * first time it logs, a domain record gives the name of a domain index
+ * the first time it is used, and message records reference both followed
+ * by the raw arguments of the format, parsed again when decoding. The
+ * file grows by chunks full of zeros, a 0 type marks the end.
  */
-Eina_Bool
-eina_log_shutdown(void)
+#define EINA_LOG_BINARY_MAGIC "EiLB"
+#define EINA_LOG_BINARY_BYTE_ORDER 0x01020304
+#define EINA_LOG_BINARY_VERSION 1
+#define EINA_LOG_BINARY_CHUNK (1024 * 1024)
+#define EINA_LOG_BINARY_RECORD_MAX (64 * 1024)
+#define EINA_LOG_BINARY_ALIGN(Size) (((Size) + 7) & ~((size_t) 7))
+
+typedef enum _Eina_Log_Binary_Type
 {
-#ifdef EINA_ENABLE_LOG
-   Eina_Inlist *tmp;
+   EINA_LOG_BINARY_END = 0,
+   EINA_LOG_BINARY_SITE,
+   EINA_LOG_BINARY_DOMAIN,
+   EINA_LOG_BINARY_MESSAGE,
+   EINA_LOG_BINARY_TEXT /* message that had to be formatted at once */
+} Eina_Log_Binary_Type;
+
+typedef enum _Eina_Log_Binary_Length
+{
+   EINA_LOG_BINARY_LENGTH_NONE,
+   EINA_LOG_BINARY_LENGTH_HH,
+   EINA_LOG_BINARY_LENGTH_H,
+   EINA_LOG_BINARY_LENGTH_L,
+   EINA_LOG_BINARY_LENGTH_LL,
+   EINA_LOG_BINARY_LENGTH_J,
+   EINA_LOG_BINARY_LENGTH_Z,
+   EINA_LOG_BINARY_LENGTH_T,
+   EINA_LOG_BINARY_LENGTH_BIG_L
+} Eina_Log_Binary_Length;
+
+typedef struct _Eina_Log_Binary_Header Eina_Log_Binary_Header;
+typedef struct _Eina_Log_Binary_Head Eina_Log_Binary_Head;
+typedef struct _Eina_Log_Binary_Site Eina_Log_Binary_Site;
+typedef struct _Eina_Log_Binary_Site_Key Eina_Log_Binary_Site_Key;
+typedef struct _Eina_Log_Binary_Domain Eina_Log_Binary_Domain;
+typedef struct _Eina_Log_Binary_Message Eina_Log_Binary_Message;
+typedef struct _Eina_Log_Binary_Conv Eina_Log_Binary_Conv;
+
+struct _Eina_Log_Binary_Header
+{
+   char magic[4];
+   uint32_t byte_order;
+   uint32_t version;
+   uint32_t pid;
+};
 
-   while (_log_domains_count--)
-     {
-        if (_log_domains[_log_domains_count].deleted)
-           continue;
+struct _Eina_Log_Binary_Head
+{
+   uint32_t type;
+   uint32_t size;
+};
 
-        eina_log_domain_free(&_log_domains[_log_domains_count]);
+/* followed by format, file and function, nul terminated */
+struct _Eina_Log_Binary_Site
+{
+   Eina_Log_Binary_Head head;
+   uint32_t id;
+   int32_t line;
+};
+
+/* followed by the nul terminated name */
+struct _Eina_Log_Binary_Domain
+{
+   Eina_Log_Binary_Head head;
+   int32_t domain;
+   uint32_t padding;
+};
+
+/* followed by the arguments, or the nul terminated text */
+struct _Eina_Log_Binary_Message
+{
+   Eina_Log_Binary_Head head;
+   uint32_t site;
+   int32_t domain;
+   int32_t level;
+   uint32_t padding;
+   uint64_t timestamp;
+   uint64_t thread;
+};
+
+struct _Eina_Log_Binary_Site_Key
+{
+   const char *fmt;
+   const char *file;
+   const char *fnc;
+   int line;
+};
+
+struct _Eina_Log_Binary
+{
+   int fd;
+   unsigned char *map;
+   size_t size;
+   size_t used;
+
+   Eina_Hash *sites;
+   Eina_Inarray *sites_offsets;
+
+   const char **domains;
+   unsigned int domains_count;
+   const char *other_domain; /* domain not in _log_domains, stored as -1 */
+};
+
+/* One conversion of a printf format. */
+struct _Eina_Log_Binary_Conv
+{
+   const char *start; /* the '%' */
+   const char *length; /* the length modifier, or the conversion */
+   const char *end; /* after the conversion */
+   Eina_Log_Binary_Length modifier;
+   int stars;
+   int precision; /* -1 when none, -2 when given by the last star */
+   char conv; /* 0 when not supported */
+};
+
+/*
+ * Find the next conversion of fmt, returns NULL when there is none.
+ * Positional arguments are not supported.
+ */
+static const char *
+eina_log_binary_conv_next(const char *fmt, Eina_Log_Binary_Conv *c)
+{
+   const char *p;
+
+   p = strchr(fmt, '%');
+   if (!p)
+      return NULL;
+
+   memset(c, 0, sizeof(*c));
+   c->precision = -1;
+   c->start = p++;
+
+   if (*p == '%')
+     {
+        c->length = p;
+        c->conv = '%';
+        c->end = p + 1;
+        return c->end;
      }
 
-        free(_log_domains);
+   while (*p && strchr("-+ #0'", *p))
+      p++;
 
-   _log_domains = NULL;
-   _log_domains_count = 0;
-   _log_domains_allocated = 0;
+   if (*p == '*')
+     {
+        c->stars++;
+        p++;
+     }
+   else
+     {
+        while ((*p >= '0') && (*p <= '9'))
+           p++;
+        if (*p == '$')
+           goto unsupported;
+     }
 
-   while (_glob_list)
+   if (*p == '.')
      {
-        tmp = _glob_list;
-        _glob_list = _glob_list->next;
-        free(tmp);
+        p++;
+        if (*p == '*')
+          {
+             c->stars++;
+             c->precision = -2;
+             p++;
+          }
+        else
+          {
+             c->precision = 0;
+             for (; (*p >= '0') && (*p <= '9'); p++)
+                if (c->precision < INT_MAX / 10 - 1)
+                   c->precision = c->precision * 10 + *p - '0';
+          }
      }
 
-   while (_pending_list)
+   c->length = p;
+   switch (*p)
      {
-        tmp = _pending_list;
-        _pending_list = _pending_list->next;
-        free(tmp);
+      case 'h':
+         if (p[1] == 'h')
+           {
+              c->modifier = EINA_LOG_BINARY_LENGTH_HH;
+              p++;
+           }
+         else
+            c->modifier = EINA_LOG_BINARY_LENGTH_H;
+         p++;
+         break;
+      case 'l':
+         if (p[1] == 'l')
+           {
+              c->modifier = EINA_LOG_BINARY_LENGTH_LL;
+              p++;
+           }
+         else
+            c->modifier = EINA_LOG_BINARY_LENGTH_L;
+         p++;
+         break;
+      case 'q': c->modifier = EINA_LOG_BINARY_LENGTH_LL; p++; break;
+      case 'j': c->modifier = EINA_LOG_BINARY_LENGTH_J; p++; break;
+      case 'z': c->modifier = EINA_LOG_BINARY_LENGTH_Z; p++; break;
+      case 't': c->modifier = EINA_LOG_BINARY_LENGTH_T; p++; break;
+      case 'L': c->modifier = EINA_LOG_BINARY_LENGTH_BIG_L; p++; break;
+      default: break;
      }
 
-#endif
-   return EINA_TRUE;
-}
+   if (!*p)
+      goto unsupported;
 
-#ifdef EFL_HAVE_THREADS
+   c->conv = *p;
+   c->end = p + 1;
+   return c->end;
 
-/**
- * @internal
- * @brief Activate the log mutex.
- *
- * This function activate the mutex in the eina log module. It is called by
- * eina_threads_init().
- *
- * @see eina_threads_init()
- */
-void
-eina_log_threads_init(void)
-{
-#ifdef EINA_ENABLE_LOG
-   if (_threads_inited) return;
-   _main_thread = SELF();
-   if (!INIT()) return;
-   _threads_inited = EINA_TRUE;
-#endif
+unsupported:
+   c->conv = 0;
+   c->end = p;
+   return NULL;
 }
 
-/**
- * @internal
- * @brief Shut down the log mutex.
- *
- * This function shuts down the mutex in the log module.
- * It is called by eina_threads_shutdown().
- *
- * @see eina_threads_shutdown()
+#define EINA_LOG_BINARY_PUT(Dst, Max, Len, Value)        \
+   do {                                                  \
+      uint64_t _v = (Value);                             \
+      if ((Len) + sizeof(_v) > (Max)) return EINA_FALSE; \
+      memcpy((Dst) + (Len), &_v, sizeof(_v));            \
+      (Len) += sizeof(_v);                               \
+   } while (0)
+
+/*
+ * Copy the arguments of fmt to dst, returns EINA_FALSE if the format is
+ * not supported or they do not fit.
  */
-void
-eina_log_threads_shutdown(void)
+static Eina_Bool
+eina_log_binary_args_write(unsigned char *dst, size_t max, size_t *plen,
+                           const char *fmt, va_list args)
 {
-#ifdef EINA_ENABLE_LOG
-   if (!_threads_inited) return;
-   CHECK_MAIN();
-   SHUTDOWN();
-   _threads_enabled = EINA_FALSE;
-   _threads_inited = EINA_FALSE;
-#endif
-}
-
-#endif
+   Eina_Log_Binary_Conv c;
+   size_t len = 0;
+   int star = 0;
+   int i;
 
-/*============================================================================*
-*                                   API                                      *
-*============================================================================*/
+   while ((fmt = eina_log_binary_conv_next(fmt, &c)))
+     {
+        for (i = 0; i < c.stars; i++)
+          {
+             star = va_arg(args, int);
+             EINA_LOG_BINARY_PUT(dst, max, len, (int64_t)star);
+          }
+        if (c.precision == -2)
+           c.precision = star;
 
-/**
+        switch (c.conv)
+          {
+           case '%':
+              break;
+
+           case 'd':
+           case 'i':
+              switch (c.modifier)
+                {
+                 case EINA_LOG_BINARY_LENGTH_NONE:
+                    EINA_LOG_BINARY_PUT(dst, max, len, (int64_t)va_arg(args, int));
+                    break;
+                 case EINA_LOG_BINARY_LENGTH_HH:
+                    EINA_LOG_BINARY_PUT(dst, max, len, (int64_t)(signed char)va_arg(args, int));
+                    break;
+                 case EINA_LOG_BINARY_LENGTH_H:
+                    EINA_LOG_BINARY_PUT(dst, max, len, (int64_t)(short)va_arg(args, int));
+                    break;
+                 case EINA_LOG_BINARY_LENGTH_L:
+                    EINA_LOG_BINARY_PUT(dst, max, len, (int64_t)va_arg(args, long));
+                    break;
+                 case EINA_LOG_BINARY_LENGTH_LL:
+                    EINA_LOG_BINARY_PUT(dst, max, len, (int64_t)va_arg(args, long long));
+                    break;
+                 case EINA_LOG_BINARY_LENGTH_J:
+                    EINA_LOG_BINARY_PUT(dst, max, len, (int64_t)va_arg(args, intmax_t));
+                    break;
+                 case EINA_LOG_BINARY_LENGTH_Z:
+                    EINA_LOG_BINARY_PUT(dst, max, len, (int64_t)(long)va_arg(args, size_t));
+                    break;
+                 case EINA_LOG_BINARY_LENGTH_T:
+                    EINA_LOG_BINARY_PUT(dst, max, len, (int64_t)va_arg(args, ptrdiff_t));
+                    break;
+                 default:
+                    return EINA_FALSE;
+                }
+              break;
+
+           case 'o':
+           case 'u':
+           case 'x':
+           case 'X':
+              switch (c.modifier)
+                {
+                 case EINA_LOG_BINARY_LENGTH_NONE:
+                    EINA_LOG_BINARY_PUT(dst, max, len, va_arg(args, unsigned int));
+                    break;
+                 case EINA_LOG_BINARY_LENGTH_HH:
+                    EINA_LOG_BINARY_PUT(dst, max, len, (unsigned char)va_arg(args, unsigned int));
+                    break;
+                 case EINA_LOG_BINARY_LENGTH_H:
+                    EINA_LOG_BINARY_PUT(dst, max, len, (unsigned short)va_arg(args, unsigned int));
+                    break;
+                 case EINA_LOG_BINARY_LENGTH_L:
+                    EINA_LOG_BINARY_PUT(dst, max, len, va_arg(args, unsigned long));
+                    break;
+                 case EINA_LOG_BINARY_LENGTH_LL:
+                    EINA_LOG_BINARY_PUT(dst, max, len, va_arg(args, unsigned long long));
+                    break;
+                 case EINA_LOG_BINARY_LENGTH_J:
+                    EINA_LOG_BINARY_PUT(dst, max, len, va_arg(args, uintmax_t));
+                    break;
+                 case EINA_LOG_BINARY_LENGTH_Z:
+                    EINA_LOG_BINARY_PUT(dst, max, len, va_arg(args, size_t));
+                    break;
+                 case EINA_LOG_BINARY_LENGTH_T:
+                    EINA_LOG_BINARY_PUT(dst, max, len, (uint64_t)va_arg(args, ptrdiff_t));
+                    break;
+                 default:
+                    return EINA_FALSE;
+                }
+              break;
+
+           case 'c':
+              if (c.modifier != EINA_LOG_BINARY_LENGTH_NONE)
+                 return EINA_FALSE;
+              EINA_LOG_BINARY_PUT(dst, max, len, (int64_t)va_arg(args, int));
+              break;
+
+           case 'e':
+           case 'E':
+           case 'f':
+           case 'F':
+           case 'g':
+           case 'G':
+           case 'a':
+           case 'A':
+             {
+                double d;
+                uint64_t v;
+
+                if (c.modifier == EINA_LOG_BINARY_LENGTH_BIG_L)
+                   d = va_arg(args, long double);
+                else if ((c.modifier == EINA_LOG_BINARY_LENGTH_NONE) ||
+                         (c.modifier == EINA_LOG_BINARY_LENGTH_L))
+                   d = va_arg(args, double);
+                else
+                   return EINA_FALSE;
+                memcpy(&v, &d, sizeof(v));
+                EINA_LOG_BINARY_PUT(dst, max, len, v);
+                break;
+             }
+
+           case 's':
+             {
+                const char *str;
+                uint32_t slen;
+
+                if (c.modifier != EINA_LOG_BINARY_LENGTH_NONE)
+                   return EINA_FALSE;
+                str = va_arg(args, const char *);
+                if (!str)
+                   slen = 0xffffffff;
+                else if (c.precision >= 0)
+                  {
+                     // the string does not have to be nul terminated
+                     const char *nul = memchr(str, '\0', c.precision);
+
+                     slen = nul ? (uint32_t)(nul - str) : (uint32_t)c.precision;
+                  }
+                else
+                   slen = strlen(str);
+                if (len + sizeof(slen) > max)
+                   return EINA_FALSE;
+                if ((str) && (slen > max - len - sizeof(slen)))
+                   slen = max - len - sizeof(slen);
+                memcpy(dst + len, &slen, sizeof(slen));
+                len += sizeof(slen);
+                if (str)
+                  {
+                     memcpy(dst + len, str, slen);
+                     len += slen;
+                  }
+                break;
+             }
+
+           case 'p':
+              EINA_LOG_BINARY_PUT(dst, max, len, (uintptr_t)va_arg(args, void *));
+              break;
+
+           case 'n':
+              (void)va_arg(args, void *);
+              break;
+
+           default:
+              return EINA_FALSE;
+          }
+     }
+
+   // a conversion that could not be parsed
+   if (c.start && !c.conv)
+      return EINA_FALSE;
+
+   *plen = len;
+   return EINA_TRUE;
+}
+
+#undef EINA_LOG_BINARY_PUT
+
+static unsigned int
+eina_log_binary_site_key_length(const void *key __UNUSED__)
+{
+   return sizeof(Eina_Log_Binary_Site_Key);
+}
+
+static int
+eina_log_binary_site_key_cmp(const void *key1, int key1_length __UNUSED__,
+                             const void *key2, int key2_length __UNUSED__)
+{
+   return memcmp(key1, key2, sizeof(Eina_Log_Binary_Site_Key));
+}
+
+static int
+eina_log_binary_site_key_hash(const void *key, int key_length)
+{
+   return eina_hash_superfast(key, key_length);
+}
+
+/* Get room for a record of at most length bytes at the end of the file. */
+static unsigned char *
+eina_log_binary_reserve(Eina_Log_Binary *bin, size_t length)
+{
+#ifdef HAVE_SYS_MMAN_H
+   unsigned char *map;
+   size_t size;
+
+   length = EINA_LOG_BINARY_ALIGN(length);
+   if (bin->used + length <= bin->size)
+      return bin->map + bin->used;
+
+   size = bin->size + (length > EINA_LOG_BINARY_CHUNK ?
+                       length : EINA_LOG_BINARY_CHUNK);
+   if (ftruncate(bin->fd, size))
+      return NULL;
+
+   map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, bin->fd, 0);
+   if (map == MAP_FAILED)
+      return NULL;
+
+   if (bin->map)
+      munmap(bin->map, bin->size);
+   bin->map = map;
+   bin->size = size;
+
+   return bin->map + bin->used;
+#else
+   (void)bin;
+   (void)length;
+   return NULL;
+#endif
+}
+
+static void
+eina_log_binary_commit(Eina_Log_Binary *bin, unsigned char *p,
+                       Eina_Log_Binary_Type type, size_t length)
+{
+   Eina_Log_Binary_Head *head = (Eina_Log_Binary_Head *)p;
+
+   length = EINA_LOG_BINARY_ALIGN(length);
+   head->size = length;
+   // the next head may hold leftovers of a record that was not committed
+   if (bin->used + length + sizeof(Eina_Log_Binary_Head) <= bin->size)
+      memset(p + length, 0, sizeof(Eina_Log_Binary_Head));
+   // the type last, so a partially written record ends the file
+   head->type = type;
+   bin->used += length;
+}
+
+static Eina_Bool
+eina_log_binary_domain_write(Eina_Log_Binary *bin, int domain,
+                             const char *name)
+{
+   Eina_Log_Binary_Domain *rec;
+   unsigned char *p;
+   size_t namelen;
+
+   if ((domain >= 0) && ((unsigned int)domain >= bin->domains_count))
+     {
+        const char **tmp;
+        unsigned int count = domain + 8;
+
+        tmp = realloc(bin->domains, count * sizeof(const char *));
+        if (!tmp)
+           return EINA_FALSE;
+        memset(tmp + bin->domains_count, 0,
+               (count - bin->domains_count) * sizeof(const char *));
+        bin->domains = tmp;
+        bin->domains_count = count;
+     }
+
+   namelen = strlen(name) + 1;
+   p = eina_log_binary_reserve(bin, sizeof(Eina_Log_Binary_Domain) + namelen);
+   if (!p)
+      return EINA_FALSE;
+
+   rec = (Eina_Log_Binary_Domain *)p;
+   rec->domain = domain;
+   memcpy(rec + 1, name, namelen);
+   eina_log_binary_commit(bin, p, EINA_LOG_BINARY_DOMAIN,
+                          sizeof(Eina_Log_Binary_Domain) + namelen);
+
+   if (domain >= 0)
+      bin->domains[domain] = name;
+   else
+      bin->other_domain = name;
+   return EINA_TRUE;
+}
+
+/*
+ * Return the id of the call site, writing it on first use, or -1. The
+ * format is compared too, in case it was not a literal and its memory got
+ * reused for something else.
+ */
+static int
+eina_log_binary_site_get(Eina_Log_Binary *bin, const char *fmt,
+                         const char *file, const char *fnc, int line)
+{
+   Eina_Log_Binary_Site_Key key;
+   Eina_Log_Binary_Site *rec;
+   unsigned char *p;
+   size_t fmtlen, filelen, fnclen, offset;
+   unsigned int id;
+   void *found;
+
+   memset(&key, 0, sizeof(key));
+   key.fmt = fmt;
+   key.file = file;
+   key.fnc = fnc;
+   key.line = line;
+
+   found = eina_hash_find(bin->sites, &key);
+   if (found)
+     {
+        id = (uintptr_t)found - 1;
+        offset = *(size_t *)eina_inarray_nth(bin->sites_offsets, id);
+        if (!strcmp(fmt, (const char *)bin->map + offset +
+                    sizeof(Eina_Log_Binary_Site)))
+           return id;
+     }
+
+   fmtlen = strlen(fmt) + 1;
+   filelen = strlen(file) + 1;
+   fnclen = strlen(fnc) + 1;
+   if (sizeof(Eina_Log_Binary_Site) + fmtlen + filelen + fnclen >
+       EINA_LOG_BINARY_RECORD_MAX)
+      return -1;
+
+   p = eina_log_binary_reserve(bin, sizeof(Eina_Log_Binary_Site) +
+                               fmtlen + filelen + fnclen);
+   if (!p)
+      return -1;
+
+   offset = bin->used;
+   id = eina_inarray_count(bin->sites_offsets);
+   if (eina_inarray_push(bin->sites_offsets, &offset) < 0)
+      return -1;
+
+   if (found)
+      eina_hash_modify(bin->sites, &key, (void *)(uintptr_t)(id + 1));
+   else if (!eina_hash_add(bin->sites, &key, (void *)(uintptr_t)(id + 1)))
+     {
+        eina_inarray_pop(bin->sites_offsets);
+        return -1;
+     }
+
+   rec = (Eina_Log_Binary_Site *)p;
+   rec->id = id;
+   rec->line = line;
+   p = (unsigned char *)(rec + 1);
+   memcpy(p, fmt, fmtlen);
+   memcpy(p + fmtlen, file, filelen);
+   memcpy(p + fmtlen + filelen, fnc, fnclen);
+   eina_log_binary_commit(bin, (unsigned char *)rec, EINA_LOG_BINARY_SITE,
+                          sizeof(Eina_Log_Binary_Site) +
+                          fmtlen + filelen + fnclen);
+
+   return id;
+}
+
+static uint64_t
+eina_log_binary_timestamp(void)
+{
+#ifdef CLOCK_REALTIME
+   struct timespec t;
+
+   if (!clock_gettime(CLOCK_REALTIME, &t))
+      return (uint64_t)t.tv_sec * 1000000000ULL + t.tv_nsec;
+#endif
+   {
+      struct timeval tv;
+
+      gettimeofday(&tv, NULL);
+      return (uint64_t)tv.tv_sec * 1000000000ULL + tv.tv_usec * 1000ULL;
+   }
+}
+
+/* Read the next argument of a message being decoded. */
+static Eina_Bool
+eina_log_binary_arg_read(const unsigned char **p, const unsigned char *end,
+                         uint64_t *v)
+{
+   if ((size_t)(end - *p) < sizeof(*v))
+      return EINA_FALSE;
+   memcpy(v, *p, sizeof(*v));
+   *p += sizeof(*v);
+   return EINA_TRUE;
+}
+
+/* Format the arguments of a message back, following its format. */
+static Eina_Bool
+eina_log_binary_message_format(Eina_Strbuf *buf, const char *fmt,
+                               const unsigned char *p,
+                               const unsigned char *end)
+{
+   Eina_Log_Binary_Conv c;
+   const char *next;
+   char spec[64];
+
+   while ((next = eina_log_binary_conv_next(fmt, &c)))
+     {
+        const char *s;
+        size_t n = 0;
+        uint64_t v;
+
+        eina_strbuf_append_length(buf, fmt, c.start - fmt);
+        fmt = next;
+
+        if (c.conv == '%')
+          {
+             eina_strbuf_append_char(buf, '%');
+             continue;
+          }
+
+        // rebuild the conversion, with the stars replaced
+        for (s = c.start; (s < c.length) && (n < sizeof(spec) - 16); s++)
+          {
+             if (*s == '*')
+               {
+                  if (!eina_log_binary_arg_read(&p, end, &v))
+                     return EINA_FALSE;
+                  n += snprintf(spec + n, sizeof(spec) - 16 - n, "%i",
+                                (int)(int64_t)v);
+                  if (n >= sizeof(spec) - 16)
+                     return EINA_FALSE;
+               }
+             else
+                spec[n++] = *s;
+          }
+
+        switch (c.conv)
+          {
+           case 'd':
+           case 'i':
+              if (!eina_log_binary_arg_read(&p, end, &v))
+                 return EINA_FALSE;
+              spec[n++] = 'l';
+              spec[n++] = 'l';
+              spec[n++] = c.conv;
+              spec[n] = '\0';
+              eina_strbuf_append_printf(buf, spec, (long long)(int64_t)v);
+              break;
+
+           case 'o':
+           case 'u':
+           case 'x':
+           case 'X':
+              if (!eina_log_binary_arg_read(&p, end, &v))
+                 return EINA_FALSE;
+              spec[n++] = 'l';
+              spec[n++] = 'l';
+              spec[n++] = c.conv;
+              spec[n] = '\0';
+              eina_strbuf_append_printf(buf, spec, (unsigned long long)v);
+              break;
+
+           case 'c':
+              if (!eina_log_binary_arg_read(&p, end, &v))
+                 return EINA_FALSE;
+              spec[n++] = c.conv;
+              spec[n] = '\0';
+              eina_strbuf_append_printf(buf, spec, (int)(int64_t)v);
+              break;
+
+           case 'e':
+           case 'E':
+           case 'f':
+           case 'F':
+           case 'g':
+           case 'G':
+           case 'a':
+           case 'A':
+             {
+                double d;
+
+                if (!eina_log_binary_arg_read(&p, end, &v))
+                   return EINA_FALSE;
+                memcpy(&d, &v, sizeof(d));
+                spec[n++] = c.conv;
+                spec[n] = '\0';
+                eina_strbuf_append_printf(buf, spec, d);
+                break;
+             }
+
+           case 's':
+             {
+                uint32_t slen;
+                char *str;
+
+                if ((size_t)(end - p) < sizeof(slen))
+                   return EINA_FALSE;
+                memcpy(&slen, p, sizeof(slen));
+                p += sizeof(slen);
+
+                spec[n++] = 's';
+                spec[n] = '\0';
+                if (slen == 0xffffffff)
+                  {
+                     eina_strbuf_append_printf(buf, spec, "(null)");
+                     break;
+                  }
+                if ((size_t)(end - p) < slen)
+                   return EINA_FALSE;
+
+                str = malloc(slen + 1);
+                if (!str)
+                   return EINA_FALSE;
+                memcpy(str, p, slen);
+                str[slen] = '\0';
+                p += slen;
+                eina_strbuf_append_printf(buf, spec, str);
+                free(str);
+                break;
+             }
+
+           case 'p':
+              if (!eina_log_binary_arg_read(&p, end, &v))
+                 return EINA_FALSE;
+              spec[n++] = 'p';
+              spec[n] = '\0';
+              eina_strbuf_append_printf(buf, spec, (void *)(uintptr_t)v);
+              break;
+
+           case 'n':
+              break;
+
+           default:
+              return EINA_FALSE;
+          }
+     }
+
+   eina_strbuf_append(buf, fmt);
+   return EINA_TRUE;
+}
+
+struct _Eina_Log_Buffer
+{
+   int fd;
+   char *buf;
+   size_t size;
+   size_t len;
+   double interval;
+   double since; /* when the oldest buffered line was added */
+};
+
+static void
+eina_log_buffer_flush_unlocked(Eina_Log_Buffer *buffer)
+{
+   if (!buffer->len)
+      return;
+
+   eina_log_write_all(buffer->fd, buffer->buf, buffer->len);
+   buffer->len = 0;
+}
+
+#ifdef EINA_LOG_ASYNC
+static void
+eina_log_async_print_cb_call(const Eina_Log_Domain *d,
+                             Eina_Log_Level level,
+                             const char *file,
+                             const char *fnc,
+                             int line,
+                             const char *fmt,
+                             ...)
+{
+   va_list args;
+
+   va_start(args, fmt);
+   _print_cb(d, level, file, fnc, line, fmt, _print_cb_data, args);
+   va_end(args);
+}
+
+static void
+eina_log_async_ring_del(void *data)
+{
+   Eina_Log_Async_Ring *ring = data;
+
+   /* the async thread frees it once drained */
+   __atomic_store_n(&ring->dead, EINA_TRUE, __ATOMIC_RELEASE);
+}
+
+static Eina_Log_Async_Ring *
+eina_log_async_ring_get(void)
+{
+   Eina_Log_Async_Ring *ring;
+
+   ring = pthread_getspecific(_log_async_key);
+   if (EINA_LIKELY(ring != NULL))
+      return ring;
+
+   ring = calloc(1, sizeof(Eina_Log_Async_Ring));
+   if (!ring)
+      return NULL;
+
+   pthread_mutex_lock(&_log_async_mutex);
+   _log_async_rings = eina_inlist_append(_log_async_rings,
+                                         EINA_INLIST_GET(ring));
+   pthread_mutex_unlock(&_log_async_mutex);
+
+   pthread_setspecific(_log_async_key, ring);
+   return ring;
+}
+
+/*
+ * Format the message in the calling thread and queue it, without taking
+ * the log lock. Returns EINA_FALSE if the message has to be printed
+ * synchronously instead.
+ */
+static Eina_Bool
+eina_log_async_push(int domain,
+                    Eina_Log_Level level,
+                    const char *file,
+                    const char *fnc,
+                    int line,
+                    const char *fmt,
+                    va_list args)
+{
+   Eina_Log_Async_Ring *ring;
+   Eina_Log_Async_Record *rec;
+   char buf[512];
+   char *msg = buf;
+   va_list copy;
+   Eina_Log_Domain_Slot *slot;
+   unsigned int head, tail, pos, needed, to_end;
+   int len;
+
+   // the level was checked by eina_log_print_filter(), unknown domains
+   // and criticals go through the synchronous path
+   slot = eina_log_domain_slot_get(domain);
+   if (EINA_UNLIKELY(!slot) ||
+       EINA_UNLIKELY(LOG_ATOMIC_LOAD(&slot->level) == EINA_LOG_LEVEL_UNKNOWN))
+      return EINA_FALSE;
+
+   if ((level <= EINA_LOG_LEVEL_CRITICAL) ||
+       (_abort_on_critical && (level <= _abort_level_on_critical)))
+     {
+        if (!pthread_equal(pthread_self(), _log_async_thread))
+           eina_log_async_flush();
+        return EINA_FALSE;
+     }
+
+   ring = eina_log_async_ring_get();
+   if (!ring)
+      return EINA_FALSE;
+
+   va_copy(copy, args);
+   len = vsnprintf(buf, sizeof(buf), fmt, copy);
+   va_end(copy);
+   if (len < 0)
+      return EINA_TRUE;
+
+   if ((unsigned int)len >= sizeof(buf))
+     {
+        if (len >= EINA_LOG_ASYNC_MESSAGE_MAX)
+           len = EINA_LOG_ASYNC_MESSAGE_MAX - 1;
+        msg = malloc(len + 1);
+        if (!msg)
+           return EINA_FALSE;
+        va_copy(copy, args);
+        vsnprintf(msg, len + 1, fmt, copy);
+        va_end(copy);
+     }
+
+   needed = EINA_LOG_ASYNC_ALIGN(sizeof(Eina_Log_Async_Record) + len + 1);
+
+   tail = ring->tail;
+   head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+   pos = tail & (EINA_LOG_ASYNC_RING_SIZE - 1);
+   to_end = EINA_LOG_ASYNC_RING_SIZE - pos;
+
+   if (to_end < needed)
+     {
+        if (EINA_LOG_ASYNC_RING_SIZE - (tail - head) < to_end + needed)
+           goto drop;
+
+        ((Eina_Log_Async_Record *)(ring->u.buffer + pos))->size = 0;
+        tail += to_end;
+        pos = 0;
+     }
+   else if (EINA_LOG_ASYNC_RING_SIZE - (tail - head) < needed)
+      goto drop;
+
+   rec = (Eina_Log_Async_Record *)(ring->u.buffer + pos);
+   rec->size = needed;
+   rec->domain = domain;
+   rec->level = level;
+   rec->line = line;
+   rec->file = file;
+   rec->fnc = fnc;
+   rec->thread = pthread_self();
+   memcpy(rec + 1, msg, len + 1);
+
+   __atomic_store_n(&ring->tail, tail + needed, __ATOMIC_RELEASE);
+   if (msg != buf)
+      free(msg);
+
+   __atomic_thread_fence(__ATOMIC_SEQ_CST);
+   if (__atomic_load_n(&_log_async_sleeping, __ATOMIC_RELAXED))
+     {
+        pthread_mutex_lock(&_log_async_mutex);
+        pthread_cond_signal(&_log_async_cond);
+        pthread_mutex_unlock(&_log_async_mutex);
+     }
+
+   return EINA_TRUE;
+
+drop:
+   if (msg != buf)
+      free(msg);
+   __atomic_add_fetch(&ring->dropped, 1, __ATOMIC_RELAXED);
+   return EINA_TRUE;
+}
+
+/* Print everything queued in ring, return the number of records. */
+static unsigned int
+eina_log_async_ring_drain(Eina_Log_Async_Ring *ring)
+{
+   unsigned int head, tail, dropped;
+   unsigned int count = 0;
+
+   head = ring->head;
+   tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+   dropped = __atomic_exchange_n(&ring->dropped, 0, __ATOMIC_RELAXED);
+   if ((head == tail) && (!dropped))
+      return 0;
+
+   while (head != tail)
+     {
+        Eina_Log_Async_Record *rec;
+        unsigned int pos;
+
+        pos = head & (EINA_LOG_ASYNC_RING_SIZE - 1);
+        rec = (Eina_Log_Async_Record *)(ring->u.buffer + pos);
+        if (rec->size == 0)
+          {
+             head += EINA_LOG_ASYNC_RING_SIZE - pos;
+             continue;
+          }
+
+        // the domain may have been unregistered in the meantime, the
+        // print lock keeps it from changing while printing
+        LOG_PRINT_LOCK();
+        if (((unsigned int)rec->domain < _log_domains_count) &&
+            (!_log_domains[rec->domain].deleted))
+          {
+             _log_async_printing = EINA_TRUE;
+             _log_async_origin = rec->thread;
+             eina_log_async_print_cb_call(_log_domains + rec->domain,
+                                          rec->level, rec->file, rec->fnc,
+                                          rec->line, "%s",
+                                          (const char *)(rec + 1));
+             _log_async_printing = EINA_FALSE;
+          }
+        LOG_PRINT_UNLOCK();
+
+        head += rec->size;
+        __atomic_store_n(&ring->head, head, __ATOMIC_RELEASE);
+        count++;
+     }
+
+   if (dropped)
+     {
+        LOG_PRINT_LOCK();
+        _log_async_printing = EINA_TRUE;
+        _log_async_origin = _log_async_thread;
+        eina_log_async_print_cb_call(_log_domains + EINA_LOG_DOMAIN_GLOBAL,
+                                     EINA_LOG_LEVEL_WARN, __FILE__,
+                                     __FUNCTION__, __LINE__,
+                                     "%u log messages dropped, "
+                                     "the queue was full", dropped);
+        _log_async_printing = EINA_FALSE;
+        LOG_PRINT_UNLOCK();
+     }
+
+   return count;
+}
+
+/* Drain all rings, freeing the ones of exited threads. */
+static unsigned int
+eina_log_async_drain(void)
+{
+   Eina_Log_Async_Ring *ring;
+   Eina_Inlist *l;
+   unsigned int count = 0;
+
+   pthread_mutex_lock(&_log_async_mutex);
+   l = _log_async_rings;
+   pthread_mutex_unlock(&_log_async_mutex);
+
+   // rings are only appended by other threads, removed here
+   while (l)
+     {
+        Eina_Bool dead;
+
+        ring = EINA_INLIST_CONTAINER_GET(l, Eina_Log_Async_Ring);
+        dead = __atomic_load_n(&ring->dead, __ATOMIC_ACQUIRE);
+        count += eina_log_async_ring_drain(ring);
+
+        pthread_mutex_lock(&_log_async_mutex);
+        l = l->next;
+        if (dead)
+          {
+             _log_async_rings = eina_inlist_remove(_log_async_rings,
+                                                   EINA_INLIST_GET(ring));
+             free(ring);
+          }
+        pthread_mutex_unlock(&_log_async_mutex);
+     }
+
+   return count;
+}
+
+static void *
+eina_log_async_main(void *data __UNUSED__)
+{
+   pthread_mutex_lock(&_log_async_mutex);
+   while (!_log_async_quit)
+     {
+        unsigned int request;
+        unsigned int count;
+        struct timespec ts;
+
+        // one pass is enough to flush what was queued before the request
+        request = _log_async_flush_request;
+        pthread_mutex_unlock(&_log_async_mutex);
+        count = eina_log_async_drain();
+        pthread_mutex_lock(&_log_async_mutex);
+
+        _log_async_flush_done = request;
+        pthread_cond_broadcast(&_log_async_flushed);
+        if ((count > 0) || (request != _log_async_flush_request))
+           continue;
+
+        // producers check it after queueing, so look at the rings again
+        __atomic_store_n(&_log_async_sleeping, 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&_log_async_mutex);
+        count = eina_log_async_drain();
+        pthread_mutex_lock(&_log_async_mutex);
+
+        if ((count == 0) && (!_log_async_quit) &&
+            (request == _log_async_flush_request))
+          {
+             // the timeout only bounds the delay of the dropped summary
+             clock_gettime(CLOCK_REALTIME, &ts);
+             ts.tv_sec += 1;
+             pthread_cond_timedwait(&_log_async_cond, &_log_async_mutex, &ts);
+          }
+        __atomic_store_n(&_log_async_sleeping, 0, __ATOMIC_RELAXED);
+     }
+   pthread_mutex_unlock(&_log_async_mutex);
+
+   eina_log_async_drain();
+   return NULL;
+}
+#endif
+
+/* Print a message that went through eina_log_print_filter(). */
+static void
+eina_log_print_filtered(int domain, Eina_Log_Level level, const char *file,
+                        const char *fnc, int line, const char *fmt,
+                        va_list args)
+{
+#ifdef EINA_LOG_ASYNC
+   if (EINA_UNLIKELY(_log_async) &&
+       eina_log_async_push(domain, level, file, fnc, line, fmt, args))
+      return;
+#endif
+   LOG_LOCK();
+   eina_log_print_unlocked(domain, level, file, fnc, line, fmt, args);
+   LOG_UNLOCK();
+}
+
+/* Tell how many messages of a call site the rate limit dropped. */
+static void
+eina_log_print_resumed(int domain, Eina_Log_Level level, const char *file,
+                       const char *fnc, int line, const char *fmt, ...)
+{
+   va_list args;
+
+   va_start(args, fmt);
+   eina_log_print_filtered(domain, level, file, fnc, line, fmt, args);
+   va_end(args);
+}
+
+/*
+ * Match a site against "file[:line]", the file being a fnmatch() pattern
+ * of the path of the site or of its last component.
+ */
+static Eina_Bool
+eina_log_site_match(const Eina_Log_Site *site, const char *file_pattern,
+                    int line)
+{
+   const char *base;
+
+   if ((line > 0) && (site->line != line))
+      return EINA_FALSE;
+
+   if (!site->file)
+      return EINA_FALSE;
+
+   if (!fnmatch(file_pattern, site->file, 0))
+      return EINA_TRUE;
+
+   base = strrchr(site->file, '/');
+   if (base && !fnmatch(file_pattern, base + 1, 0))
+      return EINA_TRUE;
+
+   return EINA_FALSE;
+}
+
+static unsigned int
+eina_log_sites_state_set_range(Eina_Log_Site *start, Eina_Log_Site *stop,
+                               const char *pattern, size_t len,
+                               Eina_Log_Site_State state)
+{
+   Eina_Log_Site *site;
+   char file_pattern[1024];
+   const char *colon;
+   char *end;
+   unsigned int count = 0;
+   int line = 0;
+
+   if ((len == 0) || (len >= sizeof(file_pattern)))
+      return 0;
+
+   memcpy(file_pattern, pattern, len);
+   file_pattern[len] = '\0';
+
+   colon = strrchr(file_pattern, ':');
+   if (colon && (colon[1] != '\0'))
+     {
+        line = strtol(colon + 1, &end, 10);
+        if ((*end == '\0') && (line > 0))
+           file_pattern[colon - file_pattern] = '\0';
+        else
+           line = 0;
+     }
+
+   for (site = start; site < stop; site++)
+     {
+        if (!eina_log_site_match(site, file_pattern, line))
+           continue;
+
+        site->state = state;
+        count++;
+     }
+
+   return count;
+}
+
+/* Apply the comma separated patterns of EINA_LOG_SITES to a range. */
+static void
+eina_log_sites_patterns_apply(Eina_Log_Site *start, Eina_Log_Site *stop)
+{
+   const char *p, *end;
+   Eina_Log_Site_State state;
+
+   if (!_log_site_patterns)
+      return;
+
+   for (p = _log_site_patterns; *p; p = end)
+     {
+        end = strchr(p, ',');
+        if (!end)
+           end = p + strlen(p);
+
+        state = EINA_LOG_SITE_ENABLED;
+        if (*p == '-')
+          {
+             state = EINA_LOG_SITE_DISABLED;
+             p++;
+          }
+
+        if (p < end)
+           eina_log_sites_state_set_range(start, stop, p, end - p, state);
+
+        if (*end == ',')
+           end++;
+     }
+}
+
+#endif
+
+/**
+ * @endcond
+ */
+
+
+/*============================================================================*
+*                                 Global                                     *
+*============================================================================*/
+
+/**
+ * @internal
+ * @brief Initialize the log module.
+ *
+ * @return #EINA_TRUE on success, #EINA_FALSE on failure.
+ *
+ * This function sets up the log module of Eina. It is called by
+ * eina_init().
+ *
+ * @see eina_init()
+ *
+ * @warning Not-MT: just call this function from main thread! The
+ *          place where this function was called the first time is
+ *          considered the main thread.
+ */
+Eina_Bool
+eina_log_init(void)
+{
+#ifdef EINA_ENABLE_LOG
+   const char *level, *tmp;
+   int color_disable;
+
+   assert((sizeof(_names) / sizeof(_names[0])) == EINA_LOG_LEVELS);
+
+#ifdef EINA_LOG_BACKTRACE
+   if ((tmp = getenv(EINA_LOG_ENV_BACKTRACE)))
+     _backtrace_level = atoi(tmp);
+#endif
+
+   if ((tmp = getenv(EINA_LOG_ENV_COLOR_DISABLE)))
+      color_disable = atoi(tmp);
+   else
+      color_disable = -1;
+
+   /* Check if color is explicitly disabled */
+   if (color_disable == 1)
+      _disable_color = EINA_TRUE;
+
+#ifndef _WIN32
+   /* color was not explicitly disabled or enabled, guess it */
+   else if (color_disable == -1)
+     {
+        if (!eina_log_term_color_supported(getenv("TERM")))
+           _disable_color = EINA_TRUE;
+        else
+          {
+             /* if not a terminal, but redirected to a file, disable color */
+             int fd;
+
+             if (_print_cb == eina_log_print_cb_stderr)
+                fd = STDERR_FILENO;
+             else if (_print_cb == eina_log_print_cb_stdout)
+                fd = STDOUT_FILENO;
+             else
+                fd = -1;
+
+             if ((fd >= 0) && (!isatty(fd)))
+                _disable_color = EINA_TRUE;
+          }
+     }
+#endif
+
+   if ((tmp = getenv(EINA_LOG_ENV_FILE_DISABLE)) && (atoi(tmp) == 1))
+      _disable_file = EINA_TRUE;
+
+   if ((tmp = getenv(EINA_LOG_ENV_FUNCTION_DISABLE)) && (atoi(tmp) == 1))
+      _disable_function = EINA_TRUE;
+
+   if ((tmp = getenv(EINA_LOG_ENV_ABORT)) && (atoi(tmp) == 1))
+      _abort_on_critical = EINA_TRUE;
+
+   if ((tmp = getenv(EINA_LOG_ENV_ABORT_LEVEL)))
+      _abort_level_on_critical = atoi(tmp);
+
+   eina_log_print_prefix_update();
+
+   // Global log level
+   if ((level = getenv(EINA_LOG_ENV_LEVEL)))
+      _log_level = atoi(level);
+
+   // Register UNKNOWN domain, the default logger
+   EINA_LOG_DOMAIN_GLOBAL = eina_log_domain_register("", NULL);
+
+   if (EINA_LOG_DOMAIN_GLOBAL < 0)
+     {
+        fprintf(stderr, "Failed to create global logging domain.\n");
+        return EINA_FALSE;
+     }
+
+   // Parse pending domains passed through EINA_LOG_LEVELS_GLOB
+   eina_log_domain_parse_pending_globs();
+
+   // Parse pending domains passed through EINA_LOG_LEVELS
+   eina_log_domain_parse_pendings();
+
+   // Call sites enabled or disabled through EINA_LOG_SITES
+   if ((tmp = getenv(EINA_LOG_ENV_SITES)))
+      _log_site_patterns = strdup(tmp);
+
+#ifdef EINA_LOG_SITES
+   eina_log_sites_register(__start___eina_log_sites, __stop___eina_log_sites);
+#endif
+   LOG_SITES_CHANGED();
+
+   if ((tmp = getenv(EINA_LOG_ENV_ASYNC)) && (atoi(tmp) == 1))
+      eina_log_async_set(EINA_TRUE);
+
+#endif
+   return EINA_TRUE;
+}
+
+/**
+ * @internal
+ * @brief Shut down the log module.
+ *
+ * @return #EINA_TRUE on success, #EINA_FALSE on failure.
+ *
+ * This function shuts down the log module set up by
+ * eina_log_init(). It is called by eina_shutdown().
+ *
+ * @see eina_shutdown()
+ *
+ * @warning Not-MT: just call this function from main thread! The
+ *          place where eina_log_init() (eina_init()) was called the
+ *          first time is considered the main thread.
+ */
+Eina_Bool
+eina_log_shutdown(void)
+{
+#ifdef EINA_ENABLE_LOG
+   Eina_Inlist *tmp;
+   unsigned int i;
+
+#ifdef EINA_LOG_ASYNC
+   eina_log_async_set(EINA_FALSE);
+   while (_log_async_rings)
+     {
+        tmp = _log_async_rings;
+        _log_async_rings = _log_async_rings->next;
+        free(tmp);
+     }
+   if (_log_async_key_created)
+     {
+        pthread_key_delete(_log_async_key);
+        _log_async_key_created = EINA_FALSE;
+     }
+#endif
+
+#ifdef EFL_HAVE_POSIX_THREADS
+   if (_log_line_key_created)
+     {
+        Eina_Log_Line *line;
+
+        // the key is kept, logging may happen before eina_log_init()
+        line = pthread_getspecific(_log_line_key);
+        if (line)
+          {
+             pthread_setspecific(_log_line_key, NULL);
+             eina_log_line_del(line);
+          }
+     }
+#else
+   free(_log_line.buf);
+   _log_line.buf = NULL;
+   _log_line.size = 0;
+#endif
+
+   while (_log_domains_count--)
+     {
+        if (_log_domains[_log_domains_count].deleted)
+           continue;
+
+        eina_log_domain_free(&_log_domains[_log_domains_count]);
+     }
+
+        free(_log_domains);
+
+   _log_domains = NULL;
+   _log_domains_count = 0;
+   _log_domains_allocated = 0;
+
+   for (i = 0; i < EINA_LOG_SLOTS_CHUNKS; i++)
+     {
+        free(_log_domain_slots[i]);
+        _log_domain_slots[i] = NULL;
+     }
+
+   while (_glob_list)
+     {
+        tmp = _glob_list;
+        _glob_list = _glob_list->next;
+        free(tmp);
+     }
+
+   while (_pending_list)
+     {
+        tmp = _pending_list;
+        _pending_list = _pending_list->next;
+        free(tmp);
+     }
+
+   while (_log_site_ranges)
+     {
+        tmp = _log_site_ranges;
+        _log_site_ranges = _log_site_ranges->next;
+        free(tmp);
+     }
+
+   free(_log_site_patterns);
+   _log_site_patterns = NULL;
+   LOG_SITES_CHANGED();
+
+#endif
+   return EINA_TRUE;
+}
+
+#ifdef EFL_HAVE_THREADS
+
+/**
+ * @internal
+ * @brief Activate the log mutex.
+ *
+ * This function activate the mutex in the eina log module. It is called by
+ * eina_threads_init().
+ *
+ * @see eina_threads_init()
+ */
+void
+eina_log_threads_init(void)
+{
+#ifdef EINA_ENABLE_LOG
+   if (_threads_inited) return;
+   _main_thread = SELF();
+   if (!INIT()) return;
+   _threads_inited = EINA_TRUE;
+#endif
+}
+
+/**
+ * @internal
+ * @brief Shut down the log mutex.
+ *
+ * This function shuts down the mutex in the log module.
+ * It is called by eina_threads_shutdown().
+ *
+ * @see eina_threads_shutdown()
+ */
+void
+eina_log_threads_shutdown(void)
+{
+#ifdef EINA_ENABLE_LOG
+   if (!_threads_inited) return;
+   CHECK_MAIN();
+#ifdef EINA_LOG_ASYNC
+   eina_log_async_set(EINA_FALSE);
+#endif
+   SHUTDOWN();
+   _threads_enabled = EINA_FALSE;
+   _threads_inited = EINA_FALSE;
+#endif
+}
+
+#endif
+
+/*============================================================================*
+*                                   API                                      *
+*============================================================================*/
+
+/**
  * @cond LOCAL
  */
 
 EAPI int EINA_LOG_DOMAIN_GLOBAL = 0;
+EAPI volatile unsigned int _eina_log_site_generation = 1;
 
 /**
  * @endcond
@@ -1540,9 +3646,11 @@ eina_log_print_cb_set(Eina_Log_Print_Cb cb, void *data)
 {
 #ifdef EINA_ENABLE_LOG
    LOG_LOCK();
+   LOG_PRINT_LOCK();
    _print_cb = cb;
    _print_cb_data = data;
    eina_log_print_prefix_update();
+   LOG_PRINT_UNLOCK();
    LOG_UNLOCK();
 #else
    (void) cb;
@@ -1557,7 +3665,11 @@ eina_log_level_set(int level)
    _log_level = level;
    if (EINA_LIKELY((EINA_LOG_DOMAIN_GLOBAL >= 0) &&
                    ((unsigned int)EINA_LOG_DOMAIN_GLOBAL < _log_domains_count)))
-      _log_domains[EINA_LOG_DOMAIN_GLOBAL].level = level;
+     {
+        _log_domains[EINA_LOG_DOMAIN_GLOBAL].level = level;
+        eina_log_domain_slot_update(EINA_LOG_DOMAIN_GLOBAL);
+     }
+   LOG_SITES_CHANGED();
 #else
    (void) level;
 #endif
@@ -1683,6 +3795,77 @@ eina_log_abort_on_critical_level_get(void)
 #endif
 }
 
+EAPI Eina_Bool
+eina_log_async_set(Eina_Bool async)
+{
+#if defined (EINA_LOG_ASYNC) && defined (EINA_ENABLE_LOG)
+   if (async == _log_async) return EINA_TRUE;
+
+   if (async)
+     {
+        if (!_log_async_key_created)
+          {
+             if (pthread_key_create(&_log_async_key, eina_log_async_ring_del))
+                return EINA_FALSE;
+             _log_async_key_created = EINA_TRUE;
+          }
+
+        // records are printed from another thread, so lock
+        eina_log_threads_enable();
+        if (!_threads_enabled) return EINA_FALSE;
+
+        _log_async_quit = EINA_FALSE;
+        if (pthread_create(&_log_async_thread, NULL, eina_log_async_main, NULL))
+           return EINA_FALSE;
+        _log_async = EINA_TRUE;
+     }
+   else
+     {
+        _log_async = EINA_FALSE;
+
+        pthread_mutex_lock(&_log_async_mutex);
+        _log_async_quit = EINA_TRUE;
+        pthread_cond_signal(&_log_async_cond);
+        pthread_mutex_unlock(&_log_async_mutex);
+
+        pthread_join(_log_async_thread, NULL);
+     }
+
+   return EINA_TRUE;
+#else
+   return !async;
+#endif
+}
+
+EAPI Eina_Bool
+eina_log_async_get(void)
+{
+#if defined (EINA_LOG_ASYNC) && defined (EINA_ENABLE_LOG)
+   return _log_async;
+#else
+   return EINA_FALSE;
+#endif
+}
+
+EAPI void
+eina_log_async_flush(void)
+{
+#if defined (EINA_LOG_ASYNC) && defined (EINA_ENABLE_LOG)
+   unsigned int request;
+
+   if (!_log_async) return;
+   // the async thread would wait for itself
+   if (pthread_equal(pthread_self(), _log_async_thread)) return;
+
+   pthread_mutex_lock(&_log_async_mutex);
+   request = ++_log_async_flush_request;
+   pthread_cond_signal(&_log_async_cond);
+   while ((int)(_log_async_flush_done - request) < 0)
+      pthread_cond_wait(&_log_async_flushed, &_log_async_mutex);
+   pthread_mutex_unlock(&_log_async_mutex);
+#endif
+}
+
 EAPI int
 eina_log_domain_register(const char *name, const char *color)
 {
@@ -1737,90 +3920,451 @@ eina_log_domain_level_set(const char *domain_name, int level)
            continue;
 
         _log_domains[i].level = level;
+        eina_log_domain_slot_update(i);
+        LOG_SITES_CHANGED();
+        return;
+     }
+
+   pending = eina_log_domain_pending_get(domain_name, namelen);
+   if (pending)
+      pending->level = level;
+#else
+   (void) domain_name;
+   (void) level;
+#endif
+}
+
+EAPI int
+eina_log_domain_level_get(const char *domain_name)
+{
+#ifdef EINA_ENABLE_LOG
+   Eina_Log_Domain_Level_Pending *pending;
+   size_t namelen;
+   unsigned int i;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(domain_name, EINA_LOG_LEVEL_UNKNOWN);
+
+   namelen = strlen(domain_name);
+
+   for (i = 0; i < _log_domains_count; i++)
+     {
+        if (_log_domains[i].deleted)
+           continue;
+
+        if ((namelen != _log_domains[i].namelen) ||
+            (strcmp(_log_domains[i].name, domain_name) != 0))
+           continue;
+
+        return _log_domains[i].level;
+     }
+
+   EINA_INLIST_FOREACH(_pending_list, pending)
+   {
+      // only a sampling or a rate limit may have been set
+      if ((namelen == pending->namelen) &&
+          (strcmp(pending->name, domain_name) == 0) &&
+          ((int)pending->level != EINA_LOG_LEVEL_UNKNOWN))
+         return pending->level;
+   }
+
+   EINA_INLIST_FOREACH(_glob_list, pending)
+   {
+      if (!fnmatch(pending->name, domain_name, 0))
+         return pending->level;
+   }
+
+   return _log_level;
+#else
+   (void) domain_name;
+   return 0;
+#endif
+}
+
+EAPI int
+eina_log_domain_registered_level_get(int domain)
+{
+#ifdef EINA_ENABLE_LOG
+   EINA_SAFETY_ON_FALSE_RETURN_VAL(domain >= 0, EINA_LOG_LEVEL_UNKNOWN);
+   EINA_SAFETY_ON_FALSE_RETURN_VAL((unsigned int)domain < _log_domains_count,
+                                   EINA_LOG_LEVEL_UNKNOWN);
+   EINA_SAFETY_ON_TRUE_RETURN_VAL(_log_domains[domain].deleted,
+                                  EINA_LOG_LEVEL_UNKNOWN);
+   return _log_domains[domain].level;
+#else
+   (void) domain;
+   return 0;
+#endif
+}
+
+EAPI void
+eina_log_domain_sampling_set(const char *domain_name, unsigned int n)
+{
+#ifdef EINA_ENABLE_LOG
+   Eina_Log_Domain_Level_Pending *pending;
+   Eina_Log_Domain *d;
+   size_t namelen;
+
+   EINA_SAFETY_ON_NULL_RETURN(domain_name);
+
+   namelen = strlen(domain_name);
+
+   d = eina_log_domain_find(domain_name, namelen);
+   if (d)
+     {
+        d->sampling = n;
+        eina_log_domain_slot_update(d - _log_domains);
+        return;
+     }
+
+   pending = eina_log_domain_pending_get(domain_name, namelen);
+   if (pending)
+      pending->sampling = n;
+#else
+   (void) domain_name;
+   (void) n;
+#endif
+}
+
+EAPI unsigned int
+eina_log_domain_sampling_get(const char *domain_name)
+{
+#ifdef EINA_ENABLE_LOG
+   Eina_Log_Domain_Level_Pending *pending;
+   Eina_Log_Domain *d;
+   size_t namelen;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(domain_name, 0);
+
+   namelen = strlen(domain_name);
+
+   d = eina_log_domain_find(domain_name, namelen);
+   if (d)
+      return d->sampling;
+
+   EINA_INLIST_FOREACH(_pending_list, pending)
+   {
+      if ((namelen == pending->namelen) &&
+          (strcmp(pending->name, domain_name) == 0))
+         return pending->sampling;
+   }
+
+   return 0;
+#else
+   (void) domain_name;
+   return 0;
+#endif
+}
+
+EAPI void
+eina_log_domain_rate_limit_set(const char *domain_name, unsigned int burst,
+                               double interval)
+{
+#ifdef EINA_ENABLE_LOG
+   Eina_Log_Domain_Level_Pending *pending;
+   Eina_Log_Domain *d;
+   size_t namelen;
+
+   EINA_SAFETY_ON_NULL_RETURN(domain_name);
+
+   namelen = strlen(domain_name);
+   if (interval < 0.0)
+      interval = 0.0;
+
+   d = eina_log_domain_find(domain_name, namelen);
+   if (d)
+     {
+        d->rate_burst = burst;
+        d->rate_interval = interval;
+        eina_log_domain_slot_update(d - _log_domains);
+        return;
+     }
+
+   pending = eina_log_domain_pending_get(domain_name, namelen);
+   if (pending)
+     {
+        pending->rate_burst = burst;
+        pending->rate_interval = interval;
+     }
+#else
+   (void) domain_name;
+   (void) burst;
+   (void) interval;
+#endif
+}
+
+EAPI void
+eina_log_domain_rate_limit_get(const char *domain_name, unsigned int *burst,
+                               double *interval)
+{
+#ifdef EINA_ENABLE_LOG
+   Eina_Log_Domain_Level_Pending *pending;
+   Eina_Log_Domain *d;
+   size_t namelen;
+
+   if (burst) *burst = 0;
+   if (interval) *interval = 0.0;
+
+   EINA_SAFETY_ON_NULL_RETURN(domain_name);
+
+   namelen = strlen(domain_name);
+
+   d = eina_log_domain_find(domain_name, namelen);
+   if (d)
+     {
+        if (burst) *burst = d->rate_burst;
+        if (interval) *interval = d->rate_interval;
+        return;
+     }
+
+   EINA_INLIST_FOREACH(_pending_list, pending)
+   {
+      if ((namelen == pending->namelen) &&
+          (strcmp(pending->name, domain_name) == 0))
+        {
+           if (burst) *burst = pending->rate_burst;
+           if (interval) *interval = pending->rate_interval;
+           return;
+        }
+   }
+#else
+   if (burst) *burst = 0;
+   if (interval) *interval = 0.0;
+   (void) domain_name;
+#endif
+}
+
+EAPI unsigned int
+eina_log_domain_suppressed_get(int domain)
+{
+#ifdef EINA_ENABLE_LOG
+   EINA_SAFETY_ON_FALSE_RETURN_VAL(domain >= 0, 0);
+   EINA_SAFETY_ON_FALSE_RETURN_VAL((unsigned int)domain < _log_domains_count,
+                                   0);
+   EINA_SAFETY_ON_TRUE_RETURN_VAL(_log_domains[domain].deleted, 0);
+   return LOG_ATOMIC_LOAD(&eina_log_domain_slot_get(domain)->suppressed);
+#else
+   (void) domain;
+   return 0;
+#endif
+}
+
+EAPI int
+eina_log_site_sync(Eina_Log_Site *site, int domain, int level)
+{
+#ifdef EINA_ENABLE_LOG
+   Eina_Log_Domain_Slot *slot;
+   unsigned int generation, sequence;
+   int domain_level = EINA_LOG_LEVEL_UNKNOWN;
+   int enabled;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(site, 0);
+
+   // read first, a change while computing makes the next call sync again
+   generation = LOG_ATOMIC_LOAD(&_eina_log_site_generation);
+
+   slot = eina_log_domain_slot_get(domain);
+   if (slot)
+      domain_level = LOG_ATOMIC_LOAD(&slot->level);
+
+   if (site->state == EINA_LOG_SITE_ENABLED)
+      enabled = 1;
+   else if (site->state == EINA_LOG_SITE_DISABLED)
+      enabled = 0;
+   else if (EINA_UNLIKELY(domain_level == EINA_LOG_LEVEL_UNKNOWN))
+      enabled = 1; // let eina_log_print_unlocked() report it
+   else
+      enabled = (level <= domain_level);
+
+   // see eina_log_site_enabled(), only one thread writes the cache
+#ifdef __ATOMIC_ACQUIRE
+   sequence = __atomic_load_n(&site->sequence, __ATOMIC_RELAXED);
+   if ((sequence & 1) ||
+       (!__atomic_compare_exchange_n(&site->sequence, &sequence, sequence + 1,
+                                     0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)))
+      return enabled;
+   __atomic_thread_fence(__ATOMIC_RELEASE);
+
+   __atomic_store_n(&site->domain, domain, __ATOMIC_RELAXED);
+   __atomic_store_n(&site->level, level, __ATOMIC_RELAXED);
+   __atomic_store_n(&site->enabled, enabled, __ATOMIC_RELAXED);
+   __atomic_store_n(&site->generation, generation, __ATOMIC_RELAXED);
+   __atomic_store_n(&site->sequence, sequence + 2, __ATOMIC_RELEASE);
+#else
+   sequence = site->sequence;
+   if (sequence & 1)
+      return enabled;
+   site->sequence = sequence + 1;
+
+   site->domain = domain;
+   site->level = level;
+   site->enabled = enabled;
+   site->generation = generation;
+   site->sequence = sequence + 2;
+#endif
+
+   return enabled;
+#else
+   (void) site;
+   (void) domain;
+   (void) level;
+   return 0;
+#endif
+}
+
+EAPI void
+eina_log_site_print(const Eina_Log_Site *site, int domain, int level,
+                    const char *fmt, ...)
+{
+#ifdef EINA_ENABLE_LOG
+   unsigned int resumed = 0;
+   va_list args;
+
+#ifdef EINA_SAFETY_CHECKS
+   if (EINA_UNLIKELY(!site))
+     {
+        fputs("ERR: eina_log_site_print() site == NULL\n", stderr);
+        return;
+     }
+
+   if (EINA_UNLIKELY(!fmt))
+     {
+        fputs("ERR: eina_log_site_print() fmt == NULL\n", stderr);
         return;
      }
 
-   EINA_INLIST_FOREACH(_pending_list, pending)
+#endif
+   if (!eina_log_print_filter(domain, level, site->file, site->line,
+                              site->state == EINA_LOG_SITE_ENABLED,
+                              &resumed))
+      return;
+
+   va_start(args, fmt);
+   eina_log_print_filtered(domain, level, site->file, site->fnc,
+                           site->line, fmt, args);
+   va_end(args);
+
+   if (EINA_UNLIKELY(resumed))
+      eina_log_print_resumed(domain, level, site->file, site->fnc,
+                             site->line,
+                             "%u similar messages were suppressed", resumed);
+#else
+   (void) site;
+   (void) domain;
+   (void) level;
+   (void) fmt;
+#endif
+}
+
+EAPI void
+eina_log_sites_register(Eina_Log_Site *start, Eina_Log_Site *stop)
+{
+#ifdef EINA_ENABLE_LOG
+   Eina_Log_Site_Range *range;
+
+   // no sites, the bounds of an empty section are NULL
+   if ((!start) || (stop <= start))
+      return;
+
+   LOG_LOCK();
+   EINA_INLIST_FOREACH(_log_site_ranges, range)
    {
-      if ((namelen == pending->namelen) &&
-          (strcmp(pending->name, domain_name) == 0))
+      if (range->start == start)
         {
-           pending->level = level;
+           LOG_UNLOCK();
            return;
         }
    }
 
-   pending = malloc(sizeof(Eina_Log_Domain_Level_Pending) + namelen + 1);
-   if (!pending)
-      return;
-
-   pending->level = level;
-   pending->namelen = namelen;
-   memcpy(pending->name, domain_name, namelen + 1);
+   range = malloc(sizeof(Eina_Log_Site_Range));
+   if (range)
+     {
+        range->start = start;
+        range->stop = stop;
+        _log_site_ranges = eina_inlist_append(_log_site_ranges,
+                                              EINA_INLIST_GET(range));
+        eina_log_sites_patterns_apply(start, stop);
+     }
+   LOG_UNLOCK();
 
-   _pending_list = eina_inlist_append(_pending_list, EINA_INLIST_GET(pending));
+   LOG_SITES_CHANGED();
 #else
-   (void) domain_name;
-   (void) level;
+   (void) start;
+   (void) stop;
 #endif
 }
 
-EAPI int
-eina_log_domain_level_get(const char *domain_name)
+EAPI void
+eina_log_sites_unregister(Eina_Log_Site *start)
 {
 #ifdef EINA_ENABLE_LOG
-   Eina_Log_Domain_Level_Pending *pending;
-   size_t namelen;
-   unsigned int i;
-
-   EINA_SAFETY_ON_NULL_RETURN_VAL(domain_name, EINA_LOG_LEVEL_UNKNOWN);
-
-   namelen = strlen(domain_name);
-
-   for (i = 0; i < _log_domains_count; i++)
-     {
-        if (_log_domains[i].deleted)
-           continue;
-
-        if ((namelen != _log_domains[i].namelen) ||
-            (strcmp(_log_domains[i].name, domain_name) != 0))
-           continue;
+   Eina_Log_Site_Range *range;
 
-        return _log_domains[i].level;
-     }
+   if (!start)
+      return;
 
-   EINA_INLIST_FOREACH(_pending_list, pending)
+   LOG_LOCK();
+   EINA_INLIST_FOREACH(_log_site_ranges, range)
    {
-      if ((namelen == pending->namelen) &&
-          (strcmp(pending->name, domain_name) == 0))
-         return pending->level;
+      if (range->start == start)
+        {
+           _log_site_ranges = eina_inlist_remove(_log_site_ranges,
+                                                 EINA_INLIST_GET(range));
+           free(range);
+           break;
+        }
    }
+   LOG_UNLOCK();
+#else
+   (void) start;
+#endif
+}
 
-   EINA_INLIST_FOREACH(_glob_list, pending)
+EAPI void
+eina_log_sites_foreach(Eina_Log_Site_Cb cb, const void *data)
+{
+#ifdef EINA_ENABLE_LOG
+   Eina_Log_Site_Range *range;
+   Eina_Log_Site *site;
+
+   EINA_SAFETY_ON_NULL_RETURN(cb);
+
+   LOG_LOCK();
+   EINA_INLIST_FOREACH(_log_site_ranges, range)
    {
-      if (!fnmatch(pending->name, domain_name, 0))
-         return pending->level;
+      for (site = range->start; site < range->stop; site++)
+        {
+           if (!cb(site, (void *)data))
+              goto end;
+        }
    }
-
-   return _log_level;
+end:
+   LOG_UNLOCK();
 #else
-   (void) domain_name;
-   return 0;
+   (void) cb;
+   (void) data;
 #endif
 }
 
-EAPI int
-eina_log_domain_registered_level_get(int domain)
+EAPI unsigned int
+eina_log_sites_state_set(const char *pattern, Eina_Log_Site_State state)
 {
 #ifdef EINA_ENABLE_LOG
-   EINA_SAFETY_ON_FALSE_RETURN_VAL(domain >= 0, EINA_LOG_LEVEL_UNKNOWN);
-   EINA_SAFETY_ON_FALSE_RETURN_VAL((unsigned int)domain < _log_domains_count,
-                                   EINA_LOG_LEVEL_UNKNOWN);
-   EINA_SAFETY_ON_TRUE_RETURN_VAL(_log_domains[domain].deleted,
-                                  EINA_LOG_LEVEL_UNKNOWN);
-   return _log_domains[domain].level;
+   Eina_Log_Site_Range *range;
+   unsigned int count = 0;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(pattern, 0);
+
+   LOG_LOCK();
+   EINA_INLIST_FOREACH(_log_site_ranges, range)
+     count += eina_log_sites_state_set_range(range->start, range->stop,
+                                             pattern, strlen(pattern), state);
+   LOG_UNLOCK();
+
+   LOG_SITES_CHANGED();
+   return count;
 #else
-   (void) domain;
+   (void) pattern;
+   (void) state;
    return 0;
 #endif
 }
@@ -1856,9 +4400,12 @@ eina_log_print_cb_stderr(const Eina_Log_Domain *d,
                          va_list args)
 {
 #ifdef EINA_ENABLE_LOG
-   _eina_log_print_prefix(stderr, d, level, file, fnc, line);
-   vfprintf(stderr, fmt, args);
-   putc('\n', stderr);
+   Eina_Log_Out out;
+
+   eina_log_out_begin(&out, stderr, EINA_TRUE);
+   _eina_log_print_prefix(&out, d, level, file, fnc, line);
+   eina_log_out_vprintf(&out, fmt, args);
+   eina_log_out_end(&out);
    DISPLAY_BACKTRACE(stderr, level);
 #else
    (void) d;
@@ -1883,9 +4430,12 @@ eina_log_print_cb_stdout(const Eina_Log_Domain *d,
                          va_list args)
 {
 #ifdef EINA_ENABLE_LOG
-   _eina_log_print_prefix(stdout, d, level, file, fnc, line);
-   vprintf(fmt, args);
-   putchar('\n');
+   Eina_Log_Out out;
+
+   eina_log_out_begin(&out, stdout, EINA_TRUE);
+   _eina_log_print_prefix(&out, d, level, file, fnc, line);
+   eina_log_out_vprintf(&out, fmt, args);
+   eina_log_out_end(&out);
    DISPLAY_BACKTRACE(stdout, level);
 #else
    (void) d;
@@ -1911,31 +4461,515 @@ eina_log_print_cb_file(const Eina_Log_Domain *d,
 {
 #ifdef EINA_ENABLE_LOG
    FILE *f = data;
-#ifdef EFL_HAVE_THREADS
-   if (_threads_enabled)
+   Eina_Log_Out out;
+
+   eina_log_out_begin(&out, f, EINA_FALSE);
+   eina_log_print_file_prefix(&out, d, file, fnc, line);
+   eina_log_out_vprintf(&out, fmt, args);
+   eina_log_out_end(&out);
+   DISPLAY_BACKTRACE(f, level);
+#else
+   (void) d;
+   (void) file;
+   (void) fnc;
+   (void) line;
+   (void) fmt;
+   (void) data;
+   (void) args;
+#endif
+}
+
+EAPI Eina_Log_Buffer *
+eina_log_buffer_new(const char *filename, size_t size, double interval)
+{
+#ifdef EINA_ENABLE_LOG
+   Eina_Log_Buffer *buffer;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(filename, NULL);
+
+   if (size < 4096)
+      size = 4096;
+
+   buffer = calloc(1, sizeof(Eina_Log_Buffer));
+   if (!buffer)
+      return NULL;
+
+   buffer->buf = malloc(size);
+   if (!buffer->buf)
+      goto on_error;
+
+   buffer->fd = open(filename, O_WRONLY | O_CREAT | O_APPEND, 0644);
+   if (buffer->fd < 0)
+      goto on_error;
+   fcntl(buffer->fd, F_SETFD, FD_CLOEXEC);
+
+   buffer->size = size;
+   buffer->interval = interval;
+
+   return buffer;
+
+on_error:
+   free(buffer->buf);
+   free(buffer);
+   return NULL;
+#else
+   (void) filename;
+   (void) size;
+   (void) interval;
+   return NULL;
+#endif
+}
+
+EAPI void
+eina_log_buffer_flush(Eina_Log_Buffer *buffer)
+{
+#ifdef EINA_ENABLE_LOG
+   EINA_SAFETY_ON_NULL_RETURN(buffer);
+
+   LOG_LOCK();
+   LOG_PRINT_LOCK();
+   eina_log_buffer_flush_unlocked(buffer);
+   LOG_PRINT_UNLOCK();
+   LOG_UNLOCK();
+#else
+   (void) buffer;
+#endif
+}
+
+EAPI void
+eina_log_buffer_free(Eina_Log_Buffer *buffer)
+{
+#ifdef EINA_ENABLE_LOG
+   if (!buffer)
+      return;
+
+   eina_log_buffer_flush_unlocked(buffer);
+   close(buffer->fd);
+   free(buffer->buf);
+   free(buffer);
+#else
+   (void) buffer;
+#endif
+}
+
+EAPI void
+eina_log_print_cb_buffer(const Eina_Log_Domain *d,
+                         __UNUSED__ Eina_Log_Level level,
+                         const char *file,
+                         const char *fnc,
+                         int line,
+                         const char *fmt,
+                         void *data,
+                         va_list args)
+{
+#ifdef EINA_ENABLE_LOG
+   Eina_Log_Buffer *buffer = data;
+   Eina_Log_Out out;
+   double now = 0.0;
+
+   if (!buffer)
+      return;
+
+   eina_log_out_begin(&out, NULL, EINA_FALSE);
+   if (!out.buf)
+      return;
+   eina_log_print_file_prefix(&out, d, file, fnc, line);
+   eina_log_out_vprintf(&out, fmt, args);
+   out.buf[out.len++] = '\n';
+
+   if (buffer->interval > 0.0)
+      now = eina_log_now();
+
+   if (buffer->len + out.len > buffer->size)
+      eina_log_buffer_flush_unlocked(buffer);
+
+   if (out.len >= buffer->size)
+      eina_log_write_all(buffer->fd, out.buf, out.len);
+   else
      {
-        Thread cur;
+        if (!buffer->len)
+           buffer->since = now;
+        memcpy(buffer->buf + buffer->len, out.buf, out.len);
+        buffer->len += out.len;
+     }
 
-        cur = SELF();
-        if (IS_OTHER(cur))
+   // a critical message may well be the last one
+   if ((level <= EINA_LOG_LEVEL_CRITICAL) ||
+       ((buffer->interval > 0.0) && (now - buffer->since >= buffer->interval)))
+      eina_log_buffer_flush_unlocked(buffer);
+
+   eina_log_out_release(&out);
+#else
+   (void) d;
+   (void) file;
+   (void) fnc;
+   (void) line;
+   (void) fmt;
+   (void) data;
+   (void) args;
+#endif
+}
+
+EAPI Eina_Log_Binary *
+eina_log_binary_new(const char *filename)
+{
+#if defined(EINA_ENABLE_LOG) && defined(HAVE_SYS_MMAN_H)
+   Eina_Log_Binary_Header *header;
+   Eina_Log_Binary *bin;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(filename, NULL);
+
+   bin = calloc(1, sizeof(Eina_Log_Binary));
+   if (!bin)
+      return NULL;
+   bin->fd = -1;
+
+   bin->sites = eina_hash_new(EINA_KEY_LENGTH(eina_log_binary_site_key_length),
+                              EINA_KEY_CMP(eina_log_binary_site_key_cmp),
+                              EINA_KEY_HASH(eina_log_binary_site_key_hash),
+                              NULL, 8);
+   bin->sites_offsets = eina_inarray_new(sizeof(size_t), 64);
+   if (!bin->sites || !bin->sites_offsets)
+      goto on_error;
+
+   bin->fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+   if (bin->fd < 0)
+      goto on_error;
+   fcntl(bin->fd, F_SETFD, FD_CLOEXEC);
+
+   header = (Eina_Log_Binary_Header *)
+      eina_log_binary_reserve(bin, sizeof(Eina_Log_Binary_Header));
+   if (!header)
+      goto on_error;
+
+   memcpy(header->magic, EINA_LOG_BINARY_MAGIC, sizeof(header->magic));
+   header->byte_order = EINA_LOG_BINARY_BYTE_ORDER;
+   header->version = EINA_LOG_BINARY_VERSION;
+   header->pid = eina_log_pid_get();
+   bin->used = EINA_LOG_BINARY_ALIGN(sizeof(Eina_Log_Binary_Header));
+
+   return bin;
+
+on_error:
+   eina_log_binary_free(bin);
+   return NULL;
+#else
+   (void) filename;
+   return NULL;
+#endif
+}
+
+EAPI void
+eina_log_binary_free(Eina_Log_Binary *bin)
+{
+#ifdef EINA_ENABLE_LOG
+   if (!bin)
+      return;
+
+#ifdef HAVE_SYS_MMAN_H
+   if (bin->map)
+      munmap(bin->map, bin->size);
+#endif
+   if (bin->fd >= 0)
+     {
+        if (ftruncate(bin->fd, bin->used))
+           fputs("ERR: could not truncate the binary log\n", stderr);
+        close(bin->fd);
+     }
+   if (bin->sites)
+      eina_hash_free(bin->sites);
+   if (bin->sites_offsets)
+      eina_inarray_free(bin->sites_offsets);
+   free(bin->domains);
+   free(bin);
+#else
+   (void) bin;
+#endif
+}
+
+EAPI Eina_Bool
+eina_log_binary_decode(const char *filename, Eina_Log_Binary_Cb cb, void *data)
+{
+#ifdef EINA_ENABLE_LOG
+   const Eina_Log_Binary_Header *header;
+   const unsigned char *map, *p, *end;
+   Eina_Log_Binary_Record record;
+   Eina_Inarray *sites = NULL;
+   Eina_Inarray *domains = NULL;
+   Eina_Strbuf *buf = NULL;
+   const char *other_domain = NULL;
+   Eina_File *f;
+   Eina_Bool r = EINA_FALSE;
+   size_t size;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(filename, EINA_FALSE);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(cb, EINA_FALSE);
+
+   f = eina_file_open(filename, EINA_FALSE);
+   if (!f)
+      return EINA_FALSE;
+
+   size = eina_file_size_get(f);
+   if (size < sizeof(Eina_Log_Binary_Header))
+      goto on_error_file;
+
+   map = eina_file_map_all(f, EINA_FILE_SEQUENTIAL);
+   if (!map)
+      goto on_error_file;
+
+   header = (const Eina_Log_Binary_Header *)map;
+   if (memcmp(header->magic, EINA_LOG_BINARY_MAGIC, sizeof(header->magic)) ||
+       (header->byte_order != EINA_LOG_BINARY_BYTE_ORDER) ||
+       (header->version != EINA_LOG_BINARY_VERSION))
+      goto on_error;
+
+   // sites are pointers to their record, domains to their name
+   sites = eina_inarray_new(sizeof(const Eina_Log_Binary_Site *), 64);
+   domains = eina_inarray_new(sizeof(const char *), 16);
+   buf = eina_strbuf_new();
+   if (!sites || !domains || !buf)
+      goto on_error;
+
+   memset(&record, 0, sizeof(record));
+   record.pid = header->pid;
+
+   p = map + EINA_LOG_BINARY_ALIGN(sizeof(Eina_Log_Binary_Header));
+   end = map + size;
+   while ((size_t)(end - p) >= sizeof(Eina_Log_Binary_Head))
+     {
+        const Eina_Log_Binary_Head *head = (const Eina_Log_Binary_Head *)p;
+        const unsigned char *rec_end;
+
+        if (head->type == EINA_LOG_BINARY_END)
+           break;
+        if ((head->size < sizeof(Eina_Log_Binary_Head)) ||
+            (head->size & 7) || (head->size > (size_t)(end - p)))
+           goto on_error;
+        rec_end = p + head->size;
+
+        switch (head->type)
           {
-             fprintf(f, "%s[T:%lu] %s:%d %s() ", d->name, (unsigned long)cur,
-	        file, line, fnc);
-             goto end;
+           case EINA_LOG_BINARY_SITE:
+             {
+                const Eina_Log_Binary_Site *site;
+                const char *s;
+                int i;
+
+                site = (const Eina_Log_Binary_Site *)p;
+                if ((head->size < sizeof(Eina_Log_Binary_Site)) ||
+                    (site->id != eina_inarray_count(sites)))
+                   goto on_error;
+                // format, file and function must all be terminated
+                for (s = (const char *)(site + 1), i = 0;
+                     (i < 3) && (s < (const char *)rec_end); s++)
+                   if (!*s)
+                      i++;
+                if (i < 3)
+                   goto on_error;
+                if (eina_inarray_push(sites, &site) < 0)
+                   goto on_error;
+                break;
+             }
+
+           case EINA_LOG_BINARY_DOMAIN:
+             {
+                const Eina_Log_Binary_Domain *dom;
+                const char *name;
+
+                dom = (const Eina_Log_Binary_Domain *)p;
+                if (head->size < sizeof(Eina_Log_Binary_Domain))
+                   goto on_error;
+                name = (const char *)(dom + 1);
+                if (!memchr(name, 0, rec_end - (const unsigned char *)name))
+                   goto on_error;
+
+                if (dom->domain < 0)
+                   other_domain = name;
+                else
+                  {
+                     const char *none = NULL;
+
+                     while (eina_inarray_count(domains) <= (unsigned int)dom->domain)
+                        if (eina_inarray_push(domains, &none) < 0)
+                           goto on_error;
+                     eina_inarray_replace_at(domains, dom->domain, &name);
+                  }
+                break;
+             }
+
+           case EINA_LOG_BINARY_MESSAGE:
+           case EINA_LOG_BINARY_TEXT:
+             {
+                const Eina_Log_Binary_Message *msg;
+                const Eina_Log_Binary_Site *site;
+                const char *fmt;
+
+                msg = (const Eina_Log_Binary_Message *)p;
+                if ((head->size < sizeof(Eina_Log_Binary_Message)) ||
+                    (msg->site >= eina_inarray_count(sites)))
+                   goto on_error;
+                site = *(const Eina_Log_Binary_Site **)
+                   eina_inarray_nth(sites, msg->site);
+                fmt = (const char *)(site + 1);
+
+                if (msg->domain < 0)
+                   record.domain = other_domain;
+                else if ((unsigned int)msg->domain < eina_inarray_count(domains))
+                   record.domain = *(const char **)
+                      eina_inarray_nth(domains, msg->domain);
+                else
+                   record.domain = NULL;
+                if (!record.domain)
+                   goto on_error;
+
+                record.level = msg->level;
+                record.file = fmt + strlen(fmt) + 1;
+                record.fnc = record.file + strlen(record.file) + 1;
+                record.line = site->line;
+                record.thread = msg->thread;
+                record.timestamp = (double)(msg->timestamp / 1000000000ULL) +
+                   (double)(msg->timestamp % 1000000000ULL) / 1000000000.0;
+
+                eina_strbuf_reset(buf);
+                if (head->type == EINA_LOG_BINARY_TEXT)
+                  {
+                     const char *text = (const char *)(msg + 1);
+
+                     if (!memchr(text, 0, rec_end - (const unsigned char *)text))
+                        goto on_error;
+                     eina_strbuf_append(buf, text);
+                  }
+                else if (!eina_log_binary_message_format
+                      (buf, fmt, (const unsigned char *)(msg + 1), rec_end))
+                   goto on_error;
+                record.message = eina_strbuf_string_get(buf);
+
+                if (!cb(data, &record))
+                   goto on_error;
+                break;
+             }
+
+           default:
+              // unknown records are skipped
+              break;
           }
+
+        p = rec_end;
      }
 
+   r = EINA_TRUE;
+
+on_error:
+   if (buf)
+      eina_strbuf_free(buf);
+   if (domains)
+      eina_inarray_free(domains);
+   if (sites)
+      eina_inarray_free(sites);
+   eina_file_map_free(f, (void *)map);
+on_error_file:
+   eina_file_close(f);
+   return r;
+#else
+   (void) filename;
+   (void) cb;
+   (void) data;
+   return EINA_FALSE;
 #endif
-   fprintf(f, "%s<%u> %s:%d %s() ", d->name, eina_log_pid_get(), 
-           file, line, fnc);
-   DISPLAY_BACKTRACE(f, level);
+}
+
+EAPI void
+eina_log_print_cb_binary(const Eina_Log_Domain *d,
+                         Eina_Log_Level level,
+                         const char *file,
+                         const char *fnc,
+                         int line,
+                         const char *fmt,
+                         void *data,
+                         va_list args)
+{
+#ifdef EINA_ENABLE_LOG
+   Eina_Log_Binary *bin = data;
+   Eina_Log_Binary_Message *msg;
+   unsigned char *p;
+   size_t len = 0;
+   int domain, site;
+   va_list copy;
+
+   if (!bin)
+      return;
+
+   if ((d >= _log_domains) && (d < _log_domains + _log_domains_count))
+     {
+        domain = d - _log_domains;
+        if (((unsigned int)domain >= bin->domains_count) ||
+            (bin->domains[domain] != d->name))
+           if (!eina_log_binary_domain_write(bin, domain, d->name))
+              return;
+     }
+   else
+     {
+        domain = -1;
+        if (bin->other_domain != d->name)
+           if (!eina_log_binary_domain_write(bin, domain, d->name))
+              return;
+     }
+
+   site = eina_log_binary_site_get(bin, fmt, file, fnc, line);
+   if (site < 0)
+      return;
+
+   p = eina_log_binary_reserve(bin, EINA_LOG_BINARY_RECORD_MAX);
+   if (!p)
+      return;
+
+   msg = (Eina_Log_Binary_Message *)p;
+   msg->site = site;
+   msg->domain = domain;
+   msg->level = level;
+   msg->padding = 0;
+   msg->timestamp = eina_log_binary_timestamp();
+   msg->thread = 0;
 #ifdef EFL_HAVE_THREADS
-end:
+   if (_threads_enabled)
+     {
+        Thread cur;
+
+        cur = LOG_SELF();
+        if (IS_OTHER(cur))
+           msg->thread = (unsigned long)cur;
+     }
 #endif
-   vfprintf(f, fmt, args);
-   putc('\n', f);
+
+   va_copy(copy, args);
+   if (eina_log_binary_args_write((unsigned char *)(msg + 1),
+                                  EINA_LOG_BINARY_RECORD_MAX -
+                                  sizeof(Eina_Log_Binary_Message),
+                                  &len, fmt, copy))
+      eina_log_binary_commit(bin, p, EINA_LOG_BINARY_MESSAGE,
+                             sizeof(Eina_Log_Binary_Message) + len);
+   else
+     {
+        int n;
+
+        n = vsnprintf((char *)(msg + 1),
+                      EINA_LOG_BINARY_RECORD_MAX -
+                      sizeof(Eina_Log_Binary_Message),
+                      fmt, args);
+        if (n < 0)
+           n = 0;
+        else if ((size_t)n >= EINA_LOG_BINARY_RECORD_MAX -
+                 sizeof(Eina_Log_Binary_Message))
+           n = EINA_LOG_BINARY_RECORD_MAX -
+              sizeof(Eina_Log_Binary_Message) - 1;
+        ((char *)(msg + 1))[n] = '\0';
+        eina_log_binary_commit(bin, p, EINA_LOG_BINARY_TEXT,
+                               sizeof(Eina_Log_Binary_Message) + n + 1);
+     }
+   va_end(copy);
 #else
    (void) d;
+   (void) level;
    (void) file;
    (void) fnc;
    (void) line;
@@ -1950,6 +4984,7 @@ eina_log_print(int domain, Eina_Log_Level level, const char *file,
                const char *fnc, int line, const char *fmt, ...)
 {
 #ifdef EINA_ENABLE_LOG
+   unsigned int resumed = 0;
    va_list args;
 
 #ifdef EINA_SAFETY_CHECKS
@@ -1972,11 +5007,17 @@ eina_log_print(int domain, Eina_Log_Level level, const char *file,
      }
 
 #endif
+   if (!eina_log_print_filter(domain, level, file, line,
+                              EINA_FALSE, &resumed))
+      return;
+
    va_start(args, fmt);
-   LOG_LOCK();
-   eina_log_print_unlocked(domain, level, file, fnc, line, fmt, args);
-   LOG_UNLOCK();
+   eina_log_print_filtered(domain, level, file, fnc, line, fmt, args);
    va_end(args);
+
+   if (EINA_UNLIKELY(resumed))
+      eina_log_print_resumed(domain, level, file, fnc, line,
+                             "%u similar messages were suppressed", resumed);
 #else
    (void) domain;
    (void) level;
@@ -1992,6 +5033,7 @@ eina_log_vprint(int domain, Eina_Log_Level level, const char *file,
                 const char *fnc, int line, const char *fmt, va_list args)
 {
 #ifdef EINA_ENABLE_LOG
+   unsigned int resumed = 0;
 
 #ifdef EINA_SAFETY_CHECKS
    if (EINA_UNLIKELY(!file))
@@ -2013,9 +5055,15 @@ eina_log_vprint(int domain, Eina_Log_Level level, const char *file,
      }
 
 #endif
-   LOG_LOCK();
-   eina_log_print_unlocked(domain, level, file, fnc, line, fmt, args);
-   LOG_UNLOCK();
+   if (!eina_log_print_filter(domain, level, file, line,
+                              EINA_FALSE, &resumed))
+      return;
+
+   eina_log_print_filtered(domain, level, file, fnc, line, fmt, args);
+
+   if (EINA_UNLIKELY(resumed))
+      eina_log_print_resumed(domain, level, file, fnc, line,
+                             "%u similar messages were suppressed", resumed);
 #else
    (void) domain;
    (void) level;
@@ -48,7 +48,9 @@ void *alloca (size_t);
 #include "eina_mempool.h"
 #include "eina_lock.h"
 #include "eina_inlist.h"
+#include "eina_inarray.h"
 #include "eina_strbuf.h"
+#include "eina_stringshare.h"
 
 /* undefs EINA_ARG_NONULL() so NULL checks are not compiled out! */
 #include "eina_safety_checks.h"
@@ -313,6 +315,10 @@ struct _Eina_Model_Event_Description_Cache
  * the first usable operation is stopred for type at "ops" struct,
  * avoiding usage of _eina_model_type_find_offset().
  *
+ * the properties interface used by EINA_MODEL_TYPE_MIXIN is resolved
+ * as well, with its methods and the position of its private data, so
+ * property access doesn't walk interfaces for every call.
+ *
  * Get a model type description using _eina_model_description_get(),
  * when it's not used anymore use
  * _eina_model_description_dispose(). These operations are thread
@@ -358,6 +364,15 @@ struct _Eina_Model_Description
          char *(*to_string)(const Eina_Model *model); /**< used to represent model as string, usually for debug purposes or user convenience */
          const void **extension;
       } type;
+      /* first interface named EINA_MODEL_INTERFACE_NAME_PROPERTIES */
+      struct {
+         const Eina_Model_Interface *iface;
+         unsigned int private_idx; /* position in model->privates */
+         Eina_Bool (*get)(const Eina_Model *model, const char *name, Eina_Value *value);
+         Eina_Bool (*set)(Eina_Model *model, const char *name, const Eina_Value *value);
+         Eina_Bool (*del)(Eina_Model *model, const char *name);
+         Eina_List *(*names_list_get)(const Eina_Model *model);
+      } properties;
    } ops;
    struct {
       unsigned int types;
@@ -791,6 +806,38 @@ _eina_model_description_privates_fill(Eina_Model_Description *desc)
    return EINA_TRUE;
 }
 
+static const void *_eina_model_interface_find_offset(const Eina_Model_Interface *iface, unsigned int offset);
+
+/* same interface as EINA_MODEL_TYPE_MIXIN constructor gets */
+static void
+_eina_model_description_properties_fill(Eina_Model_Description *desc)
+{
+   const Eina_Model_Interface *iface = NULL;
+   unsigned int i;
+
+   for (i = 0; i < desc->total.ifaces; i++)
+     {
+        if (strcmp(desc->cache.ifaces[i]->name,
+                   EINA_MODEL_INTERFACE_NAME_PROPERTIES) == 0)
+          {
+             iface = desc->cache.ifaces[i];
+             break;
+          }
+     }
+   if (!iface) return;
+
+   desc->ops.properties.iface = iface;
+   desc->ops.properties.private_idx = desc->total.types + i;
+   desc->ops.properties.get = _eina_model_interface_find_offset
+     (iface, offsetof(Eina_Model_Interface_Properties, get));
+   desc->ops.properties.set = _eina_model_interface_find_offset
+     (iface, offsetof(Eina_Model_Interface_Properties, set));
+   desc->ops.properties.del = _eina_model_interface_find_offset
+     (iface, offsetof(Eina_Model_Interface_Properties, del));
+   desc->ops.properties.names_list_get = _eina_model_interface_find_offset
+     (iface, offsetof(Eina_Model_Interface_Properties, names_list_get));
+}
+
 static int
 _eina_model_description_events_cmp(const void *pa, const void *pb)
 {
@@ -949,6 +996,7 @@ _eina_model_description_get_internal(const Eina_Model_Type *type)
    if (!_eina_model_description_type_fill(desc, type)) goto failed_type;
    if (!_eina_model_description_ifaces_fill(desc)) goto failed_ifaces;
    if (!_eina_model_description_privates_fill(desc)) goto failed_privates;
+   _eina_model_description_properties_fill(desc);
    if (!_eina_model_description_events_fill(desc)) goto failed_events;
    if (!eina_hash_add(_eina_model_descriptions, &type, desc)) goto failed_hash;
 
@@ -1045,6 +1093,25 @@ struct _Eina_Model_Event_Listener
    Eina_Bool deleted:1;
 };
 
+/* events recorded between eina_model_event_batch_begin() and
+ * eina_model_event_batch_end(), emitted once each at the end.
+ */
+typedef struct _Eina_Model_Event_Batch_Property Eina_Model_Event_Batch_Property;
+struct _Eina_Model_Event_Batch_Property
+{
+   const char *name; /* stringshared property name */
+   int event_id; /* last of property,set or property,deleted */
+};
+
+typedef struct _Eina_Model_Event_Batch Eina_Model_Event_Batch;
+struct _Eina_Model_Event_Batch
+{
+   Eina_Inarray properties; /* Eina_Model_Event_Batch_Property, in order of first change */
+   Eina_Hash *positions; /* stringshared name -> position + 1 in properties */
+   unsigned char *pending; /* other events to emit, for each event */
+   int count; /* nested batches */
+};
+
 struct _Eina_Model
 {
    const Eina_Model_Description *desc; /**< optimized model description */
@@ -1052,6 +1119,7 @@ struct _Eina_Model
       Eina_Inlist **entries; /**< connected/listeners for each event, array of lists of Eina_Model_Event_Listener */
       Eina_List **deleted; /**< deleted listeners while was walking. array of lists of Eina_Model_Event_Listener with deleted flag */
       int *freeze; /**< freeze count for each event */
+      Eina_Model_Event_Batch *batch; /**< if eina_model_event_batch_begin() was called */
       int walking; /**< increased while walking entries lists */
    } listeners;
    void **privates; /**< private data per type and interface, each level gets its own stuff */
@@ -1183,27 +1251,109 @@ _eina_model_event_callback_free_deleted(Eina_Model *model)
    model->listeners.deleted = NULL;
 }
 
-static inline Eina_Bool
-_eina_model_event_callback_call(Eina_Model *model, const char *name, const void *event_info)
+static void
+_eina_model_event_batch_free(Eina_Model_Event_Batch *batch)
+{
+   Eina_Model_Event_Batch_Property *itr;
+
+   if (batch->positions) eina_hash_free(batch->positions);
+   EINA_INARRAY_FOREACH(&batch->properties, itr)
+     eina_stringshare_del(itr->name);
+   eina_inarray_flush(&batch->properties);
+   free(batch);
+}
+
+/* returns EINA_FALSE if the event must be emitted right away */
+static Eina_Bool
+_eina_model_event_batch_add(Eina_Model *model, int event_id, const void *event_info)
+{
+   Eina_Model_Event_Batch *batch = model->listeners.batch;
+   const char *name = model->desc->cache.events[event_id].name;
+
+   if ((name == _eina_model_str_property_set) ||
+       (name == _eina_model_str_property_del))
+     {
+        Eina_Model_Event_Batch_Property *itr, prop;
+        uintptr_t pos;
+        int idx;
+
+        if (!event_info) return EINA_FALSE;
+
+        if (!batch->positions)
+          {
+             batch->positions = eina_hash_stringshared_new(NULL);
+             if (!batch->positions) return EINA_FALSE;
+          }
+
+        prop.name = eina_stringshare_add(event_info);
+        prop.event_id = event_id;
+        pos = (uintptr_t)eina_hash_find(batch->positions, prop.name);
+        if (pos)
+          {
+             eina_stringshare_del(prop.name);
+             itr = eina_inarray_nth(&batch->properties, pos - 1);
+             itr->event_id = event_id;
+             return EINA_TRUE;
+          }
+
+        idx = eina_inarray_push(&batch->properties, &prop);
+        if (idx < 0)
+          {
+             eina_stringshare_del(prop.name);
+             return EINA_FALSE;
+          }
+        if (!eina_hash_add(batch->positions, prop.name,
+                           (void *)(uintptr_t)(idx + 1)))
+          {
+             eina_inarray_pop(&batch->properties);
+             eina_stringshare_del(prop.name);
+             return EINA_FALSE;
+          }
+        return EINA_TRUE;
+     }
+
+   /* positions are meaningless after many changes, tell they changed */
+   if ((name == _eina_model_str_child_inserted) ||
+       (name == _eina_model_str_child_set) ||
+       (name == _eina_model_str_child_del))
+     {
+        event_id = _eina_model_description_event_id_find
+          (model->desc, _eina_model_str_children_changed);
+        if (event_id < 0) return EINA_FALSE;
+     }
+   else if ((event_info) ||
+            (name == _eina_model_str_deleted) ||
+            (name == _eina_model_str_freed))
+     return EINA_FALSE;
+
+   batch->pending[event_id] = 1;
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_eina_model_event_callback_call_id(Eina_Model *model, int event_id, const void *event_info)
 {
    Eina_Inlist *lst;
    Eina_Model_Event_Listener *el;
    const Eina_Model_Event_Description *ev_desc;
-   int event_id = _eina_model_description_event_id_find(model->desc, name);
 
-   if (event_id < 0) return EINA_FALSE;
    if (!model->listeners.entries) return EINA_TRUE;
 
    if ((model->listeners.freeze) && (model->listeners.freeze[event_id]))
      {
         DBG("Ignored event callback '%s' of model %p (%s): frozen",
-            name, model, model->desc->cache.types[0]->name);
+            model->desc->cache.events[event_id].name,
+            model, model->desc->cache.types[0]->name);
         return EINA_TRUE;
      }
 
    lst = model->listeners.entries[event_id];
    if (!lst) return EINA_TRUE;
 
+   if ((model->listeners.batch) &&
+       (_eina_model_event_batch_add(model, event_id, event_info)))
+     return EINA_TRUE;
+
    ev_desc = model->desc->cache.events[event_id].desc;
 
    model->listeners.walking++;
@@ -1220,6 +1370,15 @@ _eina_model_event_callback_call(Eina_Model *model, const char *name, const void
    return EINA_FALSE;
 }
 
+static inline Eina_Bool
+_eina_model_event_callback_call(Eina_Model *model, const char *name, const void *event_info)
+{
+   int event_id = _eina_model_description_event_id_find(model->desc, name);
+
+   if (event_id < 0) return EINA_FALSE;
+   return _eina_model_event_callback_call_id(model, event_id, event_info);
+}
+
 static const char EINA_ERROR_MODEL_FAILED_STR[] = "Model check failed.";
 static const char EINA_ERROR_MODEL_METHOD_MISSING_STR[] = "Model method is missing.";
 static const char EINA_MAGIC_MODEL_STR[] = "Eina Model";
@@ -2111,8 +2270,7 @@ _eina_model_type_mixin_constructor(Eina_Model *model)
 
    DBG("mix-in constructor of %p (priv=%p)", model, priv);
 
-   priv->if_properties = eina_model_interface_get
-     (model, EINA_MODEL_INTERFACE_NAME_PROPERTIES);
+   priv->if_properties = model->desc->ops.properties.iface;
    if (priv->if_properties)
      {
         if (!eina_model_interface_constructor(priv->if_properties, model))
@@ -2244,60 +2402,63 @@ _eina_model_type_mixin_unload(Eina_Model *model)
    return ret;
 }
 
+/* properties methods are resolved in the description, the checks of
+ * eina_model_interface_properties_*() are only done if they are missing.
+ */
 static Eina_Bool
 _eina_model_type_mixin_property_get(const Eina_Model *model, const char *name, Eina_Value *value)
 {
-   Eina_Bool ret = EINA_FALSE;
-
-   EINA_MODEL_TYPE_MIXIN_GET(model);
+   const Eina_Model_Description *desc = model->desc;
 
-   if (priv->if_properties)
-     ret = eina_model_interface_properties_get
-       (priv->if_properties, model, name, value);
+   if (desc->ops.properties.get)
+     return desc->ops.properties.get(model, name, value);
+   if (desc->ops.properties.iface)
+     return eina_model_interface_properties_get
+       (desc->ops.properties.iface, model, name, value);
 
-   return ret;
+   return EINA_FALSE;
 }
 
 static Eina_Bool
 _eina_model_type_mixin_property_set(Eina_Model *model, const char *name, const Eina_Value *value)
 {
-   Eina_Bool ret = EINA_FALSE;
-
-   EINA_MODEL_TYPE_MIXIN_GET(model);
+   const Eina_Model_Description *desc = model->desc;
 
-   if (priv->if_properties)
-     ret = eina_model_interface_properties_set
-       (priv->if_properties, model, name, value);
+   if (desc->ops.properties.set)
+     return desc->ops.properties.set(model, name, value);
+   if (desc->ops.properties.iface)
+     return eina_model_interface_properties_set
+       (desc->ops.properties.iface, model, name, value);
 
-   return ret;
+   return EINA_FALSE;
 }
 
 static Eina_Bool
 _eina_model_type_mixin_property_del(Eina_Model *model, const char *name)
 {
-   Eina_Bool ret = EINA_FALSE;
-
-   EINA_MODEL_TYPE_MIXIN_GET(model);
+   const Eina_Model_Description *desc = model->desc;
 
-   if (priv->if_properties)
-     ret = eina_model_interface_properties_del
-       (priv->if_properties, model, name);
+   if (desc->ops.properties.del)
+     return desc->ops.properties.del(model, name);
+   if (desc->ops.properties.iface)
+     return eina_model_interface_properties_del
+       (desc->ops.properties.iface, model, name);
 
-   return ret;
+   return EINA_FALSE;
 }
 
 static Eina_List *
 _eina_model_type_mixin_properties_names_list_get(const Eina_Model *model)
 {
-   Eina_List *ret = NULL;
+   const Eina_Model_Description *desc = model->desc;
 
-   EINA_MODEL_TYPE_MIXIN_GET(model);
+   if (desc->ops.properties.names_list_get)
+     return desc->ops.properties.names_list_get(model);
+   if (desc->ops.properties.iface)
+     return eina_model_interface_properties_names_list_get
+       (desc->ops.properties.iface, model);
 
-   if (priv->if_properties)
-     ret = eina_model_interface_properties_names_list_get
-       (priv->if_properties, model);
-
-   return ret;
+   return NULL;
 }
 
 static int
@@ -2416,10 +2577,21 @@ static const Eina_Model_Event_Description _eina_model_interface_properties_event
   EINA_MODEL_EVENT_DESCRIPTION_SENTINEL
 };
 
+/* skip the interfaces walk if iface is the one used by the model */
+static inline void *
+_eina_model_interface_properties_private_get(const Eina_Model *model, const Eina_Model_Interface *iface)
+{
+   const Eina_Model_Description *desc = model->desc;
+
+   if (desc->ops.properties.iface == iface)
+     return model->privates[desc->ops.properties.private_idx];
+   return eina_model_interface_private_data_get(model, iface);
+}
+
 /* EINA_MODEL_INTERFACE_PROPERTIES_HASH ******************************/
 
 #define EINA_MODEL_INTERFACE_PROPERTIES_HASH_GET(model)                 \
-  Eina_Hash *priv = *(Eina_Hash **)eina_model_interface_private_data_get \
+  Eina_Hash *priv = *(Eina_Hash **)_eina_model_interface_properties_private_get \
     (model, EINA_MODEL_INTERFACE_PROPERTIES_HASH)
 
 static Eina_Bool
@@ -2603,7 +2775,7 @@ static const Eina_Model_Interface_Properties _EINA_MODEL_INTERFACE_PROPERTIES_HA
 static Eina_Value_Struct *
 _eina_model_interface_properties_struct_private_get(const Eina_Model *model)
 {
-   Eina_Value *val = eina_model_interface_private_data_get
+   Eina_Value *val = _eina_model_interface_properties_private_get
      (model, EINA_MODEL_INTERFACE_PROPERTIES_STRUCT);
    return eina_value_memory_get(val);
 }
@@ -2672,7 +2844,7 @@ _eina_model_interface_properties_struct_destructor(Eina_Model *model)
 static Eina_Bool
 _eina_model_interface_properties_struct_get(const Eina_Model *model, const char *name, Eina_Value *val)
 {
-   const Eina_Value *v = eina_model_interface_private_data_get
+   const Eina_Value *v = _eina_model_interface_properties_private_get
      (model, EINA_MODEL_INTERFACE_PROPERTIES_STRUCT);
    return eina_value_struct_value_get(v, name, val);
 }
@@ -2680,7 +2852,7 @@ _eina_model_interface_properties_struct_get(const Eina_Model *model, const char
 static Eina_Bool
 _eina_model_interface_properties_struct_set(Eina_Model *model, const char *name, const Eina_Value *val)
 {
-   Eina_Value *v = eina_model_interface_private_data_get
+   Eina_Value *v = _eina_model_interface_properties_private_get
      (model, EINA_MODEL_INTERFACE_PROPERTIES_STRUCT);
    return eina_value_struct_value_set(v, name, val);
 }
@@ -3180,6 +3352,7 @@ eina_model_new(const Eina_Model_Type *type)
    model->listeners.entries = NULL;
    model->listeners.deleted = NULL;
    model->listeners.freeze = NULL;
+   model->listeners.batch = NULL;
    model->listeners.walking = 0;
 
    if (desc->total.size == 0)
@@ -3373,6 +3546,9 @@ _eina_model_free(Eina_Model *model)
      _eina_model_inner_free(model->desc->total.events * sizeof(int),
                             model->listeners.freeze);
 
+   if (model->listeners.batch)
+     _eina_model_event_batch_free(model->listeners.batch);
+
    EINA_MAGIC_SET(model, EINA_MAGIC_NONE);
    eina_mempool_free(_eina_model_mp, model);
 
@@ -3896,6 +4072,71 @@ eina_model_event_callback_thaw(Eina_Model *model, const char *name)
    return model->listeners.freeze[event_id];
 }
 
+EAPI int
+eina_model_event_batch_begin(Eina_Model *model)
+{
+   Eina_Model_Event_Batch *batch;
+
+   EINA_MODEL_INSTANCE_CHECK_VAL(model, -1);
+
+   batch = model->listeners.batch;
+   if (batch)
+     {
+        batch->count++;
+        return batch->count;
+     }
+
+   batch = calloc(1, sizeof(Eina_Model_Event_Batch) +
+                  model->desc->total.events);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(batch, -1);
+
+   eina_inarray_step_set(&batch->properties, sizeof(Eina_Inarray),
+                         sizeof(Eina_Model_Event_Batch_Property), 8);
+   batch->pending = (unsigned char *)(batch + 1);
+   batch->count = 1;
+   model->listeners.batch = batch;
+
+   DBG("model %p (%s) events batched",
+       model, model->desc->cache.types[0]->name);
+   return 1;
+}
+
+EAPI int
+eina_model_event_batch_end(Eina_Model *model)
+{
+   Eina_Model_Event_Batch *batch;
+   Eina_Model_Event_Batch_Property *itr;
+   unsigned int i;
+
+   EINA_MODEL_INSTANCE_CHECK_VAL(model, -1);
+   batch = model->listeners.batch;
+   EINA_SAFETY_ON_NULL_RETURN_VAL(batch, -1);
+
+   batch->count--;
+   if (batch->count > 0) return batch->count;
+
+   DBG("model %p (%s) events emitted: %u properties",
+       model, model->desc->cache.types[0]->name,
+       eina_inarray_count(&batch->properties));
+
+   /* callbacks may start another batch or release the model */
+   model->listeners.batch = NULL;
+   eina_model_ref(model);
+
+   EINA_INARRAY_FOREACH(&batch->properties, itr)
+     _eina_model_event_callback_call_id(model, itr->event_id, itr->name);
+
+   for (i = 0; i < model->desc->total.events; i++)
+     {
+        if (batch->pending[i])
+          _eina_model_event_callback_call_id(model, i, NULL);
+     }
+
+   _eina_model_event_batch_free(batch);
+   eina_model_unref(model);
+   return 0;
+}
+
 EAPI Eina_Model *
 eina_model_copy(const Eina_Model *model)
 {
@@ -5471,6 +5712,49 @@ eina_model_struct_get(const Eina_Model *model, const Eina_Value_Struct_Desc **p_
    return EINA_FALSE;
 }
 
+EAPI Eina_Bool
+eina_model_struct_index_get(const Eina_Model *model, unsigned int index, Eina_Value *value)
+{
+   const Eina_Value_Struct_Member *member;
+   const Eina_Value *val;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(value, EINA_FALSE);
+   EINA_MODEL_INTERFACE_IMPLEMENTED_CHECK_VAL
+     (&_EINA_MODEL_INTERFACE_PROPERTIES_STRUCT.base, model, EINA_FALSE);
+
+   val = _eina_model_interface_properties_private_get
+     (model, &_EINA_MODEL_INTERFACE_PROPERTIES_STRUCT.base);
+   member = eina_value_struct_member_at(eina_value_memory_get(val), index);
+   if (!member)
+     return EINA_FALSE;
+
+   return eina_value_struct_member_value_get(val, member, value);
+}
+
+EAPI Eina_Bool
+eina_model_struct_index_set(Eina_Model *model, unsigned int index, const Eina_Value *value)
+{
+   const Eina_Value_Struct_Member *member;
+   Eina_Value *val;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(value, EINA_FALSE);
+   EINA_MODEL_INTERFACE_IMPLEMENTED_CHECK_VAL
+     (&_EINA_MODEL_INTERFACE_PROPERTIES_STRUCT.base, model, EINA_FALSE);
+
+   val = _eina_model_interface_properties_private_get
+     (model, &_EINA_MODEL_INTERFACE_PROPERTIES_STRUCT.base);
+   member = eina_value_struct_member_at(eina_value_memory_get(val), index);
+   if (!member)
+     return EINA_FALSE;
+
+   if (!eina_value_struct_member_value_set(val, member, value))
+     return EINA_FALSE;
+
+   _eina_model_event_callback_call
+     (model, _eina_model_str_property_set, member->name);
+   return EINA_TRUE;
+}
+
 EAPI void
 eina_models_usage_dump(void)
 {
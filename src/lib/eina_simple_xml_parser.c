@@ -45,12 +45,25 @@ void *alloca (size_t);
 #include <string.h>
 #include <ctype.h>
 
+#ifdef EFL_HAVE_POSIX_THREADS
+# include <pthread.h>
+#endif
+
+#if defined(EFL_HAVE_SSE2) && defined(__SSE2__)
+# include <emmintrin.h>
+# define EINA_SIMPLE_XML_SSE2 1
+#endif
+
 #ifdef HAVE_EVIL
 # include <Evil.h>
 #endif
 
 #include "eina_private.h"
+#include "eina_binbuf.h"
+#include "eina_cpu.h"
+#include "eina_lock.h"
 #include "eina_log.h"
+#include "eina_main.h"
 #include "eina_mempool.h"
 #include "eina_stringshare.h"
 #include "eina_strbuf.h"
@@ -67,6 +80,9 @@ void *alloca (size_t);
 static Eina_Mempool *_eina_simple_xml_tag_mp = NULL;
 static Eina_Mempool *_eina_simple_xml_attribute_mp = NULL;
 static int _eina_simple_xml_log_dom = -1;
+#ifdef EINA_SIMPLE_XML_SSE2
+static Eina_Bool _eina_simple_xml_sse2 = EINA_FALSE;
+#endif
 
 static const char EINA_MAGIC_SIMPLE_XML_TAG_STR[] = "Eina Simple XML Tag";
 static const char EINA_MAGIC_SIMPLE_XML_DATA_STR[] = "Eina Simple XML Data";
@@ -120,9 +136,116 @@ static const char EINA_MAGIC_SIMPLE_XML_ATTRIBUTE_STR[] = "Eina Simple XML Attri
 #define DBG(...) EINA_LOG_DOM_DBG(_eina_simple_xml_log_dom, __VA_ARGS__)
 
 
+#ifdef EINA_SIMPLE_XML_SSE2
+/*
+ * The SSE2 kernels look at 16 bytes at a time and return either the
+ * first match or where less than 16 bytes (18 for the 3 bytes
+ * sequences) are left, the byte at a time loops finish from there.
+ * Most tokens are short, so the callers first look at up to 16 bytes
+ * one by one, calling a kernel only pays off after that.
+ */
+
+/* bit i is set if byte i is a space in the "C" locale */
+static inline int
+_eina_simple_xml_sse2_space_mask(__m128i v)
+{
+   __m128i ctrl, space;
+
+   /* \t, \n, \v, \f and \r are 9 to 13 */
+   ctrl = _mm_sub_epi8(v, _mm_set1_epi8(9));
+   ctrl = _mm_cmpeq_epi8(_mm_min_epu8(ctrl, _mm_set1_epi8(4)), ctrl);
+   space = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+   return _mm_movemask_epi8(_mm_or_si128(ctrl, space));
+}
+
+static const char *
+_eina_simple_xml_whitespace_find_sse2(const char *itr, const char *itr_end, Eina_Bool space)
+{
+   for (; itr + 16 <= itr_end; itr += 16)
+     {
+        __m128i v = _mm_loadu_si128((const __m128i *)itr);
+        int mask;
+
+        /* other bytes may be spaces in the current locale */
+        if (_mm_movemask_epi8(v))
+          {
+             const char *p;
+
+             for (p = itr; p < itr + 16; p++)
+               if ((!isspace((unsigned char)*p)) == (!space))
+                 return p;
+             continue;
+          }
+
+        mask = _eina_simple_xml_sse2_space_mask(v);
+        if (!space) mask ^= 0xffff;
+        if (mask) return itr + __builtin_ctz(mask);
+     }
+   return itr;
+}
+
+static const char *
+_eina_simple_xml_tag_end_find_sse2(const char *itr, const char *itr_end)
+{
+   const __m128i gt = _mm_set1_epi8('>');
+   const __m128i lt = _mm_set1_epi8('<');
+
+   for (; itr + 16 <= itr_end; itr += 16)
+     {
+        __m128i v = _mm_loadu_si128((const __m128i *)itr);
+        int mask;
+
+        mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, gt),
+                                              _mm_cmpeq_epi8(v, lt)));
+        if (mask) return itr + __builtin_ctz(mask);
+     }
+   return itr;
+}
+
+/* where c1 c1 c2 starts, "-->" or "]]>" */
+static const char *
+_eina_simple_xml_sequence_find_sse2(const char *itr, const char *itr_end, char c1, char c2)
+{
+   const __m128i v1 = _mm_set1_epi8(c1);
+   const __m128i v2 = _mm_set1_epi8(c2);
+
+   for (; itr + 18 <= itr_end; itr += 16)
+     {
+        __m128i a = _mm_loadu_si128((const __m128i *)itr);
+        __m128i b = _mm_loadu_si128((const __m128i *)(itr + 1));
+        __m128i c = _mm_loadu_si128((const __m128i *)(itr + 2));
+        int mask;
+
+        mask = _mm_movemask_epi8(_mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(a, v1),
+                                                              _mm_cmpeq_epi8(b, v1)),
+                                               _mm_cmpeq_epi8(c, v2)));
+        if (mask) return itr + __builtin_ctz(mask);
+     }
+   return itr;
+}
+
+static inline const char *
+_eina_simple_xml_head_end(const char *itr, const char *itr_end)
+{
+   if (!_eina_simple_xml_sse2) return itr;
+   return (itr_end - itr > 16) ? itr + 16 : itr_end;
+}
+#else
+# define _eina_simple_xml_head_end(itr, itr_end) (itr)
+#endif
+
 static inline const char *
 _eina_simple_xml_whitespace_find(const char *itr, const char *itr_end)
 {
+   const char *head = _eina_simple_xml_head_end(itr, itr_end);
+
+   for (; itr < head; itr++)
+     if (isspace((unsigned char)*itr))
+       return itr;
+#ifdef EINA_SIMPLE_XML_SSE2
+   if (_eina_simple_xml_sse2)
+     itr = _eina_simple_xml_whitespace_find_sse2(itr, itr_end, EINA_TRUE);
+#endif
    for (; itr < itr_end; itr++)
      if (isspace((unsigned char)*itr)) break;
    return itr;
@@ -131,6 +254,15 @@ _eina_simple_xml_whitespace_find(const char *itr, const char *itr_end)
 static inline const char *
 _eina_simple_xml_whitespace_skip(const char *itr, const char *itr_end)
 {
+   const char *head = _eina_simple_xml_head_end(itr, itr_end);
+
+   for (; itr < head; itr++)
+     if (!isspace((unsigned char)*itr))
+       return itr;
+#ifdef EINA_SIMPLE_XML_SSE2
+   if (_eina_simple_xml_sse2)
+     itr = _eina_simple_xml_whitespace_find_sse2(itr, itr_end, EINA_FALSE);
+#endif
    for (; itr < itr_end; itr++)
      if (!isspace((unsigned char)*itr)) break;
    return itr;
@@ -153,6 +285,15 @@ _eina_simple_xml_tag_start_find(const char *itr, const char *itr_end)
 static inline const char *
 _eina_simple_xml_tag_end_find(const char *itr, const char *itr_end)
 {
+   const char *head = _eina_simple_xml_head_end(itr, itr_end);
+
+   for (; itr < head; itr++)
+     if ((*itr == '>') || (*itr == '<'))
+       return itr;
+#ifdef EINA_SIMPLE_XML_SSE2
+   if (_eina_simple_xml_sse2)
+     itr = _eina_simple_xml_tag_end_find_sse2(itr, itr_end);
+#endif
    for (; itr < itr_end; itr++)
      if ((*itr == '>') || (*itr == '<')) /* consider < also ends a tag */
        return itr;
@@ -162,6 +303,17 @@ _eina_simple_xml_tag_end_find(const char *itr, const char *itr_end)
 static inline const char *
 _eina_simple_xml_tag_comment_end_find(const char *itr, const char *itr_end)
 {
+   const char *head = _eina_simple_xml_head_end(itr, itr_end);
+
+   for (; itr < head; itr++)
+     if ((*itr == '-') &&
+         ((itr + 1 < itr_end) && (*(itr + 1) == '-')) &&
+         ((itr + 2 < itr_end) && (*(itr + 2) == '>')))
+       return itr + 2;
+#ifdef EINA_SIMPLE_XML_SSE2
+   if (_eina_simple_xml_sse2)
+     itr = _eina_simple_xml_sequence_find_sse2(itr, itr_end, '-', '>');
+#endif
    for (; itr < itr_end; itr++)
      if ((*itr == '-') &&
          ((itr + 1 < itr_end) && (*(itr + 1) == '-')) &&
@@ -173,6 +325,17 @@ _eina_simple_xml_tag_comment_end_find(const char *itr, const char *itr_end)
 static inline const char *
 _eina_simple_xml_tag_cdata_end_find(const char *itr, const char *itr_end)
 {
+   const char *head = _eina_simple_xml_head_end(itr, itr_end);
+
+   for (; itr < head; itr++)
+     if ((*itr == ']') &&
+         ((itr + 1 < itr_end) && (*(itr + 1) == ']')) &&
+         ((itr + 2 < itr_end) && (*(itr + 2) == '>')))
+       return itr + 2;
+#ifdef EINA_SIMPLE_XML_SSE2
+   if (_eina_simple_xml_sse2)
+     itr = _eina_simple_xml_sequence_find_sse2(itr, itr_end, ']', '>');
+#endif
    for (; itr < itr_end; itr++)
      if ((*itr == ']') &&
          ((itr + 1 < itr_end) && (*(itr + 1) == ']')) &&
@@ -181,124 +344,186 @@ _eina_simple_xml_tag_cdata_end_find(const char *itr, const char *itr_end)
    return NULL;
 }
 
-/**
- * @endcond
+/* Structural index: the offsets of every '<' and '>' of the document,
+ * found by several threads, each in its own slice. As quotes do not
+ * matter to this parser, they are all that is needed to find where
+ * tokens start and end, the parser then walks the index in order while
+ * the next slices are still being looked at.
  */
+#define EINA_SIMPLE_XML_INDEX_THREADS_MAX 32
+#define EINA_SIMPLE_XML_INDEX_SLICE_MIN (1024 * 1024)
 
-/*============================================================================*
- *                                 Global                                     *
- *============================================================================*/
+typedef struct _Eina_Simple_XML_Index Eina_Simple_XML_Index;
+typedef struct _Eina_Simple_XML_Index_Slice Eina_Simple_XML_Index_Slice;
 
+struct _Eina_Simple_XML_Index_Slice
+{
+   Eina_Simple_XML_Index *idx;
+   const char *start;
+   const char *end;
+   unsigned *marks; /* offsets in the document, increasing */
+   unsigned count;
+   Eina_Bool done : 1; /* marks can be read */
+   Eina_Bool failed : 1; /* marks are not usable, look at the bytes */
+};
 
-/**
- * @internal
- * @brief Initialize the simple xml parser module.
- *
- * @return #EINA_TRUE on success, #EINA_FALSE on failure.
- *
- * This function sets up the simple xml parser module of Eina. It is called by
- * eina_init().
- *
- * @see eina_init()
- */
-Eina_Bool
-eina_simple_xml_init(void)
+struct _Eina_Simple_XML_Index
 {
-   const char *choice, *tmp;
+   const char *buf;
+   Eina_Simple_XML_Index_Slice *slices;
+   unsigned slice_count;
+   unsigned slice; /* cursor of the parser */
+   unsigned mark;
+   unsigned ready; /* slices known to be done */
+
+   Eina_Lock lock;
+   Eina_Condition cond;
+};
 
-   _eina_simple_xml_log_dom = eina_log_domain_register("eina_simple_xml",
-                                                       EINA_LOG_COLOR_DEFAULT);
-   if (_eina_simple_xml_log_dom < 0)
+static void
+_eina_simple_xml_index_slice_scan(Eina_Simple_XML_Index_Slice *slice)
+{
+   const char *itr = slice->start, *p;
+   unsigned size = (slice->end - slice->start) / 32 + 16;
+
+   slice->marks = malloc(size * sizeof(unsigned));
+   if (!slice->marks) goto on_error;
+
+   while ((p = _eina_simple_xml_tag_end_find(itr, slice->end)))
      {
-        EINA_LOG_ERR("Could not register log domain: eina_simple_xml");
-        return EINA_FALSE;
+        if (slice->count == size)
+          {
+             unsigned *tmp;
+
+             size *= 2;
+             tmp = realloc(slice->marks, size * sizeof(unsigned));
+             if (!tmp) goto on_error;
+             slice->marks = tmp;
+          }
+        slice->marks[slice->count++] = p - slice->idx->buf;
+        itr = p + 1;
      }
+   return;
+
+ on_error:
+   /* no logging, this may run in a thread that did not init eina */
+   free(slice->marks);
+   slice->marks = NULL;
+   slice->count = 0;
+   slice->failed = EINA_TRUE;
+}
 
-#ifdef EINA_DEFAULT_MEMPOOL
-   choice = "pass_through";
-#else
-   choice = "chained_mempool";
+#ifdef EFL_HAVE_POSIX_THREADS
+static void *
+_eina_simple_xml_index_worker(void *data)
+{
+   Eina_Simple_XML_Index_Slice *slice = data;
+   Eina_Simple_XML_Index *idx = slice->idx;
+
+   _eina_simple_xml_index_slice_scan(slice);
+
+   eina_lock_take(&idx->lock);
+   slice->done = EINA_TRUE;
+   eina_condition_broadcast(&idx->cond);
+   eina_lock_release(&idx->lock);
+
+   return NULL;
+}
 #endif
-   tmp = getenv("EINA_MEMPOOL");
-   if (tmp && tmp[0])
-      choice = tmp;
 
-   _eina_simple_xml_tag_mp = eina_mempool_add
-         (choice, "simple_xml_tag", NULL,
-          sizeof(Eina_Simple_XML_Node_Tag), 32);
-   if (!_eina_simple_xml_tag_mp)
-     {
-        ERR("Mempool for simple_xml_tag cannot be allocated in init.");
-        goto on_init_fail;
-     }
+/* first '<' or '>' at or after from */
+static const char *
+_eina_simple_xml_index_next(Eina_Simple_XML_Index *idx, const char *from)
+{
+   unsigned offset = from - idx->buf;
 
-   _eina_simple_xml_attribute_mp = eina_mempool_add
-         (choice, "simple_xml_attribute", NULL,
-          sizeof(Eina_Simple_XML_Attribute), 8);
-   if (!_eina_simple_xml_attribute_mp)
+   for (; idx->slice < idx->slice_count; idx->slice++, idx->mark = 0)
      {
-        ERR("Mempool for simple_xml_attribute cannot be allocated in init.");
-        eina_mempool_del(_eina_simple_xml_tag_mp);
-        goto on_init_fail;
-     }
+        Eina_Simple_XML_Index_Slice *slice = idx->slices + idx->slice;
 
-#define EMS(n) eina_magic_string_static_set(n, n ## _STR)
-   EMS(EINA_MAGIC_SIMPLE_XML_TAG);
-   EMS(EINA_MAGIC_SIMPLE_XML_DATA);
-   EMS(EINA_MAGIC_SIMPLE_XML_ATTRIBUTE);
-#undef EMS
+        if (idx->ready <= idx->slice)
+          {
+             eina_lock_take(&idx->lock);
+             while (!slice->done)
+               eina_condition_wait(&idx->cond);
+             eina_lock_release(&idx->lock);
+             idx->ready = idx->slice + 1;
+          }
 
-   return EINA_TRUE;
+        if (slice->failed)
+          {
+             const char *p;
 
-on_init_fail:
-   eina_log_domain_unregister(_eina_simple_xml_log_dom);
-   _eina_simple_xml_log_dom = -1;
-   return EINA_FALSE;
+             if (from >= slice->end) continue;
+             if (from < slice->start) from = slice->start;
+             p = _eina_simple_xml_tag_end_find(from, slice->end);
+             if (p) return p;
+             continue;
+          }
+
+        while ((idx->mark < slice->count) &&
+               (slice->marks[idx->mark] < offset))
+          idx->mark++;
+        if (idx->mark < slice->count)
+          return idx->buf + slice->marks[idx->mark];
+     }
+
+   return NULL;
 }
 
-/**
- * @internal
- * @brief Shut down the simple xml parser module.
- *
- * @return #EINA_TRUE on success, #EINA_FALSE on failure.
- *
- * This function shuts down the simple xml parser module set
- * up by eina_simple_xml_init(). It is called by
- * eina_shutdown().
- *
- * @see eina_shutdown()
- */
-Eina_Bool
-eina_simple_xml_shutdown(void)
+static const char *
+_eina_simple_xml_index_tag_start_find(Eina_Simple_XML_Index *idx, const char *itr)
 {
-   eina_mempool_del(_eina_simple_xml_attribute_mp);
-   eina_mempool_del(_eina_simple_xml_tag_mp);
+   const char *p;
 
-   eina_log_domain_unregister(_eina_simple_xml_log_dom);
-   _eina_simple_xml_log_dom = -1;
-   return EINA_TRUE;
+   while ((p = _eina_simple_xml_index_next(idx, itr)) && (*p != '<'))
+     itr = p + 1;
+   return p;
 }
 
+/* the '>' of the first c c > at or after from, "-->" or "]]>" */
+static const char *
+_eina_simple_xml_index_sequence_end_find(Eina_Simple_XML_Index *idx, const char *from, char c)
+{
+   const char *itr = from, *p;
 
-/*============================================================================*
- *                                   API                                      *
- *============================================================================*/
+   while ((p = _eina_simple_xml_index_next(idx, itr)))
+     {
+        if ((*p == '>') && (p - 2 >= from) &&
+            (p[-1] == c) && (p[-2] == c))
+          return p;
+        itr = p + 1;
+     }
+   return NULL;
+}
 
+struct _Eina_Simple_XML_Parser
+{
+   Eina_Simple_XML_Cb func;
+   const void *data;
+   Eina_Binbuf *pending; /* bytes of the unfinished token */
+   unsigned offset; /* of the unfinished token in the document */
+   Eina_Bool strip : 1;
+   Eina_Bool failed : 1;
+};
 
-EAPI Eina_Bool
-eina_simple_xml_parse(const char *buf, unsigned buflen, Eina_Bool strip, Eina_Simple_XML_Cb func, const void *data)
+/*
+ * Parse buf, offset is where it starts in the whole document. Unless
+ * last is set, parsing stops before a token that may continue after
+ * buf and *stop tells where, so it can be parsed again with more bytes.
+ * If idx is given, it is used to find where tokens start and end.
+ */
+static Eina_Bool
+_eina_simple_xml_parse(const char *buf, unsigned buflen, unsigned offset, Eina_Bool strip, Eina_Bool last, Eina_Simple_XML_Index *idx, Eina_Simple_XML_Cb func, const void *data, const char **stop)
 {
    const char *itr = buf, *itr_end = buf + buflen;
 
-   if (!buf) return EINA_FALSE;
-   if (!func) return EINA_FALSE;
-
 #define CB(type, start, end)                                            \
    do                                                                   \
      {                                                                  \
         size_t _sz = end - start;                                       \
         Eina_Bool _ret;                                                 \
-        _ret = func((void*)data, type, start, start - buf, _sz);        \
+        _ret = func((void*)data, type, start, offset + (start - buf), _sz); \
         if (!_ret) return EINA_FALSE;                                   \
      }                                                                  \
    while (0)
@@ -307,6 +532,13 @@ eina_simple_xml_parse(const char *buf, unsigned buflen, Eina_Bool strip, Eina_Si
      {
         if (itr[0] == '<')
           {
+             /* enough bytes to tell "<![CDATA[" and others apart */
+             if ((!last) &&
+                 ((itr + 1 >= itr_end) ||
+                  ((itr[1] == '!') &&
+                   (itr_end - itr < (ptrdiff_t)sizeof("<![CDATA[]]>")))))
+               break;
+
              if (itr + 1 >= itr_end)
                {
                   CB(EINA_SIMPLE_XML_ERROR, itr, itr_end);
@@ -364,13 +596,25 @@ eina_simple_xml_parse(const char *buf, unsigned buflen, Eina_Bool strip, Eina_Si
                        toff = 0;
                     }
 
-                  if (type == EINA_SIMPLE_XML_CDATA)
+                  if (idx)
+                    {
+                       if (type == EINA_SIMPLE_XML_CDATA)
+                         p = _eina_simple_xml_index_sequence_end_find(idx, itr + 1 + toff, ']');
+                       else if (type == EINA_SIMPLE_XML_COMMENT)
+                         p = _eina_simple_xml_index_sequence_end_find(idx, itr + 1 + toff, '-');
+                       else
+                         p = _eina_simple_xml_index_next(idx, itr + 1 + toff);
+                    }
+                  else if (type == EINA_SIMPLE_XML_CDATA)
                     p = _eina_simple_xml_tag_cdata_end_find(itr + 1 + toff, itr_end);
                   else if (type == EINA_SIMPLE_XML_COMMENT)
                     p = _eina_simple_xml_tag_comment_end_find(itr + 1 + toff, itr_end);
                   else
                     p = _eina_simple_xml_tag_end_find(itr + 1 + toff, itr_end);
 
+                  if ((!p) && (!last))
+                    break;
+
                   if ((p) && (*p == '<'))
                     {
                        type = EINA_SIMPLE_XML_ERROR;
@@ -435,11 +679,22 @@ eina_simple_xml_parse(const char *buf, unsigned buflen, Eina_Bool strip, Eina_Si
           }
         else
           {
-             const char *p, *end;
+             const char *p, *end, *tag;
+
+             /* data is only known to end at the next tag */
+             if (idx)
+               tag = _eina_simple_xml_index_tag_start_find(idx, itr);
+             else
+               tag = _eina_simple_xml_tag_start_find(itr, itr_end);
+             if (!tag)
+               {
+                  if (!last) break;
+                  tag = itr_end;
+               }
 
              if (strip)
                {
-                  p = _eina_simple_xml_whitespace_skip(itr, itr_end);
+                  p = _eina_simple_xml_whitespace_skip(itr, tag);
                   if (p)
                     {
                        CB(EINA_SIMPLE_XML_IGNORED, itr, p);
@@ -447,8 +702,7 @@ eina_simple_xml_parse(const char *buf, unsigned buflen, Eina_Bool strip, Eina_Si
                     }
                }
 
-             p = _eina_simple_xml_tag_start_find(itr, itr_end);
-             if (!p) p = itr_end;
+             p = tag;
 
              end = p;
              if (strip)
@@ -466,9 +720,354 @@ eina_simple_xml_parse(const char *buf, unsigned buflen, Eina_Bool strip, Eina_Si
 
 #undef CB
 
+   if (stop) *stop = itr;
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_eina_simple_xml_parser_run(Eina_Simple_XML_Parser *parser, const char *buf, unsigned buflen, Eina_Bool last)
+{
+   const char *stop = buf;
+
+   if (!_eina_simple_xml_parse(buf, buflen, parser->offset, parser->strip,
+                               last, NULL, parser->func, parser->data, &stop))
+     {
+        parser->failed = EINA_TRUE;
+        return EINA_FALSE;
+     }
+
+   parser->offset += stop - buf;
    return EINA_TRUE;
 }
 
+/* parse the pending bytes and drop what is done with */
+static Eina_Bool
+_eina_simple_xml_parser_pending_run(Eina_Simple_XML_Parser *parser, Eina_Bool last)
+{
+   const char *pending;
+   unsigned offset = parser->offset;
+
+   pending = (const char *)eina_binbuf_string_get(parser->pending);
+   if (!_eina_simple_xml_parser_run(parser, pending,
+                                    eina_binbuf_length_get(parser->pending),
+                                    last))
+     return EINA_FALSE;
+
+   eina_binbuf_remove(parser->pending, 0, parser->offset - offset);
+   return EINA_TRUE;
+}
+
+/**
+ * @endcond
+ */
+
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+
+
+/**
+ * @internal
+ * @brief Initialize the simple xml parser module.
+ *
+ * @return #EINA_TRUE on success, #EINA_FALSE on failure.
+ *
+ * This function sets up the simple xml parser module of Eina. It is called by
+ * eina_init().
+ *
+ * @see eina_init()
+ */
+Eina_Bool
+eina_simple_xml_init(void)
+{
+   const char *choice, *tmp;
+
+   _eina_simple_xml_log_dom = eina_log_domain_register("eina_simple_xml",
+                                                       EINA_LOG_COLOR_DEFAULT);
+   if (_eina_simple_xml_log_dom < 0)
+     {
+        EINA_LOG_ERR("Could not register log domain: eina_simple_xml");
+        return EINA_FALSE;
+     }
+
+#ifdef EINA_DEFAULT_MEMPOOL
+   choice = "pass_through";
+#else
+   choice = "chained_mempool";
+#endif
+   tmp = getenv("EINA_MEMPOOL");
+   if (tmp && tmp[0])
+      choice = tmp;
+
+   _eina_simple_xml_tag_mp = eina_mempool_add
+         (choice, "simple_xml_tag", NULL,
+          sizeof(Eina_Simple_XML_Node_Tag), 32);
+   if (!_eina_simple_xml_tag_mp)
+     {
+        ERR("Mempool for simple_xml_tag cannot be allocated in init.");
+        goto on_init_fail;
+     }
+
+   _eina_simple_xml_attribute_mp = eina_mempool_add
+         (choice, "simple_xml_attribute", NULL,
+          sizeof(Eina_Simple_XML_Attribute), 8);
+   if (!_eina_simple_xml_attribute_mp)
+     {
+        ERR("Mempool for simple_xml_attribute cannot be allocated in init.");
+        eina_mempool_del(_eina_simple_xml_tag_mp);
+        goto on_init_fail;
+     }
+
+#ifdef EINA_SIMPLE_XML_SSE2
+   _eina_simple_xml_sse2 = !!(eina_cpu_features_get() & EINA_CPU_SSE2);
+#endif
+
+#define EMS(n) eina_magic_string_static_set(n, n ## _STR)
+   EMS(EINA_MAGIC_SIMPLE_XML_TAG);
+   EMS(EINA_MAGIC_SIMPLE_XML_DATA);
+   EMS(EINA_MAGIC_SIMPLE_XML_ATTRIBUTE);
+#undef EMS
+
+   return EINA_TRUE;
+
+on_init_fail:
+   eina_log_domain_unregister(_eina_simple_xml_log_dom);
+   _eina_simple_xml_log_dom = -1;
+   return EINA_FALSE;
+}
+
+/**
+ * @internal
+ * @brief Shut down the simple xml parser module.
+ *
+ * @return #EINA_TRUE on success, #EINA_FALSE on failure.
+ *
+ * This function shuts down the simple xml parser module set
+ * up by eina_simple_xml_init(). It is called by
+ * eina_shutdown().
+ *
+ * @see eina_shutdown()
+ */
+Eina_Bool
+eina_simple_xml_shutdown(void)
+{
+   eina_mempool_del(_eina_simple_xml_attribute_mp);
+   eina_mempool_del(_eina_simple_xml_tag_mp);
+
+   eina_log_domain_unregister(_eina_simple_xml_log_dom);
+   _eina_simple_xml_log_dom = -1;
+   return EINA_TRUE;
+}
+
+
+/*============================================================================*
+ *                                   API                                      *
+ *============================================================================*/
+
+
+EAPI Eina_Bool
+eina_simple_xml_parse(const char *buf, unsigned buflen, Eina_Bool strip, Eina_Simple_XML_Cb func, const void *data)
+{
+   if (!buf) return EINA_FALSE;
+   if (!func) return EINA_FALSE;
+
+   return _eina_simple_xml_parse(buf, buflen, 0, strip, EINA_TRUE, NULL,
+                                 func, data, NULL);
+}
+
+EAPI Eina_Bool
+eina_simple_xml_parse_parallel(const char *buf, unsigned buflen, Eina_Bool strip, unsigned int max_threads, Eina_Simple_XML_Cb func, const void *data)
+{
+#ifdef EFL_HAVE_POSIX_THREADS
+   Eina_Simple_XML_Index idx;
+   Eina_Simple_XML_Index_Slice *slices;
+   pthread_t *threads;
+   Eina_Bool *started;
+   unsigned int i, slice_size;
+   Eina_Bool r;
+#endif
+
+   if (!buf) return EINA_FALSE;
+   if (!func) return EINA_FALSE;
+
+#ifdef EFL_HAVE_POSIX_THREADS
+   if (max_threads == 0) max_threads = eina_cpu_count();
+   if (max_threads > EINA_SIMPLE_XML_INDEX_THREADS_MAX)
+     max_threads = EINA_SIMPLE_XML_INDEX_THREADS_MAX;
+   if (max_threads > buflen / EINA_SIMPLE_XML_INDEX_SLICE_MIN)
+     max_threads = buflen / EINA_SIMPLE_XML_INDEX_SLICE_MIN;
+   if (max_threads < 2)
+     return eina_simple_xml_parse(buf, buflen, strip, func, data);
+
+   slices = calloc(max_threads, sizeof(Eina_Simple_XML_Index_Slice));
+   if (!slices)
+     return eina_simple_xml_parse(buf, buflen, strip, func, data);
+
+   idx.buf = buf;
+   idx.slices = slices;
+   idx.slice_count = max_threads;
+   idx.slice = 0;
+   idx.mark = 0;
+   idx.ready = 0;
+
+   slice_size = buflen / max_threads;
+   for (i = 0; i < max_threads; i++)
+     {
+        slices[i].idx = &idx;
+        slices[i].start = buf + i * slice_size;
+        slices[i].end = (i + 1 < max_threads) ?
+          buf + (i + 1) * slice_size : buf + buflen;
+     }
+
+   eina_threads_init();
+   if (!eina_lock_new(&idx.lock))
+     goto on_error;
+   if (!eina_condition_new(&idx.cond, &idx.lock))
+     {
+        eina_lock_free(&idx.lock);
+        goto on_error;
+     }
+
+   threads = alloca(sizeof(pthread_t) * max_threads);
+   started = alloca(sizeof(Eina_Bool) * max_threads);
+   for (i = 1; i < max_threads; i++)
+     {
+        started[i] = !pthread_create(&threads[i], NULL,
+                                     _eina_simple_xml_index_worker,
+                                     slices + i);
+        if (!started[i])
+          {
+             /* the parser will look at the bytes itself */
+             slices[i].failed = EINA_TRUE;
+             slices[i].done = EINA_TRUE;
+          }
+     }
+
+   _eina_simple_xml_index_slice_scan(slices);
+   slices[0].done = EINA_TRUE;
+
+   r = _eina_simple_xml_parse(buf, buflen, 0, strip, EINA_TRUE, &idx,
+                              func, data, NULL);
+
+   for (i = 1; i < max_threads; i++)
+     if (started[i]) pthread_join(threads[i], NULL);
+
+   eina_condition_free(&idx.cond);
+   eina_lock_free(&idx.lock);
+   eina_threads_shutdown();
+
+   for (i = 0; i < max_threads; i++)
+     free(slices[i].marks);
+   free(slices);
+
+   return r;
+
+ on_error:
+   eina_threads_shutdown();
+   free(slices);
+   return eina_simple_xml_parse(buf, buflen, strip, func, data);
+#else
+   (void) max_threads;
+   return eina_simple_xml_parse(buf, buflen, strip, func, data);
+#endif
+}
+
+EAPI Eina_Simple_XML_Parser *
+eina_simple_xml_parser_new(Eina_Bool strip, Eina_Simple_XML_Cb func, const void *data)
+{
+   Eina_Simple_XML_Parser *parser;
+
+   if (!func) return NULL;
+
+   parser = calloc(1, sizeof(Eina_Simple_XML_Parser));
+   if (!parser) return NULL;
+
+   parser->pending = eina_binbuf_new();
+   if (!parser->pending)
+     {
+        free(parser);
+        return NULL;
+     }
+
+   parser->func = func;
+   parser->data = data;
+   parser->strip = !!strip;
+   return parser;
+}
+
+EAPI void
+eina_simple_xml_parser_free(Eina_Simple_XML_Parser *parser)
+{
+   if (!parser) return;
+
+   eina_binbuf_free(parser->pending);
+   free(parser);
+}
+
+EAPI Eina_Bool
+eina_simple_xml_parser_feed(Eina_Simple_XML_Parser *parser, const char *buf, unsigned buflen)
+{
+   const char *pending;
+   size_t length;
+   unsigned consumed;
+
+   if (!parser) return EINA_FALSE;
+   if ((!buf) && (buflen)) return EINA_FALSE;
+   if (parser->failed) return EINA_FALSE;
+   if (!buflen) return EINA_TRUE;
+
+   length = eina_binbuf_length_get(parser->pending);
+   if (!length)
+     {
+        unsigned offset = parser->offset;
+
+        /* nothing left from the previous chunks, parse buf in place */
+        if (!_eina_simple_xml_parser_run(parser, buf, buflen, EINA_FALSE))
+          return EINA_FALSE;
+        consumed = parser->offset - offset;
+        if ((consumed < buflen) &&
+            (!eina_binbuf_append_length(parser->pending,
+                                        (const unsigned char *)buf + consumed,
+                                        buflen - consumed)))
+          goto on_error;
+        return EINA_TRUE;
+     }
+
+   if (!eina_binbuf_append_length(parser->pending,
+                                  (const unsigned char *)buf, buflen))
+     goto on_error;
+
+   /* a tag can only end with a '>' or '<' and data with a '<', do not
+    * look again at a long token until one of them comes.
+    */
+   pending = (const char *)eina_binbuf_string_get(parser->pending);
+   if ((pending[0] == '<') && (length > 1) &&
+       ((pending[1] != '!') || (length >= sizeof("<![CDATA[]]>"))))
+     {
+        if ((!memchr(buf, '>', buflen)) && (!memchr(buf, '<', buflen)))
+          return EINA_TRUE;
+     }
+   else if ((pending[0] != '<') && (!memchr(buf, '<', buflen)))
+     return EINA_TRUE;
+
+   return _eina_simple_xml_parser_pending_run(parser, EINA_FALSE);
+
+ on_error:
+   ERR("could not keep %u bytes of unfinished XML", buflen);
+   parser->failed = EINA_TRUE;
+   return EINA_FALSE;
+}
+
+EAPI Eina_Bool
+eina_simple_xml_parser_end(Eina_Simple_XML_Parser *parser)
+{
+   if (!parser) return EINA_FALSE;
+   if (parser->failed) return EINA_FALSE;
+   if (!eina_binbuf_length_get(parser->pending)) return EINA_TRUE;
+
+   return _eina_simple_xml_parser_pending_run(parser, EINA_TRUE);
+}
+
 EAPI const char *
 eina_simple_xml_tag_attributes_find(const char *buf, unsigned buflen)
 {
@@ -822,22 +1421,211 @@ eina_simple_xml_node_comment_free(Eina_Simple_XML_Node_Data *node)
    _eina_simple_xml_node_data_free(node);
 }
 
+/* Arena loader: the nodes and their strings of a read only tree are cut
+ * from big blocks, without stringshare, and are freed all at once.
+ */
+
+#define EINA_SIMPLE_XML_ARENA_ALIGN(n) \
+  (((n) + sizeof(void *) - 1) & ~(sizeof(void *) - 1))
+#define EINA_SIMPLE_XML_ARENA_BLOCK_MIN 4096
+#define EINA_SIMPLE_XML_ARENA_BLOCK_MAX (4 * 1024 * 1024)
+
+typedef struct _Eina_Simple_XML_Arena_Block Eina_Simple_XML_Arena_Block;
+typedef struct _Eina_Simple_XML_Arena Eina_Simple_XML_Arena;
+
+struct _Eina_Simple_XML_Arena_Block
+{
+   Eina_Simple_XML_Arena_Block *next;
+};
+
+struct _Eina_Simple_XML_Arena
+{
+   Eina_Simple_XML_Node_Root root; /* first, the tree is freed from it */
+   Eina_Simple_XML_Arena_Block *blocks;
+   char *cur;
+   char *end;
+   size_t block_size;
+};
+
+/* name of the root of the trees loaded in an arena */
+static const char _eina_simple_xml_arena_root_name[] = "";
+
+static void *
+_eina_simple_xml_arena_alloc(Eina_Simple_XML_Arena *arena, size_t size)
+{
+   void *ret;
+
+   size = EINA_SIMPLE_XML_ARENA_ALIGN(size);
+   if ((size_t)(arena->end - arena->cur) < size)
+     {
+        Eina_Simple_XML_Arena_Block *block;
+        size_t block_size = arena->block_size;
+
+        if (block_size < size) block_size = size;
+        block = malloc(EINA_SIMPLE_XML_ARENA_ALIGN(sizeof(*block)) + block_size);
+        if (!block)
+          {
+             ERR("could not allocate %zu bytes for the nodes", block_size);
+             return NULL;
+          }
+
+        block->next = arena->blocks;
+        arena->blocks = block;
+        arena->cur = (char *)block + EINA_SIMPLE_XML_ARENA_ALIGN(sizeof(*block));
+        arena->end = arena->cur + block_size;
+
+        if (arena->block_size < EINA_SIMPLE_XML_ARENA_BLOCK_MAX)
+          arena->block_size *= 2;
+     }
+
+   ret = arena->cur;
+   arena->cur += size;
+   return ret;
+}
+
+static Eina_Simple_XML_Arena *
+_eina_simple_xml_arena_new(unsigned buflen)
+{
+   Eina_Simple_XML_Arena *arena;
+
+   arena = calloc(1, sizeof(Eina_Simple_XML_Arena));
+   if (!arena) return NULL;
+
+   EINA_MAGIC_SET(&arena->root.base, EINA_MAGIC_SIMPLE_XML_TAG);
+   arena->root.base.type = EINA_SIMPLE_XML_NODE_ROOT;
+   arena->root.name = _eina_simple_xml_arena_root_name;
+
+   /* nodes usually take more room than their text */
+   arena->block_size = buflen;
+   if (arena->block_size < EINA_SIMPLE_XML_ARENA_BLOCK_MIN)
+     arena->block_size = EINA_SIMPLE_XML_ARENA_BLOCK_MIN;
+   else if (arena->block_size > EINA_SIMPLE_XML_ARENA_BLOCK_MAX)
+     arena->block_size = EINA_SIMPLE_XML_ARENA_BLOCK_MAX;
+
+   return arena;
+}
+
+static void
+_eina_simple_xml_arena_free(Eina_Simple_XML_Arena *arena)
+{
+   while (arena->blocks)
+     {
+        Eina_Simple_XML_Arena_Block *block = arena->blocks;
+
+        arena->blocks = block->next;
+        free(block);
+     }
+
+   EINA_MAGIC_SET(&arena->root.base, EINA_MAGIC_NONE);
+   free(arena);
+}
+
+static Eina_Simple_XML_Node_Tag *
+_eina_simple_xml_arena_tag_new(Eina_Simple_XML_Arena *arena, Eina_Simple_XML_Node_Tag *parent, const char *name, size_t length)
+{
+   Eina_Simple_XML_Node_Tag *n;
+   char *s;
+
+   n = _eina_simple_xml_arena_alloc(arena, sizeof(*n) + length + 1);
+   if (!n) return NULL;
+
+   memset(n, 0, sizeof(*n));
+   EINA_MAGIC_SET(&n->base, EINA_MAGIC_SIMPLE_XML_TAG);
+   n->base.type = EINA_SIMPLE_XML_NODE_TAG;
+   n->base.parent = parent;
+
+   s = (char *)(n + 1);
+   memcpy(s, name, length);
+   s[length] = '\0';
+   n->name = s;
+
+   parent->children = eina_inlist_append
+     (parent->children, EINA_INLIST_GET(&n->base));
+
+   return n;
+}
+
+static Eina_Simple_XML_Node_Data *
+_eina_simple_xml_arena_data_new(Eina_Simple_XML_Arena *arena, Eina_Simple_XML_Node_Tag *parent, Eina_Simple_XML_Node_Type type, const char *content, unsigned length)
+{
+   Eina_Simple_XML_Node_Data *n;
+
+   n = _eina_simple_xml_arena_alloc(arena, sizeof(*n) + length + 1);
+   if (!n) return NULL;
+
+   EINA_MAGIC_SET(&n->base, EINA_MAGIC_SIMPLE_XML_DATA);
+   n->base.type = type;
+   n->base.parent = parent;
+
+   n->length = length;
+   memcpy(n->data, content, length);
+   n->data[length] = '\0';
+
+   parent->children = eina_inlist_append
+     (parent->children, EINA_INLIST_GET(&n->base));
+
+   return n;
+}
+
+static Eina_Simple_XML_Attribute *
+_eina_simple_xml_arena_attribute_new(Eina_Simple_XML_Arena *arena, Eina_Simple_XML_Node_Tag *parent, const char *key, const char *value)
+{
+   Eina_Simple_XML_Attribute *attr;
+   size_t klen = strlen(key) + 1, vlen = strlen(value) + 1;
+   char *s;
+
+   attr = _eina_simple_xml_arena_alloc(arena, sizeof(*attr) + klen + vlen);
+   if (!attr) return NULL;
+
+   EINA_MAGIC_SET(attr, EINA_MAGIC_SIMPLE_XML_ATTRIBUTE);
+   attr->parent = parent;
+
+   s = (char *)(attr + 1);
+   memcpy(s, key, klen);
+   attr->key = s;
+   memcpy(s + klen, value, vlen);
+   attr->value = s + klen;
+
+   parent->attributes = eina_inlist_append
+     (parent->attributes, EINA_INLIST_GET(attr));
+
+   return attr;
+}
+
 struct eina_simple_xml_node_load_ctxt
 {
    Eina_Simple_XML_Node_Root *root;
    Eina_Simple_XML_Node_Tag *current;
+   Eina_Simple_XML_Node_Tag *tag; /* getting its attributes */
+   Eina_Simple_XML_Arena *arena; /* NULL unless loaded in an arena */
 };
 
 static Eina_Bool
 _eina_simple_xml_attrs_parse(void *data, const char *key, const char *value)
 {
-   Eina_Simple_XML_Node_Tag *n = data;
+   struct eina_simple_xml_node_load_ctxt *ctx = data;
    Eina_Simple_XML_Attribute *attr;
 
-   attr = eina_simple_xml_attribute_new(n, key, value);
+   if (ctx->arena)
+     attr = _eina_simple_xml_arena_attribute_new(ctx->arena, ctx->tag, key, value);
+   else
+     attr = eina_simple_xml_attribute_new(ctx->tag, key, value);
    return !!attr;
 }
 
+static Eina_Bool
+_eina_simple_xml_node_load_data(struct eina_simple_xml_node_load_ctxt *ctx, Eina_Simple_XML_Node_Type type, const char *content, unsigned length)
+{
+   Eina_Simple_XML_Node_Data *n;
+
+   if (ctx->arena)
+     n = _eina_simple_xml_arena_data_new
+       (ctx->arena, ctx->current, type, content, length);
+   else
+     n = _eina_simple_xml_node_data_new(ctx->current, type, content, length);
+   return !!n;
+}
+
 static Eina_Bool
 _eina_simple_xml_node_parse(void *data, Eina_Simple_XML_Type type, const char *content, unsigned offset, unsigned length)
 {
@@ -859,15 +1647,24 @@ _eina_simple_xml_node_parse(void *data, Eina_Simple_XML_Type type, const char *c
 
            name_end = _eina_simple_xml_whitespace_unskip(name_end, content);
 
-           name = eina_stringshare_add_length(content, name_end - content);
-           n = eina_simple_xml_node_tag_new(ctx->current, name);
-           eina_stringshare_del(name);
+           if (ctx->arena)
+             n = _eina_simple_xml_arena_tag_new
+               (ctx->arena, ctx->current, content, name_end - content);
+           else
+             {
+                name = eina_stringshare_add_length(content, name_end - content);
+                n = eina_simple_xml_node_tag_new(ctx->current, name);
+                eina_stringshare_del(name);
+             }
            if (!n) return EINA_FALSE;
 
            if (attrs)
-             eina_simple_xml_attributes_parse
-               (attrs, length - (attrs - content),
-                _eina_simple_xml_attrs_parse, n);
+             {
+                ctx->tag = n;
+                eina_simple_xml_attributes_parse
+                  (attrs, length - (attrs - content),
+                   _eina_simple_xml_attrs_parse, ctx);
+             }
 
            if (type == EINA_SIMPLE_XML_OPEN)
              ctx->current = n;
@@ -879,10 +1676,14 @@ _eina_simple_xml_node_parse(void *data, Eina_Simple_XML_Type type, const char *c
            {
               const char *end = _eina_simple_xml_whitespace_unskip
                 (content + length, content);
-              int len;
+              int len, name_len;
               len = end - content;
+              if (ctx->arena)
+                name_len = strlen(ctx->current->name);
+              else
+                name_len = eina_stringshare_strlen(ctx->current->name);
               if ((len == 0) /* </> closes the tag for us. */ ||
-                  ((eina_stringshare_strlen(ctx->current->name) == len) &&
+                  ((name_len == len) &&
                    (memcmp(ctx->current->name, content, len) == 0)))
                 ctx->current = ctx->current->base.parent;
               else
@@ -895,20 +1696,20 @@ _eina_simple_xml_node_parse(void *data, Eina_Simple_XML_Type type, const char *c
          break;
 
       case EINA_SIMPLE_XML_DATA:
-         return !!eina_simple_xml_node_data_new
-           (ctx->current, content, length);
+         return _eina_simple_xml_node_load_data
+           (ctx, EINA_SIMPLE_XML_NODE_DATA, content, length);
       case EINA_SIMPLE_XML_CDATA:
-         return !!eina_simple_xml_node_cdata_new
-           (ctx->current, content, length);
+         return _eina_simple_xml_node_load_data
+           (ctx, EINA_SIMPLE_XML_NODE_CDATA, content, length);
       case EINA_SIMPLE_XML_PROCESSING:
-         return !!eina_simple_xml_node_processing_new
-           (ctx->current, content, length);
+         return _eina_simple_xml_node_load_data
+           (ctx, EINA_SIMPLE_XML_NODE_PROCESSING, content, length);
       case EINA_SIMPLE_XML_DOCTYPE:
-         return !!eina_simple_xml_node_doctype_new
-           (ctx->current, content, length);
+         return _eina_simple_xml_node_load_data
+           (ctx, EINA_SIMPLE_XML_NODE_DOCTYPE, content, length);
       case EINA_SIMPLE_XML_COMMENT:
-         return !!eina_simple_xml_node_comment_new
-           (ctx->current, content, length);
+         return _eina_simple_xml_node_load_data
+           (ctx, EINA_SIMPLE_XML_NODE_COMMENT, content, length);
 
       case EINA_SIMPLE_XML_ERROR:
          ERR("parser error at offset %u-%u: %.*s",
@@ -940,11 +1741,33 @@ eina_simple_xml_node_load(const char *buf, unsigned buflen, Eina_Bool strip)
 
    ctx.root = root;
    ctx.current = root;
+   ctx.tag = NULL;
+   ctx.arena = NULL;
    eina_simple_xml_parse(buf, buflen, strip, _eina_simple_xml_node_parse, &ctx);
 
    return root;
 }
 
+EAPI Eina_Simple_XML_Node_Root *
+eina_simple_xml_node_arena_load(const char *buf, unsigned buflen, Eina_Bool strip)
+{
+   Eina_Simple_XML_Arena *arena;
+   struct eina_simple_xml_node_load_ctxt ctx;
+
+   if (!buf) return NULL;
+
+   arena = _eina_simple_xml_arena_new(buflen);
+   if (!arena) return NULL;
+
+   ctx.root = &arena->root;
+   ctx.current = &arena->root;
+   ctx.tag = NULL;
+   ctx.arena = arena;
+   eina_simple_xml_parse(buf, buflen, strip, _eina_simple_xml_node_parse, &ctx);
+
+   return &arena->root;
+}
+
 EAPI void
 eina_simple_xml_node_root_free(Eina_Simple_XML_Node_Root *root)
 {
@@ -955,6 +1778,11 @@ eina_simple_xml_node_root_free(Eina_Simple_XML_Node_Root *root)
         ERR("expected root node!");
         return;
      }
+   if (root->name == _eina_simple_xml_arena_root_name)
+     {
+        _eina_simple_xml_arena_free((Eina_Simple_XML_Arena *)root);
+        return;
+     }
    _eina_simple_xml_node_tag_free(root);
 }
 
@@ -1003,8 +1831,7 @@ _eina_simple_xml_node_dump(Eina_Strbuf *buf, Eina_Simple_XML_Node *node, const c
            if (indent) _eina_simple_xml_node_dump_indent(buf, indent, level);
 
            eina_strbuf_append_char(buf, '<');
-           eina_strbuf_append_length
-               (buf, n->name, eina_stringshare_strlen(n->name));
+           eina_strbuf_append(buf, n->name);
 
            if (n->attributes)
              _eina_simple_xml_node_tag_attributes_append(buf, n);
@@ -1024,8 +1851,7 @@ _eina_simple_xml_node_dump(Eina_Strbuf *buf, Eina_Simple_XML_Node *node, const c
                   _eina_simple_xml_node_dump_indent(buf, indent, level);
 
                 eina_strbuf_append_length(buf, "</", sizeof("</") - 1);
-                eina_strbuf_append_length
-                    (buf, n->name, eina_stringshare_strlen(n->name));
+                eina_strbuf_append(buf, n->name);
                 eina_strbuf_append_char(buf, '>');
 
                 if (indent) eina_strbuf_append_char(buf, '\n');
@@ -16,10 +16,11 @@
  * if not, see <http://www.gnu.org/licenses/>.
  */
 
-/* TODO
- * it is possible to have more than one tiler algorithm, but for now the
- * version Gustavo did is hardcoded here
+/* Two tiler algorithms are available:
+ * - the splitter Gustavo did, used by default
  * http://blog.gustavobarbieri.com.br/2007/06/03/evas-now-using-rectangle-split-and-merge/
+ * - an exact y-x banded region, as done by X11 and pixman
+ * - a bitmap of the dirty tiles
  */
 
 #ifdef HAVE_CONFIG_H
@@ -28,11 +29,14 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <limits.h>
 
 #include "eina_config.h"
 #include "eina_private.h"
 #include "eina_tiler.h"
 #include "eina_error.h"
+#include "eina_safety_checks.h"
 
 /*============================================================================*
 *                                  Local                                     *
@@ -72,23 +76,60 @@ struct rect_node
    struct rect rect;
 };
 
+/* each tiler keeps its own nodes, so tilers can be used by different
+ * threads */
+typedef struct list_node_pool
+{
+   list_node_t *node;
+   int len;
+   int max;
+} list_node_pool_t;
+
 typedef struct splitter
 {
    Eina_Bool need_merge;
    list_t rects;
+   list_node_pool_t pool;
 } splitter_t;
 
-typedef struct list_node_pool
+/* The region data types */
+typedef struct region_box region_box_t;
+typedef struct region region_t;
+
+struct region_box
 {
-   list_node_t *node;
-   int len;
-   int max;
-} list_node_pool_t;
+   int x1, y1, x2, y2;
+};
+
+struct region
+{
+   region_box_t *boxes;
+   int count;
+   int size;
+   region_box_t extents;
+};
+
+typedef struct region_data
+{
+   region_t rects;
+   region_t tmp;
+   region_t batch;
+   region_t pending;
+} region_data_t;
+
+/* The tiles data types */
+typedef struct tiles_data
+{
+   unsigned long *bits;
+   int cols;
+   int rows;
+   int stride; /* words by row */
+} tiles_data_t;
 
 
 static const list_node_t list_node_zeroed = { NULL };
 static const list_t list_zeroed = { NULL, NULL };
-static list_node_pool_t list_node_pool = { NULL, 0, 1024 };
+static const list_node_pool_t list_node_pool_zeroed = { NULL, 0, 1024 };
 
 
 typedef struct _Eina_Iterator_Tiler
@@ -96,6 +137,8 @@ typedef struct _Eina_Iterator_Tiler
    Eina_Iterator iterator;
    const Eina_Tiler *tiler;
    list_node_t *curr;
+   int idx;
+   int row, row_end;
    Eina_Rectangle r;
    EINA_MAGIC
 } Eina_Iterator_Tiler;
@@ -107,8 +150,11 @@ struct _Eina_Tiler
       int w, h;
    } tile;
    Eina_Rectangle area;
+   Eina_Tiler_Algorithm algorithm;
    EINA_MAGIC
    splitter_t splitter;
+   region_data_t region;
+   tiles_data_t tiles;
 };
 
 #define EINA_MAGIC_CHECK_TILER(d, ...)                                  \
@@ -146,15 +192,15 @@ static inline void rect_init(rect_t *r, int x, int y, int w, int h)
 }
 
 static inline list_node_t *
-rect_list_node_pool_get(void)
+rect_list_node_pool_get(list_node_pool_t *pool)
 {
-   if (list_node_pool.node)
+   if (pool->node)
      {
         list_node_t *node;
 
-        node = list_node_pool.node;
-        list_node_pool.node = node->next;
-        list_node_pool.len--;
+        node = pool->node;
+        pool->node = node->next;
+        pool->len--;
 
         return node;
      }
@@ -196,27 +242,34 @@ static inline void rect_list_append_node(list_t *rects, list_node_t *node)
      }
 }
 
-static inline void rect_list_append(list_t *rects, const rect_t r)
+static inline Eina_Bool rect_list_append(list_node_pool_t *pool,
+                                         list_t *rects,
+                                         const rect_t r)
 {
    rect_node_t *rect_node;
 
-   rect_node = (rect_node_t *)rect_list_node_pool_get();
+   rect_node = (rect_node_t *)rect_list_node_pool_get(pool);
+   if (!rect_node)
+      return EINA_FALSE;
+
    rect_node->rect = r;
    rect_node->_lst = list_node_zeroed;
 
    rect_list_append_node(rects, (list_node_t *)rect_node);
+   return EINA_TRUE;
 }
 
-static inline void rect_list_append_xywh(list_t *rects,
-                                         int x,
-                                         int y,
-                                         int w,
-                                         int h)
+static inline Eina_Bool rect_list_append_xywh(list_node_pool_t *pool,
+                                              list_t *rects,
+                                              int x,
+                                              int y,
+                                              int w,
+                                              int h)
 {
    rect_t r;
 
    rect_init(&r, x, y, w, h);
-   rect_list_append(rects, r);
+   return rect_list_append(pool, rects, r);
 }
 
 static inline void _calc_intra_rect_area(const rect_t a, const rect_t b,
@@ -249,7 +302,11 @@ static inline void _calc_intra_rect_area(const rect_t a, const rect_t b,
    *height = min_bottom - max_top;
 }
 
-static inline void _split_strict(list_t *dirty, const rect_t current, rect_t r)
+/* the pieces already appended to dirty stay there on failure */
+static inline Eina_Bool _split_strict(list_node_pool_t *pool,
+                                 list_t *dirty,
+                                 const rect_t current,
+                                 rect_t r)
 {
    int h_1, h_2, w_1, w_2;
 
@@ -267,7 +324,8 @@ static inline void _split_strict(list_t *dirty, const rect_t current, rect_t r)
          *  | `--'  |        `---'
          *  `-------'
          */
-        rect_list_append_xywh(dirty, r.left, r.top, r.width, h_1);
+        if (!rect_list_append_xywh(pool, dirty, r.left, r.top, r.width, h_1))
+           return EINA_FALSE;
         r.height -= h_1;
         r.top = current.top;
      }
@@ -281,8 +339,9 @@ static inline void _split_strict(list_t *dirty, const rect_t current, rect_t r)
          *    |   |                     |   |
          *    `---'r (b)                `---'
          */
-        rect_list_append_xywh(dirty, r.left, current.bottom, r.width,
-                              h_2);
+        if (!rect_list_append_xywh(pool, dirty, r.left, current.bottom,
+                                   r.width, h_2))
+           return EINA_FALSE;
         r.height -= h_2;
      }
 
@@ -293,7 +352,8 @@ static inline void _split_strict(list_t *dirty, const rect_t current, rect_t r)
        *     `--|-'  |      `--'     `-'
        *        `----'
        */
-        rect_list_append_xywh(dirty, r.left, r.top, w_1, r.height);  /* not necessary to keep these, r (b) will be destroyed */
+      if (!rect_list_append_xywh(pool, dirty, r.left, r.top, w_1, r.height))  /* not necessary to keep these, r (b) will be destroyed */
+         return EINA_FALSE;
 
    /* r.width -= w_1; */
    /* r.left = current.left; */
@@ -306,10 +366,12 @@ static inline void _split_strict(list_t *dirty, const rect_t current, rect_t r)
        *  |  `-|--'       `-'    `--'
        *  `----'
        */
-        rect_list_append_xywh(dirty, current.right, r.top, w_2,
-                            r.height);  /* not necessary to keep this, r (b) will be destroyed */
+      if (!rect_list_append_xywh(pool, dirty, current.right, r.top, w_2,
+                                 r.height))  /* not necessary to keep this, r (b) will be destroyed */
+         return EINA_FALSE;
 
    /* r.width -= w_2; */
+   return EINA_TRUE;
 }
 
 static inline void _calc_intra_outer_rect_area(const rect_t a, const rect_t b,
@@ -388,10 +450,14 @@ enum
 {
    SPLIT_FUZZY_ACTION_NONE,
    SPLIT_FUZZY_ACTION_SPLIT,
-   SPLIT_FUZZY_ACTION_MERGE
+   SPLIT_FUZZY_ACTION_MERGE,
+   SPLIT_FUZZY_ACTION_ERROR
 };
 
-static inline int _split_fuzzy(list_t *dirty, const rect_t a, rect_t *b)
+static inline int _split_fuzzy(list_node_pool_t *pool,
+                               list_t *dirty,
+                               const rect_t a,
+                               rect_t *b)
 {
    int h_1, h_2, w_1, w_2, action;
 
@@ -411,7 +477,9 @@ static inline int _split_fuzzy(list_t *dirty, const rect_t a, rect_t *b)
          *  | `--'  |        `---'
          *  `-------'
          */
-        rect_list_append_xywh(dirty, b->left, b->top, b->width, h_1);
+        if (!rect_list_append_xywh(pool, dirty, b->left, b->top, b->width,
+                                   h_1))
+           return SPLIT_FUZZY_ACTION_ERROR;
         b->height -= h_1;
         b->top = a.top;
         action = SPLIT_FUZZY_ACTION_SPLIT;
@@ -426,7 +494,9 @@ static inline int _split_fuzzy(list_t *dirty, const rect_t a, rect_t *b)
          *    |   |                     |   |
          *    `---'r (b)                `---'
          */
-        rect_list_append_xywh(dirty, b->left, a.bottom, b->width, h_2);
+        if (!rect_list_append_xywh(pool, dirty, b->left, a.bottom, b->width,
+                                   h_2))
+           return SPLIT_FUZZY_ACTION_ERROR;
         b->height -= h_2;
         action = SPLIT_FUZZY_ACTION_SPLIT;
      }
@@ -442,7 +512,9 @@ static inline int _split_fuzzy(list_t *dirty, const rect_t a, rect_t *b)
          *      `--|-'  |      `--'     `-'
          *         `----'
          */
-        rect_list_append_xywh(dirty, b->left, b->top, w_1, b->height);
+        if (!rect_list_append_xywh(pool, dirty, b->left, b->top, w_1,
+                                   b->height))
+           return SPLIT_FUZZY_ACTION_ERROR;
         /* not necessary to keep these, r (b) will be destroyed */
         /* b->width -= w_1; */
         /* b->left = a.left; */
@@ -458,7 +530,9 @@ static inline int _split_fuzzy(list_t *dirty, const rect_t a, rect_t *b)
          * |  `-|--'       `-'    `--'
          * `----'
          */
-        rect_list_append_xywh(dirty, a.right, b->top, w_2, b->height);
+        if (!rect_list_append_xywh(pool, dirty, a.right, b->top, w_2,
+                                   b->height))
+           return SPLIT_FUZZY_ACTION_ERROR;
         /* not necessary to keep these, r (b) will be destroyed */
         /* b->width -= w_2; */
         action = SPLIT_FUZZY_ACTION_SPLIT;
@@ -468,35 +542,35 @@ static inline int _split_fuzzy(list_t *dirty, const rect_t a, rect_t *b)
 }
 
 #if 0
-static void rect_list_node_pool_set_max(int max)
+static void rect_list_node_pool_set_max(list_node_pool_t *pool, int max)
 {
    int diff;
 
-   diff = list_node_pool.len - max;
-   for (; diff > 0 && list_node_pool.node != NULL; diff--)
+   diff = pool->len - max;
+   for (; diff > 0 && pool->node != NULL; diff--)
      {
         list_node_t *node;
 
-        node = list_node_pool.node;
-        list_node_pool.node = node->next;
-        list_node_pool.len--;
+        node = pool->node;
+        pool->node = node->next;
+        pool->len--;
 
         free(node);
      }
 
-   list_node_pool.max = max;
+   pool->max = max;
 }
 #endif
 
-static void rect_list_node_pool_flush(void)
+static void rect_list_node_pool_flush(list_node_pool_t *pool)
 {
-   while (list_node_pool.node)
+   while (pool->node)
      {
         list_node_t *node;
 
-        node = list_node_pool.node;
-        list_node_pool.node = node->next;
-        list_node_pool.len--;
+        node = pool->node;
+        pool->node = node->next;
+        pool->len--;
 
         free(node);
      }
@@ -504,13 +578,14 @@ static void rect_list_node_pool_flush(void)
 
 
 
-static inline void rect_list_node_pool_put(list_node_t *node)
+static inline void rect_list_node_pool_put(list_node_pool_t *pool,
+                                           list_node_t *node)
 {
-   if (list_node_pool.len < list_node_pool.max)
+   if (pool->len < pool->max)
      {
-        node->next = list_node_pool.node;
-        list_node_pool.node = node;
-        list_node_pool.len++;
+        node->next = pool->node;
+        pool->node = node;
+        pool->len++;
      }
    else
         free(node);
@@ -574,15 +649,17 @@ rect_list_unlink_next(list_t *rects, list_node_t *parent_node)
    return node;
 }
 
-static inline void rect_list_del_next(list_t *rects, list_node_t *parent_node)
+static inline void rect_list_del_next(list_node_pool_t *pool,
+                                      list_t *rects,
+                                      list_node_t *parent_node)
 {
    list_node_t *node;
 
    node = rect_list_unlink_next(rects, parent_node);
-        rect_list_node_pool_put(node);
+        rect_list_node_pool_put(pool, node);
 }
 
-static void rect_list_clear(list_t *rects)
+static void rect_list_clear(list_node_pool_t *pool, list_t *rects)
 {
    list_node_t *node;
 
@@ -592,16 +669,20 @@ static void rect_list_clear(list_t *rects)
         list_node_t *aux;
 
         aux = node->next;
-        rect_list_node_pool_put(node);
+        rect_list_node_pool_put(pool, node);
         node = aux;
      }
    *rects = list_zeroed;
 }
 
-static void rect_list_del_split_strict(list_t *rects, const rect_t del_r)
+/* on failure the rectangles that could not be split are kept whole */
+static Eina_Bool rect_list_del_split_strict(list_node_pool_t *pool,
+                                            list_t *rects,
+                                            const rect_t del_r)
 {
    list_t modified = list_zeroed;
    list_node_t *cur_node, *prev_node;
+   Eina_Bool r = EINA_TRUE;
 
    prev_node = NULL;
    cur_node = rects->head;
@@ -637,21 +718,34 @@ static void rect_list_del_split_strict(list_t *rects, const rect_t del_r)
               * current is contained, remove from rects
               */
              cur_node = cur_node->next;
-             rect_list_del_next(rects, prev_node);
+             rect_list_del_next(pool, rects, prev_node);
           }
         else
           {
-             _split_strict(&modified, del_r, current);
+             list_t split = list_zeroed;
+
+             if (!_split_strict(pool, &split, del_r, current))
+               {
+                  rect_list_clear(pool, &split);
+                  r = EINA_FALSE;
+                  prev_node = cur_node;
+                  cur_node = cur_node->next;
+                  continue;
+               }
+             rect_list_concat(&modified, &split);
              cur_node = cur_node->next;
-             rect_list_del_next(rects, prev_node);
+             rect_list_del_next(pool, rects, prev_node);
           }
      }
 
    rect_list_concat(rects, &modified);
+   return r;
 }
 
 #if 0
-static void rect_list_add_split_strict(list_t *rects, list_node_t *node)
+static void rect_list_add_split_strict(list_node_pool_t *pool,
+                                       list_t *rects,
+                                       list_node_t *node)
 {
    list_t dirty = list_zeroed;
    list_t new_dirty = list_zeroed;
@@ -694,7 +788,7 @@ static void rect_list_add_split_strict(list_t *rects, list_node_t *node)
                  *  | `---' |
                  *  `-------'
                  */
-                rect_list_del_next(&dirty, NULL);
+                rect_list_del_next(pool, &dirty, NULL);
              else if ((intra_width <= 0) || (intra_height <= 0))
                {
                   /*  .---.cur     .---.r
@@ -709,8 +803,8 @@ static void rect_list_add_split_strict(list_t *rects, list_node_t *node)
                }
              else
                {
-                  _split_strict(&new_dirty, current, r);
-                  rect_list_del_next(&dirty, NULL);
+                  _split_strict(pool, &new_dirty, current, r);
+                  rect_list_del_next(pool, &dirty, NULL);
                }
           }
         dirty = new_dirty;
@@ -722,7 +816,10 @@ static void rect_list_add_split_strict(list_t *rects, list_node_t *node)
 #endif
 
 static list_node_t *
-rect_list_add_split_fuzzy(list_t *rects, list_node_t *node, int accepted_error)
+rect_list_add_split_fuzzy(list_node_pool_t *pool,
+                          list_t *rects,
+                          list_node_t *node,
+                          int accepted_error)
 {
    list_t dirty = list_zeroed;
    list_node_t *old_last;
@@ -783,7 +880,7 @@ rect_list_add_split_fuzzy(list_t *rects, list_node_t *node, int accepted_error)
                      old_last = prev_cur_node;
 
                   cur_node = cur_node->next;
-                  rect_list_del_next(rects, prev_cur_node);
+                  rect_list_del_next(pool, rects, prev_cur_node);
                }
              else if ((outer.area - area) <= accepted_error)
                {
@@ -823,7 +920,7 @@ rect_list_add_split_fuzzy(list_t *rects, list_node_t *node, int accepted_error)
              else
                {
                   /* split is required */
-                  action = _split_fuzzy(&dirty, current, &r);
+                  action = _split_fuzzy(pool, &dirty, current, &r);
                   if (action == SPLIT_FUZZY_ACTION_MERGE)
                     {
 /* horizontal merge is possible: remove both, add merged */
@@ -844,6 +941,15 @@ rect_list_add_split_fuzzy(list_t *rects, list_node_t *node, int accepted_error)
                        rect_list_append_node(&dirty,
                                              (list_node_t *)n);
                     }
+                  else if (action == SPLIT_FUZZY_ACTION_ERROR)
+                    {
+/*
+ * keep r whole, the pieces already made are
+ * inside it and are dropped against it later
+ */
+                       keep_dirty = 1;
+                       break;
+                    }
                   else if (action == SPLIT_FUZZY_ACTION_NONE)
                     {
 /*
@@ -863,7 +969,7 @@ rect_list_add_split_fuzzy(list_t *rects, list_node_t *node, int accepted_error)
         if (EINA_UNLIKELY(keep_dirty))
            rect_list_append_node(rects, d_node);
         else
-           rect_list_node_pool_put(d_node);
+           rect_list_node_pool_put(pool, d_node);
      }
 
    return old_last;
@@ -906,7 +1012,8 @@ static inline void _calc_outer_rect_area(const rect_t a, const rect_t b,
    outer->area = outer->width * outer->height;
 }
 
-static void rect_list_merge_rects(list_t *rects,
+static void rect_list_merge_rects(list_node_pool_t *pool,
+                                  list_t *rects,
                                   list_t *to_merge,
                                   int accepted_error)
 {
@@ -958,18 +1065,19 @@ static void rect_list_merge_rects(list_t *rects,
                   rect_list_append_node(rects, n);
           }
         else
-                  rect_list_del_next(to_merge, NULL);
+                  rect_list_del_next(pool, to_merge, NULL);
      }
 }
 
-static void rect_list_add_split_fuzzy_and_merge(list_t *rects,
+static void rect_list_add_split_fuzzy_and_merge(list_node_pool_t *pool,
+                                                list_t *rects,
                                                 list_node_t *node,
                                                 int split_accepted_error,
                                                 int merge_accepted_error)
 {
    list_node_t *n;
 
-   n = rect_list_add_split_fuzzy(rects, node, split_accepted_error);
+   n = rect_list_add_split_fuzzy(pool, rects, node, split_accepted_error);
    if (n && n->next)
      {
         list_t to_merge;
@@ -980,7 +1088,7 @@ static void rect_list_add_split_fuzzy_and_merge(list_t *rects,
         rects->tail = n;
         n->next = NULL;
 
-        rect_list_merge_rects(rects, &to_merge, merge_accepted_error);
+        rect_list_merge_rects(pool, rects, &to_merge, merge_accepted_error);
      }
 }
 
@@ -988,12 +1096,13 @@ static inline void _splitter_new(Eina_Tiler *t)
 {
    t->splitter.rects = list_zeroed;
    t->splitter.need_merge = EINA_FALSE;
+   t->splitter.pool = list_node_pool_zeroed;
 }
 
 static inline void _splitter_del(Eina_Tiler *t)
 {
-   rect_list_clear(&t->splitter.rects);
-   rect_list_node_pool_flush();
+   rect_list_clear(&t->splitter.pool, &t->splitter.rects);
+   rect_list_node_pool_flush(&t->splitter.pool);
 }
 
 static inline void _splitter_tile_size_set(Eina_Tiler *t,
@@ -1001,7 +1110,7 @@ static inline void _splitter_tile_size_set(Eina_Tiler *t,
                                            int h __UNUSED__)
 {
    /* TODO are w and h used for something? */
-   t->splitter.rects = list_zeroed;
+   rect_list_clear(&t->splitter.pool, &t->splitter.rects);
 }
 
 static inline Eina_Bool _splitter_rect_add(Eina_Tiler *t, Eina_Rectangle *rect)
@@ -1016,25 +1125,30 @@ static inline Eina_Bool _splitter_rect_add(Eina_Tiler *t, Eina_Rectangle *rect)
    rect->h += 2;
    rect->h >>= 1;
 
-   rn = (rect_node_t *)rect_list_node_pool_get();
+   rn = (rect_node_t *)rect_list_node_pool_get(&t->splitter.pool);
+   if (!rn)
+      return EINA_FALSE;
+
    rn->_lst = list_node_zeroed;
    rect_init(&rn->rect, rect->x, rect->y, rect->w, rect->h);
    //printf("ACCOUNTING[2]: add_redraw: %4d,%4d %3dx%3d\n", x, y, w, h);
    //testing on my core2 duo desktop - fuzz of 32 or 48 is best.
 #define FUZZ 32
-   rect_list_add_split_fuzzy_and_merge(&t->splitter.rects,
+   rect_list_add_split_fuzzy_and_merge(&t->splitter.pool,
+                                       &t->splitter.rects,
                                        (list_node_t *)rn,
                                        FUZZ * FUZZ,
                                        FUZZ * FUZZ);
    return EINA_TRUE;
 }
 
-static inline void _splitter_rect_del(Eina_Tiler *t, Eina_Rectangle *rect)
+static inline Eina_Bool _splitter_rect_del(Eina_Tiler *t, Eina_Rectangle *rect)
 {
    rect_t r;
+   Eina_Bool ret;
 
    if (!t->splitter.rects.head)
-      return;
+      return EINA_TRUE;
 
    rect->x += 1;
    rect->y += 1;
@@ -1046,177 +1160,1673 @@ static inline void _splitter_rect_del(Eina_Tiler *t, Eina_Rectangle *rect)
    rect->h >>= 1;
 
    if ((rect->w <= 0) || (rect->h <= 0))
-      return;
+      return EINA_TRUE;
 
    rect_init(&r, rect->x, rect->y, rect->w, rect->h);
    //fprintf(stderr, "ACCOUNTING: del_redraw: %4d,%4d %3dx%3d\n", x, y, w, h);
 
-   rect_list_del_split_strict(&t->splitter.rects, r);
+   ret = rect_list_del_split_strict(&t->splitter.pool, &t->splitter.rects, r);
    t->splitter.need_merge = EINA_TRUE;
-   return;
+   return ret;
 }
 
 static inline void _splitter_clear(Eina_Tiler *t)
 {
-   rect_list_clear(&t->splitter.rects);
+   rect_list_clear(&t->splitter.pool, &t->splitter.rects);
    t->splitter.need_merge = EINA_FALSE;
 }
 /* end of splitter algorithm */
 
-static Eina_Bool _iterator_next(Eina_Iterator_Tiler *it, void **data)
-{
-   list_node_t *n;
+/* The Region algorithm
+ *
+ * The rectangles are kept as a y-x banded region, like X11 and pixman do:
+ * an array of boxes sorted by y then x, where boxes with the same top share
+ * the same bottom (a band), never overlap and touching boxes of a band are
+ * merged. Two bands with the same boxes that touch vertically are merged
+ * too. Union, subtraction and intersection walk both regions band by band,
+ * so they are linear in the number of boxes.
+ *
+ * Added rectangles are only queued, the queue is turned into a region with
+ * a sweep over y, then merged in a single union, when the result is needed.
+ */
+typedef void (*region_overlap_cb)(region_t *out,
+                                  const region_box_t *r1,
+                                  const region_box_t *r1_end,
+                                  const region_box_t *r2,
+                                  const region_box_t *r2_end,
+                                  int y1,
+                                  int y2);
 
-   for (n = it->curr; n; n = n->next)
-     {
-        rect_t cur;
+static const region_t region_zeroed = { NULL, 0, 0, { 0, 0, 0, 0 } };
 
-        cur = ((rect_node_t *)n)->rect;
+static inline void region_free(region_t *r)
+{
+   free(r->boxes);
+   *r = region_zeroed;
+}
 
-        it->r.x = cur.left << 1;
-        it->r.y = cur.top << 1;
-        it->r.w = cur.width << 1;
-        it->r.h = cur.height << 1;
+static Eina_Bool region_reserve(region_t *r, int count)
+{
+   region_box_t *tmp;
+   int size;
 
-        if (eina_rectangle_intersection(&it->r, &it->tiler->area) == EINA_FALSE)
-           continue;
+   if (count <= r->size)
+      return EINA_TRUE;
 
-        if ((it->r.w <= 0) || (it->r.h <= 0))
-           continue;
+   size = r->size ? r->size : 16;
+   while (size < count)
+      size <<= 1;
 
-        it->curr = n->next;
-        *(Eina_Rectangle **)data = &it->r;
-        return EINA_TRUE;
+   tmp = realloc(r->boxes, size * sizeof (region_box_t));
+   if (!tmp)
+     {
+        eina_error_set(EINA_ERROR_OUT_OF_MEMORY);
+        return EINA_FALSE;
      }
-   return EINA_FALSE;
+
+   r->boxes = tmp;
+   r->size = size;
+   return EINA_TRUE;
 }
 
-static void *_iterator_get_container(Eina_Iterator_Tiler *it)
+/* room must have been reserved */
+static inline void region_append(region_t *r, int x1, int y1, int x2, int y2)
 {
-   EINA_MAGIC_CHECK_TILER_ITERATOR(it, NULL);
-   return (void *)it->tiler;
+   region_box_t *b;
+
+   b = r->boxes + r->count++;
+   b->x1 = x1;
+   b->y1 = y1;
+   b->x2 = x2;
+   b->y2 = y2;
 }
 
-static void _iterator_free(Eina_Iterator_Tiler *it)
+static void region_extents_update(region_t *r)
 {
-   EINA_MAGIC_CHECK_TILER_ITERATOR(it);
-   free(it);
+   region_box_t *b, *end;
+
+   if (!r->count)
+     {
+        r->extents = region_zeroed.extents;
+        return;
+     }
+
+   r->extents.y1 = r->boxes[0].y1;
+   r->extents.y2 = r->boxes[r->count - 1].y2;
+   r->extents.x1 = r->boxes[0].x1;
+   r->extents.x2 = r->boxes[0].x2;
+   for (b = r->boxes + 1, end = r->boxes + r->count; b < end; b++)
+     {
+        if (b->x1 < r->extents.x1)
+           r->extents.x1 = b->x1;
+        if (b->x2 > r->extents.x2)
+           r->extents.x2 = b->x2;
+     }
 }
 
-/*============================================================================*
-*                                 Global                                     *
-*============================================================================*/
+static void region_translate(region_t *r, int dx, int dy)
+{
+   region_box_t *b, *end;
 
-/*============================================================================*
-*                                   API                                      *
-*============================================================================*/
+   for (b = r->boxes, end = b + r->count; b < end; b++)
+     {
+        b->x1 += dx;
+        b->x2 += dx;
+        b->y1 += dy;
+        b->y2 += dy;
+     }
+   region_extents_update(r);
+}
 
-EAPI Eina_Tiler *eina_tiler_new(int w, int h)
+/* first box ending below y */
+static int region_box_y2_find(const region_t *r, int y)
 {
-   Eina_Tiler *t;
+   int lo = 0, hi = r->count;
 
-   t = calloc(1, sizeof(Eina_Tiler));
-   t->area.w = w;
-   t->area.h = h;
-   t->tile.w = w;
-   t->tile.h = h;
-   EINA_MAGIC_SET(t, EINA_MAGIC_TILER);
-   _splitter_new(t);
-   return t;
+   while (lo < hi)
+     {
+        int mid = (lo + hi) / 2;
+
+        if (r->boxes[mid].y2 > y)
+           hi = mid;
+        else
+           lo = mid + 1;
+     }
+   return lo;
 }
 
-EAPI void eina_tiler_free(Eina_Tiler *t)
+/* first box starting at or below y */
+static int region_box_y1_find(const region_t *r, int y)
 {
-   if (!t)
-     return;
+   int lo = 0, hi = r->count;
 
-   EINA_MAGIC_CHECK_TILER(t);
-   _splitter_del(t);
-   free(t);
+   while (lo < hi)
+     {
+        int mid = (lo + hi) / 2;
+
+        if (r->boxes[mid].y1 >= y)
+           hi = mid;
+        else
+           lo = mid + 1;
+     }
+   return lo;
 }
 
-EAPI void eina_tiler_tile_size_set(Eina_Tiler *t, int w, int h)
+static inline const region_box_t *
+region_band_end(const region_box_t *r, const region_box_t *end)
 {
-   EINA_MAGIC_CHECK_TILER(t);
-   if ((w <= 0) || (h <= 0))
-      return;
+   int y1 = r->y1;
 
-   t->tile.w = w;
-   t->tile.h = h;
-   _splitter_tile_size_set(t, w, h);
+   while ((r != end) && (r->y1 == y1))
+      r++;
+   return r;
 }
 
-EAPI Eina_Bool eina_tiler_rect_add(Eina_Tiler *t, const Eina_Rectangle *r)
+/* merge the band starting at cur_start with the one starting at prev_start
+ * if they touch and have the same boxes, return the start of the last band.
+ */
+static int region_coalesce(region_t *r, int prev_start, int cur_start)
 {
-   Eina_Rectangle tmp;
+   region_box_t *prev, *cur;
+   int count, i;
 
-   EINA_MAGIC_CHECK_TILER(t, EINA_FALSE);
-   if ((r->w <= 0) || (r->h <= 0))
-      return EINA_FALSE;
+   count = r->count - cur_start;
+   if ((!count) || (count != cur_start - prev_start))
+      return cur_start;
 
-   tmp = *r;
-   if (eina_rectangle_intersection(&tmp, &t->area) == EINA_FALSE)
-      return EINA_FALSE;
+   prev = r->boxes + prev_start;
+   cur = r->boxes + cur_start;
+   if (prev->y2 != cur->y1)
+      return cur_start;
 
-   if ((tmp.w <= 0) || (tmp.h <= 0))
+   for (i = 0; i < count; i++)
+      if ((prev[i].x1 != cur[i].x1) || (prev[i].x2 != cur[i].x2))
+         return cur_start;
+
+   for (i = 0; i < count; i++)
+      prev[i].y2 = cur->y2;
+   r->count -= count;
+
+   return prev_start;
+}
+
+static Eina_Bool region_band_append(region_t *out,
+                                    const region_box_t *r,
+                                    const region_box_t *r_end,
+                                    int y1,
+                                    int y2)
+{
+   if (!region_reserve(out, out->count + (r_end - r)))
       return EINA_FALSE;
 
-   return _splitter_rect_add(t, &tmp);
+   for (; r != r_end; r++)
+      region_append(out, r->x1, y1, r->x2, y2);
+   return EINA_TRUE;
 }
 
-EAPI void eina_tiler_rect_del(Eina_Tiler *t, const Eina_Rectangle *r)
+static void region_union_o(region_t *out,
+                           const region_box_t *r1,
+                           const region_box_t *r1_end,
+                           const region_box_t *r2,
+                           const region_box_t *r2_end,
+                           int y1,
+                           int y2)
 {
-   Eina_Rectangle tmp;
+   const region_box_t *n;
+   int x1, x2;
 
-   EINA_MAGIC_CHECK_TILER(t);
-   if ((r->w <= 0) || (r->h <= 0))
-      return;
+   if (r1->x1 < r2->x1)
+      n = r1++;
+   else
+      n = r2++;
+   x1 = n->x1;
+   x2 = n->x2;
 
-   tmp = *r;
-   if (eina_rectangle_intersection(&tmp, &t->area) == EINA_FALSE)
-      return;
+   while ((r1 != r1_end) || (r2 != r2_end))
+     {
+        if ((r2 == r2_end) || ((r1 != r1_end) && (r1->x1 < r2->x1)))
+           n = r1++;
+        else
+           n = r2++;
 
-   if ((tmp.w <= 0) || (tmp.h <= 0))
-      return;
+        if (n->x1 <= x2)
+          {
+             if (n->x2 > x2)
+                x2 = n->x2;
+          }
+        else
+          {
+             region_append(out, x1, y1, x2, y2);
+             x1 = n->x1;
+             x2 = n->x2;
+          }
+     }
 
-   _splitter_rect_del(t, &tmp);
+   region_append(out, x1, y1, x2, y2);
 }
 
-EAPI void eina_tiler_clear(Eina_Tiler *t)
+static void region_intersect_o(region_t *out,
+                               const region_box_t *r1,
+                               const region_box_t *r1_end,
+                               const region_box_t *r2,
+                               const region_box_t *r2_end,
+                               int y1,
+                               int y2)
 {
-   EINA_MAGIC_CHECK_TILER(t);
-   _splitter_clear(t);
+   while ((r1 != r1_end) && (r2 != r2_end))
+     {
+        int x1, x2;
+
+        x1 = MAX(r1->x1, r2->x1);
+        x2 = MIN(r1->x2, r2->x2);
+        if (x1 < x2)
+           region_append(out, x1, y1, x2, y2);
+
+        if (r1->x2 == x2)
+           r1++;
+        if (r2->x2 == x2)
+           r2++;
+     }
 }
 
+static void region_subtract_o(region_t *out,
+                              const region_box_t *r1,
+                              const region_box_t *r1_end,
+                              const region_box_t *r2,
+                              const region_box_t *r2_end,
+                              int y1,
+                              int y2)
+{
+   int x1;
 
-EAPI Eina_Iterator *eina_tiler_iterator_new(const Eina_Tiler *t)
+   x1 = r1->x1;
+   while ((r1 != r1_end) && (r2 != r2_end))
+     {
+        if (r2->x2 <= x1)
+           /* subtrahend entirely on the left */
+           r2++;
+        else if (r2->x1 <= x1)
+          {
+             /* subtrahend covers the left part of the minuend */
+             x1 = r2->x2;
+             if (x1 >= r1->x2)
+               {
+                  r1++;
+                  if (r1 != r1_end)
+                     x1 = r1->x1;
+               }
+             else
+                r2++;
+          }
+        else if (r2->x1 < r1->x2)
+          {
+             /* subtrahend starts inside the minuend */
+             region_append(out, x1, y1, r2->x1, y2);
+             x1 = r2->x2;
+             if (x1 >= r1->x2)
+               {
+                  r1++;
+                  if (r1 != r1_end)
+                     x1 = r1->x1;
+               }
+             else
+                r2++;
+          }
+        else
+          {
+             /* subtrahend entirely on the right */
+             if (r1->x2 > x1)
+                region_append(out, x1, y1, r1->x2, y2);
+             r1++;
+             if (r1 != r1_end)
+                x1 = r1->x1;
+          }
+     }
+
+   while (r1 != r1_end)
+     {
+        region_append(out, x1, y1, r1->x2, y2);
+        r1++;
+        if (r1 != r1_end)
+           x1 = r1->x1;
+     }
+}
+
+static Eina_Bool region_op_rest(region_t *out,
+                                int *prev_band,
+                                const region_box_t *r,
+                                const region_box_t *r_end,
+                                int ybot)
 {
-   Eina_Iterator_Tiler *it;
+   const region_box_t *band_end;
+   int cur_band;
 
-   EINA_MAGIC_CHECK_TILER(t, NULL);
+   if (r == r_end)
+      return EINA_TRUE;
 
-   it = calloc(1, sizeof (Eina_Iterator_Tiler));
-   if (!it)
-      return NULL;
+   /* the first band may have been partly consumed */
+   band_end = region_band_end(r, r_end);
+   cur_band = out->count;
+   if (!region_band_append(out, r, band_end, MAX(r->y1, ybot), r->y2))
+      return EINA_FALSE;
+   *prev_band = region_coalesce(out, *prev_band, cur_band);
 
-   it->tiler = t;
+   if (!region_reserve(out, out->count + (r_end - band_end)))
+      return EINA_FALSE;
+   memcpy(out->boxes + out->count, band_end,
+          (r_end - band_end) * sizeof (region_box_t));
+   out->count += r_end - band_end;
+   return EINA_TRUE;
+}
 
-   if (t->splitter.need_merge == EINA_TRUE)
+/* append the result of the operation between a and b to out, below its
+ * last band that starts at prev_band. out must not be a nor b and its
+ * extents are not updated.
+ */
+static Eina_Bool region_op(region_t *out,
+                           int *prev_band,
+                           const region_t *a,
+                           const region_t *b,
+                           region_overlap_cb overlap,
+                           Eina_Bool append_a,
+                           Eina_Bool append_b)
+{
+   const region_box_t *r1, *r1_end, *r2, *r2_end;
+   int ybot;
+
+   r1 = a->boxes;
+   r1_end = r1 + a->count;
+   r2 = b->boxes;
+   r2_end = r2 + b->count;
+
+   if ((r1 == r1_end) || (r2 == r2_end))
      {
-        list_t to_merge;
-        splitter_t *sp;
+        if ((append_a) &&
+            (!region_op_rest(out, prev_band, r1, r1_end, INT_MIN)))
+           return EINA_FALSE;
+        if ((append_b) &&
+            (!region_op_rest(out, prev_band, r2, r2_end, INT_MIN)))
+           return EINA_FALSE;
+        return EINA_TRUE;
+     }
 
-        sp = (splitter_t *)&(t->splitter);
-        to_merge = t->splitter.rects;
-        sp->rects = list_zeroed;
-        rect_list_merge_rects(&sp->rects, &to_merge, FUZZ * FUZZ);
-        sp->need_merge = 0;
+   ybot = MIN(r1->y1, r2->y1);
+   do
+     {
+        const region_box_t *r1_band_end, *r2_band_end;
+        int ytop, cur_band;
+
+        r1_band_end = region_band_end(r1, r1_end);
+        r2_band_end = region_band_end(r2, r2_end);
+
+        if (r1->y1 < r2->y1)
+          {
+             if (append_a)
+               {
+                  int top, bot;
+
+                  top = MAX(r1->y1, ybot);
+                  bot = MIN(r1->y2, r2->y1);
+                  if (top != bot)
+                    {
+                       cur_band = out->count;
+                       if (!region_band_append(out, r1, r1_band_end, top, bot))
+                          return EINA_FALSE;
+                       *prev_band = region_coalesce(out, *prev_band, cur_band);
+                    }
+               }
+             ytop = r2->y1;
+          }
+        else if (r2->y1 < r1->y1)
+          {
+             if (append_b)
+               {
+                  int top, bot;
+
+                  top = MAX(r2->y1, ybot);
+                  bot = MIN(r2->y2, r1->y1);
+                  if (top != bot)
+                    {
+                       cur_band = out->count;
+                       if (!region_band_append(out, r2, r2_band_end, top, bot))
+                          return EINA_FALSE;
+                       *prev_band = region_coalesce(out, *prev_band, cur_band);
+                    }
+               }
+             ytop = r1->y1;
+          }
+        else
+           ytop = r1->y1;
+
+        ybot = MIN(r1->y2, r2->y2);
+        if (ybot > ytop)
+          {
+             /* no overlap function gives more boxes than its inputs */
+             if (!region_reserve(out, out->count + (r1_band_end - r1)
+                                 + (r2_band_end - r2)))
+                return EINA_FALSE;
+
+             cur_band = out->count;
+             overlap(out, r1, r1_band_end, r2, r2_band_end, ytop, ybot);
+             *prev_band = region_coalesce(out, *prev_band, cur_band);
+          }
+
+        if (r1->y2 == ybot)
+           r1 = r1_band_end;
+        if (r2->y2 == ybot)
+           r2 = r2_band_end;
      }
+   while ((r1 != r1_end) && (r2 != r2_end));
 
-   it->curr = it->tiler->splitter.rects.head;
+   if ((append_a) && (!region_op_rest(out, prev_band, r1, r1_end, ybot)))
+      return EINA_FALSE;
+   if ((append_b) && (!region_op_rest(out, prev_band, r2, r2_end, ybot)))
+      return EINA_FALSE;
 
-   it->iterator.version = EINA_ITERATOR_VERSION;
-   it->iterator.next = FUNC_ITERATOR_NEXT(_iterator_next);
+   return EINA_TRUE;
+}
+
+static int region_box_y_cmp(const void *a, const void *b)
+{
+   const region_box_t *ba = a, *bb = b;
+
+   if (ba->y1 != bb->y1)
+      return (ba->y1 < bb->y1) ? -1 : 1;
+   if (ba->x1 != bb->x1)
+      return (ba->x1 < bb->x1) ? -1 : 1;
+   return 0;
+}
+
+/* build out from boxes that may overlap, boxes is sorted in place */
+static Eina_Bool region_sweep(region_t *out, region_box_t *boxes, int count)
+{
+   const region_box_t **active;
+   int nactive, next, prev_band, y;
+
+   out->count = 0;
+   if (!count)
+     {
+        region_extents_update(out);
+        return EINA_TRUE;
+     }
+
+   active = malloc(count * sizeof (region_box_t *));
+   if (!active)
+     {
+        eina_error_set(EINA_ERROR_OUT_OF_MEMORY);
+        return EINA_FALSE;
+     }
+
+   qsort(boxes, count, sizeof (region_box_t), region_box_y_cmp);
+
+   nactive = 0;
+   next = 0;
+   prev_band = 0;
+   y = boxes[0].y1;
+   while ((next < count) || (nactive))
+     {
+        int x1, x2, y2, cur_band, i, j;
+
+        if (!nactive)
+           y = boxes[next].y1;
+
+        /* boxes starting on this band, active stays sorted by x */
+        while ((next < count) && (boxes[next].y1 == y))
+          {
+             const region_box_t *b = boxes + next++;
+
+             for (i = nactive; (i > 0) && (active[i - 1]->x1 > b->x1); i--)
+                active[i] = active[i - 1];
+             active[i] = b;
+             nactive++;
+          }
+
+        y2 = (next < count) ? boxes[next].y1 : active[0]->y2;
+        for (i = 0; i < nactive; i++)
+           if (active[i]->y2 < y2)
+              y2 = active[i]->y2;
+
+        if (!region_reserve(out, out->count + nactive))
+          {
+             free(active);
+             return EINA_FALSE;
+          }
+
+        cur_band = out->count;
+        x1 = active[0]->x1;
+        x2 = active[0]->x2;
+        for (i = 1; i < nactive; i++)
+          {
+             if (active[i]->x1 <= x2)
+               {
+                  if (active[i]->x2 > x2)
+                     x2 = active[i]->x2;
+               }
+             else
+               {
+                  region_append(out, x1, y, x2, y2);
+                  x1 = active[i]->x1;
+                  x2 = active[i]->x2;
+               }
+          }
+        region_append(out, x1, y, x2, y2);
+        prev_band = region_coalesce(out, prev_band, cur_band);
+
+        /* boxes ending with this band */
+        for (i = 0, j = 0; i < nactive; i++)
+           if (active[i]->y2 != y2)
+              active[j++] = active[i];
+        nactive = j;
+        y = y2;
+     }
+
+   free(active);
+   region_extents_update(out);
+   return EINA_TRUE;
+}
+
+static inline Eina_Bool
+region_extents_intersect(const region_box_t *a, const region_box_t *b)
+{
+   return (a->x1 < b->x2) && (b->x1 < a->x2) &&
+          (a->y1 < b->y2) && (b->y1 < a->y2);
+}
+
+static inline Eina_Bool
+region_extents_contain(const region_box_t *a, const region_box_t *b)
+{
+   return (a->x1 <= b->x1) && (a->x2 >= b->x2) &&
+          (a->y1 <= b->y1) && (a->y2 >= b->y2);
+}
+
+static inline void region_box_from_rect(region_box_t *b, const Eina_Rectangle *r)
+{
+   b->x1 = r->x;
+   b->y1 = r->y;
+   b->x2 = r->x + r->w;
+   b->y2 = r->y + r->h;
+}
+
+static inline void _region_data_free(region_data_t *rd)
+{
+   region_free(&rd->rects);
+   region_free(&rd->tmp);
+   region_free(&rd->batch);
+   region_free(&rd->pending);
+}
+
+static inline void _region_new(Eina_Tiler *t)
+{
+   t->region.rects = region_zeroed;
+   t->region.tmp = region_zeroed;
+   t->region.batch = region_zeroed;
+   t->region.pending = region_zeroed;
+}
+
+static inline void _region_del(Eina_Tiler *t)
+{
+   _region_data_free(&t->region);
+}
+
+/* apply an operation between the region and other, that must only change
+ * the bands other spans. These bands are walked, the others are copied.
+ * The result is built in the spare region, that is then swapped with the
+ * current one.
+ */
+static Eina_Bool _region_op(region_data_t *rd,
+                            const region_t *other,
+                            region_overlap_cb overlap,
+                            Eina_Bool append_a,
+                            Eina_Bool append_b)
+{
+   region_t *rects = &rd->rects;
+   region_t *out = &rd->tmp;
+   region_t mid;
+   int start, end, prev_band;
+
+   /* boxes are sorted by y1 and by y2 */
+   start = region_box_y2_find(rects, other->extents.y1);
+   end = region_box_y1_find(rects, other->extents.y2);
+
+   if (!region_reserve(out, start))
+      return EINA_FALSE;
+   if (start)
+      memcpy(out->boxes, rects->boxes, start * sizeof (region_box_t));
+   out->count = start;
+
+   prev_band = start;
+   while ((prev_band > 0) &&
+          (out->boxes[prev_band - 1].y1 == out->boxes[start - 1].y1))
+      prev_band--;
+
+   mid.boxes = rects->boxes + start;
+   mid.count = end - start;
+
+   if ((!region_op(out, &prev_band, &mid, other,
+                   overlap, append_a, append_b)) ||
+       (!region_op_rest(out, &prev_band, rects->boxes + end,
+                        rects->boxes + rects->count, INT_MIN)))
+      return EINA_FALSE;
+   region_extents_update(out);
+
+   mid = *rects;
+   *rects = *out;
+   *out = mid;
+   return EINA_TRUE;
+}
+
+/* keep only the part of the region inside other */
+static Eina_Bool _region_intersect(region_data_t *rd, const region_t *other)
+{
+   region_t tmp;
+   int prev_band = 0;
+
+   rd->tmp.count = 0;
+   if (!region_op(&rd->tmp, &prev_band, &rd->rects, other,
+                  region_intersect_o, EINA_FALSE, EINA_FALSE))
+      return EINA_FALSE;
+   region_extents_update(&rd->tmp);
+
+   tmp = rd->rects;
+   rd->rects = rd->tmp;
+   rd->tmp = tmp;
+   return EINA_TRUE;
+}
+
+/* merge the queued rectangles in the region */
+static Eina_Bool _region_flush(Eina_Tiler *t)
+{
+   region_data_t *rd = &t->region;
+
+   if (!rd->pending.count)
+      return EINA_TRUE;
+
+   // on failure the queue is kept, to be merged next time
+   if (!region_sweep(&rd->batch, rd->pending.boxes, rd->pending.count))
+      return EINA_FALSE;
+
+   if (!rd->rects.count)
+     {
+        region_t tmp;
+
+        tmp = rd->rects;
+        rd->rects = rd->batch;
+        rd->batch = tmp;
+     }
+   else if (!_region_op(rd, &rd->batch, region_union_o, EINA_TRUE, EINA_TRUE))
+      return EINA_FALSE;
+
+   rd->pending.count = 0;
+   return EINA_TRUE;
+}
+
+/* bound the memory used by the queue when nobody looks at the result */
+#define REGION_PENDING_MAX 4096
+
+static inline Eina_Bool _region_rect_add(Eina_Tiler *t, Eina_Rectangle *rect)
+{
+   region_t *pending = &t->region.pending;
+
+   if ((pending->count >= REGION_PENDING_MAX) && (!_region_flush(t)))
+      return EINA_FALSE;
+
+   if (!region_reserve(pending, pending->count + 1))
+      return EINA_FALSE;
+
+   region_append(pending, rect->x, rect->y,
+                 rect->x + rect->w, rect->y + rect->h);
+   return EINA_TRUE;
+}
+
+/* on failure the rectangle stays, it is only redrawn for nothing */
+static inline Eina_Bool _region_rect_del(Eina_Tiler *t, Eina_Rectangle *rect)
+{
+   region_t *rects = &t->region.rects;
+   region_t other;
+   region_box_t box;
+
+   if (!_region_flush(t))
+      return EINA_FALSE;
+   region_box_from_rect(&box, rect);
+
+   if ((!rects->count) || (!region_extents_intersect(&box, &rects->extents)))
+      return EINA_TRUE;
+
+   if (region_extents_contain(&box, &rects->extents))
+     {
+        rects->count = 0;
+        region_extents_update(rects);
+        return EINA_TRUE;
+     }
+
+   other.boxes = &box;
+   other.count = 1;
+   other.size = 1;
+   other.extents = box;
+   return _region_op(&t->region, &other, region_subtract_o,
+                     EINA_TRUE, EINA_FALSE);
+}
+
+static inline void _region_clear(Eina_Tiler *t)
+{
+   t->region.pending.count = 0;
+   t->region.rects.count = 0;
+   region_extents_update(&t->region.rects);
+}
+/* end of region algorithm */
+
+/* The Tiles algorithm
+ *
+ * The area is cut in tiles of the tiler tile size, and a bit tells if a tile
+ * is dirty. Each row of tiles is an array of words, so adding or removing a
+ * rectangle is an OR or an AND with a mask on the words of the rows it
+ * touches. The iterator gives runs of dirty tiles, merged with the runs of
+ * the following rows when they are the same.
+ */
+#define TILES_WORD_BITS ((int)(sizeof (unsigned long) * 8))
+
+static inline int tiles_ctz(unsigned long w)
+{
+#ifdef __GNUC__
+   return __builtin_ctzl(w);
+#else
+   int i = 0;
+
+   while (!(w & 1))
+     {
+        w >>= 1;
+        i++;
+     }
+   return i;
+#endif
+}
+
+static inline unsigned long *tiles_row(const Eina_Tiler *t, int row)
+{
+   return t->tiles.bits + row * t->tiles.stride;
+}
+
+/* find the next run of dirty tiles starting at col or after in a row */
+static Eina_Bool tiles_run_find(const unsigned long *row, int stride,
+                                int cols, int *col, int *col_end)
+{
+   unsigned long w;
+   int i, c;
+
+   c = *col;
+   if (c >= cols)
+      return EINA_FALSE;
+
+   /* start of the run */
+   i = c / TILES_WORD_BITS;
+   w = row[i] & (~0UL << (c % TILES_WORD_BITS));
+   while (!w)
+     {
+        if (++i >= stride)
+           return EINA_FALSE;
+        w = row[i];
+     }
+   c = i * TILES_WORD_BITS + tiles_ctz(w);
+   if (c >= cols)
+      return EINA_FALSE;
+   *col = c;
+
+   /* end of the run */
+   w = ~row[i] & (~0UL << (c % TILES_WORD_BITS));
+   while (!w)
+     {
+        if (++i >= stride)
+          {
+             *col_end = cols;
+             return EINA_TRUE;
+          }
+        w = ~row[i];
+     }
+   c = i * TILES_WORD_BITS + tiles_ctz(w);
+   *col_end = c < cols ? c : cols;
+   return EINA_TRUE;
+}
+
+static void tiles_rows_set(Eina_Tiler *t, int c1, int r1, int c2, int r2,
+                           Eina_Bool dirty)
+{
+   unsigned long m1, m2;
+   int w1, w2, r;
+
+   /* columns [c1, c2[ as masks of the first and last words */
+   w1 = c1 / TILES_WORD_BITS;
+   w2 = (c2 - 1) / TILES_WORD_BITS;
+   m1 = ~0UL << (c1 % TILES_WORD_BITS);
+   m2 = ~0UL >> (TILES_WORD_BITS - 1 - ((c2 - 1) % TILES_WORD_BITS));
+   if (w1 == w2)
+     {
+        m1 &= m2;
+        m2 = m1;
+     }
+
+   for (r = r1; r < r2; r++)
+     {
+        unsigned long *row = tiles_row(t, r);
+        int w;
+
+        if (dirty)
+          {
+             row[w1] |= m1;
+             for (w = w1 + 1; w < w2; w++)
+                row[w] = ~0UL;
+             row[w2] |= m2;
+          }
+        else
+          {
+             row[w1] &= ~m1;
+             for (w = w1 + 1; w < w2; w++)
+                row[w] = 0;
+             row[w2] &= ~m2;
+          }
+     }
+}
+
+static inline void _tiles_new(Eina_Tiler *t)
+{
+   t->tiles.bits = NULL;
+   t->tiles.cols = 0;
+   t->tiles.rows = 0;
+   t->tiles.stride = 0;
+}
+
+static inline void _tiles_del(Eina_Tiler *t)
+{
+   free(t->tiles.bits);
+   _tiles_new(t);
+}
+
+/* allocate a clean bitmap for a new tile size */
+static Eina_Bool _tiles_tile_size_set(Eina_Tiler *t, int w, int h)
+{
+   unsigned long *bits;
+   int cols, rows, stride;
+
+   cols = (t->area.w + w - 1) / w;
+   rows = (t->area.h + h - 1) / h;
+   stride = (cols + TILES_WORD_BITS - 1) / TILES_WORD_BITS;
+
+   /* one more word, so an empty area still gets a bitmap */
+   bits = calloc(stride * rows + 1, sizeof (unsigned long));
+   if (!bits)
+     {
+        eina_error_set(EINA_ERROR_OUT_OF_MEMORY);
+        return EINA_FALSE;
+     }
+
+   free(t->tiles.bits);
+   t->tile.w = w;
+   t->tile.h = h;
+   t->tiles.bits = bits;
+   t->tiles.cols = cols;
+   t->tiles.rows = rows;
+   t->tiles.stride = stride;
+   return EINA_TRUE;
+}
+
+static inline Eina_Bool _tiles_rect_add(Eina_Tiler *t, Eina_Rectangle *rect)
+{
+   /* every tile the rectangle touches */
+   tiles_rows_set(t,
+                  rect->x / t->tile.w,
+                  rect->y / t->tile.h,
+                  (rect->x + rect->w + t->tile.w - 1) / t->tile.w,
+                  (rect->y + rect->h + t->tile.h - 1) / t->tile.h,
+                  EINA_TRUE);
+   return EINA_TRUE;
+}
+
+static inline void _tiles_rect_del(Eina_Tiler *t, Eina_Rectangle *rect)
+{
+   int c1, r1, c2, r2;
+
+   /* only the tiles the rectangle covers, the last ones may be cut by the
+    * tiler area */
+   c1 = (rect->x + t->tile.w - 1) / t->tile.w;
+   r1 = (rect->y + t->tile.h - 1) / t->tile.h;
+   if (rect->x + rect->w == t->area.w)
+      c2 = t->tiles.cols;
+   else
+      c2 = (rect->x + rect->w) / t->tile.w;
+   if (rect->y + rect->h == t->area.h)
+      r2 = t->tiles.rows;
+   else
+      r2 = (rect->y + rect->h) / t->tile.h;
+
+   if ((c1 >= c2) || (r1 >= r2))
+      return;
+
+   tiles_rows_set(t, c1, r1, c2, r2, EINA_FALSE);
+}
+
+static inline void _tiles_clear(Eina_Tiler *t)
+{
+   if (t->tiles.bits)
+      memset(t->tiles.bits, 0,
+             t->tiles.stride * t->tiles.rows * sizeof (unsigned long));
+}
+/* end of tiles algorithm */
+
+/* Operations between tilers
+ *
+ * They are done with regions. The region of a tiler using them is changed
+ * in place, the rectangles of the other tilers are turned into a region
+ * first and given back once done.
+ */
+typedef enum
+{
+   TILER_OP_UNION,
+   TILER_OP_SUBTRACT,
+   TILER_OP_INTERSECT
+} tiler_op_t;
+
+/* the region data holding the area of a tiler, tmp is used for the tilers
+ * that do not keep a region */
+static region_data_t *_tiler_region_data_get(const Eina_Tiler *t,
+                                             region_data_t *tmp)
+{
+   Eina_Iterator *it;
+   Eina_Rectangle *r;
+
+   if (t->algorithm == EINA_TILER_ALGORITHM_REGION)
+     {
+        if (!_region_flush((Eina_Tiler *)t))
+           return NULL;
+        return (region_data_t *)&t->region;
+     }
+
+   it = eina_tiler_iterator_new(t);
+   if (!it)
+      return NULL;
+
+   EINA_ITERATOR_FOREACH(it, r)
+     {
+        if (!region_reserve(&tmp->pending, tmp->pending.count + 1))
+          {
+             eina_iterator_free(it);
+             return NULL;
+          }
+        region_append(&tmp->pending, r->x, r->y, r->x + r->w, r->y + r->h);
+     }
+   eina_iterator_free(it);
+
+   if (!region_sweep(&tmp->rects, tmp->pending.boxes, tmp->pending.count))
+      return NULL;
+   tmp->pending.count = 0;
+
+   return tmp;
+}
+
+/* give the result of an operation back to a tiler, the splitter list is
+ * built aside so the tiler is not changed on failure */
+static Eina_Bool _tiler_region_data_set(Eina_Tiler *t, region_data_t *rd)
+{
+   const region_box_t *b, *end;
+   splitter_t old;
+
+   if (rd == &t->region)
+      return EINA_TRUE;
+
+   old = t->splitter;
+   if (t->algorithm == EINA_TILER_ALGORITHM_TILES)
+      _tiles_clear(t);
+   else
+     {
+        t->splitter.rects = list_zeroed;
+        t->splitter.need_merge = EINA_FALSE;
+     }
+
+   for (b = rd->rects.boxes, end = b + rd->rects.count; b < end; b++)
+     {
+        Eina_Rectangle r;
+
+        EINA_RECTANGLE_SET(&r, b->x1, b->y1, b->x2 - b->x1, b->y2 - b->y1);
+        if (t->algorithm == EINA_TILER_ALGORITHM_TILES)
+           _tiles_rect_add(t, &r);
+        else if (!_splitter_rect_add(t, &r))
+          {
+             rect_list_clear(&t->splitter.pool, &t->splitter.rects);
+             t->splitter.rects = old.rects;
+             t->splitter.need_merge = old.need_merge;
+             return EINA_FALSE;
+          }
+     }
+
+   if (t->algorithm != EINA_TILER_ALGORITHM_TILES)
+      rect_list_clear(&t->splitter.pool, &old.rects);
+   return EINA_TRUE;
+}
+
+/* the part of a region inside a rectangle, it is built in out when the
+ * region has to be cut, NULL on failure */
+static const region_t *_region_clipped(const region_t *r,
+                                       const Eina_Rectangle *clip,
+                                       region_t *out)
+{
+   region_t other;
+   region_box_t box;
+   int prev_band = 0;
+
+   region_box_from_rect(&box, clip);
+   if ((!r->count) || (region_extents_contain(&box, &r->extents)))
+      return r;
+
+   other.boxes = &box;
+   other.count = 1;
+   other.size = 1;
+   other.extents = box;
+
+   out->count = 0;
+   if (!region_op(out, &prev_band, r, &other,
+                  region_intersect_o, EINA_FALSE, EINA_FALSE))
+      return NULL;
+   region_extents_update(out);
+   return out;
+}
+
+/* keep only the part of the region inside a rectangle */
+static Eina_Bool _region_clip(region_data_t *rd, const Eina_Rectangle *clip)
+{
+   const region_t *clipped;
+   region_t tmp;
+
+   clipped = _region_clipped(&rd->rects, clip, &rd->tmp);
+   if (!clipped)
+      return EINA_FALSE;
+
+   if (clipped == &rd->tmp)
+     {
+        tmp = rd->rects;
+        rd->rects = rd->tmp;
+        rd->tmp = tmp;
+     }
+   return EINA_TRUE;
+}
+
+/* both tilers have the same tiles, work on the words of their bitmaps */
+static void _tiles_op(Eina_Tiler *dst, const Eina_Tiler *src, tiler_op_t op)
+{
+   unsigned long *d, *end;
+   const unsigned long *s;
+
+   d = dst->tiles.bits;
+   end = d + dst->tiles.stride * dst->tiles.rows;
+   s = src->tiles.bits;
+
+   switch (op)
+     {
+      case TILER_OP_UNION:
+         for (; d < end; d++, s++)
+            *d |= *s;
+         break;
+
+      case TILER_OP_SUBTRACT:
+         for (; d < end; d++, s++)
+            *d &= ~*s;
+         break;
+
+      case TILER_OP_INTERSECT:
+         for (; d < end; d++, s++)
+            *d &= *s;
+         break;
+     }
+}
+
+static Eina_Bool _tiler_op(Eina_Tiler *dst, const Eina_Tiler *src,
+                           tiler_op_t op)
+{
+   region_data_t src_tmp, dst_tmp;
+   region_data_t *src_rd, *dst_rd;
+   const region_t *src_rects;
+   Eina_Bool r = EINA_FALSE;
+
+   if ((dst->algorithm == EINA_TILER_ALGORITHM_TILES) &&
+       (src->algorithm == EINA_TILER_ALGORITHM_TILES) &&
+       (dst->tile.w == src->tile.w) && (dst->tile.h == src->tile.h) &&
+       (dst->area.w == src->area.w) && (dst->area.h == src->area.h))
+     {
+        _tiles_op(dst, src, op);
+        return EINA_TRUE;
+     }
+
+   src_tmp.rects = src_tmp.tmp = src_tmp.batch = src_tmp.pending = region_zeroed;
+   dst_tmp = src_tmp;
+
+   src_rd = _tiler_region_data_get(src, &src_tmp);
+   if (!src_rd)
+      goto end;
+   dst_rd = _tiler_region_data_get(dst, &dst_tmp);
+   if (!dst_rd)
+      goto end;
+
+   switch (op)
+     {
+      case TILER_OP_UNION:
+         /* dst is already inside its area, only src has to be cut */
+         src_rects = _region_clipped(&src_rd->rects, &dst->area,
+                                     &src_tmp.tmp);
+         r = (src_rects) &&
+            _region_op(dst_rd, src_rects,
+                       region_union_o, EINA_TRUE, EINA_TRUE);
+         break;
+
+      case TILER_OP_SUBTRACT:
+         r = _region_op(dst_rd, &src_rd->rects,
+                        region_subtract_o, EINA_TRUE, EINA_FALSE);
+         break;
+
+      case TILER_OP_INTERSECT:
+         r = _region_intersect(dst_rd, &src_rd->rects);
+         break;
+     }
+
+   if (r)
+      r = _tiler_region_data_set(dst, dst_rd);
+
+end:
+   _region_data_free(&src_tmp);
+   _region_data_free(&dst_tmp);
+   return r;
+}
+/* end of operations between tilers */
+
+/* append the part of the rectangles inside the tiler to boxes */
+static Eina_Bool _tiler_batch_get(const Eina_Tiler *t,
+                                  const Eina_Rectangle *rects,
+                                  unsigned int count,
+                                  region_t *boxes)
+{
+   unsigned int i;
+
+   if (!region_reserve(boxes, boxes->count + count))
+      return EINA_FALSE;
+
+   for (i = 0; i < count; i++)
+     {
+        Eina_Rectangle tmp;
+
+        if ((rects[i].w <= 0) || (rects[i].h <= 0))
+           continue;
+
+        tmp = rects[i];
+        if ((!eina_rectangle_intersection(&tmp, &t->area)) ||
+            (tmp.w <= 0) || (tmp.h <= 0))
+           continue;
+
+        region_append(boxes, tmp.x, tmp.y, tmp.x + tmp.w, tmp.y + tmp.h);
+     }
+
+   return EINA_TRUE;
+}
+
+static Eina_Bool _iterator_next(Eina_Iterator_Tiler *it, void **data)
+{
+   list_node_t *n;
+
+   for (n = it->curr; n; n = n->next)
+     {
+        rect_t cur;
+
+        cur = ((rect_node_t *)n)->rect;
+
+        it->r.x = cur.left << 1;
+        it->r.y = cur.top << 1;
+        it->r.w = cur.width << 1;
+        it->r.h = cur.height << 1;
+
+        if (eina_rectangle_intersection(&it->r, &it->tiler->area) == EINA_FALSE)
+           continue;
+
+        if ((it->r.w <= 0) || (it->r.h <= 0))
+           continue;
+
+        it->curr = n->next;
+        *(Eina_Rectangle **)data = &it->r;
+        return EINA_TRUE;
+     }
+   return EINA_FALSE;
+}
+
+static Eina_Bool _iterator_region_next(Eina_Iterator_Tiler *it, void **data)
+{
+   const region_t *rects = &it->tiler->region.rects;
+   const region_box_t *b;
+
+   if (it->idx >= rects->count)
+      return EINA_FALSE;
+
+   b = rects->boxes + it->idx++;
+   it->r.x = b->x1;
+   it->r.y = b->y1;
+   it->r.w = b->x2 - b->x1;
+   it->r.h = b->y2 - b->y1;
+
+   *(Eina_Rectangle **)data = &it->r;
+   return EINA_TRUE;
+}
+
+static Eina_Bool _iterator_tiles_next(Eina_Iterator_Tiler *it, void **data)
+{
+   const Eina_Tiler *t = it->tiler;
+   int stride = t->tiles.stride;
+
+   while (it->row < t->tiles.rows)
+     {
+        const unsigned long *row = tiles_row(t, it->row);
+        int col_end;
+
+        /* rows that are the same are given together */
+        if (it->row_end <= it->row)
+          {
+             it->row_end = it->row + 1;
+             while ((it->row_end < t->tiles.rows) &&
+                    (!memcmp(row, tiles_row(t, it->row_end),
+                             stride * sizeof (unsigned long))))
+                it->row_end++;
+          }
+
+        if (!tiles_run_find(row, stride, t->tiles.cols, &it->idx, &col_end))
+          {
+             it->row = it->row_end;
+             it->idx = 0;
+             continue;
+          }
+
+        it->r.x = it->idx * t->tile.w;
+        it->r.y = it->row * t->tile.h;
+        it->r.w = (col_end - it->idx) * t->tile.w;
+        it->r.h = (it->row_end - it->row) * t->tile.h;
+        it->idx = col_end;
+
+        /* the last tiles may be cut by the tiler area */
+        if (it->r.x + it->r.w > t->area.w)
+           it->r.w = t->area.w - it->r.x;
+        if (it->r.y + it->r.h > t->area.h)
+           it->r.h = t->area.h - it->r.y;
+
+        *(Eina_Rectangle **)data = &it->r;
+        return EINA_TRUE;
+     }
+
+   return EINA_FALSE;
+}
+
+static void *_iterator_get_container(Eina_Iterator_Tiler *it)
+{
+   EINA_MAGIC_CHECK_TILER_ITERATOR(it, NULL);
+   return (void *)it->tiler;
+}
+
+static void _iterator_free(Eina_Iterator_Tiler *it)
+{
+   EINA_MAGIC_CHECK_TILER_ITERATOR(it);
+   free(it);
+}
+
+/*============================================================================*
+*                                 Global                                     *
+*============================================================================*/
+
+/*============================================================================*
+*                                   API                                      *
+*============================================================================*/
+
+EAPI Eina_Tiler *eina_tiler_new(int w, int h)
+{
+   Eina_Tiler *t;
+
+   t = calloc(1, sizeof(Eina_Tiler));
+   t->area.w = w;
+   t->area.h = h;
+   t->tile.w = w;
+   t->tile.h = h;
+   t->algorithm = EINA_TILER_ALGORITHM_SPLITTER;
+   EINA_MAGIC_SET(t, EINA_MAGIC_TILER);
+   _splitter_new(t);
+   _region_new(t);
+   _tiles_new(t);
+   return t;
+}
+
+EAPI void eina_tiler_free(Eina_Tiler *t)
+{
+   if (!t)
+     return;
+
+   EINA_MAGIC_CHECK_TILER(t);
+   _splitter_del(t);
+   _region_del(t);
+   _tiles_del(t);
+   free(t);
+}
+
+EAPI Eina_Bool eina_tiler_algorithm_set(Eina_Tiler *t,
+                                        Eina_Tiler_Algorithm algorithm)
+{
+   EINA_MAGIC_CHECK_TILER(t, EINA_FALSE);
+   if ((algorithm != EINA_TILER_ALGORITHM_SPLITTER) &&
+       (algorithm != EINA_TILER_ALGORITHM_REGION) &&
+       (algorithm != EINA_TILER_ALGORITHM_TILES))
+      return EINA_FALSE;
+
+   if (t->algorithm == algorithm)
+      return EINA_TRUE;
+
+   if ((algorithm == EINA_TILER_ALGORITHM_TILES) &&
+       (!_tiles_tile_size_set(t, t->tile.w, t->tile.h)))
+      return EINA_FALSE;
+
+   _splitter_clear(t);
+   _region_clear(t);
+   if (t->algorithm == EINA_TILER_ALGORITHM_TILES)
+      _tiles_del(t);
+   t->algorithm = algorithm;
+   return EINA_TRUE;
+}
+
+EAPI Eina_Tiler_Algorithm eina_tiler_algorithm_get(const Eina_Tiler *t)
+{
+   EINA_MAGIC_CHECK_TILER(t, EINA_TILER_ALGORITHM_SPLITTER);
+   return t->algorithm;
+}
+
+EAPI void eina_tiler_tile_size_set(Eina_Tiler *t, int w, int h)
+{
+   EINA_MAGIC_CHECK_TILER(t);
+   if ((w <= 0) || (h <= 0))
+      return;
+
+   if (t->algorithm == EINA_TILER_ALGORITHM_TILES)
+     {
+        _tiles_tile_size_set(t, w, h);
+        return;
+     }
+
+   t->tile.w = w;
+   t->tile.h = h;
+   _splitter_tile_size_set(t, w, h);
+}
+
+EAPI Eina_Bool eina_tiler_rect_add(Eina_Tiler *t, const Eina_Rectangle *r)
+{
+   Eina_Rectangle tmp;
+
+   EINA_MAGIC_CHECK_TILER(t, EINA_FALSE);
+   if ((r->w <= 0) || (r->h <= 0))
+      return EINA_FALSE;
+
+   tmp = *r;
+   if (eina_rectangle_intersection(&tmp, &t->area) == EINA_FALSE)
+      return EINA_FALSE;
+
+   if ((tmp.w <= 0) || (tmp.h <= 0))
+      return EINA_FALSE;
+
+   if (t->algorithm == EINA_TILER_ALGORITHM_REGION)
+      return _region_rect_add(t, &tmp);
+   if (t->algorithm == EINA_TILER_ALGORITHM_TILES)
+      return _tiles_rect_add(t, &tmp);
+
+   return _splitter_rect_add(t, &tmp);
+}
+
+EAPI void eina_tiler_rect_del(Eina_Tiler *t, const Eina_Rectangle *r)
+{
+   Eina_Rectangle tmp;
+
+   EINA_MAGIC_CHECK_TILER(t);
+   if ((r->w <= 0) || (r->h <= 0))
+      return;
+
+   tmp = *r;
+   if (eina_rectangle_intersection(&tmp, &t->area) == EINA_FALSE)
+      return;
+
+   if ((tmp.w <= 0) || (tmp.h <= 0))
+      return;
+
+   if (t->algorithm == EINA_TILER_ALGORITHM_REGION)
+      _region_rect_del(t, &tmp);
+   else if (t->algorithm == EINA_TILER_ALGORITHM_TILES)
+      _tiles_rect_del(t, &tmp);
+   else
+      _splitter_rect_del(t, &tmp);
+}
+
+EAPI void eina_tiler_clear(Eina_Tiler *t)
+{
+   EINA_MAGIC_CHECK_TILER(t);
+   if (t->algorithm == EINA_TILER_ALGORITHM_REGION)
+      _region_clear(t);
+   else if (t->algorithm == EINA_TILER_ALGORITHM_TILES)
+      _tiles_clear(t);
+   else
+      _splitter_clear(t);
+}
+
+EAPI Eina_Bool eina_tiler_union(Eina_Tiler *dst, const Eina_Tiler *src)
+{
+   EINA_MAGIC_CHECK_TILER(dst, EINA_FALSE);
+   EINA_MAGIC_CHECK_TILER(src, EINA_FALSE);
+   return _tiler_op(dst, src, TILER_OP_UNION);
+}
+
+EAPI Eina_Bool eina_tiler_subtract(Eina_Tiler *dst, const Eina_Tiler *src)
+{
+   EINA_MAGIC_CHECK_TILER(dst, EINA_FALSE);
+   EINA_MAGIC_CHECK_TILER(src, EINA_FALSE);
+   return _tiler_op(dst, src, TILER_OP_SUBTRACT);
+}
+
+EAPI Eina_Bool eina_tiler_intersect(Eina_Tiler *dst, const Eina_Tiler *src)
+{
+   EINA_MAGIC_CHECK_TILER(dst, EINA_FALSE);
+   EINA_MAGIC_CHECK_TILER(src, EINA_FALSE);
+   return _tiler_op(dst, src, TILER_OP_INTERSECT);
+}
+
+EAPI Eina_Bool eina_tiler_translate(Eina_Tiler *t, int dx, int dy)
+{
+   region_data_t tmp, *rd;
+   Eina_Bool r = EINA_FALSE;
+
+   EINA_MAGIC_CHECK_TILER(t, EINA_FALSE);
+   if ((!dx) && (!dy))
+      return EINA_TRUE;
+
+   tmp.rects = tmp.tmp = tmp.batch = tmp.pending = region_zeroed;
+   rd = _tiler_region_data_get(t, &tmp);
+   if (!rd)
+      goto end;
+
+   /* the bands keep their order */
+   region_translate(&rd->rects, dx, dy);
+
+   if ((!_region_clip(rd, &t->area)) || (!_tiler_region_data_set(t, rd)))
+     {
+        /* the region of the tiler is moved in place */
+        region_translate(&rd->rects, -dx, -dy);
+        goto end;
+     }
+   r = EINA_TRUE;
+
+end:
+   _region_data_free(&tmp);
+   return r;
+}
+
+EAPI Eina_Bool eina_tiler_clip(Eina_Tiler *t, const Eina_Rectangle *clip)
+{
+   region_data_t tmp, *rd;
+   Eina_Bool r = EINA_FALSE;
+
+   EINA_MAGIC_CHECK_TILER(t, EINA_FALSE);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(clip, EINA_FALSE);
+
+   if ((clip->w <= 0) || (clip->h <= 0))
+     {
+        eina_tiler_clear(t);
+        return EINA_TRUE;
+     }
+
+   tmp.rects = tmp.tmp = tmp.batch = tmp.pending = region_zeroed;
+   rd = _tiler_region_data_get(t, &tmp);
+   if ((rd) && (_region_clip(rd, clip)))
+      r = _tiler_region_data_set(t, rd);
+
+   _region_data_free(&tmp);
+   return r;
+}
+
+EAPI Eina_Bool eina_tiler_rects_add(Eina_Tiler *t,
+                                    const Eina_Rectangle *rects,
+                                    unsigned int count)
+{
+   region_data_t tmp;
+   const region_t *boxes;
+   const region_box_t *b, *end;
+   Eina_Bool r = EINA_FALSE;
+
+   EINA_MAGIC_CHECK_TILER(t, EINA_FALSE);
+   if (!count)
+      return EINA_TRUE;
+   EINA_SAFETY_ON_NULL_RETURN_VAL(rects, EINA_FALSE);
+
+   /* a single sweep and union */
+   if (t->algorithm == EINA_TILER_ALGORITHM_REGION)
+      return _tiler_batch_get(t, rects, count, &t->region.pending) &&
+         _region_flush(t);
+
+   tmp.rects = tmp.tmp = tmp.batch = tmp.pending = region_zeroed;
+   if (!_tiler_batch_get(t, rects, count, &tmp.pending))
+      goto end;
+
+   if (t->algorithm == EINA_TILER_ALGORITHM_TILES)
+      boxes = &tmp.pending;
+   else
+     {
+        /* the splitter gets the rectangles sorted by y, so they merge
+         * with their neighbours early, or the region they make when it
+         * is made of fewer rectangles */
+        if (!region_sweep(&tmp.rects, tmp.pending.boxes, tmp.pending.count))
+           goto end;
+        boxes = (tmp.rects.count < tmp.pending.count) ?
+           &tmp.rects : &tmp.pending;
+     }
+
+   for (b = boxes->boxes, end = b + boxes->count; b < end; b++)
+     {
+        Eina_Rectangle rect;
+
+        EINA_RECTANGLE_SET(&rect, b->x1, b->y1, b->x2 - b->x1, b->y2 - b->y1);
+        if (t->algorithm == EINA_TILER_ALGORITHM_TILES)
+           _tiles_rect_add(t, &rect);
+        else if (!_splitter_rect_add(t, &rect))
+           goto end;
+     }
+   r = EINA_TRUE;
+
+end:
+   _region_data_free(&tmp);
+   return r;
+}
+
+EAPI Eina_Bool eina_tiler_rects_del(Eina_Tiler *t,
+                                    const Eina_Rectangle *rects,
+                                    unsigned int count)
+{
+   region_data_t tmp;
+   const region_box_t *b, *end;
+   Eina_Bool r = EINA_FALSE;
+
+   EINA_MAGIC_CHECK_TILER(t, EINA_FALSE);
+   if (!count)
+      return EINA_TRUE;
+   EINA_SAFETY_ON_NULL_RETURN_VAL(rects, EINA_FALSE);
+
+   tmp.rects = tmp.tmp = tmp.batch = tmp.pending = region_zeroed;
+   if (!_tiler_batch_get(t, rects, count, &tmp.pending))
+      goto end;
+
+   if (t->algorithm == EINA_TILER_ALGORITHM_REGION)
+     {
+        /* a single sweep and subtraction */
+        if ((!region_sweep(&tmp.rects, tmp.pending.boxes, tmp.pending.count))
+            || (!_region_flush(t)))
+           goto end;
+        r = _region_op(&t->region, &tmp.rects,
+                       region_subtract_o, EINA_TRUE, EINA_FALSE);
+        goto end;
+     }
+
+   for (b = tmp.pending.boxes, end = b + tmp.pending.count; b < end; b++)
+     {
+        Eina_Rectangle rect;
+
+        EINA_RECTANGLE_SET(&rect, b->x1, b->y1, b->x2 - b->x1, b->y2 - b->y1);
+        if (t->algorithm == EINA_TILER_ALGORITHM_TILES)
+           _tiles_rect_del(t, &rect);
+        else if (!_splitter_rect_del(t, &rect))
+           goto end;
+     }
+   r = EINA_TRUE;
+
+end:
+   _region_data_free(&tmp);
+   return r;
+}
+
+EAPI Eina_Iterator *eina_tiler_iterator_new(const Eina_Tiler *t)
+{
+   Eina_Iterator_Tiler *it;
+
+   EINA_MAGIC_CHECK_TILER(t, NULL);
+
+   it = calloc(1, sizeof (Eina_Iterator_Tiler));
+   if (!it)
+      return NULL;
+
+   it->tiler = t;
+
+   if (t->algorithm == EINA_TILER_ALGORITHM_REGION)
+     {
+        /* the queued rectangles would be missed */
+        if (!_region_flush((Eina_Tiler *)t))
+          {
+             free(it);
+             return NULL;
+          }
+        it->iterator.next = FUNC_ITERATOR_NEXT(_iterator_region_next);
+        goto end;
+     }
+
+   if (t->algorithm == EINA_TILER_ALGORITHM_TILES)
+     {
+        it->iterator.next = FUNC_ITERATOR_NEXT(_iterator_tiles_next);
+        goto end;
+     }
+
+   if (t->splitter.need_merge == EINA_TRUE)
+     {
+        list_t to_merge;
+        splitter_t *sp;
+
+        sp = (splitter_t *)&(t->splitter);
+        to_merge = t->splitter.rects;
+        sp->rects = list_zeroed;
+        rect_list_merge_rects(&sp->pool, &sp->rects, &to_merge, FUZZ * FUZZ);
+        sp->need_merge = 0;
+     }
+
+   it->curr = it->tiler->splitter.rects.head;
+   it->iterator.next = FUNC_ITERATOR_NEXT(_iterator_next);
+
+end:
+   it->iterator.version = EINA_ITERATOR_VERSION;
    it->iterator.get_container = FUNC_ITERATOR_GET_CONTAINER(
          _iterator_get_container);
    it->iterator.free = FUNC_ITERATOR_FREE(_iterator_free);
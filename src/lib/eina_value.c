@@ -71,6 +71,8 @@ void *alloca (size_t);
 static Eina_Mempool *_eina_value_mp = NULL;
 static Eina_Hash *_eina_value_inner_mps = NULL;
 static Eina_Lock _eina_value_inner_mps_lock;
+static Eina_Hash *_eina_value_struct_indexes = NULL;
+static Eina_RWLock _eina_value_struct_indexes_lock;
 static char *_eina_value_mp_choice = NULL;
 static int _eina_value_log_dom = -1;
 
@@ -110,6 +112,14 @@ static const long eina_value_long_max =  2147483647;
 static const long eina_value_long_min = -2147483647 - 1;
 #endif
 
+/*
+ * Whether a floating point v is not above Max, an integer maximum. Max
+ * rounded to a double or float may be Max + 1 itself (2^32, 2^63, 2^64)
+ * that does not fit, so compare with Max + 1 too. False for NaN.
+ */
+#define EINA_VALUE_FLOATING_FITS(v, Max)                        \
+  (((v) <= (Max)) && ((double)(v) < ((double)((Max) / 2 + 1)) * 2.0))
+
 
 static Eina_Bool
 _eina_value_type_uchar_setup(const Eina_Value_Type *type __UNUSED__, void *mem)
@@ -667,6 +677,8 @@ _eina_value_type_ulong_convert_to(const Eina_Value_Type *type __UNUSED__, const
    else if (convert == EINA_VALUE_TYPE_INT64)
      {
         int64_t other_mem = v;
+        if (EINA_UNLIKELY((uint64_t)v > (uint64_t)eina_value_int64_max))
+          return EINA_FALSE;
         return eina_value_type_pset(convert, convert_mem, &other_mem);
      }
    else if (convert == EINA_VALUE_TYPE_FLOAT)
@@ -1766,93 +1778,102 @@ _eina_value_type_float_convert_to(const Eina_Value_Type *type __UNUSED__, const
 
    if (convert == EINA_VALUE_TYPE_UCHAR)
      {
-        unsigned char other_mem = v;
+        unsigned char other_mem;
         if (EINA_UNLIKELY(v < 0))
           return EINA_FALSE;
-        if (EINA_UNLIKELY(v > eina_value_uchar_max))
-            return EINA_FALSE;
+        if (EINA_UNLIKELY(!EINA_VALUE_FLOATING_FITS(v, eina_value_uchar_max)))
+          return EINA_FALSE;
+        other_mem = v;
         return eina_value_type_pset(convert, convert_mem, &other_mem);
      }
    else if (convert == EINA_VALUE_TYPE_USHORT)
      {
-        unsigned short other_mem = v;
+        unsigned short other_mem;
         if (EINA_UNLIKELY(v < 0))
           return EINA_FALSE;
-        if (EINA_UNLIKELY(v > eina_value_ushort_max))
+        if (EINA_UNLIKELY(!EINA_VALUE_FLOATING_FITS(v, eina_value_ushort_max)))
           return EINA_FALSE;
+        other_mem = v;
         return eina_value_type_pset(convert, convert_mem, &other_mem);
      }
    else if (convert == EINA_VALUE_TYPE_UINT)
      {
-        unsigned int other_mem = v;
+        unsigned int other_mem;
         if (EINA_UNLIKELY(v < 0))
           return EINA_FALSE;
-        if (EINA_UNLIKELY(v > eina_value_uint_max))
+        if (EINA_UNLIKELY(!EINA_VALUE_FLOATING_FITS(v, eina_value_uint_max)))
           return EINA_FALSE;
+        other_mem = v;
         return eina_value_type_pset(convert, convert_mem, &other_mem);
      }
    else if ((convert == EINA_VALUE_TYPE_ULONG) || (convert == EINA_VALUE_TYPE_TIMESTAMP))
      {
-        unsigned long other_mem = v;
+        unsigned long other_mem;
         if (EINA_UNLIKELY(v < 0))
           return EINA_FALSE;
-        if (EINA_UNLIKELY((sizeof(other_mem) != sizeof(v)) &&
-                          (v > eina_value_ulong_max)))
+        if (EINA_UNLIKELY(!EINA_VALUE_FLOATING_FITS(v, eina_value_ulong_max)))
           return EINA_FALSE;
+        other_mem = v;
         return eina_value_type_pset(convert, convert_mem, &other_mem);
      }
    else if (convert == EINA_VALUE_TYPE_UINT64)
      {
-        uint64_t other_mem = v;
+        uint64_t other_mem;
         if (EINA_UNLIKELY(v < 0))
           return EINA_FALSE;
-        if (EINA_UNLIKELY(v > eina_value_uint64_max))
+        if (EINA_UNLIKELY(!EINA_VALUE_FLOATING_FITS(v, eina_value_uint64_max)))
           return EINA_FALSE;
+        other_mem = v;
         return eina_value_type_pset(convert, convert_mem, &other_mem);
      }
    else if (convert == EINA_VALUE_TYPE_CHAR)
      {
-        signed char other_mem = v;
+        signed char other_mem;
         if (EINA_UNLIKELY(v < eina_value_char_min))
           return EINA_FALSE;
-        if (EINA_UNLIKELY(v > eina_value_char_max))
+        if (EINA_UNLIKELY(!EINA_VALUE_FLOATING_FITS(v, eina_value_char_max)))
           return EINA_FALSE;
+        other_mem = v;
         return eina_value_type_pset(convert, convert_mem, &other_mem);
      }
    else if (convert == EINA_VALUE_TYPE_SHORT)
      {
-        short other_mem = v;
+        short other_mem;
         if (EINA_UNLIKELY(v < eina_value_short_min))
           return EINA_FALSE;
-        if (EINA_UNLIKELY(v > eina_value_short_max))
+        if (EINA_UNLIKELY(!EINA_VALUE_FLOATING_FITS(v, eina_value_short_max)))
           return EINA_FALSE;
+        other_mem = v;
         return eina_value_type_pset(convert, convert_mem, &other_mem);
      }
    else if (convert == EINA_VALUE_TYPE_INT)
      {
-        int other_mem = v;
+        int other_mem;
         if (EINA_UNLIKELY(v < eina_value_int_min))
           return EINA_FALSE;
-        if (EINA_UNLIKELY(v > eina_value_int_max))
+        if (EINA_UNLIKELY(!EINA_VALUE_FLOATING_FITS(v, eina_value_int_max)))
           return EINA_FALSE;
+        other_mem = v;
         return eina_value_type_pset(convert, convert_mem, &other_mem);
      }
    else if (convert == EINA_VALUE_TYPE_LONG)
      {
-        long other_mem = v;
+        long other_mem;
         if (EINA_UNLIKELY(v < eina_value_long_min))
           return EINA_FALSE;
-        if (EINA_UNLIKELY(v > eina_value_long_max))
+        if (EINA_UNLIKELY(!EINA_VALUE_FLOATING_FITS(v, eina_value_long_max)))
           return EINA_FALSE;
+        other_mem = v;
         return eina_value_type_pset(convert, convert_mem, &other_mem);
      }
    else if (convert == EINA_VALUE_TYPE_INT64)
      {
-        int64_t other_mem = v;
+        int64_t other_mem;
         if (EINA_UNLIKELY(v < eina_value_int64_min))
           return EINA_FALSE;
-        if (EINA_UNLIKELY(v > eina_value_int64_max))
+        if (EINA_UNLIKELY(!EINA_VALUE_FLOATING_FITS(v, eina_value_int64_max)))
           return EINA_FALSE;
+        other_mem = v;
         return eina_value_type_pset(convert, convert_mem, &other_mem);
      }
    else if (convert == EINA_VALUE_TYPE_FLOAT)
@@ -1952,87 +1973,102 @@ _eina_value_type_double_convert_to(const Eina_Value_Type *type __UNUSED__, const
 
    if (convert == EINA_VALUE_TYPE_UCHAR)
      {
-        unsigned char other_mem = v;
+        unsigned char other_mem;
         if (EINA_UNLIKELY(v < 0))
           return EINA_FALSE;
-        if (EINA_UNLIKELY(v > eina_value_uchar_max))
-            return EINA_FALSE;
+        if (EINA_UNLIKELY(!EINA_VALUE_FLOATING_FITS(v, eina_value_uchar_max)))
+          return EINA_FALSE;
+        other_mem = v;
         return eina_value_type_pset(convert, convert_mem, &other_mem);
      }
    else if (convert == EINA_VALUE_TYPE_USHORT)
      {
-        unsigned short other_mem = v;
+        unsigned short other_mem;
         if (EINA_UNLIKELY(v < 0))
           return EINA_FALSE;
-        if (EINA_UNLIKELY(v > eina_value_ushort_max))
+        if (EINA_UNLIKELY(!EINA_VALUE_FLOATING_FITS(v, eina_value_ushort_max)))
           return EINA_FALSE;
+        other_mem = v;
         return eina_value_type_pset(convert, convert_mem, &other_mem);
      }
    else if (convert == EINA_VALUE_TYPE_UINT)
      {
-        unsigned int other_mem = v;
+        unsigned int other_mem;
         if (EINA_UNLIKELY(v < 0))
           return EINA_FALSE;
-        if (EINA_UNLIKELY(v > eina_value_uint_max))
+        if (EINA_UNLIKELY(!EINA_VALUE_FLOATING_FITS(v, eina_value_uint_max)))
           return EINA_FALSE;
+        other_mem = v;
         return eina_value_type_pset(convert, convert_mem, &other_mem);
      }
    else if ((convert == EINA_VALUE_TYPE_ULONG) || (convert == EINA_VALUE_TYPE_TIMESTAMP))
      {
-        unsigned long other_mem = v;
+        unsigned long other_mem;
         if (EINA_UNLIKELY(v < 0))
           return EINA_FALSE;
-        if (EINA_UNLIKELY((sizeof(other_mem) != sizeof(v)) &&
-                          (v > eina_value_ulong_max)))
+        if (EINA_UNLIKELY(!EINA_VALUE_FLOATING_FITS(v, eina_value_ulong_max)))
           return EINA_FALSE;
+        other_mem = v;
         return eina_value_type_pset(convert, convert_mem, &other_mem);
      }
    else if (convert == EINA_VALUE_TYPE_UINT64)
      {
-        uint64_t other_mem = v;
+        uint64_t other_mem;
         if (EINA_UNLIKELY(v < 0))
           return EINA_FALSE;
+        if (EINA_UNLIKELY(!EINA_VALUE_FLOATING_FITS(v, eina_value_uint64_max)))
+          return EINA_FALSE;
+        other_mem = v;
         return eina_value_type_pset(convert, convert_mem, &other_mem);
      }
    else if (convert == EINA_VALUE_TYPE_CHAR)
      {
-        signed char other_mem = v;
+        signed char other_mem;
         if (EINA_UNLIKELY(v < eina_value_char_min))
           return EINA_FALSE;
-        if (EINA_UNLIKELY(v > eina_value_char_max))
+        if (EINA_UNLIKELY(!EINA_VALUE_FLOATING_FITS(v, eina_value_char_max)))
           return EINA_FALSE;
+        other_mem = v;
         return eina_value_type_pset(convert, convert_mem, &other_mem);
      }
    else if (convert == EINA_VALUE_TYPE_SHORT)
      {
-        short other_mem = v;
+        short other_mem;
         if (EINA_UNLIKELY(v < eina_value_short_min))
           return EINA_FALSE;
-        if (EINA_UNLIKELY(v > eina_value_short_max))
+        if (EINA_UNLIKELY(!EINA_VALUE_FLOATING_FITS(v, eina_value_short_max)))
           return EINA_FALSE;
+        other_mem = v;
         return eina_value_type_pset(convert, convert_mem, &other_mem);
      }
    else if (convert == EINA_VALUE_TYPE_INT)
      {
-        int other_mem = v;
+        int other_mem;
         if (EINA_UNLIKELY(v < eina_value_int_min))
           return EINA_FALSE;
-        if (EINA_UNLIKELY(v > eina_value_int_max))
+        if (EINA_UNLIKELY(!EINA_VALUE_FLOATING_FITS(v, eina_value_int_max)))
           return EINA_FALSE;
+        other_mem = v;
         return eina_value_type_pset(convert, convert_mem, &other_mem);
      }
    else if (convert == EINA_VALUE_TYPE_LONG)
      {
-        long other_mem = v;
+        long other_mem;
         if (EINA_UNLIKELY(v < eina_value_long_min))
           return EINA_FALSE;
-        if (EINA_UNLIKELY(v > eina_value_long_max))
+        if (EINA_UNLIKELY(!EINA_VALUE_FLOATING_FITS(v, eina_value_long_max)))
           return EINA_FALSE;
+        other_mem = v;
         return eina_value_type_pset(convert, convert_mem, &other_mem);
      }
    else if (convert == EINA_VALUE_TYPE_INT64)
      {
-        int64_t other_mem = v;
+        int64_t other_mem;
+        if (EINA_UNLIKELY(v < eina_value_int64_min))
+          return EINA_FALSE;
+        if (EINA_UNLIKELY(!EINA_VALUE_FLOATING_FITS(v, eina_value_int64_max)))
+          return EINA_FALSE;
+        other_mem = v;
         return eina_value_type_pset(convert, convert_mem, &other_mem);
      }
    else if (convert == EINA_VALUE_TYPE_FLOAT)
@@ -3983,39 +4019,208 @@ _eina_value_type_struct_ops_get(const Eina_Value_Struct *st)
    return st->desc->ops;
 }
 
-EAPI const Eina_Value_Struct_Member *
-eina_value_struct_member_find(const Eina_Value_Struct *st, const char *name)
+/* Descriptions with at least this many members and no find_member get
+ * a hash index of their member names, built on first lookup. Below it
+ * the linear scan is as fast.
+ */
+#define EINA_VALUE_STRUCT_INDEX_MIN 16
+
+typedef struct _Eina_Value_Struct_Index Eina_Value_Struct_Index;
+struct _Eina_Value_Struct_Index
 {
-   const Eina_Value_Struct_Operations *ops;
-   const Eina_Value_Struct_Member *itr;
+   const Eina_Value_Struct_Member *members; /* to notice a reused address */
+   unsigned int count;
+   unsigned int mask;
+   unsigned short *slots; /* position + 1, 0 is an empty slot */
+};
 
-   EINA_SAFETY_ON_NULL_RETURN_VAL(st, NULL);
-   EINA_SAFETY_ON_NULL_RETURN_VAL(st->desc, NULL);
+static inline unsigned int
+_eina_value_struct_index_hash(const char *name)
+{
+   unsigned int h = 5381;
+   for (; *name; name++)
+     h = (h * 33) ^ (unsigned char)*name;
+   return h;
+}
 
-   ops = _eina_value_type_struct_ops_get(st);
-   if ((ops) && (ops->find_member))
-     return ops->find_member(ops, st->desc, name);
+static inline int
+_eina_value_struct_index_lookup(const Eina_Value_Struct_Index *idx, const char *name)
+{
+   unsigned int i = _eina_value_struct_index_hash(name) & idx->mask;
 
-   itr = st->desc->members;
-   if (st->desc->member_count)
+   for (; idx->slots[i] != 0; i = (i + 1) & idx->mask)
      {
-        const Eina_Value_Struct_Member *itr_end = itr + st->desc->member_count;
-        for (; itr < itr_end; itr++)
+        int pos = idx->slots[i] - 1;
+        if (strcmp(name, idx->members[pos].name) == 0)
+          return pos;
+     }
+   return -1;
+}
+
+static Eina_Value_Struct_Index *
+_eina_value_struct_index_new(const Eina_Value_Struct_Desc *desc, unsigned int count)
+{
+   Eina_Value_Struct_Index *idx;
+   unsigned int size, pos;
+
+   for (size = 32; size < count * 2; size <<= 1);
+
+   idx = calloc(1, sizeof(Eina_Value_Struct_Index) +
+                size * sizeof(unsigned short));
+   if (!idx) return NULL;
+   idx->members = desc->members;
+   idx->count = count;
+   idx->mask = size - 1;
+   idx->slots = (unsigned short *)(idx + 1);
+
+   for (pos = 0; pos < count; pos++)
+     {
+        unsigned int i;
+
+        i = _eina_value_struct_index_hash(desc->members[pos].name) & idx->mask;
+        while (idx->slots[i] != 0)
+          i = (i + 1) & idx->mask;
+        idx->slots[i] = pos + 1;
+     }
+
+   return idx;
+}
+
+static int
+_eina_value_struct_member_index_find(const Eina_Value_Struct_Desc *desc, const char *name)
+{
+   const Eina_Value_Struct_Member *itr = desc->members;
+   Eina_Value_Struct_Index *idx, *old;
+   unsigned int count = desc->member_count;
+   int pos;
+
+   if (count == 0)
+     {
+        for (; itr->name != NULL; itr++)
           {
              if (strcmp(name, itr->name) == 0)
-               return itr;
+               return itr - desc->members;
           }
-        return NULL;
+        count = itr - desc->members;
+        itr = desc->members;
+        if (count < EINA_VALUE_STRUCT_INDEX_MIN)
+          return -1;
      }
-   else
+   else if (count < EINA_VALUE_STRUCT_INDEX_MIN)
      {
-        for (; itr->name != NULL; itr++)
+        const Eina_Value_Struct_Member *itr_end = itr + count;
+        for (; itr < itr_end; itr++)
           {
              if (strcmp(name, itr->name) == 0)
-               return itr;
+               return itr - desc->members;
           }
-        return NULL;
+        return -1;
+     }
+
+   if ((!_eina_value_struct_indexes) || (count > 65535))
+     goto linear;
+
+   eina_rwlock_take_read(&_eina_value_struct_indexes_lock);
+   idx = eina_hash_find(_eina_value_struct_indexes, &desc);
+   if ((idx) && (idx->members == desc->members) && (idx->count == count))
+     {
+        pos = _eina_value_struct_index_lookup(idx, name);
+        eina_rwlock_release(&_eina_value_struct_indexes_lock);
+        if (pos >= 0)
+          return pos;
+
+        /* the members may have been renamed in place, only trust the
+         * index if the name really is not there */
+        {
+           const Eina_Value_Struct_Member *itr_end = itr + count;
+           for (; itr < itr_end; itr++)
+             {
+                if (strcmp(name, itr->name) == 0)
+                  break;
+             }
+           if (itr == itr_end)
+             return -1;
+           itr = desc->members;
+        }
      }
+   else
+     eina_rwlock_release(&_eina_value_struct_indexes_lock);
+
+   idx = _eina_value_struct_index_new(desc, count);
+   if (!idx)
+     goto linear;
+   pos = _eina_value_struct_index_lookup(idx, name);
+
+   eina_rwlock_take_write(&_eina_value_struct_indexes_lock);
+   old = eina_hash_set(_eina_value_struct_indexes, &desc, idx);
+   eina_rwlock_release(&_eina_value_struct_indexes_lock);
+   free(old);
+
+   return pos;
+
+ linear:
+   {
+      const Eina_Value_Struct_Member *itr_end = itr + count;
+      for (; itr < itr_end; itr++)
+        {
+           if (strcmp(name, itr->name) == 0)
+             return itr - desc->members;
+        }
+      return -1;
+   }
+}
+
+EAPI void
+eina_value_struct_desc_index_del(const Eina_Value_Struct_Desc *desc)
+{
+   Eina_Value_Struct_Index *idx;
+
+   EINA_SAFETY_ON_NULL_RETURN(desc);
+   if (!_eina_value_struct_indexes) return;
+
+   eina_rwlock_take_write(&_eina_value_struct_indexes_lock);
+   idx = eina_hash_find(_eina_value_struct_indexes, &desc);
+   if (idx)
+     eina_hash_del_by_key(_eina_value_struct_indexes, &desc);
+   eina_rwlock_release(&_eina_value_struct_indexes_lock);
+}
+
+EAPI int
+eina_value_struct_member_index_get(const Eina_Value_Struct_Desc *desc, const char *name)
+{
+   const Eina_Value_Struct_Member *member;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(desc, -1);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(name, -1);
+   EINA_SAFETY_ON_FALSE_RETURN_VAL
+     (desc->version == EINA_VALUE_STRUCT_DESC_VERSION, -1);
+
+   if ((!desc->ops) || (!desc->ops->find_member))
+     return _eina_value_struct_member_index_find(desc, name);
+
+   EINA_SAFETY_ON_FALSE_RETURN_VAL
+     (desc->ops->version == EINA_VALUE_STRUCT_OPERATIONS_VERSION, -1);
+   member = desc->ops->find_member(desc->ops, desc, name);
+   if (!member) return -1;
+   return member - desc->members;
+}
+
+EAPI const Eina_Value_Struct_Member *
+eina_value_struct_member_find(const Eina_Value_Struct *st, const char *name)
+{
+   const Eina_Value_Struct_Operations *ops;
+   int pos;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(st, NULL);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(st->desc, NULL);
+
+   ops = _eina_value_type_struct_ops_get(st);
+   if ((ops) && (ops->find_member))
+     return ops->find_member(ops, st->desc, name);
+
+   pos = _eina_value_struct_member_index_find(st->desc, name);
+   if (pos < 0) return NULL;
+   return st->desc->members + pos;
 }
 
 static Eina_Bool
@@ -4786,6 +4991,230 @@ static const Eina_Value_Type _EINA_VALUE_TYPE_BASICS[] = {
   }
 };
 
+/*
+ * Conversions between the numeric basic types, used by
+ * eina_value_convert() instead of going through convert_to(), its chain
+ * of type comparisons and pset(). A conversion fails when the value
+ * does not fit in the destination type, like convert_to() does.
+ *
+ * Each one also has a bulk version, for eina_value_array_data_convert().
+ * It checks all the values before converting any, both loops are simple
+ * enough for the compiler to vectorize them.
+ */
+typedef Eina_Bool (*Eina_Value_Convert_Cb)(const void *type_mem, void *convert_mem);
+typedef Eina_Bool (*Eina_Value_Convert_Array_Cb)(const void *type_mem, void *convert_mem, unsigned int count);
+
+/* checks of v, depending on the kind of the source type */
+#define EINA_VALUE_CONVERT_UNSIGNED_MAX(Max) \
+  ((uint64_t)v <= (uint64_t)(Max))
+#define EINA_VALUE_CONVERT_SIGNED_MAX(Max) \
+  ((v >= 0) && ((uint64_t)v <= (uint64_t)(Max)))
+#define EINA_VALUE_CONVERT_SIGNED_RANGE(Min, Max) \
+  (((int64_t)v >= (int64_t)(Min)) && ((int64_t)v <= (int64_t)(Max)))
+#define EINA_VALUE_CONVERT_FLOATING_RANGE(Min, Max) \
+  ((v >= (Min)) && EINA_VALUE_FLOATING_FITS(v, Max))
+
+#define EINA_VALUE_CONVERT_FUNC(Src, SrcType, Dst, DstType, Check)          \
+  static Eina_Bool                                                          \
+  _eina_value_convert_##Src##_##Dst(const void *type_mem, void *convert_mem) \
+  {                                                                         \
+     const SrcType v = *(const SrcType *)type_mem;                          \
+     if (EINA_UNLIKELY(!(Check)))                                           \
+       return EINA_FALSE;                                                   \
+     *(DstType *)convert_mem = v;                                           \
+     return EINA_TRUE;                                                      \
+  }                                                                         \
+                                                                            \
+  static Eina_Bool                                                          \
+  _eina_value_convert_array_##Src##_##Dst(const void *type_mem,             \
+                                          void *convert_mem,                \
+                                          unsigned int count)               \
+  {                                                                         \
+     const SrcType *src = type_mem;                                         \
+     DstType *dst = convert_mem;                                            \
+     unsigned int i;                                                        \
+     int ok = 1;                                                            \
+                                                                            \
+     for (i = 0; i < count; i++)                                            \
+       {                                                                    \
+          const SrcType v = src[i];                                         \
+          (void)v;                                                          \
+          ok &= !!(Check);                                                  \
+       }                                                                    \
+     if (EINA_UNLIKELY(!ok))                                                \
+       return EINA_FALSE;                                                   \
+     for (i = 0; i < count; i++)                                            \
+       dst[i] = src[i];                                                     \
+     return EINA_TRUE;                                                      \
+  }
+
+#define EINA_VALUE_CONVERT_FROM_UNSIGNED(Src, SrcType)                      \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, uchar, unsigned char,               \
+                          EINA_VALUE_CONVERT_UNSIGNED_MAX(eina_value_uchar_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, ushort, unsigned short,             \
+                          EINA_VALUE_CONVERT_UNSIGNED_MAX(eina_value_ushort_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, uint, unsigned int,                 \
+                          EINA_VALUE_CONVERT_UNSIGNED_MAX(eina_value_uint_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, ulong, unsigned long,               \
+                          EINA_VALUE_CONVERT_UNSIGNED_MAX(eina_value_ulong_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, uint64, uint64_t,                   \
+                          EINA_VALUE_CONVERT_UNSIGNED_MAX(eina_value_uint64_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, char, signed char,                  \
+                          EINA_VALUE_CONVERT_UNSIGNED_MAX(eina_value_char_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, short, short,                       \
+                          EINA_VALUE_CONVERT_UNSIGNED_MAX(eina_value_short_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, int, int,                           \
+                          EINA_VALUE_CONVERT_UNSIGNED_MAX(eina_value_int_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, long, long,                         \
+                          EINA_VALUE_CONVERT_UNSIGNED_MAX(eina_value_long_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, int64, int64_t,                     \
+                          EINA_VALUE_CONVERT_UNSIGNED_MAX(eina_value_int64_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, float, float, 1)                    \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, double, double, 1)
+
+#define EINA_VALUE_CONVERT_FROM_SIGNED(Src, SrcType)                        \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, uchar, unsigned char,               \
+                          EINA_VALUE_CONVERT_SIGNED_MAX(eina_value_uchar_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, ushort, unsigned short,             \
+                          EINA_VALUE_CONVERT_SIGNED_MAX(eina_value_ushort_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, uint, unsigned int,                 \
+                          EINA_VALUE_CONVERT_SIGNED_MAX(eina_value_uint_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, ulong, unsigned long,               \
+                          EINA_VALUE_CONVERT_SIGNED_MAX(eina_value_ulong_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, uint64, uint64_t,                   \
+                          EINA_VALUE_CONVERT_SIGNED_MAX(eina_value_uint64_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, char, signed char,                  \
+                          EINA_VALUE_CONVERT_SIGNED_RANGE(eina_value_char_min, eina_value_char_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, short, short,                       \
+                          EINA_VALUE_CONVERT_SIGNED_RANGE(eina_value_short_min, eina_value_short_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, int, int,                           \
+                          EINA_VALUE_CONVERT_SIGNED_RANGE(eina_value_int_min, eina_value_int_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, long, long,                         \
+                          EINA_VALUE_CONVERT_SIGNED_RANGE(eina_value_long_min, eina_value_long_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, int64, int64_t,                     \
+                          EINA_VALUE_CONVERT_SIGNED_RANGE(eina_value_int64_min, eina_value_int64_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, float, float, 1)                    \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, double, double, 1)
+
+#define EINA_VALUE_CONVERT_FROM_FLOATING(Src, SrcType)                      \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, uchar, unsigned char,               \
+                          EINA_VALUE_CONVERT_FLOATING_RANGE(0, eina_value_uchar_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, ushort, unsigned short,             \
+                          EINA_VALUE_CONVERT_FLOATING_RANGE(0, eina_value_ushort_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, uint, unsigned int,                 \
+                          EINA_VALUE_CONVERT_FLOATING_RANGE(0, eina_value_uint_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, ulong, unsigned long,               \
+                          EINA_VALUE_CONVERT_FLOATING_RANGE(0, eina_value_ulong_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, uint64, uint64_t,                   \
+                          EINA_VALUE_CONVERT_FLOATING_RANGE(0, eina_value_uint64_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, char, signed char,                  \
+                          EINA_VALUE_CONVERT_FLOATING_RANGE(eina_value_char_min, eina_value_char_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, short, short,                       \
+                          EINA_VALUE_CONVERT_FLOATING_RANGE(eina_value_short_min, eina_value_short_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, int, int,                           \
+                          EINA_VALUE_CONVERT_FLOATING_RANGE(eina_value_int_min, eina_value_int_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, long, long,                         \
+                          EINA_VALUE_CONVERT_FLOATING_RANGE(eina_value_long_min, eina_value_long_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, int64, int64_t,                     \
+                          EINA_VALUE_CONVERT_FLOATING_RANGE(eina_value_int64_min, eina_value_int64_max)) \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, float, float, 1)                    \
+  EINA_VALUE_CONVERT_FUNC(Src, SrcType, double, double, 1)
+
+EINA_VALUE_CONVERT_FROM_UNSIGNED(uchar, unsigned char)
+EINA_VALUE_CONVERT_FROM_UNSIGNED(ushort, unsigned short)
+EINA_VALUE_CONVERT_FROM_UNSIGNED(uint, unsigned int)
+EINA_VALUE_CONVERT_FROM_UNSIGNED(ulong, unsigned long)
+EINA_VALUE_CONVERT_FROM_UNSIGNED(uint64, uint64_t)
+EINA_VALUE_CONVERT_FROM_SIGNED(char, signed char)
+EINA_VALUE_CONVERT_FROM_SIGNED(short, short)
+EINA_VALUE_CONVERT_FROM_SIGNED(int, int)
+EINA_VALUE_CONVERT_FROM_SIGNED(long, long)
+EINA_VALUE_CONVERT_FROM_SIGNED(int64, int64_t)
+EINA_VALUE_CONVERT_FROM_FLOATING(float, float)
+EINA_VALUE_CONVERT_FROM_FLOATING(double, double)
+
+/* indexed by Eina_Value_Type_Basic, timestamp is an unsigned long */
+#define EINA_VALUE_CONVERT_ROW(Prefix, Src)     \
+  {                                             \
+    Prefix##Src##_uchar,                        \
+    Prefix##Src##_ushort,                       \
+    Prefix##Src##_uint,                         \
+    Prefix##Src##_ulong,                        \
+    Prefix##Src##_uint64,                       \
+    Prefix##Src##_char,                         \
+    Prefix##Src##_short,                        \
+    Prefix##Src##_int,                          \
+    Prefix##Src##_long,                         \
+    Prefix##Src##_int64,                        \
+    Prefix##Src##_float,                        \
+    Prefix##Src##_double,                       \
+    NULL, /* stringshare */                     \
+    NULL, /* string */                          \
+    Prefix##Src##_ulong                         \
+  }
+
+#define EINA_VALUE_CONVERT_MATRIX(Prefix)               \
+  {                                                     \
+    EINA_VALUE_CONVERT_ROW(Prefix, uchar),              \
+    EINA_VALUE_CONVERT_ROW(Prefix, ushort),             \
+    EINA_VALUE_CONVERT_ROW(Prefix, uint),               \
+    EINA_VALUE_CONVERT_ROW(Prefix, ulong),              \
+    EINA_VALUE_CONVERT_ROW(Prefix, uint64),             \
+    EINA_VALUE_CONVERT_ROW(Prefix, char),               \
+    EINA_VALUE_CONVERT_ROW(Prefix, short),              \
+    EINA_VALUE_CONVERT_ROW(Prefix, int),                \
+    EINA_VALUE_CONVERT_ROW(Prefix, long),               \
+    EINA_VALUE_CONVERT_ROW(Prefix, int64),              \
+    EINA_VALUE_CONVERT_ROW(Prefix, float),              \
+    EINA_VALUE_CONVERT_ROW(Prefix, double),             \
+    { NULL }, /* stringshare */                         \
+    { NULL }, /* string */                              \
+    EINA_VALUE_CONVERT_ROW(Prefix, ulong)               \
+  }
+
+static const Eina_Value_Convert_Cb _eina_value_convert_matrix[EINA_VALUE_TYPE_BASIC_COUNT][EINA_VALUE_TYPE_BASIC_COUNT] =
+  EINA_VALUE_CONVERT_MATRIX(_eina_value_convert_);
+
+static const Eina_Value_Convert_Array_Cb _eina_value_convert_array_matrix[EINA_VALUE_TYPE_BASIC_COUNT][EINA_VALUE_TYPE_BASIC_COUNT] =
+  EINA_VALUE_CONVERT_MATRIX(_eina_value_convert_array_);
+
+#undef EINA_VALUE_CONVERT_MATRIX
+#undef EINA_VALUE_CONVERT_ROW
+#undef EINA_VALUE_CONVERT_FROM_FLOATING
+#undef EINA_VALUE_CONVERT_FROM_SIGNED
+#undef EINA_VALUE_CONVERT_FROM_UNSIGNED
+#undef EINA_VALUE_CONVERT_FUNC
+#undef EINA_VALUE_CONVERT_FLOATING_RANGE
+#undef EINA_VALUE_CONVERT_SIGNED_RANGE
+#undef EINA_VALUE_CONVERT_SIGNED_MAX
+#undef EINA_VALUE_CONVERT_UNSIGNED_MAX
+
+static inline Eina_Value_Convert_Cb
+_eina_value_convert_matrix_get(const Eina_Value_Type *type,
+                               const Eina_Value_Type *convert)
+{
+   size_t i, j;
+
+   i = type - _EINA_VALUE_TYPE_BASICS;
+   j = convert - _EINA_VALUE_TYPE_BASICS;
+   if ((i >= EINA_VALUE_TYPE_BASIC_COUNT) || (j >= EINA_VALUE_TYPE_BASIC_COUNT))
+     return NULL;
+   return _eina_value_convert_matrix[i][j];
+}
+
+static inline Eina_Value_Convert_Array_Cb
+_eina_value_convert_array_matrix_get(const Eina_Value_Type *type,
+                                     const Eina_Value_Type *convert)
+{
+   size_t i, j;
+
+   i = type - _EINA_VALUE_TYPE_BASICS;
+   j = convert - _EINA_VALUE_TYPE_BASICS;
+   if ((i >= EINA_VALUE_TYPE_BASIC_COUNT) || (j >= EINA_VALUE_TYPE_BASIC_COUNT))
+     return NULL;
+   return _eina_value_convert_array_matrix[i][j];
+}
+
 static void
 _eina_value_blob_operations_malloc_free(const Eina_Value_Blob_Operations *ops __UNUSED__, void *memory, size_t size __UNUSED__)
 {
@@ -4981,29 +5410,41 @@ eina_value_init(void)
         goto on_init_fail_hash;
      }
 
+   if (!eina_rwlock_new(&_eina_value_struct_indexes_lock))
+     {
+        ERR("Cannot create lock for struct indexes in value init.");
+        goto on_init_fail_indexes_lock;
+     }
+   _eina_value_struct_indexes = eina_hash_pointer_new(free);
+   if (!_eina_value_struct_indexes)
+     {
+        ERR("Cannot create hash for struct indexes in value init.");
+        goto on_init_fail_indexes;
+     }
+
    EINA_ERROR_VALUE_FAILED = eina_error_msg_static_register(
          EINA_ERROR_VALUE_FAILED_STR);
 
-   EINA_VALUE_TYPE_UCHAR       = _EINA_VALUE_TYPE_BASICS +  0;
-   EINA_VALUE_TYPE_USHORT      = _EINA_VALUE_TYPE_BASICS +  1;
-   EINA_VALUE_TYPE_UINT        = _EINA_VALUE_TYPE_BASICS +  2;
-   EINA_VALUE_TYPE_ULONG       = _EINA_VALUE_TYPE_BASICS +  3;
-   EINA_VALUE_TYPE_UINT64      = _EINA_VALUE_TYPE_BASICS +  4;
-   EINA_VALUE_TYPE_CHAR        = _EINA_VALUE_TYPE_BASICS +  5;
-   EINA_VALUE_TYPE_SHORT       = _EINA_VALUE_TYPE_BASICS +  6;
-   EINA_VALUE_TYPE_INT         = _EINA_VALUE_TYPE_BASICS +  7;
-   EINA_VALUE_TYPE_LONG        = _EINA_VALUE_TYPE_BASICS +  8;
-   EINA_VALUE_TYPE_INT64       = _EINA_VALUE_TYPE_BASICS +  9;
-   EINA_VALUE_TYPE_FLOAT       = _EINA_VALUE_TYPE_BASICS + 10;
-   EINA_VALUE_TYPE_DOUBLE      = _EINA_VALUE_TYPE_BASICS + 11;
-   EINA_VALUE_TYPE_STRINGSHARE = _EINA_VALUE_TYPE_BASICS + 12;
-   EINA_VALUE_TYPE_STRING      = _EINA_VALUE_TYPE_BASICS + 13;
-   EINA_VALUE_TYPE_TIMESTAMP   = _EINA_VALUE_TYPE_BASICS +  14;
+   EINA_VALUE_TYPE_UCHAR       = _EINA_VALUE_TYPE_BASICS + EINA_VALUE_TYPE_BASIC_UCHAR;
+   EINA_VALUE_TYPE_USHORT      = _EINA_VALUE_TYPE_BASICS + EINA_VALUE_TYPE_BASIC_USHORT;
+   EINA_VALUE_TYPE_UINT        = _EINA_VALUE_TYPE_BASICS + EINA_VALUE_TYPE_BASIC_UINT;
+   EINA_VALUE_TYPE_ULONG       = _EINA_VALUE_TYPE_BASICS + EINA_VALUE_TYPE_BASIC_ULONG;
+   EINA_VALUE_TYPE_UINT64      = _EINA_VALUE_TYPE_BASICS + EINA_VALUE_TYPE_BASIC_UINT64;
+   EINA_VALUE_TYPE_CHAR        = _EINA_VALUE_TYPE_BASICS + EINA_VALUE_TYPE_BASIC_CHAR;
+   EINA_VALUE_TYPE_SHORT       = _EINA_VALUE_TYPE_BASICS + EINA_VALUE_TYPE_BASIC_SHORT;
+   EINA_VALUE_TYPE_INT         = _EINA_VALUE_TYPE_BASICS + EINA_VALUE_TYPE_BASIC_INT;
+   EINA_VALUE_TYPE_LONG        = _EINA_VALUE_TYPE_BASICS + EINA_VALUE_TYPE_BASIC_LONG;
+   EINA_VALUE_TYPE_INT64       = _EINA_VALUE_TYPE_BASICS + EINA_VALUE_TYPE_BASIC_INT64;
+   EINA_VALUE_TYPE_FLOAT       = _EINA_VALUE_TYPE_BASICS + EINA_VALUE_TYPE_BASIC_FLOAT;
+   EINA_VALUE_TYPE_DOUBLE      = _EINA_VALUE_TYPE_BASICS + EINA_VALUE_TYPE_BASIC_DOUBLE;
+   EINA_VALUE_TYPE_STRINGSHARE = _EINA_VALUE_TYPE_BASICS + EINA_VALUE_TYPE_BASIC_STRINGSHARE;
+   EINA_VALUE_TYPE_STRING      = _EINA_VALUE_TYPE_BASICS + EINA_VALUE_TYPE_BASIC_STRING;
+   EINA_VALUE_TYPE_TIMESTAMP   = _EINA_VALUE_TYPE_BASICS + EINA_VALUE_TYPE_BASIC_TIMESTAMP;
 
    _EINA_VALUE_TYPE_BASICS_START = _EINA_VALUE_TYPE_BASICS +  0;
-   _EINA_VALUE_TYPE_BASICS_END   = _EINA_VALUE_TYPE_BASICS + 14;
+   _EINA_VALUE_TYPE_BASICS_END   = _EINA_VALUE_TYPE_BASICS + EINA_VALUE_TYPE_BASIC_COUNT - 1;
 
-   EINA_SAFETY_ON_FALSE_RETURN_VAL((sizeof(_EINA_VALUE_TYPE_BASICS)/sizeof(_EINA_VALUE_TYPE_BASICS[0])) == 15, EINA_FALSE);
+   EINA_SAFETY_ON_FALSE_RETURN_VAL((sizeof(_EINA_VALUE_TYPE_BASICS)/sizeof(_EINA_VALUE_TYPE_BASICS[0])) == EINA_VALUE_TYPE_BASIC_COUNT, EINA_FALSE);
 
 
    EINA_VALUE_TYPE_ARRAY = &_EINA_VALUE_TYPE_ARRAY;
@@ -5023,6 +5464,11 @@ eina_value_init(void)
 
    return EINA_TRUE;
 
+ on_init_fail_indexes:
+   eina_rwlock_free(&_eina_value_struct_indexes_lock);
+ on_init_fail_indexes_lock:
+   eina_hash_free(_eina_value_inner_mps);
+   _eina_value_inner_mps = NULL;
  on_init_fail_hash:
    eina_lock_free(&_eina_value_inner_mps_lock);
  on_init_fail_lock:
@@ -5057,6 +5503,10 @@ eina_value_shutdown(void)
    eina_lock_release(&_eina_value_inner_mps_lock);
    eina_lock_free(&_eina_value_inner_mps_lock);
 
+   eina_hash_free(_eina_value_struct_indexes);
+   _eina_value_struct_indexes = NULL;
+   eina_rwlock_free(&_eina_value_struct_indexes_lock);
+
    free(_eina_value_mp_choice);
    _eina_value_mp_choice = NULL;
    eina_mempool_del(_eina_value_mp);
@@ -5173,19 +5623,28 @@ eina_value_convert(const Eina_Value *value, Eina_Value *convert)
 {
    Eina_Bool ret = EINA_FALSE;
    const Eina_Value_Type *type, *convert_type;
+   Eina_Value_Convert_Cb cb;
    const void *type_mem;
    void *convert_mem;
 
    EINA_SAFETY_ON_NULL_RETURN_VAL(value, EINA_FALSE);
    EINA_SAFETY_ON_NULL_RETURN_VAL(convert, EINA_FALSE);
-   EINA_SAFETY_ON_FALSE_RETURN_VAL(eina_value_type_check(value->type),
-                                   EINA_FALSE);
-   EINA_SAFETY_ON_FALSE_RETURN_VAL(eina_value_type_check(convert->type),
-                                   EINA_FALSE);
 
    type = value->type;
    convert_type = convert->type;
 
+   /* numbers, basic types do not need eina_value_type_check() */
+   cb = _eina_value_convert_matrix_get(type, convert_type);
+   if (cb)
+     {
+        eina_error_set(0);
+        return cb(value->value.buf, convert->value.buf);
+     }
+
+   EINA_SAFETY_ON_FALSE_RETURN_VAL(eina_value_type_check(type), EINA_FALSE);
+   EINA_SAFETY_ON_FALSE_RETURN_VAL(eina_value_type_check(convert_type),
+                                   EINA_FALSE);
+
    type_mem = eina_value_memory_get(value);
    convert_mem = eina_value_memory_get(convert);
 
@@ -5235,6 +5694,141 @@ eina_value_array_new(const Eina_Value_Type *subtype, unsigned int step)
    return value;
 }
 
+EAPI void *
+eina_value_array_data_get(const Eina_Value *value, unsigned int *count)
+{
+   const Eina_Value_Array *desc;
+
+   if (count) *count = 0;
+   EINA_SAFETY_ON_NULL_RETURN_VAL(value, NULL);
+   EINA_SAFETY_ON_FALSE_RETURN_VAL(value->type == EINA_VALUE_TYPE_ARRAY, NULL);
+
+   desc = eina_value_memory_get(value);
+   if ((!desc) || (!desc->array) || (desc->array->len == 0))
+     return NULL;
+
+   if (count) *count = desc->array->len;
+   return desc->array->members;
+}
+
+EAPI Eina_Bool
+eina_value_array_data_append(Eina_Value *value, const void *data, unsigned int count)
+{
+   const Eina_Value_Array *desc;
+   const Eina_Value_Type *subtype;
+   const char *src;
+   char *mem;
+   unsigned int position, i;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(value, EINA_FALSE);
+   EINA_SAFETY_ON_FALSE_RETURN_VAL(value->type == EINA_VALUE_TYPE_ARRAY, EINA_FALSE);
+   EINA_SAFETY_ON_TRUE_RETURN_VAL((!data) && (count > 0), EINA_FALSE);
+
+   desc = eina_value_memory_get(value);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(desc, EINA_FALSE);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(desc->array, EINA_FALSE);
+
+   if (count == 0)
+     return EINA_TRUE;
+
+   subtype = desc->subtype;
+   position = eina_inarray_count(desc->array);
+   mem = eina_inarray_alloc_at(desc->array, position, count);
+   if (!mem)
+     return EINA_FALSE;
+
+   /* numbers are plain memory, no need to setup and pset each of them */
+   if (_eina_value_convert_matrix_get(subtype, subtype))
+     {
+        memcpy(mem, data, count * subtype->value_size);
+        return EINA_TRUE;
+     }
+
+   src = data;
+   for (i = 0; i < count; i++)
+     {
+        void *imem = mem + i * subtype->value_size;
+
+        if (!eina_value_type_setup(subtype, imem)) goto error;
+        if (!eina_value_type_pset(subtype, imem, src + i * subtype->value_size))
+          {
+             eina_value_type_flush(subtype, imem);
+             goto error;
+          }
+     }
+
+   return EINA_TRUE;
+
+ error:
+   while (i > 0)
+     {
+        i--;
+        eina_value_type_flush(subtype, mem + i * subtype->value_size);
+     }
+   while (count > 0)
+     {
+        count--;
+        eina_inarray_remove_at(desc->array, position + count);
+     }
+   return EINA_FALSE;
+}
+
+EAPI Eina_Bool
+eina_value_array_data_convert(const Eina_Value *value, unsigned int position, unsigned int count, const Eina_Value_Type *type, void *data)
+{
+   const Eina_Value_Array *desc;
+   const Eina_Value_Type *subtype;
+   Eina_Value_Convert_Array_Cb cb;
+   const char *mem;
+   char *dst;
+   unsigned int i;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(value, EINA_FALSE);
+   EINA_SAFETY_ON_FALSE_RETURN_VAL(value->type == EINA_VALUE_TYPE_ARRAY, EINA_FALSE);
+   EINA_SAFETY_ON_FALSE_RETURN_VAL(_eina_value_convert_matrix_get(type, type) != NULL, EINA_FALSE);
+   EINA_SAFETY_ON_TRUE_RETURN_VAL((!data) && (count > 0), EINA_FALSE);
+
+   desc = eina_value_memory_get(value);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(desc, EINA_FALSE);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(desc->array, EINA_FALSE);
+   EINA_SAFETY_ON_TRUE_RETURN_VAL(position > desc->array->len, EINA_FALSE);
+   EINA_SAFETY_ON_TRUE_RETURN_VAL(count > desc->array->len - position, EINA_FALSE);
+
+   eina_error_set(0);
+   subtype = desc->subtype;
+   mem = (const char *)desc->array->members + position * subtype->value_size;
+
+   cb = _eina_value_convert_array_matrix_get(subtype, type);
+   if (cb)
+     {
+        if (cb(mem, data, count))
+          return EINA_TRUE;
+        eina_error_set(EINA_ERROR_VALUE_FAILED);
+        return EINA_FALSE;
+     }
+
+   /* other subtypes, like strings, one member at a time */
+   dst = data;
+   for (i = 0; i < count; i++)
+     {
+        const void *imem = mem + i * subtype->value_size;
+        void *convert_mem = dst + i * type->value_size;
+        Eina_Bool ret = EINA_FALSE;
+
+        if (subtype->convert_to)
+          ret = subtype->convert_to(subtype, type, imem, convert_mem);
+        if ((!ret) && (type->convert_from))
+          ret = type->convert_from(type, subtype, convert_mem, imem);
+        if (!ret)
+          {
+             eina_error_set(EINA_ERROR_VALUE_FAILED);
+             return EINA_FALSE;
+          }
+     }
+
+   return EINA_TRUE;
+}
+
 EAPI Eina_Value *
 eina_value_list_new(const Eina_Value_Type *subtype)
 {
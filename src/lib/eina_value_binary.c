@@ -0,0 +1,1155 @@
+/* EINA - EFL data type library
+ * Copyright (C) 2012 Enlightenment Project
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#ifdef HAVE_STDINT_H
+# include <stdint.h>
+#endif
+
+#ifdef HAVE_EVIL
+# include <Evil.h>
+#endif
+
+#include "eina_config.h"
+#include "eina_private.h"
+#include "eina_error.h"
+#include "eina_inarray.h"
+#include "eina_hash.h"
+#include "eina_list.h"
+#include "eina_stringshare.h"
+
+/* undefs EINA_ARG_NONULL() so NULL checks are not compiled out! */
+#include "eina_safety_checks.h"
+#include "eina_value_binary.h"
+
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+
+/**
+ * @cond LOCAL
+ */
+
+/*
+ * Encoding, all integers in the byte order of the writer:
+ *
+ *   header     magic "EiVb", byte order (uint16), version (uint8),
+ *              reserved (uint8)
+ *   value      tag (uint8), payload
+ *
+ * Payloads, depending on the tag:
+ *
+ *   char, uchar                1 byte
+ *   short, ushort              2 bytes
+ *   int, uint, float           4 bytes
+ *   long, ulong, timestamp,    8 bytes, long and ulong are 64 bits
+ *   int64, uint64, double      on every platform
+ *   string, stringshare        size + 1 (0 for NULL), bytes, nul
+ *   blob                       size, bytes
+ *   timeval                    seconds, microseconds (int64)
+ *   array                      subtype tag, step, count, payloads
+ *   list                       subtype tag, count, payloads
+ *   hash                       subtype tag, count, key (string payload)
+ *                              and payload of each member
+ *   struct                     description, payload of each member
+ *
+ * Sizes, counts and steps are unsigned LEB128. Array of numbers are
+ * thus their members memory. A struct description is 0 for a struct
+ * without description, memory or members, 1 followed by the count of
+ * members and the name (string payload) and tag of each of them, or
+ * 2 + n to use again the n-th description of the same value.
+ */
+
+#define EINA_VALUE_BINARY_MAGIC "EiVb"
+#define EINA_VALUE_BINARY_BYTE_ORDER 0x0102
+#define EINA_VALUE_BINARY_VERSION 1
+#define EINA_VALUE_BINARY_HEADER_SIZE 8
+#define EINA_VALUE_BINARY_DEPTH_MAX 256
+
+typedef enum _Eina_Value_Binary_Tag
+{
+  EINA_VALUE_BINARY_TAG_NONE = 0,
+  EINA_VALUE_BINARY_TAG_UCHAR,
+  EINA_VALUE_BINARY_TAG_USHORT,
+  EINA_VALUE_BINARY_TAG_UINT,
+  EINA_VALUE_BINARY_TAG_ULONG,
+  EINA_VALUE_BINARY_TAG_UINT64,
+  EINA_VALUE_BINARY_TAG_CHAR,
+  EINA_VALUE_BINARY_TAG_SHORT,
+  EINA_VALUE_BINARY_TAG_INT,
+  EINA_VALUE_BINARY_TAG_LONG,
+  EINA_VALUE_BINARY_TAG_INT64,
+  EINA_VALUE_BINARY_TAG_FLOAT,
+  EINA_VALUE_BINARY_TAG_DOUBLE,
+  EINA_VALUE_BINARY_TAG_STRINGSHARE,
+  EINA_VALUE_BINARY_TAG_STRING,
+  EINA_VALUE_BINARY_TAG_TIMESTAMP,
+  EINA_VALUE_BINARY_TAG_ARRAY,
+  EINA_VALUE_BINARY_TAG_LIST,
+  EINA_VALUE_BINARY_TAG_HASH,
+  EINA_VALUE_BINARY_TAG_TIMEVAL,
+  EINA_VALUE_BINARY_TAG_BLOB,
+  EINA_VALUE_BINARY_TAG_STRUCT
+} Eina_Value_Binary_Tag;
+
+/* indexed by Eina_Value_Type_Basic */
+static const unsigned char _eina_value_binary_basic_tags[EINA_VALUE_TYPE_BASIC_COUNT] = {
+  EINA_VALUE_BINARY_TAG_UCHAR,
+  EINA_VALUE_BINARY_TAG_USHORT,
+  EINA_VALUE_BINARY_TAG_UINT,
+  EINA_VALUE_BINARY_TAG_ULONG,
+  EINA_VALUE_BINARY_TAG_UINT64,
+  EINA_VALUE_BINARY_TAG_CHAR,
+  EINA_VALUE_BINARY_TAG_SHORT,
+  EINA_VALUE_BINARY_TAG_INT,
+  EINA_VALUE_BINARY_TAG_LONG,
+  EINA_VALUE_BINARY_TAG_INT64,
+  EINA_VALUE_BINARY_TAG_FLOAT,
+  EINA_VALUE_BINARY_TAG_DOUBLE,
+  EINA_VALUE_BINARY_TAG_STRINGSHARE,
+  EINA_VALUE_BINARY_TAG_STRING,
+  EINA_VALUE_BINARY_TAG_TIMESTAMP
+};
+
+/* bytes of the payload of numbers, indexed by tag, 0 for other tags */
+static const unsigned char _eina_value_binary_number_sizes[] = {
+  0, 1, 2, 4, 8, 8, 1, 2, 4, 8, 8, 4, 8, 0, 0, 8
+};
+
+typedef struct _Eina_Value_Binary_Encoder Eina_Value_Binary_Encoder;
+typedef struct _Eina_Value_Binary_Decoder Eina_Value_Binary_Decoder;
+typedef struct _Eina_Value_Binary_Desc Eina_Value_Binary_Desc;
+
+struct _Eina_Value_Binary_Encoder
+{
+   Eina_Binbuf *buf;
+   Eina_Hash *descs; /* Eina_Value_Struct_Desc * -> index + 1 */
+   unsigned int descs_count;
+   unsigned int depth;
+};
+
+struct _Eina_Value_Binary_Decoder
+{
+   const unsigned char *p;
+   const unsigned char *end;
+   Eina_Inarray *descs; /* Eina_Value_Binary_Desc * */
+   unsigned int depth;
+   Eina_Bool zero_copy : 1;
+   Eina_Bool referenced : 1; /* a blob points to the decoded memory */
+};
+
+/*
+ * Description of decoded structs, shared by all the structs using it
+ * and released with the last of them.
+ */
+struct _Eina_Value_Binary_Desc
+{
+   Eina_Value_Struct_Desc desc;
+   int refcount;
+};
+
+static unsigned char
+_eina_value_binary_tag_get(const Eina_Value_Type *type)
+{
+   if ((_EINA_VALUE_TYPE_BASICS_START <= type) &&
+       (type <= _EINA_VALUE_TYPE_BASICS_END))
+     return _eina_value_binary_basic_tags[type - _EINA_VALUE_TYPE_BASICS_START];
+   if (type == EINA_VALUE_TYPE_ARRAY) return EINA_VALUE_BINARY_TAG_ARRAY;
+   if (type == EINA_VALUE_TYPE_LIST) return EINA_VALUE_BINARY_TAG_LIST;
+   if (type == EINA_VALUE_TYPE_HASH) return EINA_VALUE_BINARY_TAG_HASH;
+   if (type == EINA_VALUE_TYPE_TIMEVAL) return EINA_VALUE_BINARY_TAG_TIMEVAL;
+   if (type == EINA_VALUE_TYPE_BLOB) return EINA_VALUE_BINARY_TAG_BLOB;
+   if (type == EINA_VALUE_TYPE_STRUCT) return EINA_VALUE_BINARY_TAG_STRUCT;
+   return EINA_VALUE_BINARY_TAG_NONE;
+}
+
+static const Eina_Value_Type *
+_eina_value_binary_type_get(unsigned char tag)
+{
+   switch ((Eina_Value_Binary_Tag)tag)
+     {
+      case EINA_VALUE_BINARY_TAG_UCHAR: return EINA_VALUE_TYPE_UCHAR;
+      case EINA_VALUE_BINARY_TAG_USHORT: return EINA_VALUE_TYPE_USHORT;
+      case EINA_VALUE_BINARY_TAG_UINT: return EINA_VALUE_TYPE_UINT;
+      case EINA_VALUE_BINARY_TAG_ULONG: return EINA_VALUE_TYPE_ULONG;
+      case EINA_VALUE_BINARY_TAG_UINT64: return EINA_VALUE_TYPE_UINT64;
+      case EINA_VALUE_BINARY_TAG_CHAR: return EINA_VALUE_TYPE_CHAR;
+      case EINA_VALUE_BINARY_TAG_SHORT: return EINA_VALUE_TYPE_SHORT;
+      case EINA_VALUE_BINARY_TAG_INT: return EINA_VALUE_TYPE_INT;
+      case EINA_VALUE_BINARY_TAG_LONG: return EINA_VALUE_TYPE_LONG;
+      case EINA_VALUE_BINARY_TAG_INT64: return EINA_VALUE_TYPE_INT64;
+      case EINA_VALUE_BINARY_TAG_FLOAT: return EINA_VALUE_TYPE_FLOAT;
+      case EINA_VALUE_BINARY_TAG_DOUBLE: return EINA_VALUE_TYPE_DOUBLE;
+      case EINA_VALUE_BINARY_TAG_STRINGSHARE: return EINA_VALUE_TYPE_STRINGSHARE;
+      case EINA_VALUE_BINARY_TAG_STRING: return EINA_VALUE_TYPE_STRING;
+      case EINA_VALUE_BINARY_TAG_TIMESTAMP: return EINA_VALUE_TYPE_TIMESTAMP;
+      case EINA_VALUE_BINARY_TAG_ARRAY: return EINA_VALUE_TYPE_ARRAY;
+      case EINA_VALUE_BINARY_TAG_LIST: return EINA_VALUE_TYPE_LIST;
+      case EINA_VALUE_BINARY_TAG_HASH: return EINA_VALUE_TYPE_HASH;
+      case EINA_VALUE_BINARY_TAG_TIMEVAL: return EINA_VALUE_TYPE_TIMEVAL;
+      case EINA_VALUE_BINARY_TAG_BLOB: return EINA_VALUE_TYPE_BLOB;
+      case EINA_VALUE_BINARY_TAG_STRUCT: return EINA_VALUE_TYPE_STRUCT;
+      default: return NULL;
+     }
+}
+
+/* numbers whose payload is their memory, as is */
+static inline Eina_Bool
+_eina_value_binary_tag_is_plain(unsigned char tag, const Eina_Value_Type *type)
+{
+   return ((tag < sizeof(_eina_value_binary_number_sizes)) &&
+           (_eina_value_binary_number_sizes[tag] == type->value_size));
+}
+
+/*
+ * Struct descriptions built by the decoder.
+ */
+
+static void
+_eina_value_binary_desc_unref(Eina_Value_Binary_Desc *bdesc)
+{
+   unsigned int i;
+
+   if (--bdesc->refcount > 0) return;
+
+   eina_value_struct_desc_index_del(&bdesc->desc);
+
+   for (i = 0; i < bdesc->desc.member_count; i++)
+     eina_stringshare_del(bdesc->desc.members[i].name);
+   free(bdesc);
+}
+
+static void *
+_eina_value_binary_struct_alloc(const Eina_Value_Struct_Operations *ops __UNUSED__, const Eina_Value_Struct_Desc *desc)
+{
+   Eina_Value_Binary_Desc *bdesc = (Eina_Value_Binary_Desc *)desc;
+   void *memory;
+
+   memory = malloc(desc->size);
+   if (memory) bdesc->refcount++;
+   return memory;
+}
+
+static void
+_eina_value_binary_struct_free(const Eina_Value_Struct_Operations *ops __UNUSED__, const Eina_Value_Struct_Desc *desc, void *memory)
+{
+   free(memory);
+   _eina_value_binary_desc_unref((Eina_Value_Binary_Desc *)desc);
+}
+
+static const Eina_Value_Struct_Operations _eina_value_binary_struct_ops = {
+  EINA_VALUE_STRUCT_OPERATIONS_VERSION,
+  _eina_value_binary_struct_alloc,
+  _eina_value_binary_struct_free,
+  NULL, /* copy, members one by one after alloc() */
+  NULL, /* compare */
+  NULL  /* find_member */
+};
+
+/*
+ * Encoder.
+ */
+
+static Eina_Bool _eina_value_binary_encode_payload(Eina_Value_Binary_Encoder *enc, const Eina_Value_Type *type, unsigned char tag, const void *mem);
+
+static inline Eina_Bool
+_eina_value_binary_encode_bytes(Eina_Value_Binary_Encoder *enc, const void *bytes, size_t size)
+{
+   if (size == 0) return EINA_TRUE;
+   return eina_binbuf_append_length(enc->buf, bytes, size);
+}
+
+static Eina_Bool
+_eina_value_binary_encode_size(Eina_Value_Binary_Encoder *enc, uint64_t size)
+{
+   unsigned char bytes[10];
+   unsigned int i = 0;
+
+   do
+     {
+        bytes[i] = size & 0x7f;
+        size >>= 7;
+        if (size) bytes[i] |= 0x80;
+        i++;
+     }
+   while (size);
+
+   return eina_binbuf_append_length(enc->buf, bytes, i);
+}
+
+static Eina_Bool
+_eina_value_binary_encode_string(Eina_Value_Binary_Encoder *enc, const char *str)
+{
+   size_t size;
+
+   if (!str) return _eina_value_binary_encode_size(enc, 0);
+
+   size = strlen(str) + 1;
+   return (_eina_value_binary_encode_size(enc, size) &&
+           _eina_value_binary_encode_bytes(enc, str, size));
+}
+
+static Eina_Bool
+_eina_value_binary_encode_number(Eina_Value_Binary_Encoder *enc, unsigned char tag, const void *mem)
+{
+   if (tag == EINA_VALUE_BINARY_TAG_LONG)
+     {
+        int64_t v = *(const long *)mem;
+        return _eina_value_binary_encode_bytes(enc, &v, sizeof(v));
+     }
+   else if ((tag == EINA_VALUE_BINARY_TAG_ULONG) ||
+            (tag == EINA_VALUE_BINARY_TAG_TIMESTAMP))
+     {
+        uint64_t v = *(const unsigned long *)mem;
+        return _eina_value_binary_encode_bytes(enc, &v, sizeof(v));
+     }
+
+   return _eina_value_binary_encode_bytes
+     (enc, mem, _eina_value_binary_number_sizes[tag]);
+}
+
+static Eina_Bool
+_eina_value_binary_encode_array(Eina_Value_Binary_Encoder *enc, const Eina_Value_Array *desc)
+{
+   const Eina_Value_Type *subtype = desc->subtype;
+   const unsigned char *itr, *itr_end;
+   unsigned char tag;
+   unsigned int count;
+
+   tag = subtype ? _eina_value_binary_tag_get(subtype) : 0;
+   if (!tag) return EINA_FALSE;
+
+   count = desc->array ? desc->array->len : 0;
+   if (!eina_binbuf_append_char(enc->buf, tag) ||
+       !_eina_value_binary_encode_size(enc, desc->step) ||
+       !_eina_value_binary_encode_size(enc, count))
+     return EINA_FALSE;
+   if (count == 0) return EINA_TRUE;
+
+   itr = desc->array->members;
+   if (_eina_value_binary_tag_is_plain(tag, subtype))
+     return _eina_value_binary_encode_bytes(enc, itr, count * subtype->value_size);
+
+   itr_end = itr + count * subtype->value_size;
+   for (; itr < itr_end; itr += subtype->value_size)
+     if (!_eina_value_binary_encode_payload(enc, subtype, tag, itr))
+       return EINA_FALSE;
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_eina_value_binary_encode_list(Eina_Value_Binary_Encoder *enc, const Eina_Value_List *desc)
+{
+   const Eina_Value_Type *subtype = desc->subtype;
+   const Eina_List *l;
+   unsigned char tag;
+
+   tag = subtype ? _eina_value_binary_tag_get(subtype) : 0;
+   if (!tag) return EINA_FALSE;
+
+   if (!eina_binbuf_append_char(enc->buf, tag) ||
+       !_eina_value_binary_encode_size(enc, eina_list_count(desc->list)))
+     return EINA_FALSE;
+
+   for (l = desc->list; l; l = l->next)
+     {
+        const void *mem = eina_value_list_node_memory_get(subtype, l);
+        if (!_eina_value_binary_encode_payload(enc, subtype, tag, mem))
+          return EINA_FALSE;
+     }
+   return EINA_TRUE;
+}
+
+typedef struct _Eina_Value_Binary_Hash_Ctx
+{
+   Eina_Value_Binary_Encoder *enc;
+   const Eina_Value_Type *subtype;
+   unsigned char tag;
+   Eina_Bool ret;
+} Eina_Value_Binary_Hash_Ctx;
+
+static Eina_Bool
+_eina_value_binary_encode_hash_member(const Eina_Hash *hash __UNUSED__, const void *key, void *data, void *fdata)
+{
+   Eina_Value_Binary_Hash_Ctx *ctx = fdata;
+
+   ctx->ret = (_eina_value_binary_encode_string(ctx->enc, key) &&
+               _eina_value_binary_encode_payload(ctx->enc, ctx->subtype,
+                                                 ctx->tag, data));
+   return ctx->ret;
+}
+
+static Eina_Bool
+_eina_value_binary_encode_hash(Eina_Value_Binary_Encoder *enc, const Eina_Value_Hash *desc)
+{
+   Eina_Value_Binary_Hash_Ctx ctx;
+
+   ctx.enc = enc;
+   ctx.subtype = desc->subtype;
+   ctx.tag = ctx.subtype ? _eina_value_binary_tag_get(ctx.subtype) : 0;
+   ctx.ret = EINA_TRUE;
+   if (!ctx.tag) return EINA_FALSE;
+
+   if (!eina_binbuf_append_char(enc->buf, ctx.tag) ||
+       !_eina_value_binary_encode_size
+       (enc, desc->hash ? eina_hash_population(desc->hash) : 0))
+     return EINA_FALSE;
+
+   if (desc->hash)
+     eina_hash_foreach(desc->hash, _eina_value_binary_encode_hash_member, &ctx);
+   return ctx.ret;
+}
+
+static unsigned int
+_eina_value_binary_struct_member_count(const Eina_Value_Struct_Desc *desc)
+{
+   const Eina_Value_Struct_Member *itr;
+
+   if (desc->member_count > 0) return desc->member_count;
+   for (itr = desc->members; itr->name; itr++);
+   return itr - desc->members;
+}
+
+static Eina_Bool
+_eina_value_binary_encode_struct(Eina_Value_Binary_Encoder *enc, const Eina_Value_Struct *st)
+{
+   const Eina_Value_Struct_Member *itr, *itr_end;
+   const unsigned char *base = st->memory;
+   unsigned int count, index;
+
+   if ((!st->desc) || (!st->memory))
+     return _eina_value_binary_encode_size(enc, 0);
+
+   count = _eina_value_binary_struct_member_count(st->desc);
+   /* eina_value_struct_setup() refuses descriptions without members */
+   if (count == 0)
+     return _eina_value_binary_encode_size(enc, 0);
+   itr_end = st->desc->members + count;
+
+   if (!enc->descs)
+     {
+        enc->descs = eina_hash_pointer_new(NULL);
+        if (!enc->descs) return EINA_FALSE;
+     }
+
+   index = (unsigned int)(uintptr_t)eina_hash_find(enc->descs, &st->desc);
+   if (index)
+     {
+        if (!_eina_value_binary_encode_size(enc, (uint64_t)index + 1))
+          return EINA_FALSE;
+     }
+   else
+     {
+        if (!eina_hash_add(enc->descs, &st->desc,
+                           (void *)(uintptr_t)(++enc->descs_count)))
+          return EINA_FALSE;
+
+        if (!_eina_value_binary_encode_size(enc, 1) ||
+            !_eina_value_binary_encode_size(enc, count))
+          return EINA_FALSE;
+
+        for (itr = st->desc->members; itr < itr_end; itr++)
+          {
+             unsigned char tag = _eina_value_binary_tag_get(itr->type);
+
+             if ((!tag) ||
+                 (!_eina_value_binary_encode_string(enc, itr->name)) ||
+                 (!eina_binbuf_append_char(enc->buf, tag)))
+               return EINA_FALSE;
+          }
+     }
+
+   for (itr = st->desc->members; itr < itr_end; itr++)
+     {
+        unsigned char tag = _eina_value_binary_tag_get(itr->type);
+
+        if (!_eina_value_binary_encode_payload(enc, itr->type, tag,
+                                               base + itr->offset))
+          return EINA_FALSE;
+     }
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_eina_value_binary_encode_payload(Eina_Value_Binary_Encoder *enc, const Eina_Value_Type *type __UNUSED__, unsigned char tag, const void *mem)
+{
+   Eina_Bool ret;
+
+   if (tag < sizeof(_eina_value_binary_number_sizes) &&
+       _eina_value_binary_number_sizes[tag])
+     return _eina_value_binary_encode_number(enc, tag, mem);
+
+   if (enc->depth >= EINA_VALUE_BINARY_DEPTH_MAX) return EINA_FALSE;
+   enc->depth++;
+
+   switch ((Eina_Value_Binary_Tag)tag)
+     {
+      case EINA_VALUE_BINARY_TAG_STRINGSHARE:
+      case EINA_VALUE_BINARY_TAG_STRING:
+         ret = _eina_value_binary_encode_string(enc, *(const char * const *)mem);
+         break;
+
+      case EINA_VALUE_BINARY_TAG_ARRAY:
+         ret = _eina_value_binary_encode_array(enc, mem);
+         break;
+
+      case EINA_VALUE_BINARY_TAG_LIST:
+         ret = _eina_value_binary_encode_list(enc, mem);
+         break;
+
+      case EINA_VALUE_BINARY_TAG_HASH:
+         ret = _eina_value_binary_encode_hash(enc, mem);
+         break;
+
+      case EINA_VALUE_BINARY_TAG_TIMEVAL:
+        {
+           const struct timeval *tv = mem;
+           int64_t v[2];
+
+           v[0] = tv->tv_sec;
+           v[1] = tv->tv_usec;
+           ret = _eina_value_binary_encode_bytes(enc, v, sizeof(v));
+           break;
+        }
+
+      case EINA_VALUE_BINARY_TAG_BLOB:
+        {
+           const Eina_Value_Blob *blob = mem;
+           unsigned int size = blob->memory ? blob->size : 0;
+
+           ret = (_eina_value_binary_encode_size(enc, size) &&
+                  _eina_value_binary_encode_bytes(enc, blob->memory, size));
+           break;
+        }
+
+      case EINA_VALUE_BINARY_TAG_STRUCT:
+         ret = _eina_value_binary_encode_struct(enc, mem);
+         break;
+
+      default:
+         ret = EINA_FALSE;
+     }
+
+   enc->depth--;
+   return ret;
+}
+
+/*
+ * Decoder, every read is checked against the end of the data.
+ */
+
+static Eina_Bool _eina_value_binary_decode_payload(Eina_Value_Binary_Decoder *dec, const Eina_Value_Type *type, unsigned char tag, void *mem);
+
+static inline const unsigned char *
+_eina_value_binary_decode_bytes(Eina_Value_Binary_Decoder *dec, size_t size)
+{
+   const unsigned char *p = dec->p;
+
+   if (size > (size_t)(dec->end - dec->p)) return NULL;
+   dec->p += size;
+   return p;
+}
+
+static Eina_Bool
+_eina_value_binary_decode_size(Eina_Value_Binary_Decoder *dec, uint64_t *size)
+{
+   unsigned int shift = 0;
+
+   *size = 0;
+   while (dec->p < dec->end)
+     {
+        unsigned char c = *dec->p++;
+
+        *size |= (uint64_t)(c & 0x7f) << shift;
+        if (!(c & 0x80)) return EINA_TRUE;
+        shift += 7;
+        if (shift >= 64) return EINA_FALSE;
+     }
+   return EINA_FALSE;
+}
+
+/* a count of members, each of them takes at least a byte */
+static Eina_Bool
+_eina_value_binary_decode_count(Eina_Value_Binary_Decoder *dec, unsigned int *count)
+{
+   uint64_t v;
+
+   if (!_eina_value_binary_decode_size(dec, &v)) return EINA_FALSE;
+   if (v > (uint64_t)(dec->end - dec->p)) return EINA_FALSE;
+   if (v > UINT_MAX) return EINA_FALSE;
+   *count = v;
+   return EINA_TRUE;
+}
+
+/* the string stays in the decoded memory, it is nul terminated there */
+static Eina_Bool
+_eina_value_binary_decode_string(Eina_Value_Binary_Decoder *dec, const char **str)
+{
+   const unsigned char *bytes;
+   uint64_t size;
+
+   if (!_eina_value_binary_decode_size(dec, &size)) return EINA_FALSE;
+   if (size == 0)
+     {
+        *str = NULL;
+        return EINA_TRUE;
+     }
+
+   if (size > (uint64_t)(dec->end - dec->p)) return EINA_FALSE;
+   bytes = _eina_value_binary_decode_bytes(dec, size);
+   if (bytes[size - 1] != '\0') return EINA_FALSE;
+   *str = (const char *)bytes;
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_eina_value_binary_decode_tag(Eina_Value_Binary_Decoder *dec, unsigned char *tag, const Eina_Value_Type **type)
+{
+   if (dec->p >= dec->end) return EINA_FALSE;
+   *tag = *dec->p++;
+   *type = _eina_value_binary_type_get(*tag);
+   return *type != NULL;
+}
+
+static Eina_Bool
+_eina_value_binary_decode_number(Eina_Value_Binary_Decoder *dec, const Eina_Value_Type *type, unsigned char tag, void *mem)
+{
+   const unsigned char *bytes;
+   unsigned char size = _eina_value_binary_number_sizes[tag];
+
+   bytes = _eina_value_binary_decode_bytes(dec, size);
+   if (!bytes) return EINA_FALSE;
+
+   if (size == type->value_size)
+     {
+        memcpy(mem, bytes, size);
+        return EINA_TRUE;
+     }
+
+   /* long and unsigned long are smaller than their payload */
+   if (tag == EINA_VALUE_BINARY_TAG_LONG)
+     {
+        int64_t v;
+
+        memcpy(&v, bytes, sizeof(v));
+        if ((v < LONG_MIN) || (v > LONG_MAX)) return EINA_FALSE;
+        *(long *)mem = v;
+     }
+   else
+     {
+        uint64_t v;
+
+        memcpy(&v, bytes, sizeof(v));
+        if (v > ULONG_MAX) return EINA_FALSE;
+        *(unsigned long *)mem = v;
+     }
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_eina_value_binary_decode_array(Eina_Value_Binary_Decoder *dec, void *mem)
+{
+   Eina_Value_Array desc = { NULL, 0, NULL };
+   const Eina_Value_Type *subtype;
+   Eina_Inarray *array;
+   unsigned char tag;
+   unsigned int count, i;
+   uint64_t step;
+
+   if (!_eina_value_binary_decode_tag(dec, &tag, &subtype) ||
+       !_eina_value_binary_decode_size(dec, &step) ||
+       !_eina_value_binary_decode_count(dec, &count))
+     return EINA_FALSE;
+
+   desc.subtype = subtype;
+   desc.step = step > UINT_MAX ? 0 : step;
+   if (!eina_value_type_pset(EINA_VALUE_TYPE_ARRAY, mem, &desc))
+     return EINA_FALSE;
+   if (count == 0) return EINA_TRUE;
+
+   array = ((Eina_Value_Array *)mem)->array;
+   if (_eina_value_binary_tag_is_plain(tag, subtype))
+     {
+        const unsigned char *bytes;
+        void *members;
+
+        if (count > (size_t)(dec->end - dec->p) / subtype->value_size)
+          return EINA_FALSE;
+        bytes = _eina_value_binary_decode_bytes(dec, count * subtype->value_size);
+        members = eina_inarray_alloc_at(array, 0, count);
+        if (!members) return EINA_FALSE;
+        memcpy(members, bytes, count * subtype->value_size);
+        return EINA_TRUE;
+     }
+
+   for (i = 0; i < count; i++)
+     {
+        void *imem = eina_inarray_alloc_at(array, i, 1);
+
+        if (!imem) return EINA_FALSE;
+        if (!eina_value_type_setup(subtype, imem))
+          {
+             eina_inarray_remove_at(array, i);
+             return EINA_FALSE;
+          }
+        /* on failure the member is flushed with the array */
+        if (!_eina_value_binary_decode_payload(dec, subtype, tag, imem))
+          return EINA_FALSE;
+     }
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_eina_value_binary_decode_list(Eina_Value_Binary_Decoder *dec, void *mem)
+{
+   Eina_Value_List desc = { NULL, NULL };
+   Eina_Value_List *tmem = mem;
+   const Eina_Value_Type *subtype;
+   unsigned char tag;
+   unsigned int count, i;
+
+   if (!_eina_value_binary_decode_tag(dec, &tag, &subtype) ||
+       !_eina_value_binary_decode_count(dec, &count))
+     return EINA_FALSE;
+
+   desc.subtype = subtype;
+   if (!eina_value_type_pset(EINA_VALUE_TYPE_LIST, mem, &desc))
+     return EINA_FALSE;
+
+   for (i = 0; i < count; i++)
+     {
+        Eina_List *node;
+        void *imem;
+
+        tmem->list = eina_list_append(tmem->list, (void *)1L);
+        node = eina_list_last(tmem->list);
+        if ((!node) || (node->data != (void *)1L)) return EINA_FALSE;
+
+        imem = eina_value_list_node_memory_setup(subtype, node);
+        if (!imem)
+          {
+             tmem->list = eina_list_remove_list(tmem->list, node);
+             return EINA_FALSE;
+          }
+        if (!eina_value_type_setup(subtype, imem))
+          {
+             eina_value_list_node_memory_flush(subtype, node);
+             tmem->list = eina_list_remove_list(tmem->list, node);
+             return EINA_FALSE;
+          }
+        if (!_eina_value_binary_decode_payload(dec, subtype, tag, imem))
+          return EINA_FALSE;
+     }
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_eina_value_binary_decode_hash(Eina_Value_Binary_Decoder *dec, void *mem)
+{
+   Eina_Value_Hash desc = { NULL, 0, NULL };
+   Eina_Value_Hash *tmem = mem;
+   const Eina_Value_Type *subtype;
+   unsigned char tag;
+   unsigned int count, i;
+
+   if (!_eina_value_binary_decode_tag(dec, &tag, &subtype) ||
+       !_eina_value_binary_decode_count(dec, &count))
+     return EINA_FALSE;
+
+   desc.subtype = subtype;
+   if (!eina_value_type_pset(EINA_VALUE_TYPE_HASH, mem, &desc))
+     return EINA_FALSE;
+
+   for (i = 0; i < count; i++)
+     {
+        const char *key;
+        void *imem;
+
+        if (!_eina_value_binary_decode_string(dec, &key) || !key)
+          return EINA_FALSE;
+        if (eina_hash_find(tmem->hash, key)) return EINA_FALSE;
+
+        imem = malloc(subtype->value_size);
+        if (!imem)
+          {
+             eina_error_set(EINA_ERROR_OUT_OF_MEMORY);
+             return EINA_FALSE;
+          }
+        if (!eina_value_type_setup(subtype, imem))
+          {
+             free(imem);
+             return EINA_FALSE;
+          }
+        if ((!_eina_value_binary_decode_payload(dec, subtype, tag, imem)) ||
+            (!eina_hash_add(tmem->hash, key, imem)))
+          {
+             eina_value_type_flush(subtype, imem);
+             free(imem);
+             return EINA_FALSE;
+          }
+     }
+   return EINA_TRUE;
+}
+
+static Eina_Value_Binary_Desc *
+_eina_value_binary_decode_struct_desc(Eina_Value_Binary_Decoder *dec)
+{
+   Eina_Value_Binary_Desc *bdesc;
+   Eina_Value_Struct_Member *members;
+   unsigned int count, i, offset = 0;
+
+   if (!_eina_value_binary_decode_count(dec, &count) || (count == 0))
+     return NULL;
+
+   bdesc = calloc(1, sizeof(Eina_Value_Binary_Desc) +
+                  count * sizeof(Eina_Value_Struct_Member));
+   if (!bdesc) return NULL;
+
+   members = (Eina_Value_Struct_Member *)(bdesc + 1);
+   bdesc->desc.version = EINA_VALUE_STRUCT_DESC_VERSION;
+   bdesc->desc.ops = &_eina_value_binary_struct_ops;
+   bdesc->desc.members = members;
+   bdesc->refcount = 1;
+
+   for (i = 0; i < count; i++)
+     {
+        const Eina_Value_Type *type;
+        const char *name;
+        unsigned char tag;
+        unsigned int align;
+
+        if (!_eina_value_binary_decode_string(dec, &name) || !name ||
+            !_eina_value_binary_decode_tag(dec, &tag, &type))
+          goto error;
+
+        members[i].name = eina_stringshare_add(name);
+        members[i].type = type;
+        bdesc->desc.member_count = i + 1;
+
+        align = type->value_size >= sizeof(void *) ? sizeof(void *) :
+          type->value_size >= 4 ? 4 : type->value_size >= 2 ? 2 : 1;
+        offset = (offset + align - 1) & ~(align - 1);
+        members[i].offset = offset;
+        offset += type->value_size;
+     }
+   bdesc->desc.size = offset;
+
+   if (!dec->descs)
+     {
+        dec->descs = eina_inarray_new(sizeof(Eina_Value_Binary_Desc *), 8);
+        if (!dec->descs) goto error;
+     }
+   if (eina_inarray_push(dec->descs, &bdesc) < 0) goto error;
+
+   return bdesc;
+
+ error:
+   _eina_value_binary_desc_unref(bdesc);
+   return NULL;
+}
+
+static Eina_Bool
+_eina_value_binary_decode_struct(Eina_Value_Binary_Decoder *dec, void *mem)
+{
+   Eina_Value_Struct st = { NULL, NULL };
+   Eina_Value_Binary_Desc *bdesc;
+   const Eina_Value_Struct_Member *itr, *itr_end;
+   unsigned char *base;
+   uint64_t kind;
+
+   if (!_eina_value_binary_decode_size(dec, &kind)) return EINA_FALSE;
+   if (kind == 0) return EINA_TRUE;
+
+   if (kind == 1)
+     bdesc = _eina_value_binary_decode_struct_desc(dec);
+   else if ((dec->descs) && (kind - 2 < eina_inarray_count(dec->descs)))
+     bdesc = *(Eina_Value_Binary_Desc **)eina_inarray_nth(dec->descs, kind - 2);
+   else
+     bdesc = NULL;
+   if (!bdesc) return EINA_FALSE;
+
+   st.desc = &bdesc->desc;
+   if (!eina_value_type_pset(EINA_VALUE_TYPE_STRUCT, mem, &st))
+     return EINA_FALSE;
+
+   base = ((Eina_Value_Struct *)mem)->memory;
+   itr = bdesc->desc.members;
+   itr_end = itr + bdesc->desc.member_count;
+   for (; itr < itr_end; itr++)
+     {
+        if (!_eina_value_binary_decode_payload
+            (dec, itr->type, _eina_value_binary_tag_get(itr->type),
+             base + itr->offset))
+          return EINA_FALSE;
+     }
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_eina_value_binary_decode_payload(Eina_Value_Binary_Decoder *dec, const Eina_Value_Type *type, unsigned char tag, void *mem)
+{
+   Eina_Bool ret;
+
+   if (tag < sizeof(_eina_value_binary_number_sizes) &&
+       _eina_value_binary_number_sizes[tag])
+     return _eina_value_binary_decode_number(dec, type, tag, mem);
+
+   if (dec->depth >= EINA_VALUE_BINARY_DEPTH_MAX) return EINA_FALSE;
+   dec->depth++;
+
+   switch ((Eina_Value_Binary_Tag)tag)
+     {
+      case EINA_VALUE_BINARY_TAG_STRINGSHARE:
+      case EINA_VALUE_BINARY_TAG_STRING:
+        {
+           const char *str;
+
+           ret = (_eina_value_binary_decode_string(dec, &str) &&
+                  eina_value_type_pset(type, mem, &str));
+           break;
+        }
+
+      case EINA_VALUE_BINARY_TAG_ARRAY:
+         ret = _eina_value_binary_decode_array(dec, mem);
+         break;
+
+      case EINA_VALUE_BINARY_TAG_LIST:
+         ret = _eina_value_binary_decode_list(dec, mem);
+         break;
+
+      case EINA_VALUE_BINARY_TAG_HASH:
+         ret = _eina_value_binary_decode_hash(dec, mem);
+         break;
+
+      case EINA_VALUE_BINARY_TAG_TIMEVAL:
+        {
+           const unsigned char *bytes;
+           struct timeval *tv = mem;
+           int64_t v[2];
+
+           bytes = _eina_value_binary_decode_bytes(dec, sizeof(v));
+           ret = bytes != NULL;
+           if (!ret) break;
+           memcpy(v, bytes, sizeof(v));
+           tv->tv_sec = v[0];
+           tv->tv_usec = v[1];
+           break;
+        }
+
+      case EINA_VALUE_BINARY_TAG_BLOB:
+        {
+           Eina_Value_Blob blob = { NULL, NULL, 0 };
+           const unsigned char *bytes;
+           uint64_t size;
+
+           ret = EINA_FALSE;
+           if (!_eina_value_binary_decode_size(dec, &size)) break;
+           if (size > UINT_MAX) break;
+           bytes = _eina_value_binary_decode_bytes(dec, size);
+           if (!bytes) break;
+
+           blob.size = size;
+           if (dec->zero_copy)
+             {
+                blob.memory = bytes;
+                dec->referenced = EINA_TRUE;
+             }
+           else if (size > 0)
+             {
+                void *copy = malloc(size);
+                if (!copy)
+                  {
+                     eina_error_set(EINA_ERROR_OUT_OF_MEMORY);
+                     break;
+                  }
+                memcpy(copy, bytes, size);
+                blob.ops = EINA_VALUE_BLOB_OPERATIONS_MALLOC;
+                blob.memory = copy;
+             }
+           ret = eina_value_type_pset(type, mem, &blob);
+           break;
+        }
+
+      case EINA_VALUE_BINARY_TAG_STRUCT:
+         ret = _eina_value_binary_decode_struct(dec, mem);
+         break;
+
+      default:
+         ret = EINA_FALSE;
+     }
+
+   dec->depth--;
+   return ret;
+}
+
+static size_t
+_eina_value_binary_decode(Eina_Value_Binary_Decoder *dec, const unsigned char *data, Eina_Value *value)
+{
+   const Eina_Value_Type *type;
+   const unsigned char *header;
+   uint16_t byte_order;
+   unsigned char tag;
+   Eina_Bool ret;
+
+   header = _eina_value_binary_decode_bytes(dec, EINA_VALUE_BINARY_HEADER_SIZE);
+   if (!header) goto error;
+   memcpy(&byte_order, header + 4, sizeof(byte_order));
+   if ((memcmp(header, EINA_VALUE_BINARY_MAGIC, 4) != 0) ||
+       (byte_order != EINA_VALUE_BINARY_BYTE_ORDER) ||
+       (header[6] != EINA_VALUE_BINARY_VERSION))
+     goto error;
+
+   if (!_eina_value_binary_decode_tag(dec, &tag, &type)) goto error;
+   if (!eina_value_setup(value, type)) goto error;
+
+   ret = _eina_value_binary_decode_payload(dec, type, tag,
+                                           eina_value_memory_get(value));
+
+   /* the values hold their own references to the descriptions */
+   if (dec->descs)
+     {
+        Eina_Value_Binary_Desc **itr;
+        EINA_INARRAY_FOREACH(dec->descs, itr)
+          _eina_value_binary_desc_unref(*itr);
+        eina_inarray_free(dec->descs);
+     }
+
+   if (!ret)
+     {
+        eina_value_flush(value);
+        dec->referenced = EINA_FALSE;
+        goto error;
+     }
+
+   return dec->p - data;
+
+ error:
+   eina_error_set(EINA_ERROR_VALUE_FAILED);
+   return 0;
+}
+
+/**
+ * @endcond
+ */
+
+/*============================================================================*
+ *                                   API                                      *
+ *============================================================================*/
+
+EAPI Eina_Bool
+eina_value_binary_encode(const Eina_Value *value, Eina_Binbuf *buf)
+{
+   Eina_Value_Binary_Encoder enc;
+   unsigned char header[EINA_VALUE_BINARY_HEADER_SIZE];
+   uint16_t byte_order = EINA_VALUE_BINARY_BYTE_ORDER;
+   unsigned char tag;
+   size_t start;
+   Eina_Bool ret;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(value, EINA_FALSE);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(buf, EINA_FALSE);
+   EINA_SAFETY_ON_FALSE_RETURN_VAL(eina_value_type_check(value->type), EINA_FALSE);
+
+   tag = _eina_value_binary_tag_get(value->type);
+   if (!tag)
+     {
+        eina_error_set(EINA_ERROR_VALUE_FAILED);
+        return EINA_FALSE;
+     }
+
+   memcpy(header, EINA_VALUE_BINARY_MAGIC, 4);
+   memcpy(header + 4, &byte_order, sizeof(byte_order));
+   header[6] = EINA_VALUE_BINARY_VERSION;
+   header[7] = 0;
+
+   enc.buf = buf;
+   enc.descs = NULL;
+   enc.descs_count = 0;
+   enc.depth = 0;
+
+   start = eina_binbuf_length_get(buf);
+   ret = (eina_binbuf_append_length(buf, header, sizeof(header)) &&
+          eina_binbuf_append_char(buf, tag) &&
+          _eina_value_binary_encode_payload(&enc, value->type, tag,
+                                            eina_value_memory_get(value)));
+
+   if (enc.descs) eina_hash_free(enc.descs);
+
+   if (!ret)
+     {
+        eina_binbuf_remove(buf, start, eina_binbuf_length_get(buf));
+        eina_error_set(EINA_ERROR_VALUE_FAILED);
+     }
+   return ret;
+}
+
+EAPI size_t
+eina_value_binary_decode(const void *data, size_t size, Eina_Value *value)
+{
+   Eina_Value_Binary_Decoder dec;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(data, 0);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(value, 0);
+
+   memset(&dec, 0, sizeof(dec));
+   dec.p = data;
+   dec.end = dec.p + size;
+
+   return _eina_value_binary_decode(&dec, data, value);
+}
+
+EAPI size_t
+eina_value_binary_file_decode(Eina_File *file, size_t offset, Eina_Value *value)
+{
+   Eina_Value_Binary_Decoder dec;
+   unsigned char *map;
+   size_t size, ret;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(file, 0);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(value, 0);
+
+   size = eina_file_size_get(file);
+   if (offset >= size)
+     {
+        eina_error_set(EINA_ERROR_VALUE_FAILED);
+        return 0;
+     }
+
+   map = eina_file_map_all(file, EINA_FILE_SEQUENTIAL);
+   if (!map) return 0;
+
+   memset(&dec, 0, sizeof(dec));
+   dec.p = map + offset;
+   dec.end = map + size;
+   dec.zero_copy = EINA_TRUE;
+
+   ret = _eina_value_binary_decode(&dec, map + offset, value);
+
+   /* blobs point to the map, it is released when the file is closed */
+   if (!dec.referenced)
+     eina_file_map_free(file, map);
+
+   return ret;
+}
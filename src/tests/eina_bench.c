@@ -43,6 +43,10 @@ static const Eina_Benchmark_Case etc[] = {
    /* { "Mempool", eina_bench_mempool }, */
    /* { "Rectangle_Pool", eina_bench_rectangle_pool }, */
    // { "Render Loop", eina_bench_quadtree },
+   { "Log", eina_bench_log },
+   { "Value", eina_bench_value },
+   { "Simple_XML", eina_bench_simple_xml },
+   { "Tiler", eina_bench_tiler },
    { NULL, NULL }
 };
 
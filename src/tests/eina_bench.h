@@ -29,6 +29,10 @@ void eina_bench_sort(Eina_Benchmark *bench);
 void eina_bench_mempool(Eina_Benchmark *bench);
 void eina_bench_rectangle_pool(Eina_Benchmark *bench);
 void eina_bench_quadtree(Eina_Benchmark *bench);
+void eina_bench_log(Eina_Benchmark *bench);
+void eina_bench_value(Eina_Benchmark *bench);
+void eina_bench_simple_xml(Eina_Benchmark *bench);
+void eina_bench_tiler(Eina_Benchmark *bench);
 
 /* Specific benchmark. */
 void eina_bench_e17(void);
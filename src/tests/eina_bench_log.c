@@ -0,0 +1,135 @@
+/* EINA - EFL data type library
+ * Copyright (C) 2012 Enlightenment Project
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "eina_bench.h"
+#include "Eina.h"
+
+/* Everything goes to /dev/null, only the cost of printing is measured. */
+
+static void
+eina_bench_log_run(int request, int dom)
+{
+   int i;
+
+   for (i = 0; i < request; ++i)
+     EINA_LOG_DOM_ERR(dom, "message %i of %i, %s", i, request, "some text");
+}
+
+static int
+eina_bench_log_domain_get(void)
+{
+   int dom;
+
+   dom = eina_log_domain_register("bench", NULL);
+   eina_log_domain_level_set("bench", EINA_LOG_LEVEL_ERR);
+   return dom;
+}
+
+/* What the callbacks used to do, one stdio call for each piece. */
+static void
+eina_bench_log_print_cb_stdio(const Eina_Log_Domain *d,
+                              Eina_Log_Level level __UNUSED__,
+                              const char *file,
+                              const char *fnc,
+                              int line,
+                              const char *fmt,
+                              void *data,
+                              va_list args)
+{
+   FILE *f = data;
+
+   fprintf(f, "%s<%u> %s:%d %s() ", d->name, 0, file, line, fnc);
+   vfprintf(f, fmt, args);
+   putc('\n', f);
+}
+
+static void
+eina_bench_log_stdio(int request)
+{
+   FILE *f;
+   int dom;
+
+   f = fopen("/dev/null", "w");
+   if (!f) return;
+   setvbuf(f, NULL, _IONBF, 0);
+
+   dom = eina_bench_log_domain_get();
+   eina_log_print_cb_set(eina_bench_log_print_cb_stdio, f);
+   eina_bench_log_run(request, dom);
+   eina_log_print_cb_set(eina_log_print_cb_stderr, NULL);
+   eina_log_domain_unregister(dom);
+
+   fclose(f);
+}
+
+static void
+eina_bench_log_file(int request)
+{
+   FILE *f;
+   int dom;
+
+   f = fopen("/dev/null", "w");
+   if (!f) return;
+   setvbuf(f, NULL, _IONBF, 0);
+
+   dom = eina_bench_log_domain_get();
+   eina_log_print_cb_set(eina_log_print_cb_file, f);
+   eina_bench_log_run(request, dom);
+   eina_log_print_cb_set(eina_log_print_cb_stderr, NULL);
+   eina_log_domain_unregister(dom);
+
+   fclose(f);
+}
+
+static void
+eina_bench_log_buffer(int request)
+{
+   Eina_Log_Buffer *buffer;
+   int dom;
+
+   buffer = eina_log_buffer_new("/dev/null", 64 * 1024, 0.5);
+   if (!buffer) return;
+
+   dom = eina_bench_log_domain_get();
+   eina_log_print_cb_set(eina_log_print_cb_buffer, buffer);
+   eina_bench_log_run(request, dom);
+   eina_log_print_cb_set(eina_log_print_cb_stderr, NULL);
+   eina_log_domain_unregister(dom);
+
+   eina_log_buffer_free(buffer);
+}
+
+void eina_bench_log(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "stdio",
+                           EINA_BENCHMARK(
+                              eina_bench_log_stdio),  1000, 100000, 5000);
+   eina_benchmark_register(bench, "file",
+                           EINA_BENCHMARK(
+                              eina_bench_log_file),   1000, 100000, 5000);
+   eina_benchmark_register(bench, "buffer",
+                           EINA_BENCHMARK(
+                              eina_bench_log_buffer), 1000, 100000, 5000);
+}
@@ -0,0 +1,177 @@
+/* EINA - EFL data type library
+ * Copyright (C) 2012 Enlightenment Project
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "eina_bench.h"
+#include "Eina.h"
+
+/* sample.gpx with its track, comment and cdata repeated request times */
+static Eina_Strbuf *_doc = NULL;
+static int _doc_request = -1;
+
+static const char *
+eina_bench_simple_xml_doc_get(int request, unsigned int *len)
+{
+   Eina_File *f;
+   const char *map, *body, *footer;
+   char *src;
+   int i;
+
+   if (_doc_request == request)
+     goto end;
+
+   f = eina_file_open(TESTS_SRC_DIR "/sample.gpx", EINA_FALSE);
+   if (!f) return NULL;
+   map = eina_file_map_all(f, EINA_FILE_SEQUENTIAL);
+   if (!map)
+     {
+        eina_file_close(f);
+        return NULL;
+     }
+
+   if (!_doc) _doc = eina_strbuf_new();
+   eina_strbuf_reset(_doc);
+   eina_strbuf_append_length(_doc, map, eina_file_size_get(f));
+   eina_file_map_free(f, (void *)map);
+   eina_file_close(f);
+
+   /* the map is not nul terminated, look in the copy */
+   src = eina_strbuf_string_steal(_doc);
+   body = strstr(src, "  <trk>");
+   footer = strstr(src, "</gpx>");
+   if ((!body) || (!footer) || (footer < body))
+     {
+        free(src);
+        return NULL;
+     }
+
+   eina_strbuf_append_length(_doc, src, body - src);
+   for (i = 0; i < request; i++)
+     eina_strbuf_append_length(_doc, body, footer - body);
+   eina_strbuf_append(_doc, footer);
+   _doc_request = request;
+   free(src);
+
+ end:
+   *len = eina_strbuf_length_get(_doc);
+   return eina_strbuf_string_get(_doc);
+}
+
+static Eina_Bool
+eina_bench_simple_xml_attribute_cb(void *data, const char *key __UNUSED__, const char *value __UNUSED__)
+{
+   unsigned int *count = data;
+
+   (*count)++;
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+eina_bench_simple_xml_cb(void *data, Eina_Simple_XML_Type type, const char *content, unsigned offset __UNUSED__, unsigned length)
+{
+   unsigned int *count = data;
+   const char *attrs;
+
+   (*count)++;
+   if ((type != EINA_SIMPLE_XML_OPEN) && (type != EINA_SIMPLE_XML_OPEN_EMPTY))
+     return EINA_TRUE;
+
+   attrs = eina_simple_xml_tag_attributes_find(content, length);
+   if (attrs)
+     eina_simple_xml_attributes_parse(attrs, length - (attrs - content),
+                                      eina_bench_simple_xml_attribute_cb,
+                                      data);
+   return EINA_TRUE;
+}
+
+static void
+eina_bench_simple_xml_parse(int request)
+{
+   const char *doc;
+   unsigned int len, count = 0;
+
+   doc = eina_bench_simple_xml_doc_get(request, &len);
+   if (!doc) return;
+
+   eina_simple_xml_parse(doc, len, EINA_FALSE,
+                         eina_bench_simple_xml_cb, &count);
+}
+
+static void
+eina_bench_simple_xml_parse_strip(int request)
+{
+   const char *doc;
+   unsigned int len, count = 0;
+
+   doc = eina_bench_simple_xml_doc_get(request, &len);
+   if (!doc) return;
+
+   eina_simple_xml_parse(doc, len, EINA_TRUE,
+                         eina_bench_simple_xml_cb, &count);
+}
+
+static void
+eina_bench_simple_xml_node_load(int request)
+{
+   Eina_Simple_XML_Node_Root *root;
+   const char *doc;
+   unsigned int len;
+
+   doc = eina_bench_simple_xml_doc_get(request, &len);
+   if (!doc) return;
+
+   root = eina_simple_xml_node_load(doc, len, EINA_TRUE);
+   eina_simple_xml_node_root_free(root);
+}
+
+static void
+eina_bench_simple_xml_node_arena_load(int request)
+{
+   Eina_Simple_XML_Node_Root *root;
+   const char *doc;
+   unsigned int len;
+
+   doc = eina_bench_simple_xml_doc_get(request, &len);
+   if (!doc) return;
+
+   root = eina_simple_xml_node_arena_load(doc, len, EINA_TRUE);
+   eina_simple_xml_node_root_free(root);
+}
+
+void eina_bench_simple_xml(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "parse",
+                           EINA_BENCHMARK(
+                              eina_bench_simple_xml_parse),       100, 10000, 500);
+   eina_benchmark_register(bench, "parse strip",
+                           EINA_BENCHMARK(
+                              eina_bench_simple_xml_parse_strip), 100, 10000, 500);
+   eina_benchmark_register(bench, "node load",
+                           EINA_BENCHMARK(
+                              eina_bench_simple_xml_node_load),   100, 10000, 500);
+   eina_benchmark_register(bench, "node arena load",
+                           EINA_BENCHMARK(
+                              eina_bench_simple_xml_node_arena_load), 100, 10000, 500);
+}
@@ -0,0 +1,244 @@
+/* EINA - EFL data type library
+ * Copyright (C) 2012 Enlightenment Project
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "eina_bench.h"
+#include "Eina.h"
+
+/* Each request is the number of damaged rectangles of one frame. */
+
+static Eina_Tiler *
+eina_bench_tiler_damage(int request, int size, Eina_Tiler_Algorithm algorithm)
+{
+   Eina_Tiler *t;
+   Eina_Rectangle r;
+   int i;
+
+   t = eina_tiler_new(1920, 1080);
+   eina_tiler_tile_size_set(t, 32, 32);
+   eina_tiler_algorithm_set(t, algorithm);
+
+   for (i = 0; i < request; i++)
+     {
+        EINA_RECTANGLE_SET(&r, rand() % 1920, rand() % 1080,
+                           rand() % size + 1, rand() % size + 1);
+        eina_tiler_rect_add(t, &r);
+     }
+
+   return t;
+}
+
+static void
+eina_bench_tiler_area(Eina_Tiler *t)
+{
+   Eina_Iterator *it;
+   Eina_Rectangle *rp;
+   int count = 0;
+
+   it = eina_tiler_iterator_new(t);
+   EINA_ITERATOR_FOREACH(it, rp)
+     count += rp->w * rp->h;
+   eina_iterator_free(it);
+
+   if (count == 42) printf("area: %i\n", count);
+}
+
+static void
+eina_bench_tiler_frame(int request, Eina_Tiler_Algorithm algorithm)
+{
+   Eina_Tiler *t;
+
+   srand(request);
+
+   t = eina_bench_tiler_damage(request, 64, algorithm);
+   eina_bench_tiler_area(t);
+   eina_tiler_free(t);
+}
+
+static void
+eina_bench_tiler_splitter(int request)
+{
+   eina_bench_tiler_frame(request, EINA_TILER_ALGORITHM_SPLITTER);
+}
+
+static void
+eina_bench_tiler_region(int request)
+{
+   eina_bench_tiler_frame(request, EINA_TILER_ALGORITHM_REGION);
+}
+
+static void
+eina_bench_tiler_tiles(int request)
+{
+   eina_bench_tiler_frame(request, EINA_TILER_ALGORITHM_TILES);
+}
+
+static void
+eina_bench_tiler_batch(int request, Eina_Tiler_Algorithm algorithm)
+{
+   Eina_Tiler *t;
+   Eina_Rectangle *rects;
+   int i;
+
+   srand(request);
+
+   rects = malloc(request * sizeof (Eina_Rectangle));
+   if (!rects) return;
+   for (i = 0; i < request; i++)
+     {
+        EINA_RECTANGLE_SET(&rects[i], rand() % 1920, rand() % 1080,
+                           rand() % 64 + 1, rand() % 64 + 1);
+     }
+
+   t = eina_tiler_new(1920, 1080);
+   eina_tiler_algorithm_set(t, algorithm);
+   eina_tiler_rects_add(t, rects, request);
+   eina_bench_tiler_area(t);
+   eina_tiler_free(t);
+
+   free(rects);
+}
+
+static void
+eina_bench_tiler_batch_splitter(int request)
+{
+   eina_bench_tiler_batch(request, EINA_TILER_ALGORITHM_SPLITTER);
+}
+
+static void
+eina_bench_tiler_batch_region(int request)
+{
+   eina_bench_tiler_batch(request, EINA_TILER_ALGORITHM_REGION);
+}
+
+/* damage of a frame minus its opaque areas */
+static void
+eina_bench_tiler_subtract(int request)
+{
+   Eina_Tiler *damage, *opaque;
+
+   srand(request);
+
+   damage = eina_bench_tiler_damage(request, 64, EINA_TILER_ALGORITHM_REGION);
+   opaque = eina_bench_tiler_damage(request / 4, 256, EINA_TILER_ALGORITHM_REGION);
+   eina_tiler_subtract(damage, opaque);
+   eina_bench_tiler_area(damage);
+   eina_tiler_free(opaque);
+   eina_tiler_free(damage);
+}
+
+static void
+eina_bench_tiler_subtract_rect(int request)
+{
+   Eina_Tiler *damage, *opaque;
+   Eina_Iterator *it;
+   Eina_Rectangle *rp;
+
+   srand(request);
+
+   damage = eina_bench_tiler_damage(request, 64, EINA_TILER_ALGORITHM_REGION);
+   opaque = eina_bench_tiler_damage(request / 4, 256, EINA_TILER_ALGORITHM_REGION);
+   it = eina_tiler_iterator_new(opaque);
+   EINA_ITERATOR_FOREACH(it, rp)
+     eina_tiler_rect_del(damage, rp);
+   eina_iterator_free(it);
+   eina_bench_tiler_area(damage);
+   eina_tiler_free(opaque);
+   eina_tiler_free(damage);
+}
+
+/* damage of several layers */
+static void
+eina_bench_tiler_union(int request)
+{
+   Eina_Tiler *frame, *layer;
+   int i;
+
+   srand(request);
+
+   frame = eina_bench_tiler_damage(request / 4, 64, EINA_TILER_ALGORITHM_REGION);
+   for (i = 0; i < 3; i++)
+     {
+        layer = eina_bench_tiler_damage(request / 4, 64, EINA_TILER_ALGORITHM_REGION);
+        eina_tiler_union(frame, layer);
+        eina_tiler_free(layer);
+     }
+   eina_bench_tiler_area(frame);
+   eina_tiler_free(frame);
+}
+
+static void
+eina_bench_tiler_union_rect(int request)
+{
+   Eina_Tiler *frame, *layer;
+   Eina_Iterator *it;
+   Eina_Rectangle *rp;
+   int i;
+
+   srand(request);
+
+   frame = eina_bench_tiler_damage(request / 4, 64, EINA_TILER_ALGORITHM_REGION);
+   for (i = 0; i < 3; i++)
+     {
+        layer = eina_bench_tiler_damage(request / 4, 64, EINA_TILER_ALGORITHM_REGION);
+        it = eina_tiler_iterator_new(layer);
+        EINA_ITERATOR_FOREACH(it, rp)
+          eina_tiler_rect_add(frame, rp);
+        eina_iterator_free(it);
+        eina_tiler_free(layer);
+     }
+   eina_bench_tiler_area(frame);
+   eina_tiler_free(frame);
+}
+
+void eina_bench_tiler(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "splitter",
+                           EINA_BENCHMARK(
+                              eina_bench_tiler_splitter), 10, 1000, 50);
+   eina_benchmark_register(bench, "region",
+                           EINA_BENCHMARK(
+                              eina_bench_tiler_region),   10, 1000, 50);
+   eina_benchmark_register(bench, "tiles",
+                           EINA_BENCHMARK(
+                              eina_bench_tiler_tiles),    10, 1000, 50);
+   eina_benchmark_register(bench, "batch splitter",
+                           EINA_BENCHMARK(
+                              eina_bench_tiler_batch_splitter), 10, 1000, 50);
+   eina_benchmark_register(bench, "batch region",
+                           EINA_BENCHMARK(
+                              eina_bench_tiler_batch_region),   10, 1000, 50);
+   eina_benchmark_register(bench, "subtract",
+                           EINA_BENCHMARK(
+                              eina_bench_tiler_subtract),      10, 1000, 50);
+   eina_benchmark_register(bench, "subtract rect by rect",
+                           EINA_BENCHMARK(
+                              eina_bench_tiler_subtract_rect), 10, 1000, 50);
+   eina_benchmark_register(bench, "union",
+                           EINA_BENCHMARK(
+                              eina_bench_tiler_union),         10, 1000, 50);
+   eina_benchmark_register(bench, "union rect by rect",
+                           EINA_BENCHMARK(
+                              eina_bench_tiler_union_rect),    10, 1000, 50);
+}
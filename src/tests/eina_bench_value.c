@@ -0,0 +1,345 @@
+/* EINA - EFL data type library
+ * Copyright (C) 2012 Enlightenment Project
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "eina_bench.h"
+#include "Eina.h"
+
+/* Each request is 1000 operations, to measure more than the loop. */
+
+static void
+eina_bench_value_set_get(int request)
+{
+   Eina_Value value;
+   int i, j, r = 0;
+
+   eina_value_setup(&value, EINA_VALUE_TYPE_INT);
+   for (i = 0; i < request; i++)
+     for (j = 0; j < 1000; j++)
+       {
+          int v;
+
+          eina_value_set(&value, j);
+          eina_value_get(&value, &v);
+          r += v;
+       }
+   eina_value_flush(&value);
+
+   if (r == 42) printf("sum: %i\n", r);
+}
+
+static void
+eina_bench_value_convert_int_double(int request)
+{
+   Eina_Value value, conv;
+   int i, j;
+
+   eina_value_setup(&value, EINA_VALUE_TYPE_INT);
+   eina_value_setup(&conv, EINA_VALUE_TYPE_DOUBLE);
+   for (i = 0; i < request; i++)
+     for (j = 0; j < 1000; j++)
+       {
+          eina_value_set(&value, j);
+          eina_value_convert(&value, &conv);
+          eina_value_convert(&conv, &value);
+       }
+   eina_value_flush(&conv);
+   eina_value_flush(&value);
+}
+
+static void
+eina_bench_value_convert_int64_uchar(int request)
+{
+   Eina_Value value, conv;
+   int i, j;
+
+   eina_value_setup(&value, EINA_VALUE_TYPE_INT64);
+   eina_value_setup(&conv, EINA_VALUE_TYPE_UCHAR);
+   for (i = 0; i < request; i++)
+     for (j = 0; j < 1000; j++)
+       {
+          eina_value_set(&value, (int64_t)j);
+          eina_value_convert(&value, &conv); /* fails above 255 */
+       }
+   eina_value_flush(&conv);
+   eina_value_flush(&value);
+}
+
+static void
+eina_bench_value_array_sum_get(int request)
+{
+   Eina_Value *value;
+   unsigned int i, count;
+   int j;
+   long r = 0;
+
+   value = eina_value_array_new(EINA_VALUE_TYPE_INT, 1000);
+   for (j = 0; j < 1000; j++)
+     eina_value_array_append(value, j);
+
+   for (j = 0; j < request; j++)
+     {
+        count = eina_value_array_count(value);
+        for (i = 0; i < count; i++)
+          {
+             int v;
+
+             eina_value_array_get(value, i, &v);
+             r += v;
+          }
+     }
+   eina_value_free(value);
+
+   if (r == 42) printf("sum: %li\n", r);
+}
+
+static void
+eina_bench_value_array_sum_data(int request)
+{
+   Eina_Value *value;
+   const int *members;
+   unsigned int i, count;
+   int j;
+   long r = 0;
+
+   value = eina_value_array_new(EINA_VALUE_TYPE_INT, 1000);
+   for (j = 0; j < 1000; j++)
+     eina_value_array_append(value, j);
+
+   for (j = 0; j < request; j++)
+     {
+        members = eina_value_array_data_get(value, &count);
+        for (i = 0; i < count; i++)
+          r += members[i];
+     }
+   eina_value_free(value);
+
+   if (r == 42) printf("sum: %li\n", r);
+}
+
+static void
+eina_bench_value_array_convert_get(int request)
+{
+   Eina_Value *value;
+   Eina_Value member, conv;
+   double doubles[1000];
+   unsigned int i;
+   int j;
+
+   value = eina_value_array_new(EINA_VALUE_TYPE_INT, 1000);
+   for (j = 0; j < 1000; j++)
+     eina_value_array_append(value, j);
+
+   eina_value_setup(&conv, EINA_VALUE_TYPE_DOUBLE);
+   for (j = 0; j < request; j++)
+     for (i = 0; i < 1000; i++)
+       {
+          eina_value_array_value_get(value, i, &member);
+          eina_value_convert(&member, &conv);
+          eina_value_get(&conv, &doubles[i]);
+          eina_value_flush(&member);
+       }
+   eina_value_flush(&conv);
+   eina_value_free(value);
+
+   if (doubles[0] > 42) printf("first: %f\n", doubles[0]);
+}
+
+static void
+eina_bench_value_array_convert_data(int request)
+{
+   Eina_Value *value;
+   double doubles[1000];
+   int j;
+
+   value = eina_value_array_new(EINA_VALUE_TYPE_INT, 1000);
+   for (j = 0; j < 1000; j++)
+     eina_value_array_append(value, j);
+
+   for (j = 0; j < request; j++)
+     eina_value_array_data_convert(value, 0, 1000,
+                                   EINA_VALUE_TYPE_DOUBLE, doubles);
+   eina_value_free(value);
+
+   if (doubles[0] > 42) printf("first: %f\n", doubles[0]);
+}
+
+static void
+eina_bench_value_hash_fill(Eina_Value *value)
+{
+   char key[16], str[32];
+   int i;
+
+   eina_value_hash_setup(value, EINA_VALUE_TYPE_STRINGSHARE, 0);
+   for (i = 0; i < 100; i++)
+     {
+        snprintf(key, sizeof(key), "key%d", i);
+        snprintf(str, sizeof(str), "some value %d", i * 7);
+        eina_value_hash_set(value, key, str);
+     }
+}
+
+static void
+eina_bench_value_binary(int request)
+{
+   Eina_Value value, decoded;
+   Eina_Binbuf *buf;
+   int i;
+
+   eina_bench_value_hash_fill(&value);
+   buf = eina_binbuf_new();
+   for (i = 0; i < request; i++)
+     {
+        eina_binbuf_reset(buf);
+        eina_value_binary_encode(&value, buf);
+        eina_value_binary_decode(eina_binbuf_string_get(buf),
+                                 eina_binbuf_length_get(buf), &decoded);
+        eina_value_flush(&decoded);
+     }
+   eina_binbuf_free(buf);
+   eina_value_flush(&value);
+}
+
+static void
+eina_bench_value_to_string(int request)
+{
+   Eina_Value value;
+   int i;
+
+   eina_bench_value_hash_fill(&value);
+   for (i = 0; i < request; i++)
+     free(eina_value_to_string(&value));
+   eina_value_flush(&value);
+}
+
+#define BIGST_COUNT 48
+
+static char eina_bench_value_bigst_names[BIGST_COUNT][16];
+static Eina_Value_Struct_Member eina_bench_value_bigst_members[BIGST_COUNT];
+static Eina_Value_Struct_Desc eina_bench_value_bigst_desc = {
+  EINA_VALUE_STRUCT_DESC_VERSION, NULL,
+  eina_bench_value_bigst_members, BIGST_COUNT, BIGST_COUNT * sizeof(int)
+};
+
+static void
+eina_bench_value_bigst_setup(Eina_Value *value)
+{
+   int i;
+
+   for (i = 0; i < BIGST_COUNT; i++)
+     {
+        snprintf(eina_bench_value_bigst_names[i],
+                 sizeof(eina_bench_value_bigst_names[i]), "member_%d", i);
+        eina_bench_value_bigst_members[i].name = eina_bench_value_bigst_names[i];
+        eina_bench_value_bigst_members[i].type = EINA_VALUE_TYPE_INT;
+        eina_bench_value_bigst_members[i].offset = i * sizeof(int);
+     }
+   eina_value_struct_setup(value, &eina_bench_value_bigst_desc);
+}
+
+static void
+eina_bench_value_struct_name(int request)
+{
+   Eina_Value value;
+   int i, j, r = 0;
+
+   eina_bench_value_bigst_setup(&value);
+   for (i = 0; i < request; i++)
+     for (j = 0; j < 1000; j++)
+       {
+          const char *name = eina_bench_value_bigst_names[j % BIGST_COUNT];
+          int v;
+
+          eina_value_struct_set(&value, name, j);
+          eina_value_struct_get(&value, name, &v);
+          r += v;
+       }
+   eina_value_flush(&value);
+
+   if (r == 42) printf("sum: %i\n", r);
+}
+
+static void
+eina_bench_value_struct_index(int request)
+{
+   Eina_Value value;
+   int idx[BIGST_COUNT];
+   int i, j, r = 0;
+
+   eina_bench_value_bigst_setup(&value);
+   for (i = 0; i < BIGST_COUNT; i++)
+     idx[i] = eina_value_struct_member_index_get(&eina_bench_value_bigst_desc,
+                                                 eina_bench_value_bigst_names[i]);
+   for (i = 0; i < request; i++)
+     for (j = 0; j < 1000; j++)
+       {
+          int v;
+
+          eina_value_struct_index_set(&value, idx[j % BIGST_COUNT], j);
+          eina_value_struct_index_get(&value, idx[j % BIGST_COUNT], &v);
+          r += v;
+       }
+   eina_value_flush(&value);
+
+   if (r == 42) printf("sum: %i\n", r);
+}
+
+#undef BIGST_COUNT
+
+void eina_bench_value(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "set/get int",
+                           EINA_BENCHMARK(
+                              eina_bench_value_set_get), 100, 10000, 500);
+   eina_benchmark_register(bench, "convert int/double",
+                           EINA_BENCHMARK(
+                              eina_bench_value_convert_int_double), 100, 10000, 500);
+   eina_benchmark_register(bench, "convert int64/uchar",
+                           EINA_BENCHMARK(
+                              eina_bench_value_convert_int64_uchar), 100, 10000, 500);
+   eina_benchmark_register(bench, "array sum get",
+                           EINA_BENCHMARK(
+                              eina_bench_value_array_sum_get), 100, 10000, 500);
+   eina_benchmark_register(bench, "array sum data",
+                           EINA_BENCHMARK(
+                              eina_bench_value_array_sum_data), 100, 10000, 500);
+   eina_benchmark_register(bench, "array convert get",
+                           EINA_BENCHMARK(
+                              eina_bench_value_array_convert_get), 100, 10000, 500);
+   eina_benchmark_register(bench, "array convert data",
+                           EINA_BENCHMARK(
+                              eina_bench_value_array_convert_data), 100, 10000, 500);
+   eina_benchmark_register(bench, "hash binary encode/decode",
+                           EINA_BENCHMARK(
+                              eina_bench_value_binary), 100, 10000, 500);
+   eina_benchmark_register(bench, "hash to_string",
+                           EINA_BENCHMARK(
+                              eina_bench_value_to_string), 100, 10000, 500);
+   eina_benchmark_register(bench, "struct set/get by name",
+                           EINA_BENCHMARK(
+                              eina_bench_value_struct_name), 100, 10000, 500);
+   eina_benchmark_register(bench, "struct set/get by index",
+                           EINA_BENCHMARK(
+                              eina_bench_value_struct_index), 100, 10000, 500);
+}
@@ -68,6 +68,8 @@ static const Eina_Test_Case etc[] = {
    { "Sched", eina_test_sched },
    { "Simple Xml Parser", eina_test_simple_xml_parser},
    { "Value", eina_test_value },
+   { "Hash Index", eina_test_hash_index },
+   { "Value Binary", eina_test_value_binary },
    // Disabling Eina_Model test
    //   { "Model", eina_test_model },
    { NULL, NULL }
@@ -56,6 +56,8 @@ void eina_test_fp(TCase *tc);
 void eina_test_sched(TCase *tc);
 void eina_test_simple_xml_parser(TCase *tc);
 void eina_test_value(TCase *tc);
+void eina_test_hash_index(TCase *tc);
+void eina_test_value_binary(TCase *tc);
 void eina_test_model(TCase *tc);
 
 #endif /* EINA_SUITE_H_ */
@@ -23,6 +23,10 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/select.h>
 
 #include "eina_suite.h"
 #include "Eina.h"
@@ -134,9 +138,342 @@ START_TEST(eina_file_split_simple)
 }
 END_TEST
 
+#ifndef _WIN32
+static const char *_walk_tree[] = {
+  "a/", "a/1", "a/2", "a/b/", "a/b/3", "a/b/c/", "a/b/c/4", "d/", "d/5", "6",
+  NULL
+};
+
+static void
+_walk_tree_create(const char *root)
+{
+   char buf[PATH_MAX];
+   int i;
+
+   for (i = 0; _walk_tree[i]; i++)
+     {
+        size_t len = strlen(_walk_tree[i]);
+
+        snprintf(buf, sizeof (buf), "%s/%s", root, _walk_tree[i]);
+        if (_walk_tree[i][len - 1] == '/')
+          fail_if(mkdir(buf, S_IRWXU) != 0);
+        else
+          {
+             int fd = open(buf, O_CREAT | O_WRONLY, S_IRUSR | S_IWUSR);
+             fail_if(fd < 0);
+             close(fd);
+          }
+     }
+}
+
+static void
+_walk_tree_destroy(const char *root)
+{
+   char buf[PATH_MAX];
+   int i;
+
+   for (i = 0; _walk_tree[i]; i++) ;
+   for (i--; i >= 0; i--)
+     {
+        snprintf(buf, sizeof (buf), "%s/%s", root, _walk_tree[i]);
+        if (_walk_tree[i][strlen(_walk_tree[i]) - 1] == '/')
+          rmdir(buf);
+        else
+          unlink(buf);
+     }
+   rmdir(root);
+}
+
+static void
+_walk_batch_cb(void *data, const Eina_File_Direct_Info **infos, unsigned int count)
+{
+   Eina_Hash *found = data;
+   unsigned int i;
+
+   fail_if(count == 0);
+   for (i = 0; i < count; i++)
+     {
+        fail_if(infos[i]->path[infos[i]->path_length] != '\0');
+        fail_if(strlen(infos[i]->path + infos[i]->name_start) != infos[i]->name_length);
+        fail_if(!eina_hash_add(found, infos[i]->path + infos[i]->name_start,
+                               (void *)(long)infos[i]->type));
+     }
+}
+
+static Eina_Bool
+_walk_filter_cb(void *data __UNUSED__, const Eina_File_Direct_Info *info)
+{
+   return info->type == EINA_FILE_REG;
+}
+
+static Eina_Bool
+_walk_prune_cb(void *data __UNUSED__, const Eina_File_Direct_Info *info)
+{
+   return !strcmp(info->path + info->name_start, "b");
+}
+
+START_TEST(eina_file_dir_walk_simple)
+{
+   char root[] = "/tmp/eina_test_walk_XXXXXX";
+   Eina_Hash *found;
+
+   eina_init();
+
+   fail_if(!mkdtemp(root));
+   _walk_tree_create(root);
+
+   found = eina_hash_string_superfast_new(NULL);
+   fail_if(!eina_file_dir_walk(root, 4, NULL, NULL, _walk_batch_cb, found));
+   fail_if(eina_hash_population(found) != 10);
+   fail_if((long)eina_hash_find(found, "c") != EINA_FILE_DIR);
+   fail_if((long)eina_hash_find(found, "4") != EINA_FILE_REG);
+   eina_hash_free(found);
+
+   found = eina_hash_string_superfast_new(NULL);
+   fail_if(!eina_file_dir_walk(root, 1, _walk_filter_cb, _walk_prune_cb,
+                               _walk_batch_cb, found));
+   fail_if(eina_hash_population(found) != 4);
+   fail_if(!eina_hash_find(found, "5"));
+   fail_if(eina_hash_find(found, "3"));
+   eina_hash_free(found);
+
+   fail_if(eina_file_dir_walk("/tmp/eina_test_walk_does_not_exist", 0,
+                              NULL, NULL, _walk_batch_cb, NULL));
+
+   _walk_tree_destroy(root);
+
+   eina_shutdown();
+}
+END_TEST
+
+START_TEST(eina_file_dir_walk_symlink)
+{
+   char root[] = "/tmp/eina_test_walk_XXXXXX";
+   char dir[PATH_MAX];
+   char link[PATH_MAX];
+   Eina_Hash *found;
+
+   eina_init();
+
+   fail_if(!mkdtemp(root));
+   snprintf(dir, sizeof (dir), "%s/d", root);
+   snprintf(link, sizeof (link), "%s/loop", dir);
+   fail_if(mkdir(dir, S_IRWXU) != 0);
+   fail_if(symlink("..", link) != 0);
+
+   found = eina_hash_string_superfast_new(NULL);
+   fail_if(!eina_file_dir_walk(root, 4, NULL, NULL, _walk_batch_cb, found));
+   fail_if(eina_hash_population(found) != 2);
+   fail_if((long)eina_hash_find(found, "d") != EINA_FILE_DIR);
+   fail_if((long)eina_hash_find(found, "loop") != EINA_FILE_LNK);
+   eina_hash_free(found);
+
+   unlink(link);
+   rmdir(dir);
+   rmdir(root);
+
+   eina_shutdown();
+}
+END_TEST
+
+START_TEST(eina_file_cache_watch)
+{
+   char path[] = "/tmp/eina_test_watch_XXXXXX";
+   Eina_File *f1, *f2, *f3;
+   int fd;
+   int i;
+
+   eina_init();
+
+   fd = mkstemp(path);
+   fail_if(fd < 0);
+   fail_if(write(fd, "abcd", 4) != 4);
+
+   if (!eina_file_cache_watch_set(EINA_TRUE))
+     {
+        /* no watching support on this system, nothing to check */
+        close(fd);
+        unlink(path);
+        eina_shutdown();
+        return;
+     }
+   fail_if(!eina_file_cache_watch_get());
+
+   f1 = eina_file_open(path, EINA_FALSE);
+   fail_if(!f1);
+   f2 = eina_file_open(path, EINA_FALSE);
+   fail_if(f1 != f2);
+   fail_if(eina_file_size_get(f2) != 4);
+   eina_file_close(f2);
+
+   fail_if(write(fd, "efgh", 4) != 4);
+   close(fd);
+
+   /* change notification is asynchronous */
+   for (i = 0; i < 100; i++)
+     {
+        f3 = eina_file_open(path, EINA_FALSE);
+        fail_if(!f3);
+        if (f3 != f1) break;
+        eina_file_close(f3);
+        usleep(10000);
+     }
+   fail_if(f3 == f1);
+   fail_if(eina_file_size_get(f3) != 8);
+
+   eina_file_close(f3);
+   eina_file_close(f1);
+
+   fail_if(!eina_file_cache_watch_set(EINA_FALSE));
+   fail_if(eina_file_cache_watch_get());
+
+   unlink(path);
+
+   eina_shutdown();
+}
+END_TEST
+
+START_TEST(eina_file_transfer_simple)
+{
+   char src[] = "/tmp/eina_test_transfer_XXXXXX";
+   char dst[] = "/tmp/eina_test_transfer_XXXXXX";
+   const char *content = "The quick brown fox jumps over the lazy dog";
+   char buf[64];
+   Eina_File *f;
+   int fds[2];
+   int fd;
+
+   eina_init();
+
+   fd = mkstemp(src);
+   fail_if(fd < 0);
+   fail_if(write(fd, content, strlen(content)) != (ssize_t) strlen(content));
+   close(fd);
+
+   f = eina_file_open(src, EINA_FALSE);
+   fail_if(!f);
+
+   /* file to file, appended at the current position */
+   fd = mkstemp(dst);
+   fail_if(fd < 0);
+   fail_if(!eina_file_transfer(f, 4, 5, fd));
+   fail_if(!eina_file_transfer(f, 40, 3, fd));
+   fail_if(!eina_file_transfer(f, 0, 0, fd));
+   fail_if(eina_file_transfer(f, 40, 4, fd));
+   fail_if(eina_file_transfer(f, 44, 0, fd));
+   fail_if(lseek(fd, 0, SEEK_SET) != 0);
+   memset(buf, 0, sizeof (buf));
+   fail_if(read(fd, buf, sizeof (buf)) != 8);
+   fail_if(strcmp(buf, "quickdog"));
+   close(fd);
+   unlink(dst);
+
+   /* file to pipe */
+   fail_if(pipe(fds) != 0);
+   fail_if(!eina_file_transfer(f, 10, 5, fds[1]));
+   close(fds[1]);
+   memset(buf, 0, sizeof (buf));
+   fail_if(read(fds[0], buf, sizeof (buf)) != 5);
+   fail_if(strcmp(buf, "brown"));
+   close(fds[0]);
+
+   eina_file_close(f);
+   unlink(src);
+
+   eina_shutdown();
+}
+END_TEST
+
+typedef struct _Async_Read_Check Async_Read_Check;
+struct _Async_Read_Check
+{
+   const char *expected;
+   unsigned int done;
+};
+
+static void
+_eina_file_async_read_cb(void *data, Eina_File *file, void *buffer,
+                         unsigned long int offset, long int result)
+{
+   Async_Read_Check *check = data;
+
+   fail_if(!file);
+   if (offset >= 40)
+     fail_if(result != 3);
+   else
+     fail_if(result != 4);
+   fail_if(memcmp(buffer, check->expected + offset, result));
+   check->done++;
+}
+
+START_TEST(eina_file_async_read_simple)
+{
+   char src[] = "/tmp/eina_test_async_XXXXXX";
+   const char *content = "The quick brown fox jumps over the lazy dog";
+   char bufs[11][4];
+   Async_Read_Check check;
+   Eina_File_Async *async;
+   Eina_File *f;
+   struct timeval tv;
+   fd_set rfds;
+   unsigned int i;
+   int fd;
+
+   eina_init();
+
+   fd = mkstemp(src);
+   fail_if(fd < 0);
+   fail_if(write(fd, content, strlen(content)) != (ssize_t) strlen(content));
+   close(fd);
+
+   f = eina_file_open(src, EINA_FALSE);
+   fail_if(!f);
+
+   check.expected = content;
+   check.done = 0;
+
+   /* smaller than the number of reads, to exercise queueing */
+   async = eina_file_async_new(4);
+   fail_if(!async);
+   fail_if(eina_file_async_fd_get(async) < 0);
+
+   for (i = 0; i < 11; i++)
+     fail_if(!eina_file_async_read(async, f, i * 4, 4, bufs[i],
+                                   _eina_file_async_read_cb, &check));
+   /* the requests hold a reference */
+   eina_file_close(f);
+   fail_if(eina_file_async_pending_get(async) != 11);
+
+   /* wait for at least one completion through the file descriptor */
+   FD_ZERO(&rfds);
+   FD_SET(eina_file_async_fd_get(async), &rfds);
+   tv.tv_sec = 5;
+   tv.tv_usec = 0;
+   fail_if(select(eina_file_async_fd_get(async) + 1, &rfds, NULL, NULL, &tv) != 1);
+   fail_if(eina_file_async_process(async) == 0);
+
+   eina_file_async_wait(async);
+   fail_if(check.done != 11);
+   fail_if(eina_file_async_pending_get(async) != 0);
+
+   eina_file_async_free(async);
+   unlink(src);
+
+   eina_shutdown();
+}
+END_TEST
+#endif
+
 void
 eina_test_file(TCase *tc)
 {
    tcase_add_test(tc, eina_file_split_simple);
+#ifndef _WIN32
+   tcase_add_test(tc, eina_file_dir_walk_simple);
+   tcase_add_test(tc, eina_file_dir_walk_symlink);
+   tcase_add_test(tc, eina_file_cache_watch);
+   tcase_add_test(tc, eina_file_transfer_simple);
+   tcase_add_test(tc, eina_file_async_read_simple);
+#endif
 }
 
@@ -0,0 +1,213 @@
+/* EINA - EFL data type library
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "eina_suite.h"
+#include "Eina.h"
+
+#ifndef _WIN32
+START_TEST(eina_hash_index_string)
+{
+   char filename[] = "/tmp/eina_test_hash_index_XXXXXX";
+   Eina_Hash_Index *idx;
+   Eina_Hash *hash;
+   Eina_File *f;
+   struct stat st;
+   const char *value;
+   char key[32];
+   char expected[32];
+   unsigned int length;
+   mode_t mask;
+   int fd;
+   int i;
+
+   eina_init();
+
+   fd = mkstemp(filename);
+   fail_if(fd < 0);
+   close(fd);
+
+   hash = eina_hash_string_superfast_new(free);
+   fail_if(!hash);
+   for (i = 0; i < 1000; i++)
+     {
+        snprintf(key, sizeof (key), "key-%i", i);
+        snprintf(expected, sizeof (expected), "value %i", i * 7);
+        fail_if(!eina_hash_add(hash, key, strdup(expected)));
+     }
+
+   fail_if(!eina_hash_index_hash_write(filename, hash, NULL, NULL));
+   eina_hash_free(hash);
+
+   mask = umask(0);
+   umask(mask);
+   fail_if(stat(filename, &st));
+   fail_if((st.st_mode & 0777) != (0644 & ~mask));
+
+   f = eina_file_open(filename, EINA_FALSE);
+   fail_if(!f);
+   idx = eina_hash_index_open(f);
+   fail_if(!idx);
+
+   fail_if(eina_hash_index_count(idx) != 1000);
+   for (i = 0; i < 1000; i++)
+     {
+        snprintf(key, sizeof (key), "key-%i", i);
+        snprintf(expected, sizeof (expected), "value %i", i * 7);
+        value = eina_hash_index_find(idx, key, strlen(key) + 1, &length);
+        fail_if(!value);
+        fail_if(length != strlen(expected) + 1);
+        fail_if(strcmp(value, expected));
+     }
+
+   /* not there, and not a prefix match */
+   fail_if(eina_hash_index_find(idx, "key-1000", 9, &length) != NULL);
+   fail_if(length != 0);
+   fail_if(eina_hash_index_find(idx, "key-1", 5, NULL) != NULL);
+
+   eina_hash_index_close(idx);
+   eina_file_close(f);
+   unlink(filename);
+
+   eina_shutdown();
+}
+END_TEST
+
+static const void *
+_eina_hash_index_int_cb(void *data, const Eina_Hash_Tuple *tuple, unsigned int *length)
+{
+   int *calls = data;
+
+   (*calls)++;
+   *length = sizeof (int);
+   return tuple->data;
+}
+
+START_TEST(eina_hash_index_iterator)
+{
+   char filename[] = "/tmp/eina_test_hash_index_XXXXXX";
+   Eina_Hash_Tuple tuples[3];
+   int values[3] = { 1, 2, 3 };
+   Eina_Hash_Index *idx;
+   Eina_Iterator *it;
+   Eina_Array *array;
+   Eina_File *f;
+   const int *value;
+   unsigned int length;
+   int calls = 0;
+   int fd;
+   int i;
+
+   eina_init();
+
+   fd = mkstemp(filename);
+   fail_if(fd < 0);
+   close(fd);
+
+   /* binary keys, the last one duplicating the first */
+   tuples[0].key = "a\0b";
+   tuples[0].key_length = 3;
+   tuples[1].key = "";
+   tuples[1].key_length = 0;
+   tuples[2].key = "a\0b";
+   tuples[2].key_length = 3;
+
+   array = eina_array_new(4);
+   for (i = 0; i < 3; i++)
+     {
+        tuples[i].data = &values[i];
+        eina_array_push(array, &tuples[i]);
+     }
+
+   it = eina_array_iterator_new(array);
+   fail_if(!eina_hash_index_write(filename, it, _eina_hash_index_int_cb, &calls));
+   eina_iterator_free(it);
+   eina_array_free(array);
+   fail_if(calls != 3);
+
+   f = eina_file_open(filename, EINA_FALSE);
+   fail_if(!f);
+   idx = eina_hash_index_open(f);
+   fail_if(!idx);
+
+   fail_if(eina_hash_index_count(idx) != 2);
+
+   value = eina_hash_index_find(idx, "a\0b", 3, &length);
+   fail_if(!value);
+   fail_if(length != sizeof (int));
+   fail_if(((unsigned long) value) % 8);
+   fail_if(*value != 3);
+
+   value = eina_hash_index_find(idx, "", 0, &length);
+   fail_if(!value);
+   fail_if(*value != 2);
+
+   fail_if(eina_hash_index_find(idx, "a", 1, NULL) != NULL);
+
+   eina_hash_index_close(idx);
+   eina_file_close(f);
+   unlink(filename);
+
+   eina_shutdown();
+}
+END_TEST
+
+START_TEST(eina_hash_index_invalid)
+{
+   char filename[] = "/tmp/eina_test_hash_index_XXXXXX";
+   const char *content = "This is not an index, but it is long enough to be one.";
+   Eina_File *f;
+   int fd;
+
+   eina_init();
+
+   fd = mkstemp(filename);
+   fail_if(fd < 0);
+   fail_if(write(fd, content, strlen(content)) != (ssize_t) strlen(content));
+   close(fd);
+
+   f = eina_file_open(filename, EINA_FALSE);
+   fail_if(!f);
+   fail_if(eina_hash_index_open(f) != NULL);
+   eina_file_close(f);
+
+   unlink(filename);
+
+   eina_shutdown();
+}
+END_TEST
+#endif
+
+void
+eina_test_hash_index(TCase *tc)
+{
+#ifndef _WIN32
+   tcase_add_test(tc, eina_hash_index_string);
+   tcase_add_test(tc, eina_hash_index_iterator);
+   tcase_add_test(tc, eina_hash_index_invalid);
+#endif
+}
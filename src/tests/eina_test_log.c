@@ -23,6 +23,11 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <unistd.h>
+
+#ifdef EFL_HAVE_POSIX_THREADS
+# include <pthread.h>
+#endif
 
 #include "eina_suite.h"
 #include "Eina.h"
@@ -411,6 +416,482 @@ START_TEST(eina_log_level_name)
 }
 END_TEST
 
+#ifdef EFL_HAVE_POSIX_THREADS
+#define ASYNC_THREADS 4
+#define ASYNC_MESSAGES 200
+
+struct log_async_ctx {
+   int dom;
+   int next[ASYNC_THREADS + 1];
+   int count;
+   int count_at_critical;
+   Eina_Bool ordered;
+};
+
+static void
+_eina_test_log_async(const Eina_Log_Domain *d __UNUSED__, Eina_Log_Level level, const char *file __UNUSED__, const char *fnc __UNUSED__, int line __UNUSED__, const char *fmt, void *data, va_list args)
+{
+   struct log_async_ctx *ctx = data;
+   va_list cp_args;
+   const char *str;
+   int t, i;
+
+   if (level == EINA_LOG_LEVEL_CRITICAL)
+     {
+        ctx->count_at_critical = ctx->count;
+        return;
+     }
+
+   va_copy(cp_args, args);
+   str = va_arg(cp_args, const char *);
+   va_end(cp_args);
+
+   /* the message was formatted by the caller */
+   if ((strcmp(fmt, "%s") != 0) ||
+       (sscanf(str, "thread %i message %i", &t, &i) != 2) ||
+       (t < 0) || (t > ASYNC_THREADS) ||
+       (ctx->next[t] != i))
+     ctx->ordered = EINA_FALSE;
+   else
+     ctx->next[t]++;
+   ctx->count++;
+}
+
+static void *
+_eina_test_log_async_thread(void *data)
+{
+   struct log_async_ctx *ctx = data;
+   static int n = 0;
+   int t, i;
+
+   t = __sync_add_and_fetch(&n, 1);
+   for (i = 0; i < ASYNC_MESSAGES; i++)
+     EINA_LOG_DOM_WARN(ctx->dom, "thread %i message %i", t, i);
+
+   return NULL;
+}
+
+START_TEST(eina_log_async)
+{
+   struct log_async_ctx ctx;
+   pthread_t threads[ASYNC_THREADS];
+   int i;
+
+   fail_if(!eina_init());
+
+   memset(&ctx, 0, sizeof (ctx));
+   ctx.ordered = EINA_TRUE;
+   ctx.count_at_critical = -1;
+   ctx.dom = eina_log_domain_register("async", NULL);
+   fail_if(ctx.dom < 0);
+   eina_log_domain_level_set("async", EINA_LOG_LEVEL_WARN);
+
+   eina_log_print_cb_set(_eina_test_log_async, &ctx);
+   fail_if(!eina_log_async_set(EINA_TRUE));
+   fail_if(!eina_log_async_get());
+
+   for (i = 0; i < ASYNC_THREADS; i++)
+     fail_if(pthread_create(&threads[i], NULL,
+                            _eina_test_log_async_thread, &ctx) != 0);
+   for (i = 0; i < ASYNC_MESSAGES; i++)
+     EINA_LOG_DOM_WARN(ctx.dom, "thread 0 message %i", i);
+   for (i = 0; i < ASYNC_THREADS; i++)
+     pthread_join(threads[i], NULL);
+
+   /* a critical message flushes what this thread queued before it */
+   EINA_LOG_DOM_CRIT(ctx.dom, "critical");
+   fail_if(ctx.count_at_critical != (ASYNC_THREADS + 1) * ASYNC_MESSAGES);
+
+   eina_log_async_flush();
+   fail_if(!ctx.ordered);
+   fail_if(ctx.count != (ASYNC_THREADS + 1) * ASYNC_MESSAGES);
+
+   fail_if(!eina_log_async_set(EINA_FALSE));
+   fail_if(eina_log_async_get());
+
+   eina_log_print_cb_set(eina_log_print_cb_stderr, NULL);
+   eina_log_domain_unregister(ctx.dom);
+
+   eina_shutdown();
+}
+END_TEST
+#endif
+
+#ifndef _WIN32
+struct log_binary_ctx {
+   int count;
+   Eina_Bool failed;
+};
+
+static const char *_log_binary_expected[] = {
+  "int -42 padded 3.14 string 'hello'",
+  "star [   7] [1.50] null (null) hex ff",
+  "slice [slic] [sli]",
+  "percent 100% long 1234567890123 unsigned 4294967295",
+  "positional b a",
+  "no arguments",
+  "other format"
+};
+
+static Eina_Bool
+_eina_test_log_binary(void *data, const Eina_Log_Binary_Record *record)
+{
+   struct log_binary_ctx *ctx = data;
+
+   if ((ctx->count >= (int)(sizeof(_log_binary_expected) / sizeof(char *))) ||
+       strcmp(record->message, _log_binary_expected[ctx->count]) ||
+       strcmp(record->domain, "binary") ||
+       strcmp(record->fnc, "eina_log_binary") ||
+       (record->level != EINA_LOG_LEVEL_WARN) ||
+       (record->timestamp <= 0.0))
+     ctx->failed = EINA_TRUE;
+   ctx->count++;
+
+   return EINA_TRUE;
+}
+
+START_TEST(eina_log_binary)
+{
+   char filename[] = "/tmp/eina_test_log_binary_XXXXXX";
+   struct log_binary_ctx ctx;
+   Eina_Log_Binary *bin;
+   char dynamic[32];
+   char slice[4] = { 's', 'l', 'i', 'c' };
+   int dom;
+   int fd;
+   int i;
+
+   fail_if(!eina_init());
+
+   fd = mkstemp(filename);
+   fail_if(fd < 0);
+   close(fd);
+
+   bin = eina_log_binary_new(filename);
+   fail_if(!bin);
+
+   dom = eina_log_domain_register("binary", NULL);
+   fail_if(dom < 0);
+   eina_log_domain_level_set("binary", EINA_LOG_LEVEL_WARN);
+   eina_log_print_cb_set(eina_log_print_cb_binary, bin);
+
+   EINA_LOG_DOM_WARN(dom, "int %d padded %4.2f string '%s'", -42, 3.14159, "hello");
+   EINA_LOG_DOM_WARN(dom, "star [%*d] [%.*f] null %s hex %hhx",
+                     4, 7, 2, 1.5, (char *)NULL, 0x1ff);
+   /* not nul terminated, the precision bounds the string */
+   EINA_LOG_DOM_WARN(dom, "slice [%.*s] [%.3s]", 4, slice, slice);
+   EINA_LOG_DOM_WARN(dom, "percent 100%% long %lld unsigned %u",
+                     1234567890123LL, 4294967295U);
+   /* not stored as arguments, formatted at once */
+   EINA_LOG_DOM_WARN(dom, "positional %2$s %1$s", "a", "b");
+
+   /* same call site, its format changing under it */
+   for (i = 0; i < 2; i++)
+     {
+        strcpy(dynamic, i ? "other format" : "no arguments");
+        eina_log_print(dom, EINA_LOG_LEVEL_WARN, __FILE__, __FUNCTION__,
+                       __LINE__, dynamic);
+     }
+
+   eina_log_print_cb_set(eina_log_print_cb_stderr, NULL);
+   eina_log_binary_free(bin);
+
+   memset(&ctx, 0, sizeof (ctx));
+   fail_if(!eina_log_binary_decode(filename, _eina_test_log_binary, &ctx));
+   fail_if(ctx.failed);
+   fail_if(ctx.count != 7);
+
+   unlink(filename);
+   eina_log_domain_unregister(dom);
+
+   eina_shutdown();
+}
+END_TEST
+#endif
+
+#ifndef _WIN32
+static size_t
+_eina_test_log_file_read(const char *filename, char *buf, size_t size)
+{
+   FILE *f;
+   size_t n;
+
+   f = fopen(filename, "r");
+   if (!f) return 0;
+   n = fread(buf, 1, size - 1, f);
+   buf[n] = '\0';
+   fclose(f);
+   return n;
+}
+
+START_TEST(eina_log_buffer)
+{
+   char filename[] = "/tmp/eina_test_log_buffer_XXXXXX";
+   char buf[8192];
+   char *long_message;
+   Eina_Log_Buffer *buffer;
+   FILE *f;
+   int dom;
+   int fd;
+
+   fail_if(!eina_init());
+
+   fd = mkstemp(filename);
+   fail_if(fd < 0);
+   close(fd);
+
+   dom = eina_log_domain_register("buffer", NULL);
+   fail_if(dom < 0);
+   eina_log_domain_level_set("buffer", EINA_LOG_LEVEL_WARN);
+
+   /* one line per message, even longer than the initial buffer */
+   long_message = malloc(2000);
+   fail_if(!long_message);
+   memset(long_message, 'x', 1999);
+   long_message[1999] = '\0';
+
+   f = fopen(filename, "w");
+   fail_if(!f);
+   eina_log_print_cb_set(eina_log_print_cb_file, f);
+   EINA_LOG_DOM_WARN(dom, "short %d", 1);
+   EINA_LOG_DOM_WARN(dom, "long %s", long_message);
+   fclose(f);
+
+   fail_if(_eina_test_log_file_read(filename, buf, sizeof (buf)) == 0);
+   fail_if(strncmp(buf, "buffer<", 7));
+   fail_if(!strstr(buf, " eina_log_buffer() short 1\nbuffer<"));
+   fail_if(!strstr(buf, long_message));
+   fail_if(buf[strlen(buf) - 1] != '\n');
+
+   /* buffered, written when flushed or on critical */
+   unlink(filename);
+   buffer = eina_log_buffer_new(filename, 4096, 0.0);
+   fail_if(!buffer);
+   eina_log_print_cb_set(eina_log_print_cb_buffer, buffer);
+
+   EINA_LOG_DOM_WARN(dom, "pending %d", 1);
+   EINA_LOG_DOM_WARN(dom, "pending %d", 2);
+   fail_if(_eina_test_log_file_read(filename, buf, sizeof (buf)) != 0);
+
+   eina_log_buffer_flush(buffer);
+   fail_if(_eina_test_log_file_read(filename, buf, sizeof (buf)) == 0);
+   fail_if(!strstr(buf, "pending 1\n"));
+   fail_if(!strstr(buf, "pending 2\n"));
+
+   EINA_LOG_DOM_CRIT(dom, "critical");
+   _eina_test_log_file_read(filename, buf, sizeof (buf));
+   fail_if(!strstr(buf, "critical\n"));
+
+   /* filling the buffer writes it */
+   EINA_LOG_DOM_WARN(dom, "long %s", long_message);
+   EINA_LOG_DOM_WARN(dom, "long %s", long_message);
+   EINA_LOG_DOM_WARN(dom, "long %s", long_message);
+   _eina_test_log_file_read(filename, buf, sizeof (buf));
+   fail_if(!strstr(buf, long_message));
+
+   eina_log_print_cb_set(eina_log_print_cb_stderr, NULL);
+   eina_log_buffer_free(buffer);
+
+   fail_if(_eina_test_log_file_read(filename, buf, sizeof (buf)) < 3 * 2000);
+
+   free(long_message);
+   unlink(filename);
+   eina_log_domain_unregister(dom);
+
+   eina_shutdown();
+}
+END_TEST
+#endif
+
+struct log_limit_ctx {
+   int printed;
+   unsigned int resumed;
+};
+
+static void
+_eina_test_log_limit(const Eina_Log_Domain *d __UNUSED__,
+                     Eina_Log_Level level __UNUSED__,
+                     const char *file __UNUSED__,
+                     const char *fnc __UNUSED__,
+                     int line __UNUSED__,
+                     const char *fmt,
+                     void *data,
+                     va_list args)
+{
+   struct log_limit_ctx *ctx = data;
+
+   if (!strcmp(fmt, "%u similar messages were suppressed"))
+     ctx->resumed += va_arg(args, unsigned int);
+   else
+     ctx->printed++;
+}
+
+START_TEST(eina_log_limit)
+{
+   struct log_limit_ctx ctx;
+   unsigned int burst;
+   double interval;
+   int dom;
+   int i;
+
+   fail_if(!eina_init());
+
+   /* pending limits do not change the level of a domain */
+   eina_log_domain_sampling_set("limit", 10);
+   eina_log_domain_rate_limit_set("limit", 3, 1.5);
+   fail_if(eina_log_domain_level_get("limit") != eina_log_level_get());
+   eina_log_domain_rate_limit_get("limit", &burst, &interval);
+   fail_if(burst != 3);
+   fail_if(interval != 1.5);
+   eina_log_domain_rate_limit_set("limit", 0, 0.0);
+
+   dom = eina_log_domain_register("limit", NULL);
+   fail_if(dom < 0);
+   eina_log_domain_level_set("limit", EINA_LOG_LEVEL_WARN);
+   fail_if(eina_log_domain_sampling_get("limit") != 10);
+
+   memset(&ctx, 0, sizeof (ctx));
+   eina_log_print_cb_set(_eina_test_log_limit, &ctx);
+
+   /* one out of ten, for each call site */
+   for (i = 0; i < 100; i++)
+     EINA_LOG_DOM_WARN(dom, "sampled %i", i);
+   fail_if(ctx.printed != 10);
+   for (i = 0; i < 5; i++)
+     EINA_LOG_DOM_WARN(dom, "other site %i", i);
+   fail_if(ctx.printed != 11);
+   fail_if(eina_log_domain_suppressed_get(dom) != 94);
+
+   /* criticals always get through */
+   for (i = 0; i < 3; i++)
+     EINA_LOG_DOM_CRIT(dom, "critical %i", i);
+   fail_if(ctx.printed != 14);
+
+   /* at most 5 messages every 0.2s */
+   eina_log_domain_sampling_set("limit", 0);
+   eina_log_domain_rate_limit_set("limit", 5, 0.2);
+   memset(&ctx, 0, sizeof (ctx));
+   for (i = 0; i < 51; i++)
+     {
+        /* the count of dropped messages comes with the next printed one */
+        if (i == 50)
+          {
+             fail_if(ctx.printed < 5);
+             fail_if(ctx.printed >= 50);
+             usleep(250000);
+          }
+        EINA_LOG_DOM_WARN(dom, "limited %i", i);
+     }
+   fail_if(ctx.resumed == 0);
+   fail_if(ctx.resumed + ctx.printed != 51);
+   fail_if(eina_log_domain_suppressed_get(dom) != 94 + ctx.resumed);
+
+   eina_log_print_cb_set(eina_log_print_cb_stderr, NULL);
+   eina_log_domain_unregister(dom);
+
+   eina_shutdown();
+
+   /* the period does not depend on the locale */
+   setenv("EINA_LOG_LEVELS", "limit_env:3:rate=4/0.25", 1);
+   fail_if(!eina_init());
+   eina_log_domain_rate_limit_get("limit_env", &burst, &interval);
+   fail_if(burst != 4);
+   fail_if(interval != 0.25);
+   unsetenv("EINA_LOG_LEVELS");
+   eina_shutdown();
+}
+END_TEST
+
+#ifdef EINA_LOG_SITES
+static void
+_eina_test_log_site(int dom)
+{
+   EINA_LOG_DOM_DBG(dom, "site message");
+}
+
+static void
+_eina_test_log_site_level(int dom, int level)
+{
+   EINA_LOG(dom, level, "site message of level %i", level);
+}
+
+static Eina_Bool
+_eina_test_log_site_find(const Eina_Log_Site *site, void *data)
+{
+   const Eina_Log_Site **found = data;
+
+   if (strcmp(site->fnc, "_eina_test_log_site"))
+     return EINA_TRUE;
+
+   *found = site;
+   return EINA_FALSE;
+}
+
+START_TEST(eina_log_sites)
+{
+   struct log_limit_ctx ctx;
+   const Eina_Log_Site *site = NULL;
+   char pattern[64];
+   int dom;
+
+   fail_if(!eina_init());
+   EINA_LOG_SITES_REGISTER();
+
+   dom = eina_log_domain_register("sites", NULL);
+   fail_if(dom < 0);
+   eina_log_domain_level_set("sites", EINA_LOG_LEVEL_ERR);
+
+   memset(&ctx, 0, sizeof (ctx));
+   eina_log_print_cb_set(_eina_test_log_limit, &ctx);
+
+   eina_log_sites_foreach(_eina_test_log_site_find, &site);
+   fail_if(!site);
+   fail_if(site->level != EINA_LOG_LEVEL_DBG);
+   fail_if(!strstr(site->file, "eina_test_log.c"));
+
+   _eina_test_log_site(dom);
+   fail_if(ctx.printed != 0);
+   fail_if(site->domain != dom);
+
+   /* enabled whatever the level of the domain */
+   snprintf(pattern, sizeof (pattern), "eina_test_log.c:%i", site->line);
+   fail_if(eina_log_sites_state_set(pattern, EINA_LOG_SITE_ENABLED) != 1);
+   _eina_test_log_site(dom);
+   fail_if(ctx.printed != 1);
+
+   /* back to the level of the domain, which the site follows */
+   fail_if(eina_log_sites_state_set("eina_test_lo?.c", EINA_LOG_SITE_DEFAULT) == 0);
+   _eina_test_log_site(dom);
+   fail_if(ctx.printed != 1);
+   eina_log_domain_level_set("sites", EINA_LOG_LEVEL_DBG);
+   _eina_test_log_site(dom);
+   fail_if(ctx.printed != 2);
+
+   fail_if(eina_log_sites_state_set(pattern, EINA_LOG_SITE_DISABLED) != 1);
+   _eina_test_log_site(dom);
+   fail_if(ctx.printed != 2);
+
+   fail_if(eina_log_sites_state_set("no_such_file.c", EINA_LOG_SITE_ENABLED) != 0);
+   eina_log_sites_state_set(pattern, EINA_LOG_SITE_DEFAULT);
+
+   /* a level only known at runtime is checked again when it changes */
+   eina_log_domain_level_set("sites", EINA_LOG_LEVEL_WARN);
+   _eina_test_log_site_level(dom, EINA_LOG_LEVEL_ERR);
+   fail_if(ctx.printed != 3);
+   _eina_test_log_site_level(dom, EINA_LOG_LEVEL_DBG);
+   fail_if(ctx.printed != 3);
+   _eina_test_log_site_level(dom, EINA_LOG_LEVEL_WARN);
+   fail_if(ctx.printed != 4);
+
+   eina_log_print_cb_set(eina_log_print_cb_stderr, NULL);
+   eina_log_domain_unregister(dom);
+
+   EINA_LOG_SITES_UNREGISTER();
+   eina_shutdown();
+}
+END_TEST
+#endif
+
 void
 eina_test_log(TCase *tc)
 {
@@ -421,4 +902,15 @@ eina_test_log(TCase *tc)
    tcase_add_test(tc, eina_log_level_indexes);
    tcase_add_test(tc, eina_log_customize);
    tcase_add_test(tc, eina_log_level_name);
+   tcase_add_test(tc, eina_log_limit);
+#ifdef EINA_LOG_SITES
+   tcase_add_test(tc, eina_log_sites);
+#endif
+#ifdef EFL_HAVE_POSIX_THREADS
+   tcase_add_test(tc, eina_log_async);
+#endif
+#ifndef _WIN32
+   tcase_add_test(tc, eina_log_binary);
+   tcase_add_test(tc, eina_log_buffer);
+#endif
 }
@@ -224,6 +224,77 @@ START_TEST(eina_model_test_properties)
 }
 END_TEST
 
+START_TEST(eina_model_test_event_batch)
+{
+   unsigned int count_pset = 0, count_pdel = 0, count_cins = 0, count_cchg = 0;
+   Eina_Model *m, *c;
+   Eina_Value inv;
+   Eina_Bool ck;
+   int i;
+
+   eina_init();
+
+   m = eina_model_new(EINA_MODEL_TYPE_GENERIC);
+   fail_unless(m != NULL);
+
+   eina_model_event_callback_add
+     (m, "property,set", _eina_test_model_cb_count, &count_pset);
+   eina_model_event_callback_add
+     (m, "property,deleted", _eina_test_model_cb_count, &count_pdel);
+   eina_model_event_callback_add
+     (m, "child,inserted", _eina_test_model_cb_count, &count_cins);
+   eina_model_event_callback_add
+     (m, "children,changed", _eina_test_model_cb_count, &count_cchg);
+
+   fail_unless(eina_value_setup(&inv, EINA_VALUE_TYPE_INT));
+
+   ck_assert_int_eq(eina_model_event_batch_begin(m), 1);
+   ck_assert_int_eq(eina_model_event_batch_begin(m), 2);
+
+   for (i = 0; i < 3; i++)
+     {
+        fail_unless(eina_value_set(&inv, i));
+        fail_unless(eina_model_property_set(m, "abc", &inv));
+        fail_unless(eina_model_property_set(m, "xyz", &inv));
+        fail_unless(eina_model_property_set(m, "gone", &inv));
+     }
+   fail_unless(eina_model_property_del(m, "gone"));
+
+   for (i = 0; i < 5; i++)
+     {
+        c = eina_model_new(EINA_MODEL_TYPE_GENERIC);
+        fail_unless(c != NULL);
+        fail_unless(eina_model_child_append(m, c) >= 0);
+        eina_model_unref(c);
+     }
+
+   ck_assert_int_eq(eina_model_event_batch_end(m), 1);
+   ck_assert_int_eq(count_pset, 0);
+   ck_assert_int_eq(count_cchg, 0);
+
+   ck_assert_int_eq(eina_model_event_batch_end(m), 0);
+   ck_assert_int_eq(count_pset, 2);
+   ck_assert_int_eq(count_pdel, 1);
+   ck_assert_int_eq(count_cins, 0);
+   ck_assert_int_eq(count_cchg, 1);
+   ck_assert_int_eq(eina_model_child_count(m), 5);
+
+   /* out of a batch callbacks are called right away */
+   fail_unless(eina_model_property_set(m, "abc", &inv));
+   ck_assert_int_eq(count_pset, 3);
+
+   eina_log_print_cb_set(_eina_test_model_check_safety_null, &ck);
+   ck = EINA_FALSE;
+   ck_assert_int_eq(eina_model_event_batch_end(m), -1);
+   fail_unless(ck == EINA_TRUE);
+   eina_log_print_cb_set(eina_log_print_cb_stderr, NULL);
+
+   eina_value_flush(&inv);
+   eina_model_unref(m);
+   eina_shutdown();
+}
+END_TEST
+
 static int
 eina_model_test_children_reverse_cmp(const Eina_Model *a, const Eina_Model *b)
 {
@@ -855,6 +926,71 @@ START_TEST(eina_model_test_struct)
 }
 END_TEST
 
+START_TEST(eina_model_test_struct_index)
+{
+   unsigned int count_pset = 0;
+   Eina_Model *m;
+   struct myst {
+      int i;
+      char c;
+   };
+   const Eina_Value_Struct_Member myst_members[] = {
+        EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_INT, struct myst, i),
+        EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_CHAR, struct myst, c)
+   };
+   const Eina_Value_Struct_Desc myst_desc = {
+     EINA_VALUE_STRUCT_DESC_VERSION,
+     NULL, myst_members, EINA_C_ARRAY_LENGTH(myst_members), sizeof(struct myst)
+   };
+   Eina_Value inv, outv;
+   int i, idx;
+   char c;
+
+   eina_init();
+
+   m = eina_model_struct_new(&myst_desc);
+   fail_unless(m != NULL);
+
+   eina_model_event_callback_add
+     (m, "property,set", _eina_test_model_cb_count, &count_pset);
+
+   idx = eina_value_struct_member_index_get(&myst_desc, "i");
+   ck_assert_int_eq(idx, 0);
+
+   fail_unless(eina_value_setup(&inv, EINA_VALUE_TYPE_INT));
+   fail_unless(eina_value_set(&inv, 1234));
+   fail_unless(eina_model_struct_index_set(m, idx, &inv));
+   eina_value_flush(&inv);
+
+   fail_unless(eina_model_property_get(m, "i", &outv));
+   fail_unless(eina_value_get(&outv, &i));
+   ck_assert_int_eq(i, 1234);
+   eina_value_flush(&outv);
+
+   fail_unless(eina_value_setup(&inv, EINA_VALUE_TYPE_CHAR));
+   fail_unless(eina_value_set(&inv, 33));
+   fail_unless(eina_model_property_set(m, "c", &inv));
+
+   idx = eina_value_struct_member_index_get(&myst_desc, "c");
+   fail_unless(eina_model_struct_index_get(m, idx, &outv));
+   fail_unless(outv.type == EINA_VALUE_TYPE_CHAR);
+   fail_unless(eina_value_get(&outv, &c));
+   ck_assert_int_eq(c, 33);
+   eina_value_flush(&outv);
+
+   /* out of the description, or of another type */
+   fail_if(eina_model_struct_index_get(m, 2, &outv));
+   fail_if(eina_model_struct_index_set(m, 2, &inv));
+   fail_if(eina_model_struct_index_set(m, 0, &inv));
+   eina_value_flush(&inv);
+
+   ck_assert_int_eq(count_pset, 2);
+
+   eina_model_unref(m);
+   eina_shutdown();
+}
+END_TEST
+
 static Eina_Bool
 _struct_complex_members_constructor(Eina_Model *m)
 {
@@ -1282,6 +1418,8 @@ eina_test_model(TCase *tc)
    tcase_add_test(tc, eina_model_test_child_sorted_iterator);
    tcase_add_test(tc, eina_model_test_child_filtered_iterator);
    tcase_add_test(tc, eina_model_test_struct);
+   tcase_add_test(tc, eina_model_test_struct_index);
+   tcase_add_test(tc, eina_model_test_event_batch);
    tcase_add_test(tc, eina_model_test_struct_complex_members);
    tcase_add_test(tc, eina_model_test_inheritance);
    tcase_add_test(tc, eina_model_test_ifaces_load_unload);
@@ -68,8 +68,387 @@ START_TEST(eina_simple_xml_parser_node_dump)
 }
 END_TEST
 
+static Eina_Bool
+_eina_simple_xml_parser_record(void *data, Eina_Simple_XML_Type type, const char *content, unsigned offset __UNUSED__, unsigned length)
+{
+   Eina_Strbuf *buf = data;
+
+   if (type == EINA_SIMPLE_XML_IGNORED) return EINA_TRUE;
+   eina_strbuf_append_printf(buf, "%d:", type);
+   eina_strbuf_append_length(buf, content, length);
+   eina_strbuf_append_char(buf, ';');
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_eina_simple_xml_parser_attribute_record(void *data, const char *key, const char *value)
+{
+   eina_strbuf_append_printf(data, "%s=%s;", key, value);
+   return EINA_TRUE;
+}
+
+/* tokens around the points where the scanners switch from 16 bytes to a
+ * byte at a time, and spaces of all kinds next to other bytes.
+ */
+START_TEST(eina_simple_xml_parser_scan)
+{
+   static const char spaces[] = " \t\n\r\v\f";
+   Eina_Strbuf *doc, *got, *expected, *pad;
+   unsigned int n, i;
+
+   eina_init();
+
+   doc = eina_strbuf_new();
+   got = eina_strbuf_new();
+   expected = eina_strbuf_new();
+   pad = eina_strbuf_new();
+
+   for (n = 0; n < 48; n++)
+     {
+        const char *s, *tag;
+
+        eina_strbuf_reset(pad);
+        for (i = 0; i < n; i++)
+          eina_strbuf_append_char(pad, spaces[i % (sizeof(spaces) - 1)]);
+        s = eina_strbuf_string_get(pad);
+
+        eina_strbuf_reset(doc);
+        eina_strbuf_append_printf
+          (doc, "<root>%st\xc3\xa9xt%s<!-- %.*s- -> -->"
+           "<![CDATA[%s]%.*s] ]>]]><tag%sk=v%.*s o='1'/>%s</root>",
+           s, s, n, "cccccccccccccccccccccccccccccccccccccccccccccccc",
+           s, n, "dddddddddddddddddddddddddddddddddddddddddddddddd",
+           n ? s : " ", n, "vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv", s);
+
+        eina_strbuf_reset(expected);
+        /* stripped, so the cdata starts at ']' */
+        eina_strbuf_append_printf
+          (expected, "%d:root;%d:t\xc3\xa9xt;%d:%.*s- ->;"
+           "%d:]%.*s] ]>;%d:tag%sk=v%.*s o='1';%d:root;",
+           EINA_SIMPLE_XML_OPEN, EINA_SIMPLE_XML_DATA,
+           EINA_SIMPLE_XML_COMMENT,
+           n, "cccccccccccccccccccccccccccccccccccccccccccccccc",
+           EINA_SIMPLE_XML_CDATA,
+           n, "dddddddddddddddddddddddddddddddddddddddddddddddd",
+           EINA_SIMPLE_XML_OPEN_EMPTY, n ? s : " ",
+           n, "vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv",
+           EINA_SIMPLE_XML_CLOSE);
+        eina_strbuf_reset(got);
+        fail_unless(eina_simple_xml_parse(eina_strbuf_string_get(doc),
+                                          eina_strbuf_length_get(doc),
+                                          EINA_TRUE,
+                                          _eina_simple_xml_parser_record,
+                                          got));
+        ck_assert_str_eq(eina_strbuf_string_get(got),
+                         eina_strbuf_string_get(expected));
+
+        tag = strstr(eina_strbuf_string_get(doc), "<tag") + 1;
+        tag = eina_simple_xml_tag_attributes_find(tag, strchr(tag, '/') - tag);
+        fail_unless(tag != NULL);
+        eina_strbuf_reset(got);
+        fail_unless(eina_simple_xml_attributes_parse
+                    (tag, strchr(tag, '/') - tag,
+                     _eina_simple_xml_parser_attribute_record, got));
+        eina_strbuf_reset(expected);
+        eina_strbuf_append_printf
+          (expected, "k=v%.*s;o=1;",
+           n, "vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv");
+        ck_assert_str_eq(eina_strbuf_string_get(got),
+                         eina_strbuf_string_get(expected));
+     }
+
+   /* unterminated comments and cdata, whatever their length */
+   for (n = 0; n < 48; n++)
+     {
+        eina_strbuf_reset(doc);
+        eina_strbuf_append_printf
+          (doc, "<!-- %.*s --", n,
+           "cccccccccccccccccccccccccccccccccccccccccccccccc");
+        fail_if(eina_simple_xml_parse(eina_strbuf_string_get(doc),
+                                      eina_strbuf_length_get(doc),
+                                      EINA_TRUE,
+                                      _eina_simple_xml_parser_record, got));
+
+        eina_strbuf_reset(doc);
+        eina_strbuf_append_printf
+          (doc, "<![CDATA[%.*s]]", n,
+           "dddddddddddddddddddddddddddddddddddddddddddddddd");
+        fail_if(eina_simple_xml_parse(eina_strbuf_string_get(doc),
+                                      eina_strbuf_length_get(doc),
+                                      EINA_TRUE,
+                                      _eina_simple_xml_parser_record, got));
+     }
+
+   eina_strbuf_free(pad);
+   eina_strbuf_free(expected);
+   eina_strbuf_free(got);
+   eina_strbuf_free(doc);
+
+   eina_shutdown();
+}
+END_TEST
+
+static Eina_Bool
+_eina_simple_xml_parser_offset_record(void *data, Eina_Simple_XML_Type type, const char *content, unsigned offset, unsigned length)
+{
+   eina_strbuf_append_printf(data, "%d@%u:", type, offset);
+   eina_strbuf_append_length(data, content, length);
+   eina_strbuf_append_char(data, ';');
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_eina_simple_xml_parser_abort(void *data, Eina_Simple_XML_Type type, const char *content __UNUSED__, unsigned offset __UNUSED__, unsigned length __UNUSED__)
+{
+   int *count = data;
+
+   if (type == EINA_SIMPLE_XML_CLOSE) return EINA_FALSE;
+   (*count)++;
+   return EINA_TRUE;
+}
+
+/* any split of the document gives the tokens of the whole document */
+START_TEST(eina_simple_xml_parser_stream)
+{
+   static const char doc[] =
+     "<?xml version=\"1.0\"?>\n<!DOCTYPE gpx>\n"
+     "<gpx a='1' b=\"two words\">\n  <!-- <foo>bar</foo> -->\n"
+     "  <![CDATA[ <foo>bar</foo> ]]>\n  some text  \n"
+     "  <trkpt lon=\"5.62373\" lat=\"53.01\"/>"
+     "<name>Route</name><broken<x/>\n</gpx>\n  trailing";
+   Eina_Simple_XML_Parser *parser;
+   Eina_Strbuf *got, *expected;
+   unsigned int strip, chunk, i;
+   int count = 0;
+
+   eina_init();
+
+   got = eina_strbuf_new();
+   expected = eina_strbuf_new();
+
+   for (strip = 0; strip < 2; strip++)
+     {
+        eina_strbuf_reset(expected);
+        eina_simple_xml_parse(doc, sizeof(doc) - 1, strip,
+                              _eina_simple_xml_parser_offset_record,
+                              expected);
+
+        for (chunk = 1; chunk < sizeof(doc); chunk++)
+          {
+             eina_strbuf_reset(got);
+             parser = eina_simple_xml_parser_new
+               (strip, _eina_simple_xml_parser_offset_record, got);
+             fail_if(parser == NULL);
+
+             for (i = 0; i < sizeof(doc) - 1; i += chunk)
+               {
+                  unsigned int len = sizeof(doc) - 1 - i;
+
+                  if (len > chunk) len = chunk;
+                  fail_unless(eina_simple_xml_parser_feed(parser, doc + i, len));
+               }
+             fail_unless(eina_simple_xml_parser_end(parser));
+             eina_simple_xml_parser_free(parser);
+
+             ck_assert_str_eq(eina_strbuf_string_get(got),
+                              eina_strbuf_string_get(expected));
+          }
+     }
+
+   /* a tag left open is only an error at the end */
+   parser = eina_simple_xml_parser_new
+     (EINA_TRUE, _eina_simple_xml_parser_offset_record, got);
+   fail_unless(eina_simple_xml_parser_feed(parser, "<a><b c='", 9));
+   fail_if(eina_simple_xml_parser_end(parser));
+   eina_simple_xml_parser_free(parser);
+
+   /* once aborted, it stays so */
+   parser = eina_simple_xml_parser_new
+     (EINA_TRUE, _eina_simple_xml_parser_abort, &count);
+   fail_unless(eina_simple_xml_parser_feed(parser, "<a>text", 7));
+   fail_if(eina_simple_xml_parser_feed(parser, "</a><b>", 7));
+   fail_if(eina_simple_xml_parser_feed(parser, "<c/>", 4));
+   fail_if(eina_simple_xml_parser_end(parser));
+   eina_simple_xml_parser_free(parser);
+   fail_if(count != 3);
+
+   eina_strbuf_free(expected);
+   eina_strbuf_free(got);
+
+   eina_shutdown();
+}
+END_TEST
+
+typedef struct _Eina_Simple_XML_Parser_Hash Eina_Simple_XML_Parser_Hash;
+struct _Eina_Simple_XML_Parser_Hash
+{
+   unsigned int hash;
+   unsigned int count;
+};
+
+static Eina_Bool
+_eina_simple_xml_parser_hash(void *data, Eina_Simple_XML_Type type, const char *content, unsigned offset, unsigned length)
+{
+   Eina_Simple_XML_Parser_Hash *h = data;
+   unsigned int i;
+
+   h->hash = (h->hash * 31 + type) * 31 + offset;
+   for (i = 0; i < length; i++)
+     h->hash = h->hash * 31 + (unsigned char)content[i];
+   h->count++;
+   return EINA_TRUE;
+}
+
+/* big enough to be split between threads */
+START_TEST(eina_simple_xml_parser_parallel)
+{
+   static const char *pieces[] = {
+     "<item id='%u' name=\"a > b\">\n  text %u &amp; more\n</item>\n",
+     "<!-- comment %u <not a tag> -- - -->",
+     "<![CDATA[ cdata %u <x> ] ]> ]]]>",
+     "<?pi %u?><empty%u/>",
+     "<broken %u<ok/>",
+     "   \t\n%u   "
+   };
+   Eina_Simple_XML_Parser_Hash got, expected;
+   Eina_Strbuf *doc;
+   unsigned int i, strip, threads;
+   int count = 0;
+
+   eina_init();
+
+   doc = eina_strbuf_new();
+
+   eina_strbuf_append(doc, "<root>");
+   for (i = 0; eina_strbuf_length_get(doc) < 3 * 1024 * 1024; i++)
+     eina_strbuf_append_printf(doc, pieces[i % (sizeof(pieces) / sizeof(pieces[0]))], i, i);
+   eina_strbuf_append(doc, "</root>");
+
+   for (strip = 0; strip < 2; strip++)
+     {
+        memset(&expected, 0, sizeof(expected));
+        fail_unless(eina_simple_xml_parse(eina_strbuf_string_get(doc),
+                                          eina_strbuf_length_get(doc),
+                                          strip,
+                                          _eina_simple_xml_parser_hash,
+                                          &expected));
+
+        for (threads = 0; threads < 5; threads++)
+          {
+             memset(&got, 0, sizeof(got));
+             fail_unless(eina_simple_xml_parse_parallel
+                         (eina_strbuf_string_get(doc),
+                          eina_strbuf_length_get(doc), strip, threads,
+                          _eina_simple_xml_parser_hash, &got));
+             fail_if(got.count != expected.count);
+             fail_if(got.hash != expected.hash);
+          }
+     }
+
+   /* aborted by the callback while threads are running */
+   fail_if(eina_simple_xml_parse(eina_strbuf_string_get(doc),
+                                 eina_strbuf_length_get(doc), EINA_TRUE,
+                                 _eina_simple_xml_parser_abort, &count));
+   expected.count = count;
+   count = 0;
+   fail_if(eina_simple_xml_parse_parallel(eina_strbuf_string_get(doc),
+                                          eina_strbuf_length_get(doc),
+                                          EINA_TRUE, 3,
+                                          _eina_simple_xml_parser_abort,
+                                          &count));
+   fail_if((unsigned int)count != expected.count);
+
+   /* unterminated at the end */
+   eina_strbuf_append(doc, "<!-- no end ->");
+   fail_if(eina_simple_xml_parse_parallel(eina_strbuf_string_get(doc),
+                                          eina_strbuf_length_get(doc),
+                                          EINA_TRUE, 3,
+                                          _eina_simple_xml_parser_hash,
+                                          &got));
+
+   eina_strbuf_free(doc);
+
+   eina_shutdown();
+}
+END_TEST
+
+START_TEST(eina_simple_xml_parser_arena_load)
+{
+   static const char doc[] =
+     "<?xml version=\"1.0\"?>\n<!DOCTYPE svg>\n"
+     "<svg width='10' height=\"20\">\n  <!-- a comment -->\n"
+     "  <![CDATA[ <foo>bar</foo> ]]>\n"
+     "  <g id=\"g1\"><rect x=\"1\" y=\"2\"/><text>some text</text></g>\n"
+     "</svg>\n";
+   Eina_Simple_XML_Node_Root *root, *arena;
+   Eina_Simple_XML_Node_Tag *tag;
+   Eina_Simple_XML_Attribute *attr;
+   char *expected, *got;
+   unsigned int i;
+
+   eina_init();
+
+   root = eina_simple_xml_node_load(doc, sizeof(doc) - 1, EINA_TRUE);
+   fail_if(root == NULL);
+   expected = eina_simple_xml_node_dump(&root->base, "  ");
+   fail_if(expected == NULL);
+   eina_simple_xml_node_root_free(root);
+
+   arena = eina_simple_xml_node_arena_load(doc, sizeof(doc) - 1, EINA_TRUE);
+   fail_if(arena == NULL);
+   got = eina_simple_xml_node_dump(&arena->base, "  ");
+   ck_assert_str_eq(got, expected);
+   free(got);
+
+   tag = (Eina_Simple_XML_Node_Tag *)EINA_INLIST_CONTAINER_GET
+     (arena->children->next->next, Eina_Simple_XML_Node);
+   fail_if(tag->base.type != EINA_SIMPLE_XML_NODE_TAG);
+   fail_if(tag->base.parent != arena);
+   ck_assert_str_eq(tag->name, "svg");
+   attr = EINA_INLIST_CONTAINER_GET(tag->attributes->next,
+                                    Eina_Simple_XML_Attribute);
+   fail_if(attr->parent != tag);
+   ck_assert_str_eq(attr->key, "height");
+   ck_assert_str_eq(attr->value, "20");
+   eina_simple_xml_node_root_free(arena);
+
+   /* more nodes than the first block holds */
+   {
+      Eina_Strbuf *big = eina_strbuf_new();
+
+      eina_strbuf_append(big, "<a>");
+      for (i = 0; i < 10000; i++)
+        eina_strbuf_append_printf(big, "<b i='%u'>%u</b>", i, i);
+      eina_strbuf_append(big, "</a>");
+
+      root = eina_simple_xml_node_load(eina_strbuf_string_get(big),
+                                       eina_strbuf_length_get(big),
+                                       EINA_FALSE);
+      arena = eina_simple_xml_node_arena_load(eina_strbuf_string_get(big),
+                                              eina_strbuf_length_get(big),
+                                              EINA_FALSE);
+      free(expected);
+      expected = eina_simple_xml_node_dump(&root->base, NULL);
+      got = eina_simple_xml_node_dump(&arena->base, NULL);
+      ck_assert_str_eq(got, expected);
+      free(got);
+      eina_simple_xml_node_root_free(arena);
+      eina_simple_xml_node_root_free(root);
+      eina_strbuf_free(big);
+   }
+
+   free(expected);
+
+   eina_shutdown();
+}
+END_TEST
+
 void
 eina_test_simple_xml_parser(TCase *tc)
 {
    tcase_add_test(tc, eina_simple_xml_parser_node_dump);
+   tcase_add_test(tc, eina_simple_xml_parser_scan);
+   tcase_add_test(tc, eina_simple_xml_parser_stream);
+   tcase_add_test(tc, eina_simple_xml_parser_arena_load);
+   tcase_add_test(tc, eina_simple_xml_parser_parallel);
 }
@@ -20,7 +20,13 @@
 # include "config.h"
 #endif
 
+#include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+
+#ifdef EFL_HAVE_POSIX_THREADS
+# include <pthread.h>
+#endif
 
 #include "eina_suite.h"
 #include "Eina.h"
@@ -176,9 +182,567 @@ START_TEST(eina_test_tiler_all)
 }
 END_TEST
 
+#define TILER_MASK_W 64
+#define TILER_MASK_H 48
+
+static void
+_tiler_mask_set(unsigned char *mask, const Eina_Rectangle *r, unsigned char v)
+{
+   int x, y;
+
+   for (y = r->y; y < r->y + r->h; y++)
+     for (x = r->x; x < r->x + r->w; x++)
+       if ((x >= 0) && (y >= 0) && (x < TILER_MASK_W) && (y < TILER_MASK_H))
+         mask[y * TILER_MASK_W + x] = v;
+}
+
+static void
+_tiler_mask_get(Eina_Tiler *tl, unsigned char *mask, Eina_Bool overlap)
+{
+   Eina_Iterator *it;
+   Eina_Rectangle *rp;
+   int x, y;
+
+   memset(mask, 0, TILER_MASK_W * TILER_MASK_H);
+   it = eina_tiler_iterator_new(tl);
+   fail_if(!it);
+   EINA_ITERATOR_FOREACH(it, rp)
+     {
+        fail_if(rp->w <= 0 || rp->h <= 0);
+        fail_if(rp->x < 0 || rp->x + rp->w > TILER_MASK_W);
+        fail_if(rp->y < 0 || rp->y + rp->h > TILER_MASK_H);
+        for (y = rp->y; y < rp->y + rp->h; y++)
+          for (x = rp->x; x < rp->x + rp->w; x++)
+            {
+               fail_if(!overlap && mask[y * TILER_MASK_W + x]);
+               mask[y * TILER_MASK_W + x] = 1;
+            }
+     }
+   eina_iterator_free(it);
+}
+
+START_TEST(eina_test_tiler_region)
+{
+   unsigned char expected[TILER_MASK_W * TILER_MASK_H];
+   unsigned char got[TILER_MASK_W * TILER_MASK_H];
+   unsigned char split[TILER_MASK_W * TILER_MASK_H];
+   struct test_rect bands[] =
+   {{0, 0, 10, 10, 20, 10, 0},
+    {0, 0, 10, 20, 30, 10, 0},
+    {0, 0, 20, 30, 20, 10, 0}};
+   Eina_Tiler *tl, *ts;
+   Eina_Iterator *it;
+   Eina_Rectangle *rp;
+   Eina_Rectangle r;
+   unsigned int i;
+   int j;
+
+   eina_init();
+
+   tl = eina_tiler_new(TILER_MASK_W, TILER_MASK_H);
+   fail_if(eina_tiler_algorithm_get(tl) != EINA_TILER_ALGORITHM_SPLITTER);
+   fail_if(!eina_tiler_algorithm_set(tl, EINA_TILER_ALGORITHM_REGION));
+   fail_if(eina_tiler_algorithm_get(tl) != EINA_TILER_ALGORITHM_REGION);
+
+   EINA_RECTANGLE_SET(&r, 10, 10, 20, 20);
+   fail_if(!eina_tiler_rect_add(tl, &r));
+   EINA_RECTANGLE_SET(&r, 20, 20, 20, 20);
+   fail_if(!eina_tiler_rect_add(tl, &r));
+   EINA_RECTANGLE_SET(&r, 12, 12, 4, 4);
+   fail_if(!eina_tiler_rect_add(tl, &r));
+
+   i = 0;
+   it = eina_tiler_iterator_new(tl);
+   EINA_ITERATOR_FOREACH(it, rp)
+     {
+        fail_if(i >= sizeof (bands) / sizeof (bands[0]));
+        fail_if(rp->x != bands[i].x || rp->y != bands[i].y ||
+                rp->w != bands[i].w || rp->h != bands[i].h);
+        i++;
+     }
+   fail_if(eina_iterator_container_get(it) != tl);
+   eina_iterator_free(it);
+   fail_if(i != sizeof (bands) / sizeof (bands[0]));
+
+   /* bands with the same boxes are merged back */
+   EINA_RECTANGLE_SET(&r, 30, 10, 10, 10);
+   fail_if(!eina_tiler_rect_add(tl, &r));
+   EINA_RECTANGLE_SET(&r, 10, 30, 10, 10);
+   fail_if(!eina_tiler_rect_add(tl, &r));
+   it = eina_tiler_iterator_new(tl);
+   fail_if(!eina_iterator_next(it, (void **)&rp));
+   fail_if(rp->x != 10 || rp->y != 10 || rp->w != 30 || rp->h != 30);
+   fail_if(eina_iterator_next(it, (void **)&rp));
+   eina_iterator_free(it);
+
+   eina_tiler_clear(tl);
+   it = eina_tiler_iterator_new(tl);
+   fail_if(eina_iterator_next(it, (void **)&rp));
+   eina_iterator_free(it);
+
+   /* random additions and removals against a pixel mask, the splitter must
+    * cover at least the same area */
+   ts = eina_tiler_new(TILER_MASK_W, TILER_MASK_H);
+   memset(expected, 0, sizeof (expected));
+   srand(42);
+   for (i = 0; i < 300; i++)
+     {
+        EINA_RECTANGLE_SET(&r,
+                           rand() % (TILER_MASK_W + 8) - 4,
+                           rand() % (TILER_MASK_H + 8) - 4,
+                           rand() % 24 + 1, rand() % 24 + 1);
+        if (rand() % 3)
+          {
+             eina_tiler_rect_add(tl, &r);
+             eina_tiler_rect_add(ts, &r);
+             _tiler_mask_set(expected, &r, 1);
+          }
+        else
+          {
+             eina_tiler_rect_del(tl, &r);
+             eina_tiler_rect_del(ts, &r);
+             _tiler_mask_set(expected, &r, 0);
+          }
+
+        _tiler_mask_get(tl, got, EINA_FALSE);
+        fail_if(memcmp(expected, got, sizeof (expected)));
+
+        if (i % 10) continue;
+        _tiler_mask_get(ts, split, EINA_TRUE);
+        for (j = 0; j < TILER_MASK_W * TILER_MASK_H; j++)
+          fail_if(got[j] && !split[j]);
+     }
+
+   /* many additions between two looks at the result */
+   for (i = 0; i < 5000; i++)
+     {
+        EINA_RECTANGLE_SET(&r, rand() % TILER_MASK_W, rand() % TILER_MASK_H,
+                           rand() % 4 + 1, rand() % 4 + 1);
+        fail_if(!eina_tiler_rect_add(tl, &r));
+        _tiler_mask_set(expected, &r, 1);
+     }
+   _tiler_mask_get(tl, got, EINA_FALSE);
+   fail_if(memcmp(expected, got, sizeof (expected)));
+
+   /* switching algorithm drops the rectangles */
+   fail_if(!eina_tiler_algorithm_set(tl, EINA_TILER_ALGORITHM_SPLITTER));
+   it = eina_tiler_iterator_new(tl);
+   fail_if(eina_iterator_next(it, (void **)&rp));
+   eina_iterator_free(it);
+
+   eina_tiler_free(ts);
+   eina_tiler_free(tl);
+
+   eina_shutdown();
+}
+END_TEST
+
+static Eina_Tiler *
+_tiler_random_new(Eina_Tiler_Algorithm algorithm)
+{
+   Eina_Tiler *tl;
+   Eina_Rectangle r;
+   int i;
+
+   tl = eina_tiler_new(TILER_MASK_W, TILER_MASK_H);
+   eina_tiler_tile_size_set(tl, 8, 8);
+   fail_if(!eina_tiler_algorithm_set(tl, algorithm));
+   for (i = 0; i < 12; i++)
+     {
+        EINA_RECTANGLE_SET(&r, rand() % TILER_MASK_W, rand() % TILER_MASK_H,
+                           rand() % 24 + 1, rand() % 24 + 1);
+        eina_tiler_rect_add(tl, &r);
+     }
+
+   return tl;
+}
+
+START_TEST(eina_test_tiler_operations)
+{
+   unsigned char ma[TILER_MASK_W * TILER_MASK_H];
+   unsigned char mb[TILER_MASK_W * TILER_MASK_H];
+   unsigned char expected[TILER_MASK_W * TILER_MASK_H];
+   unsigned char got[TILER_MASK_W * TILER_MASK_H];
+   Eina_Tiler *a, *b;
+   Eina_Rectangle r;
+   int algo, i, op, x, y;
+
+   eina_init();
+
+   srand(7);
+   for (algo = 0; algo < 3; algo++)
+     for (i = 0; i < 30; i++)
+       for (op = 0; op < 5; op++)
+         {
+            Eina_Bool exact;
+
+            a = _tiler_random_new(algo);
+            b = _tiler_random_new((algo + i) % 3);
+            _tiler_mask_get(a, ma, EINA_TRUE);
+            _tiler_mask_get(b, mb, EINA_TRUE);
+
+            exact = (algo == EINA_TILER_ALGORITHM_REGION) ||
+              ((algo == EINA_TILER_ALGORITHM_TILES) && (op < 3) &&
+               (eina_tiler_algorithm_get(b) == EINA_TILER_ALGORITHM_TILES));
+
+            switch (op)
+              {
+               case 0:
+                  fail_if(!eina_tiler_union(a, b));
+                  for (x = 0; x < TILER_MASK_W * TILER_MASK_H; x++)
+                    expected[x] = ma[x] | mb[x];
+                  break;
+               case 1:
+                  fail_if(!eina_tiler_subtract(a, b));
+                  for (x = 0; x < TILER_MASK_W * TILER_MASK_H; x++)
+                    expected[x] = ma[x] & !mb[x];
+                  break;
+               case 2:
+                  fail_if(!eina_tiler_intersect(a, b));
+                  for (x = 0; x < TILER_MASK_W * TILER_MASK_H; x++)
+                    expected[x] = ma[x] & mb[x];
+                  break;
+               case 3:
+                  r.x = rand() % 41 - 20;
+                  r.y = rand() % 41 - 20;
+                  fail_if(!eina_tiler_translate(a, r.x, r.y));
+                  memset(expected, 0, sizeof (expected));
+                  for (y = 0; y < TILER_MASK_H; y++)
+                    for (x = 0; x < TILER_MASK_W; x++)
+                      if (x - r.x >= 0 && x - r.x < TILER_MASK_W &&
+                          y - r.y >= 0 && y - r.y < TILER_MASK_H)
+                        expected[y * TILER_MASK_W + x] =
+                          ma[(y - r.y) * TILER_MASK_W + x - r.x];
+                  break;
+               case 4:
+                  EINA_RECTANGLE_SET(&r, rand() % TILER_MASK_W - 8,
+                                     rand() % TILER_MASK_H - 8,
+                                     rand() % 48, rand() % 48);
+                  fail_if(!eina_tiler_clip(a, &r));
+                  memset(expected, 0, sizeof (expected));
+                  _tiler_mask_set(expected, &r, 1);
+                  for (x = 0; x < TILER_MASK_W * TILER_MASK_H; x++)
+                    expected[x] &= ma[x];
+                  break;
+              }
+
+            _tiler_mask_get(a, got, algo == EINA_TILER_ALGORITHM_SPLITTER);
+            if (exact)
+              fail_if(memcmp(expected, got, sizeof (got)));
+            else
+              for (x = 0; x < TILER_MASK_W * TILER_MASK_H; x++)
+                fail_if(expected[x] && !got[x]);
+
+            eina_tiler_free(b);
+            eina_tiler_free(a);
+         }
+
+   /* a tiler with itself */
+   a = _tiler_random_new(EINA_TILER_ALGORITHM_REGION);
+   _tiler_mask_get(a, ma, EINA_FALSE);
+   fail_if(!eina_tiler_union(a, a));
+   _tiler_mask_get(a, got, EINA_FALSE);
+   fail_if(memcmp(ma, got, sizeof (got)));
+   fail_if(!eina_tiler_subtract(a, a));
+   _tiler_mask_get(a, got, EINA_FALSE);
+   memset(expected, 0, sizeof (expected));
+   fail_if(memcmp(expected, got, sizeof (got)));
+   eina_tiler_free(a);
+
+   eina_shutdown();
+}
+END_TEST
+
+START_TEST(eina_test_tiler_batch)
+{
+   unsigned char expected[TILER_MASK_W * TILER_MASK_H];
+   unsigned char got[TILER_MASK_W * TILER_MASK_H];
+   Eina_Rectangle add[200], del[50];
+   Eina_Tiler *one, *batch;
+   int algo, i, j;
+
+   eina_init();
+
+   srand(11);
+   for (algo = 0; algo < 3; algo++)
+     for (i = 0; i < 10; i++)
+       {
+          for (j = 0; j < 200; j++)
+            {
+               EINA_RECTANGLE_SET(&add[j],
+                                  rand() % (TILER_MASK_W + 16) - 8,
+                                  rand() % (TILER_MASK_H + 16) - 8,
+                                  rand() % 20 - 2, rand() % 20 - 2);
+            }
+          for (j = 0; j < 50; j++)
+            {
+               EINA_RECTANGLE_SET(&del[j],
+                                  rand() % TILER_MASK_W, rand() % TILER_MASK_H,
+                                  rand() % 16 + 1, rand() % 16 + 1);
+            }
+
+          /* rectangles given one by one, with the exact area for the
+           * splitter */
+          one = eina_tiler_new(TILER_MASK_W, TILER_MASK_H);
+          eina_tiler_tile_size_set(one, 8, 8);
+          fail_if(!eina_tiler_algorithm_set(one, algo ? algo : EINA_TILER_ALGORITHM_REGION));
+          for (j = 0; j < 200; j++)
+            eina_tiler_rect_add(one, &add[j]);
+          for (j = 0; j < 50; j++)
+            eina_tiler_rect_del(one, &del[j]);
+
+          batch = eina_tiler_new(TILER_MASK_W, TILER_MASK_H);
+          eina_tiler_tile_size_set(batch, 8, 8);
+          fail_if(!eina_tiler_algorithm_set(batch, algo));
+          fail_if(!eina_tiler_rects_add(batch, add, 200));
+          fail_if(!eina_tiler_rects_add(batch, NULL, 0));
+          fail_if(!eina_tiler_rects_del(batch, del, 50));
+
+          _tiler_mask_get(one, expected, EINA_FALSE);
+          _tiler_mask_get(batch, got, algo == EINA_TILER_ALGORITHM_SPLITTER);
+          if (algo == EINA_TILER_ALGORITHM_SPLITTER)
+            {
+               for (j = 0; j < TILER_MASK_W * TILER_MASK_H; j++)
+                 fail_if(expected[j] && !got[j]);
+            }
+          else
+            fail_if(memcmp(expected, got, sizeof (got)));
+
+          eina_tiler_free(batch);
+          eina_tiler_free(one);
+       }
+
+   eina_shutdown();
+}
+END_TEST
+
+#ifdef EFL_HAVE_POSIX_THREADS
+#define TILER_THREADS 4
+
+typedef struct _Tiler_Thread Tiler_Thread;
+struct _Tiler_Thread
+{
+   unsigned int seed;
+   unsigned char mask[TILER_MASK_W * TILER_MASK_H];
+};
+
+static void *
+_tiler_thread_run(void *data)
+{
+   Tiler_Thread *tt = data;
+   Eina_Tiler *tl;
+   Eina_Rectangle r;
+   unsigned int seed = tt->seed;
+   int i;
+
+   tl = eina_tiler_new(TILER_MASK_W, TILER_MASK_H);
+   for (i = 0; i < 2000; i++)
+     {
+        EINA_RECTANGLE_SET(&r, rand_r(&seed) % TILER_MASK_W,
+                           rand_r(&seed) % TILER_MASK_H,
+                           rand_r(&seed) % 16 + 1, rand_r(&seed) % 16 + 1);
+        if (rand_r(&seed) % 3)
+          eina_tiler_rect_add(tl, &r);
+        else
+          eina_tiler_rect_del(tl, &r);
+
+        /* the nodes go back and forth between the list and the pool */
+        if (!(i % 100))
+          {
+             _tiler_mask_get(tl, tt->mask, EINA_TRUE);
+             eina_tiler_clear(tl);
+          }
+     }
+   _tiler_mask_get(tl, tt->mask, EINA_TRUE);
+   eina_tiler_free(tl);
+
+   return NULL;
+}
+
+START_TEST(eina_test_tiler_threads)
+{
+   Tiler_Thread tt[TILER_THREADS];
+   Tiler_Thread ref;
+   pthread_t threads[TILER_THREADS];
+   int i;
+
+   eina_init();
+
+   for (i = 0; i < TILER_THREADS; i++)
+     {
+        tt[i].seed = i + 1;
+        fail_if(pthread_create(&threads[i], NULL, _tiler_thread_run, &tt[i]));
+     }
+   for (i = 0; i < TILER_THREADS; i++)
+     pthread_join(threads[i], NULL);
+
+   /* each tiler gives what it gives alone */
+   for (i = 0; i < TILER_THREADS; i++)
+     {
+        ref.seed = i + 1;
+        _tiler_thread_run(&ref);
+        fail_if(memcmp(ref.mask, tt[i].mask, sizeof (ref.mask)));
+     }
+
+   eina_shutdown();
+}
+END_TEST
+#endif
+
+#define TILES_W 2000
+#define TILES_H 100
+#define TILES_SIZE 8
+#define TILES_COLS (TILES_W / TILES_SIZE)
+#define TILES_ROWS ((TILES_H + TILES_SIZE - 1) / TILES_SIZE)
+
+static void
+_tiler_tiles_check(Eina_Tiler *tl, const unsigned char *expected)
+{
+   unsigned char got[TILES_COLS * TILES_ROWS];
+   Eina_Iterator *it;
+   Eina_Rectangle *rp;
+   int x, y;
+
+   memset(got, 0, sizeof (got));
+   it = eina_tiler_iterator_new(tl);
+   fail_if(!it);
+   EINA_ITERATOR_FOREACH(it, rp)
+     {
+        fail_if(rp->w <= 0 || rp->h <= 0);
+        fail_if(rp->x % TILES_SIZE || rp->y % TILES_SIZE);
+        fail_if(rp->x + rp->w > TILES_W || rp->y + rp->h > TILES_H);
+        fail_if(rp->w % TILES_SIZE && rp->x + rp->w != TILES_W);
+        fail_if(rp->h % TILES_SIZE && rp->y + rp->h != TILES_H);
+        for (y = rp->y / TILES_SIZE; y * TILES_SIZE < rp->y + rp->h; y++)
+          for (x = rp->x / TILES_SIZE; x * TILES_SIZE < rp->x + rp->w; x++)
+            {
+               fail_if(got[y * TILES_COLS + x]);
+               got[y * TILES_COLS + x] = 1;
+            }
+     }
+   eina_iterator_free(it);
+
+   fail_if(memcmp(expected, got, sizeof (got)));
+}
+
+START_TEST(eina_test_tiler_tiles)
+{
+   unsigned char expected[TILES_COLS * TILES_ROWS];
+   Eina_Tiler *tl;
+   Eina_Iterator *it;
+   Eina_Rectangle *rp;
+   Eina_Rectangle r;
+   int i, x, y;
+
+   eina_init();
+
+   tl = eina_tiler_new(100, 70);
+   eina_tiler_tile_size_set(tl, 16, 16);
+   fail_if(!eina_tiler_algorithm_set(tl, EINA_TILER_ALGORITHM_TILES));
+
+   EINA_RECTANGLE_SET(&r, 20, 20, 10, 10);
+   fail_if(!eina_tiler_rect_add(tl, &r));
+   EINA_RECTANGLE_SET(&r, 40, 20, 30, 1);
+   fail_if(!eina_tiler_rect_add(tl, &r));
+   EINA_RECTANGLE_SET(&r, 90, 60, 20, 20);
+   fail_if(!eina_tiler_rect_add(tl, &r));
+
+   it = eina_tiler_iterator_new(tl);
+   fail_if(!eina_iterator_next(it, (void **)&rp));
+   fail_if(rp->x != 16 || rp->y != 16 || rp->w != 64 || rp->h != 16);
+   fail_if(!eina_iterator_next(it, (void **)&rp));
+   fail_if(rp->x != 80 || rp->y != 48 || rp->w != 20 || rp->h != 22);
+   fail_if(eina_iterator_next(it, (void **)&rp));
+   fail_if(eina_iterator_container_get(it) != tl);
+   eina_iterator_free(it);
+
+   /* only the tiles fully covered are removed */
+   EINA_RECTANGLE_SET(&r, 20, 0, 60, 40);
+   eina_tiler_rect_del(tl, &r);
+   EINA_RECTANGLE_SET(&r, 96, 64, 4, 6);
+   eina_tiler_rect_del(tl, &r);
+
+   it = eina_tiler_iterator_new(tl);
+   fail_if(!eina_iterator_next(it, (void **)&rp));
+   fail_if(rp->x != 16 || rp->y != 16 || rp->w != 16 || rp->h != 16);
+   fail_if(!eina_iterator_next(it, (void **)&rp));
+   fail_if(rp->x != 80 || rp->y != 48 || rp->w != 20 || rp->h != 16);
+   fail_if(!eina_iterator_next(it, (void **)&rp));
+   fail_if(rp->x != 80 || rp->y != 64 || rp->w != 16 || rp->h != 6);
+   fail_if(eina_iterator_next(it, (void **)&rp));
+   eina_iterator_free(it);
+
+   /* a new tile size drops the tiles */
+   eina_tiler_tile_size_set(tl, 32, 32);
+   it = eina_tiler_iterator_new(tl);
+   fail_if(eina_iterator_next(it, (void **)&rp));
+   eina_iterator_free(it);
+   eina_tiler_free(tl);
+
+   /* rows of several words, against a mask of tiles */
+   tl = eina_tiler_new(TILES_W, TILES_H);
+   fail_if(!eina_tiler_algorithm_set(tl, EINA_TILER_ALGORITHM_TILES));
+   eina_tiler_tile_size_set(tl, TILES_SIZE, TILES_SIZE);
+   fail_if(eina_tiler_algorithm_get(tl) != EINA_TILER_ALGORITHM_TILES);
+
+   memset(expected, 0, sizeof (expected));
+   srand(42);
+   for (i = 0; i < 300; i++)
+     {
+        int x1, y1, x2, y2;
+        unsigned char v;
+
+        EINA_RECTANGLE_SET(&r, rand() % TILES_W, rand() % TILES_H,
+                           rand() % 600 + 1, rand() % 40 + 1);
+        if (r.x + r.w > TILES_W) r.w = TILES_W - r.x;
+        if (r.y + r.h > TILES_H) r.h = TILES_H - r.y;
+
+        if (rand() % 3)
+          {
+             fail_if(!eina_tiler_rect_add(tl, &r));
+             v = 1;
+             x1 = r.x / TILES_SIZE;
+             y1 = r.y / TILES_SIZE;
+             x2 = (r.x + r.w + TILES_SIZE - 1) / TILES_SIZE;
+             y2 = (r.y + r.h + TILES_SIZE - 1) / TILES_SIZE;
+          }
+        else
+          {
+             eina_tiler_rect_del(tl, &r);
+             v = 0;
+             x1 = (r.x + TILES_SIZE - 1) / TILES_SIZE;
+             y1 = (r.y + TILES_SIZE - 1) / TILES_SIZE;
+             x2 = (r.x + r.w) / TILES_SIZE;
+             y2 = (r.y + r.h == TILES_H) ? TILES_ROWS : (r.y + r.h) / TILES_SIZE;
+          }
+
+        for (y = y1; y < y2; y++)
+          for (x = x1; x < x2; x++)
+            expected[y * TILES_COLS + x] = v;
+
+        _tiler_tiles_check(tl, expected);
+     }
+
+   eina_tiler_clear(tl);
+   memset(expected, 0, sizeof (expected));
+   _tiler_tiles_check(tl, expected);
+
+   eina_tiler_free(tl);
+
+   eina_shutdown();
+}
+END_TEST
+
 void
 eina_test_tiler(TCase *tc)
 {
    tcase_add_test(tc, eina_test_tile_grid_slicer_iterator);
    tcase_add_test(tc, eina_test_tiler_all);
+   tcase_add_test(tc, eina_test_tiler_region);
+   tcase_add_test(tc, eina_test_tiler_tiles);
+   tcase_add_test(tc, eina_test_tiler_operations);
+   tcase_add_test(tc, eina_test_tiler_batch);
+#ifdef EFL_HAVE_POSIX_THREADS
+   tcase_add_test(tc, eina_test_tiler_threads);
+#endif
 }
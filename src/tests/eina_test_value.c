@@ -1156,6 +1156,90 @@ START_TEST(eina_value_test_array)
 }
 END_TEST
 
+START_TEST(eina_value_test_array_data)
+{
+   Eina_Value *value;
+   const char *strs[] = { "10", "-20", "30" };
+   const char *s;
+   int ints[1000];
+   double doubles[1000];
+   unsigned char uchars[3];
+   const int *members;
+   int x;
+   unsigned int i, count;
+
+   eina_init();
+
+   for (i = 0; i < 1000; i++)
+     ints[i] = (int)i - 500;
+
+   value = eina_value_array_new(EINA_VALUE_TYPE_INT, 0);
+   fail_unless(value != NULL);
+
+   fail_unless(eina_value_array_data_get(value, &count) == NULL);
+   fail_unless(count == 0);
+
+   fail_unless(eina_value_array_append(value, 42));
+   fail_unless(eina_value_array_data_append(value, ints, 1000));
+   fail_unless(eina_value_array_data_append(value, NULL, 0));
+   fail_unless(eina_value_array_count(value) == 1001);
+
+   members = eina_value_array_data_get(value, &count);
+   fail_unless(members != NULL);
+   fail_unless(count == 1001);
+   fail_unless(members[0] == 42);
+   for (i = 0; i < 1000; i++)
+     fail_unless(members[i + 1] == ints[i]);
+
+   fail_unless(eina_value_array_get(value, 1000, &x));
+   fail_unless(x == 499);
+
+   fail_unless(eina_value_array_data_convert(value, 1, 1000,
+                                             EINA_VALUE_TYPE_DOUBLE, doubles));
+   for (i = 0; i < 1000; i++)
+     fail_unless(CHECK_FP(doubles[i], (double)ints[i]));
+
+   /* out of range for uchar, nothing is written */
+   memset(uchars, 0xaa, sizeof(uchars));
+   fail_if(eina_value_array_data_convert(value, 499, 3,
+                                         EINA_VALUE_TYPE_UCHAR, uchars));
+   fail_unless(eina_error_get() == EINA_ERROR_VALUE_FAILED);
+   fail_unless(uchars[0] == 0xaa && uchars[1] == 0xaa && uchars[2] == 0xaa);
+
+   fail_unless(eina_value_array_data_convert(value, 501, 3,
+                                             EINA_VALUE_TYPE_UCHAR, uchars));
+   fail_unless(uchars[0] == 0 && uchars[1] == 1 && uchars[2] == 2);
+
+   /* ranges */
+   fail_if(eina_value_array_data_convert(value, 1000, 2,
+                                         EINA_VALUE_TYPE_DOUBLE, doubles));
+   fail_unless(eina_value_array_data_convert(value, 1001, 0,
+                                             EINA_VALUE_TYPE_DOUBLE, doubles));
+   fail_if(eina_value_array_data_convert(value, 0, 1,
+                                         EINA_VALUE_TYPE_STRING, &s));
+   eina_value_free(value);
+
+   /* members that are not numbers go through their type */
+   value = eina_value_array_new(EINA_VALUE_TYPE_STRING, 0);
+   fail_unless(value != NULL);
+   fail_unless(eina_value_array_data_append(value, strs, 3));
+   fail_unless(eina_value_array_count(value) == 3);
+   fail_unless(eina_value_array_get(value, 1, &s));
+   fail_unless(s != strs[1]);
+   fail_unless(strcmp(s, "-20") == 0);
+
+   fail_unless(eina_value_array_data_convert(value, 0, 3,
+                                             EINA_VALUE_TYPE_INT, ints));
+   fail_unless(ints[0] == 10 && ints[1] == -20 && ints[2] == 30);
+   fail_unless(eina_value_array_append(value, "not a number"));
+   fail_if(eina_value_array_data_convert(value, 0, 4,
+                                         EINA_VALUE_TYPE_INT, ints));
+   eina_value_free(value);
+
+   eina_shutdown();
+}
+END_TEST
+
 START_TEST(eina_value_test_list)
 {
    Eina_Value *value, other;
@@ -1853,6 +1937,232 @@ START_TEST(eina_value_test_model)
 END_TEST
 #endif
 
+START_TEST(eina_value_test_convert_numbers)
+{
+   /* eina_value_convert() uses a table for numbers, it must give the
+    * same results as the convert_to() of the types */
+   const Eina_Value_Type *types[] = {
+     EINA_VALUE_TYPE_UCHAR, EINA_VALUE_TYPE_USHORT, EINA_VALUE_TYPE_UINT,
+     EINA_VALUE_TYPE_ULONG, EINA_VALUE_TYPE_TIMESTAMP, EINA_VALUE_TYPE_UINT64,
+     EINA_VALUE_TYPE_CHAR, EINA_VALUE_TYPE_SHORT, EINA_VALUE_TYPE_INT,
+     EINA_VALUE_TYPE_LONG, EINA_VALUE_TYPE_INT64, EINA_VALUE_TYPE_FLOAT,
+     EINA_VALUE_TYPE_DOUBLE
+   };
+   const int64_t integers[] = {
+     0, 1, -1, 42, 127, 128, -128, -129, 255, 256, 32767, 32768, -32769,
+     65535, 65536, 2147483647LL, 2147483648LL, -2147483649LL,
+     4294967295LL, 4294967296LL, 9223372036854775807LL,
+     -9223372036854775807LL - 1
+   };
+   const double reals[] = {
+     0.0, 0.5, -0.5, 127.9, -128.9, 255.5, 1e10, -1e10, 1e30, -1e30,
+     2147483648.0, 4294967296.0, 9223372036854775808.0,
+     18446744073709551616.0, -9223372036854775808.0
+   };
+   unsigned int i, j, k, n;
+   int64_t i64;
+   uint64_t u64;
+   double d;
+
+   eina_init();
+
+   n = sizeof(integers) / sizeof(integers[0]) +
+     sizeof(reals) / sizeof(reals[0]) + 1;
+
+   for (i = 0; i < sizeof(types) / sizeof(types[0]); i++)
+     for (j = 0; j < sizeof(types) / sizeof(types[0]); j++)
+       for (k = 0; k < n; k++)
+         {
+            Eina_Value src, conv;
+            union { char buf[8]; double d; } expected;
+            Eina_Bool ret, expected_ret;
+
+            fail_unless(eina_value_setup(&src, EINA_VALUE_TYPE_UINT64));
+            if (k < sizeof(integers) / sizeof(integers[0]))
+              {
+                 i64 = integers[k];
+                 memcpy(src.value.buf, &i64, sizeof(i64));
+              }
+            else if (k < n - 1)
+              {
+                 eina_value_flush(&src);
+                 fail_unless(eina_value_setup(&src, EINA_VALUE_TYPE_DOUBLE));
+                 d = reals[k - sizeof(integers) / sizeof(integers[0])];
+                 fail_unless(eina_value_set(&src, d));
+              }
+            else
+              {
+                 u64 = 18446744073709551615ULL;
+                 fail_unless(eina_value_set(&src, u64));
+              }
+
+            /* bring the source value to the tested type, skip if it
+             * does not fit */
+            {
+               Eina_Value tmp;
+
+               fail_unless(eina_value_setup(&tmp, types[i]));
+               if (!eina_value_type_convert_to(src.type, types[i],
+                                               src.value.buf,
+                                               tmp.value.buf))
+                 {
+                    eina_value_flush(&tmp);
+                    eina_value_flush(&src);
+                    continue;
+                 }
+               eina_value_flush(&src);
+               src = tmp;
+            }
+
+            fail_unless(eina_value_setup(&conv, types[j]));
+            memset(&expected, 0, sizeof(expected));
+            expected_ret = eina_value_type_convert_to(types[i], types[j],
+                                                      src.value.buf,
+                                                      expected.buf);
+            ret = eina_value_convert(&src, &conv);
+            fail_if(ret != expected_ret,
+                    "%s -> %s (%u): %d instead of %d",
+                    types[i]->name, types[j]->name, k, ret, expected_ret);
+            if (ret)
+              fail_if(memcmp(conv.value.buf, expected.buf, types[j]->value_size),
+                      "%s -> %s (%u): different values",
+                      types[i]->name, types[j]->name, k);
+            eina_value_flush(&conv);
+            eina_value_flush(&src);
+         }
+
+   /* limits rounded to a double do not fit */
+   {
+      Eina_Value src, conv;
+
+      fail_unless(eina_value_setup(&src, EINA_VALUE_TYPE_DOUBLE));
+      fail_unless(eina_value_setup(&conv, EINA_VALUE_TYPE_INT64));
+      fail_unless(eina_value_set(&src, 9223372036854775808.0));
+      fail_if(eina_value_convert(&src, &conv));
+      fail_if(eina_value_type_convert_to(src.type, conv.type,
+                                         src.value.buf, conv.value.buf));
+      fail_unless(eina_value_set(&src, -9223372036854775808.0));
+      fail_unless(eina_value_convert(&src, &conv));
+      eina_value_flush(&conv);
+
+      fail_unless(eina_value_setup(&conv, EINA_VALUE_TYPE_UINT64));
+      fail_unless(eina_value_set(&src, 18446744073709551616.0));
+      fail_if(eina_value_convert(&src, &conv));
+      fail_if(eina_value_type_convert_to(src.type, conv.type,
+                                         src.value.buf, conv.value.buf));
+      eina_value_flush(&conv);
+      eina_value_flush(&src);
+   }
+
+   eina_shutdown();
+}
+END_TEST
+
+#define BIGST_COUNT 48
+
+static const Eina_Value_Struct_Member *
+_struct_index_find_member(const Eina_Value_Struct_Operations *ops __UNUSED__, const Eina_Value_Struct_Desc *desc, const char *name)
+{
+   if (strcmp(name, "m47") == 0)
+     return desc->members + 7;
+   return NULL;
+}
+
+START_TEST(eina_value_test_struct_index)
+{
+   Eina_Value_Struct_Operations ops = {
+     EINA_VALUE_STRUCT_OPERATIONS_VERSION,
+     NULL, NULL, NULL, NULL,
+     _struct_index_find_member
+   };
+   static char names[BIGST_COUNT][8];
+   static Eina_Value_Struct_Member members[BIGST_COUNT + 1];
+   static Eina_Value_Struct_Member reversed[BIGST_COUNT + 1];
+   Eina_Value_Struct_Desc desc = {
+     EINA_VALUE_STRUCT_DESC_VERSION,
+     NULL, members, BIGST_COUNT, BIGST_COUNT * sizeof(int)
+   };
+   Eina_Value value;
+   int i, x;
+
+   eina_init();
+
+   for (i = 0; i < BIGST_COUNT; i++)
+     {
+        snprintf(names[i], sizeof(names[i]), "m%d", i);
+        members[i].name = names[i];
+        members[i].type = EINA_VALUE_TYPE_INT;
+        members[i].offset = i * sizeof(int);
+        reversed[BIGST_COUNT - 1 - i] = members[i];
+     }
+   memset(members + BIGST_COUNT, 0, sizeof(members[0]));
+   memset(reversed + BIGST_COUNT, 0, sizeof(reversed[0]));
+
+   fail_unless(eina_value_struct_setup(&value, &desc));
+   for (i = 0; i < BIGST_COUNT; i++)
+     {
+        fail_unless(eina_value_struct_member_index_get(&desc, names[i]) == i);
+        fail_unless(eina_value_struct_set(&value, names[i], i * 3));
+        fail_unless(eina_value_struct_index_get(&value, i, &x));
+        fail_unless(x == i * 3);
+        fail_unless(eina_value_struct_index_set(&value, i, i * 5));
+        fail_unless(eina_value_struct_get(&value, names[i], &x));
+        fail_unless(x == i * 5);
+        x = -i;
+        fail_unless(eina_value_struct_index_pset(&value, i, &x));
+        x = 0;
+        fail_unless(eina_value_struct_index_pget(&value, i, &x));
+        fail_unless(x == -i);
+     }
+   fail_unless(eina_value_struct_member_index_get(&desc, "m") == -1);
+   fail_unless(eina_value_struct_member_index_get(&desc, "m48") == -1);
+   fail_if(eina_value_struct_get(&value, "m100", &x));
+   fail_if(eina_value_struct_index_get(&value, BIGST_COUNT, &x));
+   eina_value_flush(&value);
+
+   /* same description, other members: the index is not reused */
+   desc.members = reversed;
+   for (i = 0; i < BIGST_COUNT; i++)
+     fail_unless(eina_value_struct_member_index_get(&desc, names[i]) ==
+                 BIGST_COUNT - 1 - i);
+
+   /* members terminated by a sentinel */
+   desc.member_count = 0;
+   fail_unless(eina_value_struct_setup(&value, &desc));
+   for (i = 0; i < BIGST_COUNT; i++)
+     {
+        x = eina_value_struct_member_index_get(&desc, names[i]);
+        fail_unless(x == BIGST_COUNT - 1 - i);
+        fail_unless(eina_value_struct_index_set(&value, x, i));
+        fail_unless(eina_value_struct_get(&value, names[i], &x));
+        fail_unless(x == i);
+     }
+   fail_if(eina_value_struct_index_get(&value, BIGST_COUNT, &x));
+   eina_value_flush(&value);
+
+   /* members renamed in place, the index does not hide them */
+   fail_unless(eina_value_struct_member_index_get(&desc, "m5") ==
+               BIGST_COUNT - 1 - 5);
+   snprintf(names[5], sizeof(names[5]), "b5");
+   fail_unless(eina_value_struct_member_index_get(&desc, "b5") ==
+               BIGST_COUNT - 1 - 5);
+   fail_unless(eina_value_struct_member_index_get(&desc, "m5") == -1);
+   eina_value_struct_desc_index_del(&desc);
+   fail_unless(eina_value_struct_member_index_get(&desc, "b5") ==
+               BIGST_COUNT - 1 - 5);
+   eina_value_struct_desc_index_del(&desc);
+
+   /* find_member of the description is used */
+   desc.ops = &ops;
+   fail_unless(eina_value_struct_member_index_get(&desc, "m47") == 7);
+   fail_unless(eina_value_struct_member_index_get(&desc, "m100") == -1);
+
+   eina_shutdown();
+}
+END_TEST
+
+#undef BIGST_COUNT
+
 void
 eina_test_value(TCase *tc)
 {
@@ -1863,13 +2173,16 @@ eina_test_value(TCase *tc)
    tcase_add_test(tc, eina_value_test_to_string);
    tcase_add_test(tc, eina_value_test_convert_char);
    tcase_add_test(tc, eina_value_test_convert_uchar);
+   tcase_add_test(tc, eina_value_test_convert_numbers);
    // TODO: other converters...
    tcase_add_test(tc, eina_value_test_array);
+   tcase_add_test(tc, eina_value_test_array_data);
    tcase_add_test(tc, eina_value_test_list);
    tcase_add_test(tc, eina_value_test_hash);
    tcase_add_test(tc, eina_value_test_timeval);
    tcase_add_test(tc, eina_value_test_blob);
    tcase_add_test(tc, eina_value_test_struct);
+   tcase_add_test(tc, eina_value_test_struct_index);
    tcase_add_test(tc, eina_value_test_array_of_struct);
 #if 0
    tcase_add_test(tc, eina_value_test_model);
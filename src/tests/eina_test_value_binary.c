@@ -0,0 +1,337 @@
+/* EINA - EFL data type library
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "eina_suite.h"
+#include "Eina.h"
+
+struct point {
+   int x;
+   double y;
+   const char *name;
+};
+
+struct tree {
+   Eina_Value_Array points;
+   Eina_Value_Array longs;
+   Eina_Value_Hash lists;
+   Eina_Value_Blob blob;
+   struct timeval tv;
+   unsigned char c;
+};
+
+static const unsigned char blob_bytes[] = { 0, 1, 2, 0xfe, 0xff };
+
+/* the types are only known at runtime */
+static Eina_Value_Struct_Member point_members[3];
+static Eina_Value_Struct_Desc point_desc = {
+  EINA_VALUE_STRUCT_DESC_VERSION, NULL,
+  point_members, 3, sizeof(struct point)
+};
+static Eina_Value_Struct_Member tree_members[7];
+static Eina_Value_Struct_Desc tree_desc = {
+  EINA_VALUE_STRUCT_DESC_VERSION, NULL,
+  tree_members, 0, sizeof(struct tree)
+};
+
+/* a struct holding a bit of every type, with an array of structs */
+static void
+_eina_value_binary_tree_setup(Eina_Value *value)
+{
+   const Eina_Value_Struct_Member point_init[] = {
+     EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_INT, struct point, x),
+     EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_DOUBLE, struct point, y),
+     EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_STRINGSHARE, struct point, name)
+   };
+   const Eina_Value_Struct_Member tree_init[] = {
+     EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_ARRAY, struct tree, points),
+     EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_ARRAY, struct tree, longs),
+     EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_HASH, struct tree, lists),
+     EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_BLOB, struct tree, blob),
+     EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_TIMEVAL, struct tree, tv),
+     EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_UCHAR, struct tree, c),
+     EINA_VALUE_STRUCT_MEMBER_SENTINEL
+   };
+   Eina_Value_Blob blob = { NULL, blob_bytes, sizeof(blob_bytes) };
+   struct timeval tv = { 1234, 5678 };
+   Eina_Value points, longs, lists, strings, point;
+   Eina_Value_Struct st;
+   int i;
+
+   memcpy(point_members, point_init, sizeof(point_init));
+   memcpy(tree_members, tree_init, sizeof(tree_init));
+
+   fail_unless(eina_value_array_setup(&points, EINA_VALUE_TYPE_STRUCT, 0));
+   for (i = 0; i < 10; i++)
+     {
+        char name[16];
+
+        fail_unless(eina_value_struct_setup(&point, &point_desc));
+        snprintf(name, sizeof(name), "p%d", i);
+        fail_unless(eina_value_struct_set(&point, "x", i * 3));
+        fail_unless(eina_value_struct_set(&point, "y", i / 4.0));
+        fail_unless(eina_value_struct_set(&point, "name", name));
+        fail_unless(eina_value_pget(&point, &st));
+        fail_unless(eina_value_array_append(&points, st));
+        eina_value_flush(&point);
+     }
+
+   fail_unless(eina_value_array_setup(&longs, EINA_VALUE_TYPE_LONG, 0));
+   for (i = -500; i < 500; i++)
+     fail_unless(eina_value_array_append(&longs, (long)i * 100000));
+
+   fail_unless(eina_value_list_setup(&strings, EINA_VALUE_TYPE_STRING));
+   fail_unless(eina_value_list_append(&strings, "hello"));
+   fail_unless(eina_value_list_append(&strings, ""));
+   fail_unless(eina_value_list_append(&strings, "world"));
+
+   fail_unless(eina_value_hash_setup(&lists, EINA_VALUE_TYPE_LIST, 0));
+   fail_unless(eina_value_hash_pset(&lists, "strings",
+                                    eina_value_memory_get(&strings)));
+
+   fail_unless(eina_value_struct_setup(value, &tree_desc));
+   fail_unless(eina_value_struct_pset(value, "points",
+                                      eina_value_memory_get(&points)));
+   fail_unless(eina_value_struct_pset(value, "longs",
+                                      eina_value_memory_get(&longs)));
+   fail_unless(eina_value_struct_pset(value, "lists",
+                                      eina_value_memory_get(&lists)));
+   fail_unless(eina_value_struct_set(value, "blob", blob));
+   fail_unless(eina_value_struct_set(value, "tv", tv));
+   fail_unless(eina_value_struct_set(value, "c", 200));
+
+   eina_value_flush(&points);
+   eina_value_flush(&longs);
+   eina_value_flush(&lists);
+   eina_value_flush(&strings);
+}
+
+START_TEST(eina_value_binary_tree)
+{
+   Eina_Value value, decoded, copy;
+   Eina_Binbuf *buf;
+   char *str, *decoded_str;
+   size_t size, used, i;
+
+   eina_init();
+
+   _eina_value_binary_tree_setup(&value);
+
+   buf = eina_binbuf_new();
+   fail_unless(eina_value_binary_encode(&value, buf));
+   size = eina_binbuf_length_get(buf);
+
+   used = eina_value_binary_decode(eina_binbuf_string_get(buf), size, &decoded);
+   fail_unless(used == size);
+   fail_unless(eina_value_type_get(&decoded) == EINA_VALUE_TYPE_STRUCT);
+
+   str = eina_value_to_string(&value);
+   decoded_str = eina_value_to_string(&decoded);
+   fail_unless(str != NULL);
+   fail_unless(decoded_str != NULL);
+   fail_if(strcmp(str, decoded_str), "'%s' != '%s'", str, decoded_str);
+   free(decoded_str);
+
+   /* decoded structs can be copied and outlive each other */
+   fail_unless(eina_value_copy(&decoded, &copy));
+   eina_value_flush(&decoded);
+   decoded_str = eina_value_to_string(&copy);
+   fail_if(strcmp(str, decoded_str));
+   free(decoded_str);
+   eina_value_flush(&copy);
+
+   /* encoding again gives the same bytes */
+   fail_unless(eina_value_binary_decode(eina_binbuf_string_get(buf), size, &decoded) == size);
+   fail_unless(eina_value_binary_encode(&decoded, buf));
+   fail_unless(eina_binbuf_length_get(buf) == 2 * size);
+   fail_if(memcmp(eina_binbuf_string_get(buf),
+                  eina_binbuf_string_get(buf) + size, size));
+   eina_value_flush(&decoded);
+
+   /* and both can be decoded one after the other */
+   fail_unless(eina_value_binary_decode(eina_binbuf_string_get(buf) + size,
+                                        size, &decoded) == size);
+   eina_value_flush(&decoded);
+
+   /* truncated data is refused */
+   for (i = 0; i < size; i++)
+     fail_if(eina_value_binary_decode(eina_binbuf_string_get(buf), i, &decoded) != 0);
+
+   free(str);
+   eina_binbuf_free(buf);
+   eina_value_flush(&value);
+
+   eina_shutdown();
+}
+END_TEST
+
+START_TEST(eina_value_binary_basics)
+{
+   Eina_Value value, decoded;
+   Eina_Binbuf *buf;
+   const unsigned char *bytes;
+   const char *s;
+   int64_t i64;
+   double d;
+   int i;
+
+   eina_init();
+
+   buf = eina_binbuf_new();
+
+   eina_value_setup(&value, EINA_VALUE_TYPE_INT64);
+   eina_value_set(&value, (int64_t)-1234567890123LL);
+   fail_unless(eina_value_binary_encode(&value, buf));
+   eina_value_flush(&value);
+
+   eina_value_setup(&value, EINA_VALUE_TYPE_DOUBLE);
+   eina_value_set(&value, 3.25);
+   fail_unless(eina_value_binary_encode(&value, buf));
+   eina_value_flush(&value);
+
+   eina_value_setup(&value, EINA_VALUE_TYPE_STRING);
+   fail_unless(eina_value_binary_encode(&value, buf));
+   eina_value_flush(&value);
+
+   bytes = eina_binbuf_string_get(buf);
+   i = eina_value_binary_decode(bytes, eina_binbuf_length_get(buf), &decoded);
+   fail_unless(i == 8 + 1 + 8);
+   fail_unless(eina_value_type_get(&decoded) == EINA_VALUE_TYPE_INT64);
+   fail_unless(eina_value_get(&decoded, &i64));
+   fail_unless(i64 == -1234567890123LL);
+   eina_value_flush(&decoded);
+
+   bytes += i;
+   i = eina_value_binary_decode(bytes, 17, &decoded);
+   fail_unless(i == 17);
+   fail_unless(eina_value_get(&decoded, &d));
+   fail_unless(d == 3.25);
+   eina_value_flush(&decoded);
+
+   /* NULL string */
+   bytes += i;
+   i = eina_value_binary_decode(bytes, 10, &decoded);
+   fail_unless(i == 8 + 1 + 1);
+   fail_unless(eina_value_type_get(&decoded) == EINA_VALUE_TYPE_STRING);
+   fail_unless(eina_value_get(&decoded, &s));
+   fail_unless(s == NULL);
+   eina_value_flush(&decoded);
+
+   /* a description without members is decoded as no description */
+   {
+      static const Eina_Value_Struct_Member no_members[] = {
+        EINA_VALUE_STRUCT_MEMBER_SENTINEL
+      };
+      static const Eina_Value_Struct_Desc empty_desc = {
+        EINA_VALUE_STRUCT_DESC_VERSION, NULL, no_members, 0, 1
+      };
+      Eina_Value_Struct *st;
+      Eina_Value_Struct empty;
+
+      eina_binbuf_reset(buf);
+      eina_value_setup(&value, EINA_VALUE_TYPE_STRUCT);
+      st = eina_value_memory_get(&value);
+      st->desc = &empty_desc;
+      st->memory = malloc(1);
+      fail_unless(eina_value_binary_encode(&value, buf));
+      eina_value_flush(&value);
+
+      bytes = eina_binbuf_string_get(buf);
+      i = eina_value_binary_decode(bytes, eina_binbuf_length_get(buf),
+                                   &decoded);
+      fail_unless(i == (int)eina_binbuf_length_get(buf));
+      fail_unless(eina_value_type_get(&decoded) == EINA_VALUE_TYPE_STRUCT);
+      fail_unless(eina_value_pget(&decoded, &empty));
+      fail_unless(empty.desc == NULL);
+      eina_value_flush(&decoded);
+   }
+
+   /* not an encoded value */
+   fail_if(eina_value_binary_decode("EiVb\0\0\0\0\0", 9, &decoded) != 0);
+   fail_unless(eina_error_get() == EINA_ERROR_VALUE_FAILED);
+
+   eina_binbuf_free(buf);
+
+   eina_shutdown();
+}
+END_TEST
+
+#ifndef _WIN32
+START_TEST(eina_value_binary_file)
+{
+   char filename[] = "/tmp/eina_test_value_binary_XXXXXX";
+   Eina_Value value, decoded;
+   Eina_Value_Blob blob;
+   Eina_Binbuf *buf;
+   Eina_File *f;
+   size_t size;
+   int fd;
+
+   eina_init();
+
+   _eina_value_binary_tree_setup(&value);
+   buf = eina_binbuf_new();
+   fail_unless(eina_value_binary_encode(&value, buf));
+   size = eina_binbuf_length_get(buf);
+   fail_unless(eina_value_binary_encode(&value, buf));
+
+   fd = mkstemp(filename);
+   fail_if(fd < 0);
+   fail_if(write(fd, eina_binbuf_string_get(buf), 2 * size) != (ssize_t)(2 * size));
+   close(fd);
+
+   f = eina_file_open(filename, EINA_FALSE);
+   fail_if(!f);
+
+   fail_unless(eina_value_binary_file_decode(f, size, &decoded) == size);
+   fail_unless(eina_value_struct_get(&decoded, "blob", &blob));
+   fail_unless(blob.ops == NULL);
+   fail_unless(blob.size == sizeof(blob_bytes));
+   fail_if(blob.memory == blob_bytes);
+   fail_if(memcmp(blob.memory, blob_bytes, sizeof(blob_bytes)));
+   eina_value_flush(&decoded);
+
+   fail_unless(eina_value_binary_file_decode(f, 2 * size, &decoded) == 0);
+
+   eina_file_close(f);
+   unlink(filename);
+
+   eina_binbuf_free(buf);
+   eina_value_flush(&value);
+
+   eina_shutdown();
+}
+END_TEST
+#endif
+
+void
+eina_test_value_binary(TCase *tc)
+{
+   tcase_add_test(tc, eina_value_binary_basics);
+   tcase_add_test(tc, eina_value_binary_tree);
+#ifndef _WIN32
+   tcase_add_test(tc, eina_value_binary_file);
+#endif
+}